@@ -138,14 +138,14 @@ endif()
 
 if(IS_WIN32)
   install(DIRECTORY resources/ DESTINATION resources)
-  install(FILES ${helphtblocation} DESTINATION resources)
+  install(FILES ${helphtblocation} ${helpidxlocation} ${resourcebundlelocation} DESTINATION resources)
 elseif(IS_APPLE)
   install(FILES ${PROJECT_SOURCE_DIR}/License.txt DESTINATION .)
   install(FILES ${PROJECT_SOURCE_DIR}/GPLv2.txt DESTINATION .)
 #  add_custom_target(RemoveAppsLink ALL ${PROJECT_SOURCE_DIR}/platform/macosx/removeAppsLink.sh "${CMAKE_CURRENT_BINARY_DIR}/_CPack_Packages/Darwin/DragNDrop/wxlauncher-${CPACK_PACKAGE_VERSION_MAJOR}.${CPACK_PACKAGE_VERSION_MINOR}.${CPACK_PACKAGE_VERSION_PATCH}" VERBATIM) # attempt to remove link to Applications folder, will keep this as placeholder until I come up with a better idea -- maybe a postinstall script to delete the generated DMG, remove the Applications link, then create a new DMG with hdiutil? 
 else()
   install(DIRECTORY resources/ DESTINATION ${RESOURCES_PATH})
-  install(FILES ${helphtblocation} DESTINATION ${RESOURCES_PATH})
+  install(FILES ${helphtblocation} ${helpidxlocation} ${resourcebundlelocation} DESTINATION ${RESOURCES_PATH})
   if (${CMAKE_VERSION} VERSION_EQUAL 3.0 OR ${CMAKE_VERSION} VERSION_GREATER 3.0)
     # Assume a freedesktop environment
     set(WXLAUNCHER_FILE ${CMAKE_INSTALL_PREFIX}/bin/$<TARGET_FILE_NAME:wxlauncher>)
@@ -16,11 +16,14 @@ along with this program; if not, write to the Free Software
 Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 */
 
+#include <vector>
+
 #include <wx/wx.h>
 #include <wx/gdicmn.h>
 #include <wx/imagpng.h>
 #include <wx/imaglist.h>
 #include <wx/html/htmlwin.h>
+#include <wx/stopwatch.h>
 #include "global/ids.h"
 #include "global/Compatibility.h"
 #include "global/ProfileKeys.h"
@@ -32,11 +35,19 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "tabs/AdvSettingsPage.h"
 #include "tabs/InstallPage.h"
 #include "controls/BottomButtons.h"
+#include "controls/LazyPage.h"
 #include "apis/SkinManager.h"
 #include "controls/Logger.h"
 #include "controls/StatusBar.h"
 #include "apis/HelpManager.h"
 #include "apis/FREDManager.h"
+#include "apis/LaunchPipeline.h"
+#include "apis/GameSupervisor.h"
+#include "apis/ModDataWarmer.h"
+#include "apis/ProcessPriority.h"
+#include "apis/LaunchEnvironment.h"
+#include "controls/GameConsole.h"
+#include "global/StartupProfiler.h"
 
 #include "global/MemoryDebugging.h" // Last include for memory debugging
 
@@ -45,6 +56,10 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 const int WINDOW_WIDTH = TAB_AREA_WIDTH;
 
+/** Private event that builds the Mods page once the window is up. */
+LAUNCHER_DECLARE_EVENT_TYPE(EVT_MAIN_WINDOW_BUILD_MODS_PAGE);
+LAUNCHER_DEFINE_EVENT_TYPE(EVT_MAIN_WINDOW_BUILD_MODS_PAGE);
+
 MainWindow::MainWindow() {
 	this->Create((wxFrame*)NULL, wxID_ANY, SkinSystem::GetSkinSystem()->GetWindowTitle(),
 		wxDefaultPosition, wxSize(WINDOW_WIDTH, 550), MAINWINDOW_STYLE);
@@ -53,6 +68,12 @@ MainWindow::MainWindow() {
 
 	this->FS2_pid = 0;
 	this->FRED2_pid = 0;
+	this->fs2Process = NULL;
+	this->fredProcess = NULL;
+	this->fs2Supervisor = NULL;
+	this->fredSupervisor = NULL;
+	this->consoleSupervisor = NULL;
+	this->console = NULL;
 
 	this->SetFont(SkinSystem::GetSkinSystem()->GetFont());
 	this->SetBackgroundColour(wxSystemSettings::GetColour(wxSYS_COLOUR_WINDOW));
@@ -64,9 +85,10 @@ MainWindow::MainWindow() {
 #endif
 
 	// setup keyboard shortcuts
-	wxAcceleratorEntry entries[1];
+	wxAcceleratorEntry entries[2];
 	entries[0].Set(wxACCEL_NORMAL, WXK_F3, ID_F3_PRESSED);
-	wxAcceleratorTable accel(1, entries);
+	entries[1].Set(wxACCEL_NORMAL, WXK_F4, ID_F4_PRESSED);
+	wxAcceleratorTable accel(2, entries);
 	SetAcceleratorTable(accel);
 	
 	// setup tabs
@@ -74,12 +96,24 @@ MainWindow::MainWindow() {
 	this->mainTab = new wxNotebook();
 	this->mainTab->Create(this, ID_MAINTAB, wxPoint(0,0), wxSize(WINDOW_WIDTH,-1), wxNB_TOP);
 
-	this->mainTab->AddPage(new WelcomePage(this->mainTab), _("Welcome"), true);
-	this->mainTab->AddPage(new ModsPage(this->mainTab), _("Mods"), false);
-	this->mainTab->AddPage(new BasicSettingsPage(this->mainTab), _("Basic Settings"), false);
-	this->mainTab->AddPage(new AdvSettingsPage(this->mainTab), _("Advanced Settings"), false);
+	{
+		StartupProbe probe(_T("WelcomePage"));
+		this->mainTab->AddPage(new WelcomePage(this->mainTab), _("Welcome"), true);
+	}
+	// The other pages are built when first selected. The exception is the
+	// Mods page, whose mod list reads the TC's mod.ini files, which decide
+	// the TC's skin and the active mod that the Play button and the launch
+	// need; it is built on the first turn of the event loop instead.
+	this->modsPage = new LazyPage(this->mainTab,
+		&CreateLazyPage<ModsPage>, _T("ModsPage"));
+	this->mainTab->AddPage(this->modsPage, _("Mods"), false);
+	this->mainTab->AddPage(new LazyPage(this->mainTab,
+		&CreateLazyPage<BasicSettingsPage>, _T("BasicSettingsPage")), _("Basic Settings"), false);
+	this->mainTab->AddPage(new LazyPage(this->mainTab,
+		&CreateLazyPage<AdvSettingsPage>, _T("AdvSettingsPage")), _("Advanced Settings"), false);
 #if 0
-	this->mainTab->AddPage(new InstallPage(this->mainTab), _("Install/Update"), false);
+	this->mainTab->AddPage(new LazyPage(this->mainTab,
+		&CreateLazyPage<InstallPage>, _T("InstallPage")), _("Install/Update"), false);
 #endif
 	wxPoint bbpoint(0, -1);
 	wxSize bbsize(WINDOW_WIDTH, -1);
@@ -94,10 +128,22 @@ MainWindow::MainWindow() {
 	this->SetSizerAndFit(sizer);
 	this->Layout();
 	this->Center();
+
+	wxCommandEvent buildEvent(EVT_MAIN_WINDOW_BUILD_MODS_PAGE, wxID_NONE);
+	this->AddPendingEvent(buildEvent);
 }
 
 MainWindow::~MainWindow() {
-	//
+	// a game that is still running keeps going; wxWidgets deletes its
+	// process object when it exits instead of telling this window
+	if (this->fs2Process != NULL) {
+		this->fs2Process->Detach();
+	}
+	if (this->fredProcess != NULL) {
+		this->fredProcess->Detach();
+	}
+	delete this->fs2Supervisor;
+	delete this->fredSupervisor;
 }
 
 BEGIN_EVENT_TABLE(MainWindow, wxFrame)
@@ -112,8 +158,45 @@ BEGIN_EVENT_TABLE(MainWindow, wxFrame)
 	EVT_END_PROCESS(ID_FRED2_PROCESS, MainWindow::OnFRED2Exited)
 	EVT_COMMAND(wxID_NONE, EVT_TC_SKIN_CHANGED, MainWindow::OnTCSkinChanged)
 	EVT_MENU(ID_F3_PRESSED, MainWindow::OnF3Pressed)
+	EVT_MENU(ID_F4_PRESSED, MainWindow::OnF4Pressed)
+	EVT_COMMAND(wxID_NONE, EVT_GAME_OUTPUT, MainWindow::OnGameOutput)
+	EVT_NOTEBOOK_PAGE_CHANGING(ID_MAINTAB, MainWindow::OnPageChanging)
+	EVT_COMMAND(wxID_NONE, EVT_MAIN_WINDOW_BUILD_MODS_PAGE, MainWindow::OnBuildModsPage)
 END_EVENT_TABLE()
 
+/** Builds a lazy page just before it is shown. */
+void MainWindow::OnPageChanging(wxNotebookEvent& event) {
+	const int selection = event.GetSelection();
+	if (selection != wxNOT_FOUND) {
+		LazyPage* page = dynamic_cast<LazyPage*>(this->mainTab->GetPage(selection));
+		if (page != NULL && !page->IsBuilt()) {
+			page->Build();
+			this->FitPage(page);
+		}
+	}
+	event.Skip();
+}
+
+/** Builds the Mods page, unless it was selected before the event came up. */
+void MainWindow::OnBuildModsPage(wxCommandEvent& WXUNUSED(event)) {
+	if (!this->modsPage->IsBuilt()) {
+		this->modsPage->Build();
+		this->FitPage(this->modsPage);
+	}
+}
+
+/** Grows the window if a page that was just built needs more room than the
+ pages that were there when the window was first fitted. */
+void MainWindow::FitPage(wxWindow* page) {
+	const wxSize needed(page->GetBestSize());
+	const wxSize available(page->GetClientSize());
+	if (needed.GetWidth() > available.GetWidth()
+		|| needed.GetHeight() > available.GetHeight()) {
+		this->GetSizer()->SetSizeHints(this);
+		this->Fit();
+	}
+}
+
 void MainWindow::OnQuit(wxCommandEvent& WXUNUSED(event)) {
 	this->Destroy();
 }
@@ -153,7 +236,45 @@ void MainWindow::OnFSButton(wxCommandEvent& WXUNUSED(event)) {
 	}
 }
 
+/** Starts the game with args, its executable and the arguments to run it
+ with. A single argument is quoted as one command line where wxExecute()
+ doesn't take an argument array as is. */
+static long ExecuteGame(const wxArrayString& args, wxProcess* process,
+	const EnvironmentVariables& environment, const wxString& folder) {
+#if IS_WIN32
+	// the "" correct for spaces in the path
+	const wxString command((args[0].Find(_T(" ")) != wxNOT_FOUND) ?
+		_T("\"") + args[0] + _T("\"") : args[0]);
+	wxLogDebug(_T("Starting a process using '%s'"), command.c_str());
+#define GAME_COMMAND command
+#else
+	std::vector<wxChar*> argv;
+	wxString command;
+	for (size_t i = 0; i < args.GetCount(); ++i) {
+		argv.push_back(const_cast<wxChar*>(static_cast<const wxChar*>(args[i].c_str())));
+		command += (i == 0) ? args[i] : _T(" '") + args[i] + _T("'");
+	}
+	argv.push_back(NULL);
+	wxLogDebug(_T("Starting a process using %s"), command.c_str());
+#define GAME_COMMAND &argv[0]
+#endif
+
+#if wxCHECK_VERSION(2, 9, 2)
+	wxExecuteEnv env;
+	env.cwd = folder;
+	LaunchEnvironment::Apply(environment, env);
+	return ::wxExecute(GAME_COMMAND, wxEXEC_ASYNC, process, &env);
+#else
+	wxUnusedVar(folder); // OnStart() changes the working directory instead
+	LaunchEnvironment::Override environmentOverride(environment);
+	return ::wxExecute(GAME_COMMAND, wxEXEC_ASYNC, process);
+#endif
+#undef GAME_COMMAND
+}
+
 void MainWindow::OnStart(wxButton* button, bool startFred) {
+	wxStopWatch launchTimer; // measures launch latency from the click to wxExecute()
+
 	button->SetLabel(_("Starting"));
 	button->Disable();
 
@@ -162,7 +283,7 @@ void MainWindow::OnStart(wxButton* button, bool startFred) {
 	
 	ProMan* p = ProMan::GetProfileManager();
 	wxString folder, binary;
-	if ( !p->ProfileRead(PRO_CFG_TC_ROOT_FOLDER, &folder) ) {
+	if ( !p->ProfileRead(PKEY_TC_ROOT_FOLDER, &folder) ) {
 		wxLogError(_T("Game root folder for current profile is not set (%s)"),
 			PRO_CFG_TC_ROOT_FOLDER.c_str());
 		button->SetLabel(defaultButtonValue);
@@ -189,14 +310,8 @@ void MainWindow::OnStart(wxButton* button, bool startFred) {
 		return;
 	}
 
-	if (!Compatibility::MigrateOldConfig()) {
-		wxLogError(_T("Failed to migrate old config!!"));
-		button->SetLabel(defaultButtonValue);
-		button->Enable();
-		return;
-	}
-
-	if ( ProMan::NoError != p->PushCurrentProfile() ) {
+	// usually a no-op, since LaunchPipeline pushes the profile while idle
+	if ( ProMan::NoError != LaunchPipeline::Get()->EnsurePrepared() ) {
 		button->SetLabel(defaultButtonValue);
 		button->Enable();
 		return;
@@ -221,36 +336,61 @@ void MainWindow::OnStart(wxButton* button, bool startFred) {
 	}
 #endif
 
-	if ( startFred ) {
-		this->process = new wxProcess(this, ID_FRED2_PROCESS);
-	} else {
-		this->process = new wxProcess(this, ID_FS2_PROCESS);
-	}
-
-	wxString command;
-	// the "" correct for spaces in the path
-	if (path.GetFullPath().Find(_T(" ")) != wxNOT_FOUND) {
-		command = _T("\"") + path.GetFullPath() + _T("\"");
+	// FS2 and FRED can run at the same time, so each has its own process
+	// and supervisor
+	wxProcess*& process = startFred ? this->fredProcess : this->fs2Process;
+	GameSupervisor*& supervisor = startFred ? this->fredSupervisor : this->fs2Supervisor;
+	process = new wxProcess(this, startFred ? ID_FRED2_PROCESS : ID_FS2_PROCESS);
+
+	const wxString processName(startFred ? _T("FRED2 Open") : _T("FS2 Open"));
+	const EnvironmentVariables environment(LaunchEnvironment::ReadFromProfile());
+	LaunchEnvironment::Log(environment, processName);
+
+	const bool isOutputCaptured = GameSupervisor::PrepareOutputFiles(processName);
+	wxArrayString args;
+	if (isOutputCaptured) {
+		// the game writes its output straight to the files the supervisor
+		// tails, so it never waits on the launcher, and closing the launcher
+		// while it runs doesn't break its stdout; exec keeps the game's pid
+		args.Add(_T("/bin/sh"));
+		args.Add(_T("-c"));
+		args.Add(_T("exec \"$0\" >>\"$1\" 2>>\"$2\""));
+		args.Add(path.GetFullPath());
+		args.Add(GameSupervisor::GetOutputPath(processName, false));
+		args.Add(GameSupervisor::GetOutputPath(processName, true));
 	} else {
-		command = path.GetFullPath();
+		args.Add(path.GetFullPath());
 	}
 
-	wxLogDebug(_T("Starting a process using '%s'"), command.c_str());
-
-#if wxCHECK_VERSION(2, 9, 2)
-	wxExecuteEnv env;
-	env.cwd = folder;
+	const long latency = launchTimer.Time();
+	long pid = ExecuteGame(args, process, environment, folder);
 
-	long pid = ::wxExecute(command, wxEXEC_ASYNC, this->process, &env);
-#else
-	long pid = ::wxExecute(command, wxEXEC_ASYNC, this->process);
-#endif
+	wxLogInfo(_T("Launch latency: %ld ms from click to wxExecute(), %ld ms in wxExecute()"),
+		latency, launchTimer.Time() - latency);
 
 	if ( pid == 0 ) {
+		delete process;
+		process = NULL;
 		button->SetLabel(defaultButtonValue);
 		button->Enable();
 		return;
 	}
+
+	// as early as possible, so that the threads the game starts inherit it
+	ProcessPriority::Apply(pid, processName, ProcessPriority::ReadFromProfile());
+
+	// the game's own reads take over from here
+	ModDataWarmer::Get()->Cancel();
+	LaunchPipeline::Get()->GameStarted();
+
+	// the last run of this game has finished, so its output can go
+	delete supervisor;
+	supervisor = new GameSupervisor(this, processName, pid, isOutputCaptured);
+	this->consoleSupervisor = supervisor;
+	if (this->console != NULL) {
+		this->console->SetLines(supervisor->GetName(), supervisor->GetLines());
+	}
+
 	if ( startFred ) {
 		this->FRED2_pid = pid;
 		wxLogInfo(_T("FRED2 Open is now running..."));
@@ -304,9 +444,14 @@ void MainWindow::OnFS2Exited(wxProcessEvent &event) {
 
 	wxLogInfo(_T("FS2 Open exited with a status of %d"), exitCode);
 
-	delete this->process;
-	this->process = NULL;
+	if (this->fs2Supervisor != NULL) {
+		this->fs2Supervisor->Finish(exitCode);
+	}
+	delete this->fs2Process;
+	this->fs2Process = NULL;
 	this->FS2_pid = 0;
+
+	LaunchPipeline::Get()->GameExited();
 	
 	wxButton* play = dynamic_cast<wxButton*>(
 		wxWindow::FindWindowById(ID_PLAY_BUTTON, this));
@@ -325,9 +470,14 @@ void MainWindow::OnFRED2Exited(wxProcessEvent &event) {
 
 	wxLogInfo(_T("FRED2 Open exited with a status of %d"), exitCode);
 
-	delete this->process;
-	this->process = NULL;
+	if (this->fredSupervisor != NULL) {
+		this->fredSupervisor->Finish(exitCode);
+	}
+	delete this->fredProcess;
+	this->fredProcess = NULL;
 	this->FRED2_pid = 0;
+
+	LaunchPipeline::Get()->GameExited();
 	
 	wxButton* fred = dynamic_cast<wxButton*>(
 		wxWindow::FindWindowById(ID_FRED_BUTTON, this));
@@ -351,3 +501,22 @@ void MainWindow::OnF3Pressed(wxCommandEvent& WXUNUSED(event)) {
 	proman->GlobalWrite(GBL_CFG_OPT_CONFIG_FRED, !fredEnabled);
 	FREDManager::GenerateFREDEnabledChanged();
 }
+
+void MainWindow::OnF4Pressed(wxCommandEvent& WXUNUSED(event)) {
+	if (this->console == NULL) {
+		this->console = new GameConsole(this);
+		if (this->consoleSupervisor != NULL) {
+			this->console->SetLines(this->consoleSupervisor->GetName(),
+				this->consoleSupervisor->GetLines());
+		}
+	}
+	this->console->Show();
+	this->console->Raise();
+}
+
+void MainWindow::OnGameOutput(wxCommandEvent& event) {
+	// the console shows the game started last
+	if (this->console != NULL && event.GetEventObject() == this->consoleSupervisor) {
+		this->console->AppendLines(event.GetString());
+	}
+}
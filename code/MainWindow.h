@@ -23,6 +23,10 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include <wx/notebook.h>
 #include <wx/process.h>
 
+class GameConsole;
+class GameSupervisor;
+class LazyPage;
+
 class MainWindow: public wxFrame {
 public:
 	MainWindow();
@@ -43,11 +47,25 @@ public:
 	
 	/** F3 toggles FRED launching. */
 	void OnF3Pressed(wxCommandEvent& event);
+	/** F4 shows the console with the game's output. */
+	void OnF4Pressed(wxCommandEvent& event);
+	void OnGameOutput(wxCommandEvent& event);
+
+	void OnPageChanging(wxNotebookEvent& event);
+	void OnBuildModsPage(wxCommandEvent& event);
 
 private:
-	wxProcess* process;
+	void FitPage(wxWindow* page);
+
+	wxProcess* fs2Process; //!< NULL when FS2 Open isn't running
+	wxProcess* fredProcess; //!< NULL when FRED2 Open isn't running
 	wxNotebook* mainTab;
+	LazyPage* modsPage;
 	long FS2_pid, FRED2_pid;
+	GameSupervisor* fs2Supervisor; //!< of the running or last run of FS2 Open
+	GameSupervisor* fredSupervisor; //!< of the running or last run of FRED2 Open
+	GameSupervisor* consoleSupervisor; //!< the one shown in the console, the last started
+	GameConsole* console; //!< NULL until first shown
 
 	DECLARE_EVENT_TABLE();
 };
@@ -17,6 +17,7 @@
  */
 
 #include "apis/CmdLineManager.h"
+#include "apis/EventDispatcher.h"
 
 /** \class CmdLineManager
  CmdLineManager is used to notify controls that have registered with it
@@ -60,21 +61,11 @@ void CmdLineManager::UnRegisterCustomFlagsChanged(wxEvtHandler *handler) {
 void CmdLineManager::GenerateCmdLineChanged() {
 	wxCommandEvent event(EVT_CMD_LINE_CHANGED, wxID_NONE);
 	wxLogDebug(_T("Generating EVT_CMD_LINE_CHANGED event"));
-	for (EventHandlers::iterator iter = CmdLineChangedHandlers.begin(),
-		 end = CmdLineChangedHandlers.end(); iter != end; ++iter) {
-		wxEvtHandler* current = *iter;
-		current->AddPendingEvent(event);
-		wxLogDebug(_T(" Sent EVT_CMD_LINE_CHANGED event to %p"), current);
-	}
+	EventDispatcher::Post(CmdLineChangedHandlers, event);
 }
 
 void CmdLineManager::GenerateCustomFlagsChanged() {
 	wxCommandEvent event(EVT_CUSTOM_FLAGS_CHANGED, wxID_NONE);
 	wxLogDebug(_T("Generating EVT_CUSTOM_FLAGS_CHANGED event"));
-	for (EventHandlers::iterator iter = CustomFlagsChangedHandlers.begin(),
-		 end = CustomFlagsChangedHandlers.end(); iter != end; ++iter) {
-		wxEvtHandler* current = *iter;
-		current->AddPendingEvent(event);
-		wxLogDebug(_T(" Sent EVT_CUSTOM_FLAGS_CHANGED event to %p"), current);
-	}
+	EventDispatcher::Post(CustomFlagsChangedHandlers, event);
 }
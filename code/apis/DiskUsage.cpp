@@ -0,0 +1,744 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <set>
+#include <string>
+
+#include <wx/wx.h>
+#include <wx/filename.h>
+#include <wx/stopwatch.h>
+
+#include "apis/DiskUsage.h"
+#include "generated/configure_launcher.h"
+#include "global/ProfileKeys.h"
+
+#if IS_WIN32
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "global/MemoryDebugging.h"
+
+LAUNCHER_DEFINE_EVENT_TYPE(EVT_DISK_USAGE_DONE);
+
+const wxString DISK_USAGE_CACHE_FILE_NAME(_T("diskusagecache.txt"));
+const char DISK_USAGE_CACHE_HEADER[] = "wxLauncher disk usage cache 1";
+/** Milliseconds an idle worker waits before checking for a cancel again. */
+const int DISK_USAGE_IDLE_WAIT = 100;
+/** Longer extensions are counted as no extension, so that odd file names
+ don't each get a line of their own. */
+const size_t DISK_USAGE_MAX_TYPE_LENGTH = 8;
+
+/** Paths are kept in the OS's own form while scanning, so that the workers
+ never convert or allocate wxStrings. */
+#if IS_WIN32
+typedef std::wstring NativeString;
+const wchar_t NATIVE_SEPARATOR = L'\\';
+#else
+typedef std::string NativeString;
+const char NATIVE_SEPARATOR = '/';
+#endif
+
+static NativeString ToNative(const wxString& text) {
+#if IS_WIN32
+	return NativeString(text.wc_str());
+#else
+	const wxCharBuffer buffer(text.fn_str());
+	return NativeString((buffer.data() != NULL) ? buffer.data() : "");
+#endif
+}
+
+static wxString FromNative(const NativeString& text) {
+#if IS_WIN32
+	return wxString(text.c_str());
+#else
+	return wxString(text.c_str(), *wxConvFileName);
+#endif
+}
+
+/** The files of one type in a folder. */
+struct TypeTotals {
+	NativeString type;
+	UsageTotals totals;
+};
+
+/** What a folder held when it had the modification time modified. */
+struct FolderRecord {
+	FolderRecord(): modified(0) { }
+	int64_t modified;
+	std::vector<NativeString> subfolders; //!< names
+	std::vector<TypeTotals> types;
+};
+typedef std::map<NativeString, FolderRecord> FolderCache;
+
+struct FolderJob {
+	NativeString path;
+	size_t mod;
+	bool isRoot; //!< the mod's own folder
+	bool isData; //!< in the mod's data folder
+	int64_t modified;
+};
+
+/** One worker's totals for one mod. */
+struct WorkerTotals {
+	UsageTotals total, vp, data, other;
+	std::map<NativeString, UsageTotals> byType;
+};
+
+static NativeString FileType(const NativeString& name) {
+	const size_t dot = name.rfind('.');
+	if (dot == NativeString::npos || dot == 0 || name.size() - dot - 1 > DISK_USAGE_MAX_TYPE_LENGTH) {
+		return NativeString();
+	}
+	NativeString type(name.substr(dot + 1));
+	for (size_t i = 0; i < type.size(); ++i) {
+		if (type[i] >= 'A' && type[i] <= 'Z') {
+			type[i] = type[i] - 'A' + 'a';
+		}
+	}
+	return type;
+}
+
+static bool IsDataFolderName(const NativeString& name) {
+	return name.size() == 4 && (name[0] == 'd' || name[0] == 'D') && (name[1] == 'a' || name[1] == 'A')
+		&& (name[2] == 't' || name[2] == 'T') && (name[3] == 'a' || name[3] == 'A');
+}
+
+#if IS_WIN32
+static int64_t ModifiedTime(const FILETIME& time) {
+	return (static_cast<int64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+}
+
+static bool StatFolder(const NativeString& path, bool isRoot, int64_t& modified) {
+	WIN32_FILE_ATTRIBUTE_DATA data;
+	if (!GetFileAttributesExW(path.c_str(), GetFileExInfoStandard, &data)
+		|| (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0
+		|| (!isRoot && (data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) != 0)) {
+		return false;
+	}
+	modified = ModifiedTime(data.ftLastWriteTime);
+	return true;
+}
+
+/** Windows doesn't give the allocated size when listing a folder, so it is
+ the size rounded up to whole clusters. */
+static uint64_t ClusterSize(const NativeString& path) {
+	wchar_t volume[MAX_PATH];
+	DWORD sectorsPerCluster, bytesPerSector, freeClusters, totalClusters;
+	if (GetVolumePathNameW(path.c_str(), volume, MAX_PATH)
+		&& GetDiskFreeSpaceW(volume, &sectorsPerCluster, &bytesPerSector,
+			&freeClusters, &totalClusters)) {
+		return static_cast<uint64_t>(sectorsPerCluster) * bytesPerSector;
+	}
+	return 4096;
+}
+#else
+static int64_t ModifiedTime(const struct stat& status) {
+#if IS_APPLE
+	return static_cast<int64_t>(status.st_mtimespec.tv_sec) * 1000000000 + status.st_mtimespec.tv_nsec;
+#else
+	return static_cast<int64_t>(status.st_mtim.tv_sec) * 1000000000 + status.st_mtim.tv_nsec;
+#endif
+}
+
+/** A mod's own folder may be a link to a folder elsewhere, so isRoot
+ follows links; the folders inside it aren't. */
+static bool StatFolder(const NativeString& path, bool isRoot, int64_t& modified) {
+	struct stat status;
+	const int error = isRoot ? stat(path.c_str(), &status) : lstat(path.c_str(), &status);
+	if (error != 0 || !S_ISDIR(status.st_mode)) {
+		return false;
+	}
+	modified = ModifiedTime(status);
+	return true;
+}
+#endif
+
+static FILE* OpenCacheFile(const NativeString& path, bool isWriting) {
+#if IS_WIN32
+	return _wfopen(path.c_str(), isWriting ? L"wb" : L"rb");
+#else
+	return fopen(path.c_str(), isWriting ? "wb" : "rb");
+#endif
+}
+
+/** The cache file holds paths as UTF-8 on Windows, and as they are
+ elsewhere. */
+static std::string ToCacheText(const NativeString& text) {
+#if IS_WIN32
+	const int length = WideCharToMultiByte(CP_UTF8, 0, text.c_str(), static_cast<int>(text.size()),
+		NULL, 0, NULL, NULL);
+	std::string converted(length, '\0');
+	if (length > 0) {
+		WideCharToMultiByte(CP_UTF8, 0, text.c_str(), static_cast<int>(text.size()),
+			&converted[0], length, NULL, NULL);
+	}
+	return converted;
+#else
+	return text;
+#endif
+}
+
+static NativeString FromCacheText(const std::string& text) {
+#if IS_WIN32
+	const int length = MultiByteToWideChar(CP_UTF8, 0, text.c_str(), static_cast<int>(text.size()),
+		NULL, 0);
+	std::wstring converted(length, L'\0');
+	if (length > 0) {
+		MultiByteToWideChar(CP_UTF8, 0, text.c_str(), static_cast<int>(text.size()),
+			&converted[0], length);
+	}
+	return converted;
+#else
+	return text;
+#endif
+}
+
+static bool ReadLine(FILE* file, std::string& line) {
+	line.clear();
+	char buffer[4096];
+	while (fgets(buffer, sizeof(buffer), file) != NULL) {
+		line += buffer;
+		if (!line.empty() && line[line.size() - 1] == '\n') {
+			line.erase(line.size() - 1);
+			return true;
+		}
+	}
+	return !line.empty();
+}
+
+/** Splits line at its first count tabs; the last field is the rest. */
+static bool SplitFields(const std::string& line, size_t count, std::vector<std::string>& fields) {
+	fields.clear();
+	size_t start = 0;
+	for (size_t i = 0; i < count; ++i) {
+		const size_t tab = line.find('\t', start);
+		if (tab == std::string::npos) {
+			return false;
+		}
+		fields.push_back(line.substr(start, tab - start));
+		start = tab + 1;
+	}
+	fields.push_back(line.substr(start));
+	return true;
+}
+
+static uint64_t ParseNumber(const std::string& text) {
+	return strtoull(text.c_str(), NULL, 10);
+}
+
+/** \class DiskUsageScan
+One scan, run on the scanner's thread, which starts the workers. Everything
+here is only touched by the scan's own threads; the scanner's result is
+filled in at the end, under its mutex. */
+class DiskUsageScan {
+public:
+	DiskUsageScan(DiskUsageScanner& scanner, const wxString& tcPath,
+		const wxArrayString& mods, bool useCache);
+	void Run();
+
+private:
+	void RunWorker(size_t worker);
+	void ScanFolder(const FolderJob& job, size_t worker, std::vector<FolderJob>& found);
+	void AddTypes(const FolderJob& job, const std::vector<TypeTotals>& types, size_t worker);
+	bool PopFolder(FolderJob& job);
+	void FinishFolder(std::vector<FolderJob>& found);
+	bool IsOtherMod(const NativeString& path) const {
+		return this->modRoots.find(path) != this->modRoots.end();
+	}
+	void LoadCache();
+	void SaveCache() const;
+
+	DiskUsageScanner& scanner;
+	NativeString tcRoot;
+	std::vector<NativeString> roots; //!< the mods' folders
+	std::vector<wxString> shortnames;
+	std::set<NativeString> modRoots;
+	NativeString cacheFile;
+	NativeString newCacheFile; //!< written, then renamed over cacheFile
+	bool useCache;
+	uint64_t clusterSize;
+
+	FolderCache cache; //!< as loaded; read only while the workers run
+	std::vector<std::vector<WorkerTotals> > totals; //!< by worker, then mod
+	std::vector<std::vector<std::pair<NativeString, FolderRecord> > > records; //!< by worker
+	std::atomic<uint64_t> cachedFolders;
+
+	std::mutex queueMutex;
+	std::condition_variable queueChanged;
+	std::vector<FolderJob> queue;
+	size_t pending; //!< folders queued or being scanned
+};
+
+DiskUsageScan::DiskUsageScan(DiskUsageScanner& scanner, const wxString& tcPath,
+	const wxArrayString& mods, bool useCache)
+: scanner(scanner), useCache(useCache), clusterSize(0), cachedFolders(0), pending(0) {
+	const wxString root(wxFileName::DirName(tcPath).GetPath());
+	this->tcRoot = ToNative(root);
+	for (size_t i = 0; i < mods.GetCount(); ++i) {
+		wxString folder(root);
+		if (!mods[i].IsEmpty()) {
+			wxString shortname(mods[i]);
+			shortname.Replace(_T("/"), wxString(wxFileName::GetPathSeparator()));
+			folder += wxFileName::GetPathSeparator() + shortname;
+			this->modRoots.insert(ToNative(folder));
+		}
+		this->roots.push_back(ToNative(folder));
+		this->shortnames.push_back(wxString(mods[i].c_str()));
+	}
+	const wxString cacheFile(GetProfileStorageFolder()
+		+ wxFileName::GetPathSeparator() + DISK_USAGE_CACHE_FILE_NAME);
+	this->cacheFile = ToNative(cacheFile);
+	this->newCacheFile = ToNative(cacheFile + _T(".new"));
+}
+
+void DiskUsageScan::Run() {
+	wxStopWatch timer;
+	this->LoadCache();
+#if IS_WIN32
+	this->clusterSize = ClusterSize(this->tcRoot);
+#endif
+
+	for (size_t i = 0; i < this->roots.size(); ++i) {
+		FolderJob job;
+		job.path = this->roots[i];
+		job.mod = i;
+		job.isRoot = true;
+		job.isData = false;
+		if (StatFolder(job.path, true, job.modified)) {
+			this->queue.push_back(job);
+		}
+	}
+	this->pending = this->queue.size();
+
+	const size_t threadCount = std::max<unsigned int>(1, std::thread::hardware_concurrency());
+	this->totals.resize(threadCount, std::vector<WorkerTotals>(this->roots.size()));
+	this->records.resize(threadCount);
+	std::vector<std::thread> workers;
+	for (size_t i = 0; i < threadCount; ++i) {
+		workers.push_back(std::thread(&DiskUsageScan::RunWorker, this, i));
+	}
+	for (size_t i = 0; i < workers.size(); ++i) {
+		workers[i].join();
+	}
+
+	DiskUsageResult result;
+	for (size_t mod = 0; mod < this->roots.size(); ++mod) {
+		ModUsage usage;
+		usage.shortname = this->shortnames[mod];
+		for (size_t worker = 0; worker < threadCount; ++worker) {
+			const WorkerTotals& part = this->totals[worker][mod];
+			usage.total.Add(part.total);
+			usage.vp.Add(part.vp);
+			usage.data.Add(part.data);
+			usage.other.Add(part.other);
+			for (std::map<NativeString, UsageTotals>::const_iterator it = part.byType.begin(),
+					end = part.byType.end(); it != end; ++it) {
+				usage.byType[FromNative(it->first)].Add(it->second);
+			}
+		}
+		result.mods.push_back(usage);
+	}
+	result.folderCount = this->scanner.foldersDone;
+	result.cachedFolderCount = this->cachedFolders;
+	result.isCancelled = this->scanner.isCancelled;
+
+	// even a cancelled scan leaves the folders it did for the next one
+	this->SaveCache();
+	result.milliseconds = timer.Time();
+
+	std::lock_guard<std::mutex> lock(this->scanner.mutex);
+	this->scanner.result = result;
+	this->scanner.isDone = true;
+	this->scanner.isScanning = false;
+	if (!result.isCancelled) {
+		wxCommandEvent event(EVT_DISK_USAGE_DONE, wxID_NONE);
+		this->scanner.owner->AddPendingEvent(event);
+	}
+}
+
+void DiskUsageScan::RunWorker(size_t worker) {
+	FolderJob job;
+	std::vector<FolderJob> found;
+	while (this->PopFolder(job)) {
+		found.clear();
+		if (!this->scanner.isCancelled) {
+			this->ScanFolder(job, worker, found);
+		}
+		this->FinishFolder(found);
+	}
+}
+
+/** Waits for a folder to scan. Returns false once there are none left,
+ or the scan is cancelled. */
+bool DiskUsageScan::PopFolder(FolderJob& job) {
+	std::unique_lock<std::mutex> lock(this->queueMutex);
+	while (this->queue.empty() && this->pending > 0 && !this->scanner.isCancelled) {
+		this->queueChanged.wait_for(lock, std::chrono::milliseconds(DISK_USAGE_IDLE_WAIT));
+	}
+	if (this->queue.empty() || this->scanner.isCancelled) {
+		return false;
+	}
+	job = this->queue.back();
+	this->queue.pop_back();
+	return true;
+}
+
+/** Queues the subfolders of the folder just scanned, then counts it done,
+ in that order so that pending never drops to 0 while there is work left. */
+void DiskUsageScan::FinishFolder(std::vector<FolderJob>& found) {
+	std::lock_guard<std::mutex> lock(this->queueMutex);
+	this->queue.insert(this->queue.end(), found.begin(), found.end());
+	this->pending += found.size();
+	--this->pending;
+	if (!found.empty() || this->pending == 0) {
+		this->queueChanged.notify_all();
+	}
+}
+
+void DiskUsageScan::AddTypes(const FolderJob& job, const std::vector<TypeTotals>& types,
+	size_t worker) {
+	WorkerTotals& modTotals = this->totals[worker][job.mod];
+	for (std::vector<TypeTotals>::const_iterator it = types.begin(), end = types.end();
+			it != end; ++it) {
+		modTotals.total.Add(it->totals);
+		modTotals.byType[it->type].Add(it->totals);
+		if (it->type.size() == 2 && it->type[0] == 'v' && it->type[1] == 'p') {
+			modTotals.vp.Add(it->totals);
+		} else if (job.isData) {
+			modTotals.data.Add(it->totals);
+		} else {
+			modTotals.other.Add(it->totals);
+		}
+	}
+}
+
+/** Adds up the files directly in the folder, and adds its subfolders to
+ found. If the folder hasn't changed since the cache was written, its
+ files aren't looked at, only its subfolders' times. */
+void DiskUsageScan::ScanFolder(const FolderJob& job, size_t worker,
+	std::vector<FolderJob>& found) {
+	FolderRecord record;
+	record.modified = job.modified;
+
+	FolderCache::const_iterator cached = this->cache.find(job.path);
+	const bool isCached = this->useCache && cached != this->cache.end()
+		&& cached->second.modified == job.modified && job.modified != 0;
+
+	FolderJob subfolder;
+	subfolder.mod = job.mod;
+	subfolder.isRoot = false;
+
+	if (isCached) {
+		record = cached->second;
+		++this->cachedFolders;
+		for (std::vector<NativeString>::const_iterator name = record.subfolders.begin(),
+				end = record.subfolders.end(); name != end; ++name) {
+			subfolder.path = job.path + NATIVE_SEPARATOR + *name;
+			subfolder.isData = job.isData || (job.isRoot && IsDataFolderName(*name));
+			if (!this->IsOtherMod(subfolder.path)
+				&& StatFolder(subfolder.path, false, subfolder.modified)) {
+				found.push_back(subfolder);
+			}
+		}
+	} else {
+		std::map<NativeString, UsageTotals> types;
+		uint64_t fileCount = 0;
+#if IS_WIN32
+		WIN32_FIND_DATAW data;
+		HANDLE find = FindFirstFileW((job.path + L"\\*").c_str(), &data);
+		if (find == INVALID_HANDLE_VALUE) {
+			return;
+		}
+		do {
+			const NativeString name(data.cFileName);
+			if (name == L"." || name == L"..") {
+				continue;
+			}
+			if ((data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0) {
+				if ((data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) == 0) {
+					record.subfolders.push_back(name);
+					subfolder.path = job.path + NATIVE_SEPARATOR + name;
+					subfolder.isData = job.isData || (job.isRoot && IsDataFolderName(name));
+					subfolder.modified = ModifiedTime(data.ftLastWriteTime);
+					if (!this->IsOtherMod(subfolder.path)) {
+						found.push_back(subfolder);
+					}
+				}
+				continue;
+			}
+			const uint64_t size = (static_cast<uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+			UsageTotals& totals = types[FileType(name)];
+			++totals.fileCount;
+			totals.apparentBytes += size;
+			totals.allocatedBytes += (size + this->clusterSize - 1) / this->clusterSize * this->clusterSize;
+			++fileCount;
+		} while (FindNextFileW(find, &data) && !this->scanner.isCancelled);
+		FindClose(find);
+#else
+		const int folder = open(job.path.c_str(), O_RDONLY | O_DIRECTORY);
+		DIR* dir = (folder < 0) ? NULL : fdopendir(folder);
+		if (dir == NULL) {
+			if (folder >= 0) {
+				close(folder);
+			}
+			return;
+		}
+		struct dirent* entry;
+		struct stat status;
+		while ((entry = readdir(dir)) != NULL && !this->scanner.isCancelled) {
+			if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+				continue;
+			}
+			// symbolic links aren't followed, so that a link can't count a folder twice
+			if (fstatat(folder, entry->d_name, &status, AT_SYMLINK_NOFOLLOW) != 0) {
+				continue;
+			}
+			const NativeString name(entry->d_name);
+			if (S_ISDIR(status.st_mode)) {
+				record.subfolders.push_back(name);
+				subfolder.path = job.path + NATIVE_SEPARATOR + name;
+				subfolder.isData = job.isData || (job.isRoot && IsDataFolderName(name));
+				subfolder.modified = ModifiedTime(status);
+				if (!this->IsOtherMod(subfolder.path)) {
+					found.push_back(subfolder);
+				}
+			} else if (S_ISREG(status.st_mode)) {
+				UsageTotals& totals = types[FileType(name)];
+				++totals.fileCount;
+				totals.apparentBytes += status.st_size;
+				totals.allocatedBytes += static_cast<uint64_t>(status.st_blocks) * 512;
+				++fileCount;
+			}
+		}
+		closedir(dir);
+#endif
+		for (std::map<NativeString, UsageTotals>::const_iterator it = types.begin(),
+				end = types.end(); it != end; ++it) {
+			TypeTotals typeTotals;
+			typeTotals.type = it->first;
+			typeTotals.totals = it->second;
+			record.types.push_back(typeTotals);
+		}
+		this->scanner.filesSeen += fileCount;
+	}
+
+	if (isCached) {
+		uint64_t fileCount = 0;
+		for (size_t i = 0; i < record.types.size(); ++i) {
+			fileCount += record.types[i].totals.fileCount;
+		}
+		this->scanner.filesSeen += fileCount;
+	}
+	this->AddTypes(job, record.types, worker);
+	++this->scanner.foldersDone;
+	if (!this->scanner.isCancelled) {
+		this->records[worker].push_back(std::make_pair(job.path, record));
+	}
+}
+
+/** The cache is a line per folder, "F", its time and path, followed by a
+ line per subfolder, "S" and its name, and a line per file type, "T", the
+ totals and the type. Fields are separated by tabs. */
+void DiskUsageScan::LoadCache() {
+	FILE* file = OpenCacheFile(this->cacheFile, false);
+	if (file == NULL) {
+		return;
+	}
+	std::string line;
+	std::vector<std::string> fields;
+	if (!ReadLine(file, line) || line != DISK_USAGE_CACHE_HEADER) {
+		fclose(file);
+		return;
+	}
+	FolderRecord* record = NULL;
+	while (ReadLine(file, line)) {
+		if (line.size() < 2 || line[1] != '\t') {
+			continue;
+		}
+		if (line[0] == 'F' && SplitFields(line, 2, fields)) {
+			record = &this->cache[FromCacheText(fields[2])];
+			record->modified = static_cast<int64_t>(ParseNumber(fields[1]));
+		} else if (line[0] == 'S' && record != NULL && SplitFields(line, 1, fields)) {
+			record->subfolders.push_back(FromCacheText(fields[1]));
+		} else if (line[0] == 'T' && record != NULL && SplitFields(line, 4, fields)) {
+			TypeTotals type;
+			type.totals.fileCount = ParseNumber(fields[1]);
+			type.totals.apparentBytes = ParseNumber(fields[2]);
+			type.totals.allocatedBytes = ParseNumber(fields[3]);
+			type.type = FromCacheText(fields[4]);
+			record->types.push_back(type);
+		}
+	}
+	fclose(file);
+}
+
+/** Writes the folders just scanned, and keeps those outside this TC. A
+ folder with a line break in the name of it or a subfolder can't be
+ written, so it is left out, to be scanned again next time. */
+void DiskUsageScan::SaveCache() const {
+	FILE* file = OpenCacheFile(this->newCacheFile, true);
+	if (file == NULL) {
+		return;
+	}
+	fprintf(file, "%s\n", DISK_USAGE_CACHE_HEADER);
+
+	const NativeString tcPrefix(this->tcRoot + NATIVE_SEPARATOR);
+	std::vector<std::pair<const NativeString*, const FolderRecord*> > toWrite;
+	for (FolderCache::const_iterator it = this->cache.begin(), end = this->cache.end();
+			it != end; ++it) {
+		if (it->first != this->tcRoot && it->first.compare(0, tcPrefix.size(), tcPrefix) != 0) {
+			toWrite.push_back(std::make_pair(&it->first, &it->second));
+		}
+	}
+	for (size_t worker = 0; worker < this->records.size(); ++worker) {
+		for (size_t i = 0; i < this->records[worker].size(); ++i) {
+			toWrite.push_back(std::make_pair(&this->records[worker][i].first,
+				&this->records[worker][i].second));
+		}
+	}
+
+	for (size_t i = 0; i < toWrite.size(); ++i) {
+		const std::string path(ToCacheText(*toWrite[i].first));
+		const FolderRecord& record = *toWrite[i].second;
+		bool isWritable = path.find('\n') == std::string::npos;
+		for (size_t j = 0; j < record.subfolders.size() && isWritable; ++j) {
+			isWritable = record.subfolders[j].find('\n') == NativeString::npos;
+		}
+		for (size_t j = 0; j < record.types.size() && isWritable; ++j) {
+			isWritable = record.types[j].type.find('\n') == NativeString::npos;
+		}
+		if (!isWritable) {
+			continue;
+		}
+		fprintf(file, "F\t%lld\t%s\n", static_cast<long long>(record.modified), path.c_str());
+		for (size_t j = 0; j < record.subfolders.size(); ++j) {
+			fprintf(file, "S\t%s\n", ToCacheText(record.subfolders[j]).c_str());
+		}
+		for (size_t j = 0; j < record.types.size(); ++j) {
+			const UsageTotals& totals = record.types[j].totals;
+			fprintf(file, "T\t%llu\t%llu\t%llu\t%s\n",
+				static_cast<unsigned long long>(totals.fileCount),
+				static_cast<unsigned long long>(totals.apparentBytes),
+				static_cast<unsigned long long>(totals.allocatedBytes),
+				ToCacheText(record.types[j].type).c_str());
+		}
+	}
+
+	const bool isWritten = ferror(file) == 0;
+	if (fclose(file) != 0 || !isWritten) {
+		return;
+	}
+#if IS_WIN32
+	_wremove(this->cacheFile.c_str());
+	_wrename(this->newCacheFile.c_str(), this->cacheFile.c_str());
+#else
+	rename(this->newCacheFile.c_str(), this->cacheFile.c_str());
+#endif
+}
+
+static void RunDiskUsageScan(DiskUsageScan* scan) {
+	scan->Run();
+	delete scan;
+}
+
+DiskUsageScanner& DiskUsageScanner::Get() {
+	static DiskUsageScanner scanner;
+	return scanner;
+}
+
+DiskUsageScanner::DiskUsageScanner()
+: owner(NULL), isDone(false), isScanning(false), isCancelled(false),
+  foldersDone(0), filesSeen(0) {
+}
+
+DiskUsageScanner::~DiskUsageScanner() {
+	this->Cancel();
+}
+
+void DiskUsageScanner::Start(wxEvtHandler* owner, const wxString& tcPath,
+	const wxArrayString& mods, bool useCache) {
+	wxCHECK_RET(owner != NULL, _T("Start(): disk usage scan has no owner"));
+	this->Cancel();
+
+	this->owner = owner;
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->result = DiskUsageResult();
+		this->isDone = false;
+	}
+	this->isScanning = true;
+	this->isCancelled = false;
+	this->foldersDone = 0;
+	this->filesSeen = 0;
+
+	wxLogDebug(_T("Scanning the disk usage of %lu mods in %s%s"),
+		static_cast<unsigned long>(mods.GetCount()), tcPath.c_str(),
+		useCache ? _T("") : _T(" without the cache"));
+	this->thread = std::thread(RunDiskUsageScan,
+		new DiskUsageScan(*this, tcPath, mods, useCache));
+}
+
+void DiskUsageScanner::Cancel() {
+	this->isCancelled = true;
+	if (this->thread.joinable()) {
+		this->thread.join();
+	}
+	this->isScanning = false;
+}
+
+void DiskUsageScanner::GetProgress(uint64_t& folders, uint64_t& files) const {
+	folders = this->foldersDone;
+	files = this->filesSeen;
+}
+
+bool DiskUsageScanner::TakeResult(DiskUsageResult& result) {
+	std::lock_guard<std::mutex> lock(this->mutex);
+	if (!this->isDone) {
+		return false;
+	}
+	result = this->result;
+	this->result = DiskUsageResult();
+	this->isDone = false;
+
+	wxLogInfo(_T("Scanned the disk usage of %lu mods: %lu folders, %lu from the cache, in %ld ms"),
+		static_cast<unsigned long>(result.mods.size()),
+		static_cast<unsigned long>(result.folderCount),
+		static_cast<unsigned long>(result.cachedFolderCount), result.milliseconds);
+	return true;
+}
+
+wxString DiskUsageScanner::FormatSize(uint64_t bytes) {
+	if (bytes < 1024 * 1024) {
+		return wxString::Format(_("%.1f KB"), bytes / 1024.0);
+	} else if (bytes < static_cast<uint64_t>(1024) * 1024 * 1024) {
+		return wxString::Format(_("%.1f MB"), bytes / (1024.0 * 1024.0));
+	} else {
+		return wxString::Format(_("%.2f GB"), bytes / (1024.0 * 1024.0 * 1024.0));
+	}
+}
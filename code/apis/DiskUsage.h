@@ -0,0 +1,129 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#ifndef DISKUSAGE_H
+#define DISKUSAGE_H
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <stdint.h>
+
+#include <wx/wx.h>
+
+#include "apis/EventHandlers.h"
+
+/** A disk usage scan has finished, or was cancelled. Call
+ DiskUsageScanner::TakeResult() for the result. */
+LAUNCHER_DECLARE_EVENT_TYPE(EVT_DISK_USAGE_DONE);
+
+struct UsageTotals {
+	UsageTotals(): fileCount(0), apparentBytes(0), allocatedBytes(0) { }
+	void Add(const UsageTotals& other) {
+		this->fileCount += other.fileCount;
+		this->apparentBytes += other.apparentBytes;
+		this->allocatedBytes += other.allocatedBytes;
+	}
+
+	uint64_t fileCount;
+	uint64_t apparentBytes; //!< the files' sizes
+	uint64_t allocatedBytes; //!< what they take up on the disk
+};
+
+/** The disk usage of one mod's folder, not counting the folders of other
+ mods inside it. */
+struct ModUsage {
+	wxString shortname;
+	UsageTotals total;
+	UsageTotals vp; //!< VP archives, wherever they are
+	UsageTotals data; //!< loose files under data/
+	UsageTotals other; //!< everything else, such as the game's executables
+	std::map<wxString, UsageTotals> byType; //!< by lower case extension
+};
+
+struct DiskUsageResult {
+	DiskUsageResult(): folderCount(0), cachedFolderCount(0),
+		isCancelled(false), milliseconds(0) { }
+
+	std::vector<ModUsage> mods; //!< in the order given to Start()
+	uint64_t folderCount;
+	uint64_t cachedFolderCount; //!< folders whose files weren't read again
+	bool isCancelled;
+	long milliseconds;
+};
+
+/** DiskUsageScanner - works out how much disk each mod of a TC uses. The
+ folders are walked on one thread per core, sharing a queue of folders, so
+ a deep mod doesn't hold up the rest; each thread keeps its own totals until
+ the end. Only the files' metadata is read, with fstatat() on the open
+ folder, or FindFirstFile() on Windows.
+
+ What each folder holds is cached in the profile folder, keyed by the
+ folder's modification time, which changes whenever a file is added,
+ removed or renamed in it. Unchanged folders are not listed again, so that
+ scanning a TC with millions of files a second time mostly costs a stat of
+ each folder. A file rewritten in place doesn't change its folder's time,
+ so a rescan that ignores the cache is available too. */
+class DiskUsageScanner {
+public:
+	static DiskUsageScanner& Get();
+	~DiskUsageScanner();
+
+	/** Starts scanning the folders of mods, which are shortnames of mods in
+	 the TC at tcPath; the empty shortname is the TC's own folder. A mod's
+	 folder is scanned without the folders of the other mods. owner is sent
+	 EVT_DISK_USAGE_DONE when done. Cancels a scan already in progress. */
+	void Start(wxEvtHandler* owner, const wxString& tcPath,
+		const wxArrayString& mods, bool useCache);
+	/** Stops the scan in progress and waits for its threads, so that owner
+	 isn't sent anything once this returns. */
+	void Cancel();
+	bool IsScanning() const { return this->isScanning; }
+	/** How far the scan in progress is, for showing progress. */
+	void GetProgress(uint64_t& folders, uint64_t& files) const;
+	/** Moves the result of the finished scan into result. Returns false if
+	 there is none. */
+	bool TakeResult(DiskUsageResult& result);
+
+	/** Formats a size in bytes for the user, in KB, MB or GB. */
+	static wxString FormatSize(uint64_t bytes);
+
+private:
+	DiskUsageScanner();
+
+	std::thread thread;
+	wxEvtHandler* owner;
+	std::mutex mutex; //!< guards result and isDone
+	DiskUsageResult result;
+	bool isDone;
+	std::atomic<bool> isScanning;
+	std::atomic<bool> isCancelled;
+	std::atomic<uint64_t> foldersDone;
+	std::atomic<uint64_t> filesSeen;
+
+	friend class DiskUsageScan;
+
+	DiskUsageScanner(const DiskUsageScanner&);
+	DiskUsageScanner& operator=(const DiskUsageScanner&);
+};
+
+#endif
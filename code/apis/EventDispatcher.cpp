@@ -0,0 +1,209 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+ 
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "apis/EventDispatcher.h"
+
+#include "global/MemoryDebugging.h"
+
+/** \class EventDispatcher
+The Generate*() functions of the managers used to call AddPendingEvent() on
+every registered handler for every change, so setting 40 flags one at a time
+rebuilt the command line 40 times. Events posted through EventDispatcher are
+instead queued once per (handler, event type) and delivered together when the
+dispatcher's own flush event comes up in the event loop, or when the outermost
+batch ends.
+
+Each handler gets its events in the order they were last posted. When an event
+is posted again after something else was queued for the same handler, it moves
+behind that, so a TC change posted between two active mod changes is never
+seen after the second one. The flush hands the events to the handlers'
+own queues with AddPendingEvent() rather than calling ProcessEvent(): a
+handler that runs a modal dialog would otherwise run a nested flush part way
+through this one, delivering newer events before older ones.
+
+Only use Post() for notifications that carry no data: just the event's type
+and id are delivered. */
+
+/** Private event the dispatcher sends itself to flush the queue. */
+LAUNCHER_DECLARE_EVENT_TYPE(EVT_EVENT_DISPATCHER_FLUSH);
+LAUNCHER_DEFINE_EVENT_TYPE(EVT_EVENT_DISPATCHER_FLUSH);
+
+EventDispatcher* EventDispatcher::dispatcher = NULL;
+
+bool EventDispatcher::Initialize() {
+	wxASSERT(!IsInitialized());
+	dispatcher = new EventDispatcher();
+	return true;
+}
+
+void EventDispatcher::DeInitialize() {
+	wxASSERT(IsInitialized());
+	EventDispatcher* temp = dispatcher;
+	dispatcher = NULL;
+	delete temp;
+}
+
+bool EventDispatcher::IsInitialized() {
+	return dispatcher != NULL;
+}
+
+EventDispatcher::EventDispatcher()
+: batchDepth(0), isFlushScheduled(false) {
+}
+
+EventDispatcher::~EventDispatcher() {
+	if (!this->queue.empty()) {
+		wxLogDebug(_T("EventDispatcher: dropping %d undelivered events"),
+			static_cast<int>(this->queue.size()));
+	}
+}
+
+BEGIN_EVENT_TABLE(EventDispatcher, wxEvtHandler)
+EVT_COMMAND(wxID_NONE, EVT_EVENT_DISPATCHER_FLUSH, EventDispatcher::OnFlush)
+END_EVENT_TABLE()
+
+void EventDispatcher::Post(EventHandlers& handlers, const wxCommandEvent& event) {
+	if (!IsInitialized()) {
+		for (EventHandlers::iterator iter = handlers.begin(), end = handlers.end();
+			 iter != end; ++iter) {
+			(*iter)->AddPendingEvent(event);
+		}
+		return;
+	}
+	dispatcher->Queue(handlers, event);
+}
+
+void EventDispatcher::PostTo(EventHandlers& handlers, wxEvtHandler* handler,
+		const wxCommandEvent& event) {
+	wxCHECK_RET(handlers.IndexOf(handler) != wxNOT_FOUND,
+		wxString::Format(_T("PostTo(): Handler at %p is not in the list."), handler));
+
+	if (!IsInitialized()) {
+		handler->AddPendingEvent(event);
+		return;
+	}
+	dispatcher->QueueFor(handlers, handler, event);
+	if (dispatcher->batchDepth == 0) {
+		dispatcher->ScheduleFlush();
+	}
+}
+
+void EventDispatcher::Queue(EventHandlers& handlers, const wxCommandEvent& event) {
+	for (EventHandlers::iterator iter = handlers.begin(), end = handlers.end();
+		 iter != end; ++iter) {
+		this->QueueFor(handlers, *iter, event);
+	}
+
+	if (this->batchDepth == 0) {
+		this->ScheduleFlush();
+	}
+}
+
+void EventDispatcher::QueueFor(EventHandlers& handlers, wxEvtHandler* handler,
+		const wxCommandEvent& event) {
+	for (std::vector<QueuedEvent>::iterator it = this->queue.begin(),
+		 end = this->queue.end(); it != end; ++it) {
+		if (it->handler != handler || it->eventType != event.GetEventType()) {
+			continue;
+		}
+		bool isLastForHandler = true;
+		for (std::vector<QueuedEvent>::const_iterator later = it + 1;
+			 later != end; ++later) {
+			if (later->handler == handler) {
+				isLastForHandler = false;
+				break;
+			}
+		}
+		if (isLastForHandler) {
+			wxLogDebug(_T(" Coalesced event %d for %p"),
+				static_cast<int>(event.GetEventType()), handler);
+			return;
+		}
+		// something else for this handler was posted since; deliver after it
+		this->queue.erase(it);
+		break;
+	}
+
+	this->queue.push_back(QueuedEvent(&handlers, handler, event));
+	wxLogDebug(_T(" Queued event %d for %p"),
+		static_cast<int>(event.GetEventType()), handler);
+}
+
+void EventDispatcher::ScheduleFlush() {
+	if (this->isFlushScheduled || this->queue.empty()) {
+		return;
+	}
+	this->isFlushScheduled = true;
+	wxCommandEvent flushEvent(EVT_EVENT_DISPATCHER_FLUSH, wxID_NONE);
+	this->AddPendingEvent(flushEvent);
+}
+
+void EventDispatcher::BeginBatch() {
+	if (IsInitialized()) {
+		dispatcher->batchDepth++;
+	}
+}
+
+void EventDispatcher::EndBatch() {
+	if (!IsInitialized()) {
+		return;
+	}
+	wxCHECK_RET(dispatcher->batchDepth > 0,
+		_T("EventDispatcher::EndBatch() called without a matching BeginBatch()"));
+
+	dispatcher->batchDepth--;
+	if (dispatcher->batchDepth == 0) {
+		dispatcher->ScheduleFlush();
+	}
+}
+
+void EventDispatcher::Discard(const EventHandlers& handlers) {
+	if (!IsInitialized()) {
+		return;
+	}
+	std::vector<QueuedEvent>& queue = dispatcher->queue;
+	for (std::vector<QueuedEvent>::iterator it = queue.begin(); it != queue.end(); ) {
+		if (it->handlers == &handlers) {
+			it = queue.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+void EventDispatcher::OnFlush(wxCommandEvent& WXUNUSED(event)) {
+	this->isFlushScheduled = false;
+	if (this->batchDepth > 0) {
+		return; // EndBatch() will schedule another flush
+	}
+
+	// no handler runs until this returns, so nothing can post, unregister
+	// or Discard() part way through
+	for (std::vector<QueuedEvent>::iterator it = this->queue.begin(),
+		 end = this->queue.end(); it != end; ++it) {
+		// skip handlers that unregistered (and may be gone) since the post
+		if (it->handlers->IndexOf(it->handler) == wxNOT_FOUND) {
+			continue;
+		}
+		wxCommandEvent event(it->eventType, it->eventId);
+		wxLogDebug(_T(" Sent event %d to %p"),
+			static_cast<int>(it->eventType), it->handler);
+		it->handler->AddPendingEvent(event);
+	}
+	this->queue.clear();
+}
@@ -0,0 +1,100 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+ 
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef EVENTDISPATCHER_H
+#define EVENTDISPATCHER_H
+
+#include <wx/wx.h>
+#include <wx/event.h>
+
+#include <vector>
+
+#include "apis/EventHandlers.h"
+
+/** EventDispatcher - delivers broadcast events at most once per handler
+ per event-loop turn. */
+class EventDispatcher: public wxEvtHandler {
+public:
+	static bool Initialize();
+	static void DeInitialize();
+	static bool IsInitialized();
+
+	/** Sends event to every handler in handlers. An event of the same type
+	 that is already queued for a handler is not queued again, so a burst of
+	 identical notifications reaches each handler once, in the order of the
+	 last posts. Falls back to plain AddPendingEvent() if the dispatcher
+	 isn't initialized. */
+	static void Post(EventHandlers& handlers, const wxCommandEvent& event);
+
+	/** Sends event to just handler, which must be in handlers. Used to bring
+	 a handler that registered after an event was broadcast up to date. */
+	static void PostTo(EventHandlers& handlers, wxEvtHandler* handler,
+		const wxCommandEvent& event);
+
+	/** Holds back delivery of posted events until the matching EndBatch().
+	 Batches may be nested. Prefer EventBatch over calling these directly. */
+	static void BeginBatch();
+	static void EndBatch();
+
+	/** Drops queued events for handlers in the list. Must be called before
+	 a non-static EventHandlers list passed to Post() is destroyed. */
+	static void Discard(const EventHandlers& handlers);
+
+	void OnFlush(wxCommandEvent& event);
+
+	virtual ~EventDispatcher();
+
+private:
+	EventDispatcher();
+	static EventDispatcher* dispatcher;
+
+	struct QueuedEvent {
+		QueuedEvent(const EventHandlers* handlers, wxEvtHandler* handler,
+			const wxCommandEvent& event)
+			: handlers(handlers), handler(handler),
+			  eventType(event.GetEventType()), eventId(event.GetId()) { }
+		const EventHandlers* handlers; //!< list the handler was registered in
+		wxEvtHandler* handler;
+		wxEventType eventType;
+		int eventId;
+	};
+
+	void Queue(EventHandlers& handlers, const wxCommandEvent& event);
+	void QueueFor(EventHandlers& handlers, wxEvtHandler* handler,
+		const wxCommandEvent& event);
+	void ScheduleFlush();
+
+	std::vector<QueuedEvent> queue; //!< each handler's events in the order they were last posted
+	int batchDepth;
+	bool isFlushScheduled;
+
+	DECLARE_EVENT_TABLE()
+};
+
+/** Holds back delivery of broadcast events for its lifetime, e.g.
+ while applying a flag set one flag at a time. */
+class EventBatch {
+public:
+	EventBatch() { EventDispatcher::BeginBatch(); }
+	~EventBatch() { EventDispatcher::EndBatch(); }
+private:
+	EventBatch(const EventBatch&);
+	EventBatch& operator=(const EventBatch&);
+};
+
+#endif
@@ -91,19 +91,14 @@ wxFileName GetPlatformDefaultConfigFilePath(const wxString& tcPath) {
 		return ProMan::UnknownError;\
 	}
 
-ProMan::RegistryCodes FilePushProfile(wxFileConfig *cfg) {
+ProMan::RegistryCodes FilePushProfile(ProMan* proman) {
 	wxFileName configFileName;
 	wxString tcPath;
-	cfg->Read(PRO_CFG_TC_ROOT_FOLDER, &tcPath);
+	proman->ProfileRead(PKEY_TC_ROOT_FOLDER, &tcPath);
 
-	if ( cfg->Exists(INT_CONFIG_FILE_LOCATION) ) {
-		wxString configFileNameString;
-		if (cfg->Read(INT_CONFIG_FILE_LOCATION, &configFileNameString)) {
-			configFileName.Assign(configFileNameString);
-		} else {
-			wxLogError(_T("Unable to retrieve Config File location even though config says key exists"));
-			return ProMan::UnknownError;
-		}
+	wxString configFileNameString;
+	if ( proman->ProfileRead(INT_CONFIG_FILE_LOCATION, &configFileNameString) ) {
+		configFileName.Assign(configFileNameString);
 	} else {
 		configFileName = GetPlatformDefaultConfigFilePath(tcPath);
 	}
@@ -132,27 +127,27 @@ ProMan::RegistryCodes FilePushProfile(wxFileConfig *cfg) {
 	outConfig.SetPath(REG_KEY_DEFAULT_FOLDER_CFG);
 
 	// Video
-	int width, height, bitdepth;
-	cfg->Read(PRO_CFG_VIDEO_RESOLUTION_WIDTH, &width, DEFAULT_VIDEO_RESOLUTION_WIDTH);
-	cfg->Read(PRO_CFG_VIDEO_RESOLUTION_HEIGHT, &height, DEFAULT_VIDEO_RESOLUTION_HEIGHT);
-	cfg->Read(PRO_CFG_VIDEO_BIT_DEPTH, &bitdepth, DEFAULT_VIDEO_BIT_DEPTH);
+	long width, height, bitdepth;
+	proman->ProfileRead(PKEY_VIDEO_RESOLUTION_WIDTH, &width);
+	proman->ProfileRead(PKEY_VIDEO_RESOLUTION_HEIGHT, &height);
+	proman->ProfileRead(PKEY_VIDEO_BIT_DEPTH, &bitdepth);
 
-	wxString videocardValue = wxString::Format(_T("OGL -(%dx%d)x%d bit"), width, height, bitdepth);
+	wxString videocardValue = wxString::Format(_T("OGL -(%ldx%ld)x%ld bit"), width, height, bitdepth);
 
 	ret = outConfig.Write(REG_KEY_VIDEO_RESOLUTION_DEPTH, videocardValue);
 	ReturnChecker(ret, __LINE__);
 
 	
 	wxString filterMethod;
-	cfg->Read(PRO_CFG_VIDEO_TEXTURE_FILTER, &filterMethod, DEFAULT_VIDEO_TEXTURE_FILTER);
+	proman->ProfileRead(PKEY_VIDEO_TEXTURE_FILTER, &filterMethod);
 	int filterMethodValue = ( filterMethod.StartsWith(_T("Bilinear"))) ? 0 : 1;
 	
 	ret = outConfig.Write(REG_KEY_VIDEO_TEXTURE_FILTER, filterMethodValue);
 	ReturnChecker(ret, __LINE__);
 	
 
-	int oglAnisotropicFilter;
-	cfg->Read(PRO_CFG_VIDEO_ANISOTROPIC, &oglAnisotropicFilter, DEFAULT_VIDEO_ANISOTROPIC);
+	long oglAnisotropicFilter;
+	proman->ProfileRead(PKEY_VIDEO_ANISOTROPIC, &oglAnisotropicFilter);
 
 	// Caution: FSO expects anisotropic values to be a string,
 	// but since we're writing to an .ini file, we can write it out as an int
@@ -160,8 +155,8 @@ ProMan::RegistryCodes FilePushProfile(wxFileConfig *cfg) {
 	ReturnChecker(ret, __LINE__);
 	
 
-	int oglAntiAliasSample;
-	cfg->Read(PRO_CFG_VIDEO_ANTI_ALIAS, &oglAntiAliasSample, DEFAULT_VIDEO_ANTI_ALIAS);
+	long oglAntiAliasSample;
+	proman->ProfileRead(PKEY_VIDEO_ANTI_ALIAS, &oglAntiAliasSample);
 
 	ret = outConfig.Write(REG_KEY_VIDEO_ANTI_ALIAS, oglAntiAliasSample);
 	ReturnChecker(ret, __LINE__);
@@ -169,7 +164,7 @@ ProMan::RegistryCodes FilePushProfile(wxFileConfig *cfg) {
 
 	// Audio
 	wxString soundDevice;
-	cfg->Read(PRO_CFG_OPENAL_DEVICE, &soundDevice, DEFAULT_AUDIO_OPENAL_DEVICE);
+	const bool hasSoundDevice = proman->ProfileRead(PKEY_OPENAL_DEVICE, &soundDevice);
 
 	ret = outConfig.Write(REG_KEY_AUDIO_OPENAL_DEVICE, soundDevice);
 	ReturnChecker(ret, __LINE__);
@@ -179,21 +174,16 @@ ProMan::RegistryCodes FilePushProfile(wxFileConfig *cfg) {
 	outConfig.SetPath(REG_KEY_AUDIO_FOLDER_CFG);
 
 
-	wxString playbackDevice;
-	cfg->Read(
-		PRO_CFG_OPENAL_DEVICE,
-		&playbackDevice,
-		DEFAULT_AUDIO_OPENAL_PLAYBACK_DEVICE);
+	// the same entry, with a different default
+	const wxString playbackDevice(hasSoundDevice ?
+		soundDevice : DEFAULT_AUDIO_OPENAL_PLAYBACK_DEVICE);
 
 	ret = outConfig.Write(REG_KEY_AUDIO_OPENAL_PLAYBACK_DEVICE, playbackDevice);
 	ReturnChecker(ret, __LINE__);
 
 
 	wxString captureDevice;
-	bool hasEntry = cfg->Read(
-		PRO_CFG_OPENAL_CAPTURE_DEVICE,
-		&captureDevice,
-		DEFAULT_AUDIO_OPENAL_CAPTURE_DEVICE);
+	bool hasEntry = proman->ProfileRead(PKEY_OPENAL_CAPTURE_DEVICE, &captureDevice);
 
 	if (hasEntry) {
 		ret = outConfig.Write(REG_KEY_AUDIO_OPENAL_CAPTURE_DEVICE, captureDevice);
@@ -201,20 +191,17 @@ ProMan::RegistryCodes FilePushProfile(wxFileConfig *cfg) {
 	}
 
 
-	int enableEFX;
-	hasEntry = cfg->Read(PRO_CFG_OPENAL_EFX, &enableEFX, DEFAULT_AUDIO_OPENAL_EFX);
+	bool enableEFX;
+	hasEntry = proman->ProfileRead(PKEY_OPENAL_EFX, &enableEFX);
 
 	if (hasEntry) {
-		ret = outConfig.Write(REG_KEY_AUDIO_OPENAL_EFX, enableEFX);
+		ret = outConfig.Write(REG_KEY_AUDIO_OPENAL_EFX, enableEFX ? 1L : 0L);
 		ReturnChecker(ret, __LINE__);
 	}
 
 
-	int sampleRate;
-	cfg->Read(
-		PRO_CFG_OPENAL_SAMPLE_RATE,
-		&sampleRate,
-		DEFAULT_AUDIO_OPENAL_SAMPLE_RATE);
+	long sampleRate;
+	proman->ProfileRead(PKEY_OPENAL_SAMPLE_RATE, &sampleRate);
 
 	if (sampleRate != DEFAULT_AUDIO_OPENAL_SAMPLE_RATE) {
 		ret = outConfig.Write(REG_KEY_AUDIO_OPENAL_SAMPLE_RATE, sampleRate);
@@ -227,43 +214,43 @@ ProMan::RegistryCodes FilePushProfile(wxFileConfig *cfg) {
 
 	// Speech
 #if IS_WIN32 // speech is currently not supported in OS X or Linux (although Windows doesn't use this code)
-	int speechVoice;
-	cfg->Read(PRO_CFG_SPEECH_VOICE, &speechVoice, DEFAULT_SPEECH_VOICE);
+	long speechVoice;
+	proman->ProfileRead(PKEY_SPEECH_VOICE, &speechVoice);
 
 	ret = outConfig.Write(REG_KEY_SPEECH_VOICE, speechVoice);
 	ReturnChecker(ret, __LINE__);
 
 
-	int speechVolume;
-	cfg->Read(PRO_CFG_SPEECH_VOLUME, &speechVolume, DEFAULT_SPEECH_VOLUME);
+	long speechVolume;
+	proman->ProfileRead(PKEY_SPEECH_VOLUME, &speechVolume);
 
 	ret = outConfig.Write(REG_KEY_SPEECH_VOLUME, speechVolume);
 	ReturnChecker(ret, __LINE__);
 
 
-	int inTechroom, inBriefings, inGame, inMulti;
-	cfg->Read(PRO_CFG_SPEECH_IN_TECHROOM, &inTechroom, DEFAULT_SPEECH_IN_TECHROOM);
-	cfg->Read(PRO_CFG_SPEECH_IN_BRIEFINGS, &inBriefings, DEFAULT_SPEECH_IN_BRIEFINGS);
-	cfg->Read(PRO_CFG_SPEECH_IN_GAME, &inGame, DEFAULT_SPEECH_IN_GAME);
-	cfg->Read(PRO_CFG_SPEECH_IN_MULTI, &inMulti, DEFAULT_SPEECH_IN_MULTI);
+	bool inTechroom, inBriefings, inGame, inMulti;
+	proman->ProfileRead(PKEY_SPEECH_IN_TECHROOM, &inTechroom);
+	proman->ProfileRead(PKEY_SPEECH_IN_BRIEFINGS, &inBriefings);
+	proman->ProfileRead(PKEY_SPEECH_IN_GAME, &inGame);
+	proman->ProfileRead(PKEY_SPEECH_IN_MULTI, &inMulti);
 
-	ret = outConfig.Write(REG_KEY_SPEECH_IN_TECHROOM, inTechroom);
+	ret = outConfig.Write(REG_KEY_SPEECH_IN_TECHROOM, inTechroom ? 1L : 0L);
 	ReturnChecker(ret, __LINE__);
 
-	ret = outConfig.Write(REG_KEY_SPEECH_IN_BRIEFINGS, inBriefings);
+	ret = outConfig.Write(REG_KEY_SPEECH_IN_BRIEFINGS, inBriefings ? 1L : 0L);
 	ReturnChecker(ret, __LINE__);
 
-	ret = outConfig.Write(REG_KEY_SPEECH_IN_GAME, inGame);
+	ret = outConfig.Write(REG_KEY_SPEECH_IN_GAME, inGame ? 1L : 0L);
 	ReturnChecker(ret, __LINE__);
 
-	ret = outConfig.Write(REG_KEY_SPEECH_IN_MULTI, inMulti);
+	ret = outConfig.Write(REG_KEY_SPEECH_IN_MULTI, inMulti ? 1L : 0L);
 	ReturnChecker(ret, __LINE__);
 #endif
 
 
 	// Joystick
-	int currentJoystick;
-	cfg->Read(PRO_CFG_JOYSTICK_ID, &currentJoystick, DEFAULT_JOYSTICK_ID);
+	long currentJoystick;
+	proman->ProfileRead(PKEY_JOYSTICK_ID, &currentJoystick);
 
 	ret = outConfig.Write(REG_KEY_JOYSTICK_ID, currentJoystick);
 	ReturnChecker(ret, __LINE__);
@@ -275,40 +262,37 @@ ProMan::RegistryCodes FilePushProfile(wxFileConfig *cfg) {
 	ReturnChecker(ret, __LINE__);
 
 
-	int joystickForceFeedback;
-	cfg->Read(
-		PRO_CFG_JOYSTICK_FORCE_FEEDBACK,
-		&joystickForceFeedback,
-		DEFAULT_JOYSTICK_FORCE_FEEDBACK);
+	bool joystickForceFeedback;
+	proman->ProfileRead(PKEY_JOYSTICK_FORCE_FEEDBACK, &joystickForceFeedback);
 
-	ret = outConfig.Write(REG_KEY_JOYSTICK_FORCE_FEEDBACK, joystickForceFeedback);
+	ret = outConfig.Write(REG_KEY_JOYSTICK_FORCE_FEEDBACK, joystickForceFeedback ? 1L : 0L);
 	ReturnChecker(ret, __LINE__);
 
 
-	int joystickHit;
-	cfg->Read(PRO_CFG_JOYSTICK_DIRECTIONAL, &joystickHit, DEFAULT_JOYSTICK_DIRECTIONAL);
+	bool joystickHit;
+	proman->ProfileRead(PKEY_JOYSTICK_DIRECTIONAL, &joystickHit);
 
-	ret = outConfig.Write(REG_KEY_JOYSTICK_DIRECTIONAL, joystickHit);
+	ret = outConfig.Write(REG_KEY_JOYSTICK_DIRECTIONAL, joystickHit ? 1L : 0L);
 	ReturnChecker(ret, __LINE__);
 
 
 	// Network
 	wxString networkConnectionValue;
-	cfg->Read(PRO_CFG_NETWORK_TYPE, &networkConnectionValue, DEFAULT_NETWORK_TYPE);
+	proman->ProfileRead(PKEY_NETWORK_TYPE, &networkConnectionValue);
 
 	ret = outConfig.Write(REG_KEY_NETWORK_TYPE, networkConnectionValue);
 	ReturnChecker(ret, __LINE__);
 
 
 	wxString connectionSpeedValue;
-	cfg->Read(PRO_CFG_NETWORK_SPEED, &connectionSpeedValue, DEFAULT_NETWORK_SPEED);
+	proman->ProfileRead(PKEY_NETWORK_SPEED, &connectionSpeedValue);
 
 	ret = outConfig.Write(REG_KEY_NETWORK_SPEED, connectionSpeedValue);
 	ReturnChecker(ret, __LINE__);
 
 
-	int forcedport;
-	cfg->Read(PRO_CFG_NETWORK_PORT, &forcedport, DEFAULT_NETWORK_PORT);
+	long forcedport;
+	proman->ProfileRead(PKEY_NETWORK_PORT, &forcedport);
 
 	if (forcedport != DEFAULT_NETWORK_PORT) {
 		ret = outConfig.Write(REG_KEY_NETWORK_PORT, forcedport);
@@ -323,7 +307,7 @@ ProMan::RegistryCodes FilePushProfile(wxFileConfig *cfg) {
 	outConfig.SetPath(REG_KEY_NETWORK_FOLDER_CFG);
 
 	wxString networkIP;
-	cfg->Read(PRO_CFG_NETWORK_IP, &networkIP, DEFAULT_NETWORK_IP);
+	proman->ProfileRead(PKEY_NETWORK_IP, &networkIP);
 
 	if (networkIP != DEFAULT_NETWORK_IP) {
 		ret = outConfig.Write(REG_KEY_NETWORK_IP, networkIP);
@@ -341,7 +325,7 @@ ProMan::RegistryCodes FilePushProfile(wxFileConfig *cfg) {
 
 	outConfig.Save(outFileStream);
 
-	return PushCmdlineFSO(cfg);
+	return PushCmdlineFSO(proman);
 }
 
 ProMan::RegistryCodes FilePullProfile(wxFileConfig *cfg) {
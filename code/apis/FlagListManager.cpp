@@ -22,6 +22,7 @@
 #include "apis/TCManager.h"
 #include "datastructures/FSOExecutable.h"
 #include "global/ProfileKeys.h"
+#include "global/StartupProfiler.h"
 
 #include "global/MemoryDebugging.h"
 
@@ -43,6 +44,17 @@ void FlagListManager::RegisterFlagFileProcessingStatusChanged(wxEvtHandler *hand
 			_T("RegisterFlagFileProcessingStatusChanged(): Handler at %p already registered."),
 			handler));
 	FlagListManager::ffProcessingStatusChangedHandlers.Append(handler);
+	
+	// bring a handler that registers late (e.g. a page built on first use)
+	// up to date; a reset is only of interest to the proxy, which is always
+	// registered from the start
+	const FlagFileProcessingStatus status =
+		FlagListManager::GetFlagListManager()->GetFlagFileProcessingStatus();
+	if (status != FLAG_FILE_PROCESSING_RESET) {
+		wxCommandEvent event(EVT_FLAG_FILE_PROCESSING_STATUS_CHANGED, wxID_NONE);
+		event.SetInt(status);
+		handler->AddPendingEvent(event);
+	}
 }
 
 void FlagListManager::UnRegisterFlagFileProcessingStatusChanged(wxEvtHandler *handler) {
@@ -112,7 +124,7 @@ FlagListManager* FlagListManager::GetFlagListManager() {
 }
 
 FlagListManager::FlagListManager()
-: data(NULL), proxyData(NULL), buildCaps(0) {
+: processingStatus(INITIAL_STATUS), data(NULL), proxyData(NULL), buildCaps(0) {
 	TCManager::RegisterTCBinaryChanged(this);
 }
 
@@ -163,7 +175,7 @@ void FlagListManager::BeginFlagFileProcessing() {
 	
 	wxLogDebug(_T("Initializing flag file processing."));
 	
-	if ( !ProMan::GetProfileManager()->ProfileRead(PRO_CFG_TC_ROOT_FOLDER, &tcPath) ) {
+	if ( !ProMan::GetProfileManager()->ProfileRead(PKEY_TC_ROOT_FOLDER, &tcPath) ) {
 		this->SetProcessingStatus(MISSING_TC);
 		return;
 	}
@@ -178,7 +190,7 @@ void FlagListManager::BeginFlagFileProcessing() {
 		return;
 	}
 	
-	if ( !ProMan::GetProfileManager()->ProfileRead(PRO_CFG_TC_CURRENT_BINARY, &exeName)) {
+	if ( !ProMan::GetProfileManager()->ProfileRead(PKEY_TC_CURRENT_BINARY, &exeName)) {
 		this->SetProcessingStatus(MISSING_EXE);
 		return;
 	}
@@ -261,6 +273,7 @@ void FlagListManager::BeginFlagFileProcessing() {
 	}
 #endif
 
+	StartupProfiler::BeginAsync(_T("Waiting for flag file"));
 	this->SetProcessingStatus(WAITING_FOR_FLAG_FILE);
 }
 
@@ -512,6 +525,8 @@ FlagListManager::FlagProcess::FlagProcess(FlagFileArray flagFileLocations)
 }
 
 void FlagListManager::FlagProcess::OnTerminate(int pid, int status) {
+	StartupProfiler::EndAsync(_T("Waiting for flag file"));
+	StartupProbe probe(_T("Flag file parsing"));
 	wxLogDebug(_T(" FS2 Open returned %d when polled for the flags"), status);
 	
 	// Find the flag file
@@ -0,0 +1,312 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "generated/configure_launcher.h"
+
+#if IS_LINUX
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#endif
+
+#include <wx/wx.h>
+#include <wx/filename.h>
+#include <wx/stdpaths.h>
+
+#include "apis/GameSupervisor.h"
+
+#include "global/MemoryDebugging.h"
+
+LAUNCHER_DEFINE_EVENT_TYPE(EVT_GAME_OUTPUT);
+
+/** Interval between reads of the game's output, in milliseconds. */
+const int GAME_OUTPUT_INTERVAL = 100;
+/** Output reads between samples of the game's resource use. */
+const int GAME_SAMPLE_TICKS = 10;
+/** Bytes read from each session file per timer tick, so that a chatty game
+ can't keep the launcher from handling its own events. The game writes to
+ the file regardless, so it never waits for these reads. */
+const size_t GAME_OUTPUT_MAX_READ = 64 * 1024;
+/** A line longer than this is split, so that output without newlines can't
+ grow the partial line without bound. */
+const size_t GAME_MAX_LINE_LENGTH = 4096;
+const size_t GAME_CONSOLE_MAX_LINES = 2000;
+/** Lines copied to the log in one session. A debug build of the game can
+ write far more than is useful in the launcher's log. */
+const size_t GAME_LOG_MAX_LINES = 5000;
+
+bool GameSupervisor::PrepareOutputFiles(const wxString& name) {
+#if IS_WIN32
+	// wxExecute() can only give the game pipes here, and the game must not
+	// depend on the launcher to read them
+	return false;
+#else
+	for (int i = 0; i < 2; ++i) {
+		wxFile file;
+		if (!file.Create(GetOutputPath(name, i == 1), true)) {
+			return false;
+		}
+	}
+	return true;
+#endif
+}
+
+wxString GameSupervisor::GetOutputPath(const wxString& name, bool isError) {
+	wxString base(name);
+	base.Replace(_T(" "), _T("_"));
+	return wxFileName(wxStandardPaths::Get().GetUserDataDir(),
+		base + (isError ? _T(".stderr.log") : _T(".stdout.log"))).GetFullPath();
+}
+
+GameSupervisor::GameSupervisor(wxEvtHandler* owner, const wxString& name,
+	long pid, bool isOutputCaptured)
+: owner(owner),
+  name(name),
+  isRunning(true),
+  pid(pid),
+  timer(this),
+  ticksToSample(0),
+  lineCount(0),
+  loggedCount(0),
+  hasSamples(false),
+  peakRss(0),
+  userSeconds(0.0),
+  systemSeconds(0.0),
+  peakThreads(0) {
+	wxCHECK_RET(owner != NULL, _T("GameSupervisor created without an owner"));
+	this->err.isError = true;
+	if (isOutputCaptured) {
+		if (!this->out.file.Open(GetOutputPath(name, false))
+			|| !this->err.file.Open(GetOutputPath(name, true))) {
+			wxLogWarning(_T("Unable to read the output of %s"), name.c_str());
+		}
+	}
+	this->timer.Start(GAME_OUTPUT_INTERVAL);
+}
+
+GameSupervisor::~GameSupervisor() {
+	this->timer.Stop();
+}
+
+BEGIN_EVENT_TABLE(GameSupervisor, wxEvtHandler)
+EVT_TIMER(wxID_ANY, GameSupervisor::OnTimer)
+END_EVENT_TABLE()
+
+void GameSupervisor::OnTimer(wxTimerEvent& WXUNUSED(event)) {
+	if (!this->isRunning) {
+		return;
+	}
+	this->DrainStream(this->out);
+	this->DrainStream(this->err);
+	this->SendLines();
+
+	if (--this->ticksToSample <= 0) {
+		this->ticksToSample = GAME_SAMPLE_TICKS;
+		this->Sample();
+	}
+}
+
+void GameSupervisor::Finish(int exitCode) {
+	wxCHECK_RET(this->isRunning, _T("GameSupervisor::Finish() called twice"));
+	this->timer.Stop();
+
+	// whatever the game wrote just before exiting hasn't been read yet
+	while (this->DrainStream(this->out) == GAME_OUTPUT_MAX_READ) { }
+	while (this->DrainStream(this->err) == GAME_OUTPUT_MAX_READ) { }
+	if (!this->out.partial.empty()) {
+		this->AddLine(this->out.partial, false);
+		this->out.partial.clear();
+	}
+	if (!this->err.partial.empty()) {
+		this->AddLine(this->err.partial, true);
+		this->err.partial.clear();
+	}
+	this->SendLines();
+
+	this->out.file.Close();
+	this->err.file.Close();
+	this->isRunning = false;
+	this->LogSummary(exitCode);
+}
+
+/** Reads what the game has added to one of its session files since the
+ last read, up to GAME_OUTPUT_MAX_READ bytes. Returns the number of bytes
+ read. */
+size_t GameSupervisor::DrainStream(Stream& stream) {
+	if (!stream.file.IsOpened()) {
+		return 0;
+	}
+
+	char buffer[4096];
+	size_t read = 0;
+	while (read < GAME_OUTPUT_MAX_READ) {
+		const ssize_t result = stream.file.Read(buffer, sizeof(buffer));
+		if (result <= 0) {
+			break; // caught up with the game, or the read failed
+		}
+		const size_t count = static_cast<size_t>(result);
+		read += count;
+		for (size_t i = 0; i < count; ++i) {
+			const char c = buffer[i];
+			if (c == '\n') {
+				this->AddLine(stream.partial, stream.isError);
+				stream.partial.clear();
+			} else if (c != '\r') {
+				stream.partial += c;
+				if (stream.partial.size() >= GAME_MAX_LINE_LENGTH) {
+					this->AddLine(stream.partial, stream.isError);
+					stream.partial.clear();
+				}
+			}
+		}
+	}
+	return read;
+}
+
+void GameSupervisor::AddLine(const std::string& raw, bool isError) {
+	wxString line(raw.c_str(), wxConvUTF8);
+	if (line.IsEmpty() && !raw.empty()) {
+		line = wxString(raw.c_str(), wxConvISO8859_1);
+	}
+
+	this->lines.push_back(line);
+	if (this->lines.size() > GAME_CONSOLE_MAX_LINES) {
+		this->lines.pop_front();
+	}
+	if (!this->pendingLines.IsEmpty()) {
+		this->pendingLines += _T("\n");
+	}
+	this->pendingLines += line;
+	++this->lineCount;
+
+	if (this->loggedCount < GAME_LOG_MAX_LINES) {
+		wxLogInfo(_T("%s%s: %s"), this->name.c_str(),
+			isError ? _T(" (stderr)") : _T(""), line.c_str());
+		if (++this->loggedCount == GAME_LOG_MAX_LINES) {
+			wxLogInfo(_T("%s has written %lu lines; the rest of its output is only shown in the game console"),
+				this->name.c_str(), static_cast<unsigned long>(GAME_LOG_MAX_LINES));
+		}
+	}
+}
+
+void GameSupervisor::SendLines() {
+	if (this->pendingLines.IsEmpty()) {
+		return;
+	}
+	wxCommandEvent event(EVT_GAME_OUTPUT, wxID_NONE);
+	event.SetEventObject(this);
+	event.SetString(this->pendingLines);
+	this->pendingLines.Clear();
+	this->owner->AddPendingEvent(event);
+}
+
+#if IS_LINUX
+/** Reads a file under /proc into buffer. /proc files report a size of 0,
+ so they are read until EOF instead of by their length. */
+static bool ReadProcFile(long pid, const char* file, char* buffer, size_t size) {
+	char path[64];
+	snprintf(path, sizeof(path), "/proc/%ld/%s", pid, file);
+	FILE* in = fopen(path, "r");
+	if (in == NULL) {
+		return false; // the process has exited
+	}
+	const size_t length = fread(buffer, 1, size - 1, in);
+	fclose(in);
+	buffer[length] = '\0';
+	return length > 0;
+}
+
+void GameSupervisor::Sample() {
+	char buffer[4096];
+	if (!ReadProcFile(this->pid, "stat", buffer, sizeof(buffer))) {
+		return;
+	}
+	// the command name is in parentheses and may itself contain spaces or
+	// parentheses, so the fields are counted from after the last ')'
+	char* fields = strrchr(buffer, ')');
+	if (fields == NULL) {
+		return;
+	}
+	unsigned long utime = 0, stime = 0;
+	long threads = 0, rssPages = 0;
+	bool isComplete = false;
+	int field = 3; // the state, the first field after the command name
+	char* save = NULL;
+	for (char* token = strtok_r(fields + 1, " ", &save); token != NULL;
+			token = strtok_r(NULL, " ", &save), ++field) {
+		switch (field) {
+			case 14: utime = strtoul(token, NULL, 10); break;
+			case 15: stime = strtoul(token, NULL, 10); break;
+			case 20: threads = strtol(token, NULL, 10); break;
+			case 24: rssPages = strtol(token, NULL, 10); break;
+		}
+		if (field == 24) {
+			isComplete = true;
+			break;
+		}
+	}
+	if (!isComplete) {
+		wxLogDebug(_T("Unexpected format of /proc/%ld/stat"), this->pid);
+		return;
+	}
+
+	const long ticksPerSecond = sysconf(_SC_CLK_TCK);
+	if (ticksPerSecond > 0) {
+		// CPU time only grows, so the last sample is the best figure there is
+		this->userSeconds = static_cast<double>(utime) / ticksPerSecond;
+		this->systemSeconds = static_cast<double>(stime) / ticksPerSecond;
+	}
+	if (threads > this->peakThreads) {
+		this->peakThreads = threads;
+	}
+	const unsigned long long rss =
+		static_cast<unsigned long long>(rssPages) * sysconf(_SC_PAGESIZE);
+	if (rss > this->peakRss) {
+		this->peakRss = rss;
+	}
+
+	// the kernel keeps its own high-water mark, which catches peaks that
+	// fall between samples
+	if (ReadProcFile(this->pid, "status", buffer, sizeof(buffer))) {
+		const char* hwm = strstr(buffer, "VmHWM:");
+		unsigned long long kilobytes;
+		if (hwm != NULL && sscanf(hwm + 6, "%llu", &kilobytes) == 1
+				&& kilobytes * 1024 > this->peakRss) {
+			this->peakRss = kilobytes * 1024;
+		}
+	}
+	this->hasSamples = true;
+}
+#else
+void GameSupervisor::Sample() {
+	// resource sampling is only implemented through Linux's /proc
+}
+#endif
+
+void GameSupervisor::LogSummary(int exitCode) {
+	const long seconds = this->runTime.Time() / 1000;
+	wxLogInfo(_T("%s session: ran for %ld:%02ld:%02ld, exit status %d, %lu lines of output"),
+		this->name.c_str(), seconds / 3600, (seconds / 60) % 60, seconds % 60,
+		exitCode, static_cast<unsigned long>(this->lineCount));
+	if (this->hasSamples) {
+		wxLogInfo(_T("%s session: peak memory %.1f MB, CPU time %.1f s user + %.1f s system, up to %ld threads"),
+			this->name.c_str(), this->peakRss / (1024.0 * 1024.0),
+			this->userSeconds, this->systemSeconds, this->peakThreads);
+	}
+}
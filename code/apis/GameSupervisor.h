@@ -0,0 +1,116 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef GAMESUPERVISOR_H
+#define GAMESUPERVISOR_H
+
+#include <deque>
+#include <string>
+
+#include <wx/wx.h>
+#include <wx/file.h>
+#include <wx/stopwatch.h>
+#include <wx/timer.h>
+
+#include "apis/EventHandlers.h"
+
+/** The supervised process wrote more output. The event's string is the new
+ lines, separated by '\n'. */
+LAUNCHER_DECLARE_EVENT_TYPE(EVT_GAME_OUTPUT);
+
+/** Lines of output kept for the game console. */
+extern const size_t GAME_CONSOLE_MAX_LINES;
+
+/** GameSupervisor - watches one run of FS2 Open or FRED2 Open. Where the
+ platform allows, the game's stdout and stderr go straight to two session
+ files, which are tailed on a timer, so the game never waits on the launcher
+ and is unaffected if the launcher is closed while it runs. Each line goes to
+ the log and to a bounded buffer that the game console shows. Where the
+ platform allows (Linux, through /proc), the process's memory, CPU time and
+ thread count are sampled about once a second, and a summary of the session
+ is logged when the process exits.
+
+ The supervisor is kept after the process exits so that the console can
+ still show the output of the last session. */
+class GameSupervisor: public wxEvtHandler {
+public:
+	/** Empties the session files of name's game, ready for a new session.
+	 Returns false if they can't be written, or if the platform can't send
+	 a game's output to files. */
+	static bool PrepareOutputFiles(const wxString& name);
+	/** The session file that name's game writes its stdout or stderr to. */
+	static wxString GetOutputPath(const wxString& name, bool isError);
+
+	/** owner is sent EVT_GAME_OUTPUT. If isOutputCaptured, the game was
+	 started with its output going to the files PrepareOutputFiles()
+	 emptied. */
+	GameSupervisor(wxEvtHandler* owner, const wxString& name, long pid,
+		bool isOutputCaptured);
+	virtual ~GameSupervisor();
+
+	/** Reads what the process left in its session files and logs the
+	 session summary. Call from the process's end handler. */
+	void Finish(int exitCode);
+
+	bool IsRunning() const { return this->isRunning; }
+	const wxString& GetName() const { return this->name; }
+	/** The most recent lines of output, oldest first. */
+	const std::deque<wxString>& GetLines() const { return this->lines; }
+
+	void OnTimer(wxTimerEvent& event);
+
+private:
+	struct Stream {
+		Stream(): isError(false) { }
+		bool isError;
+		wxFile file; //!< not opened if the output isn't captured
+		std::string partial; //!< the start of a line still being written
+	};
+
+	size_t DrainStream(Stream& stream);
+	void AddLine(const std::string& raw, bool isError);
+	void SendLines();
+	void Sample();
+	void LogSummary(int exitCode);
+
+	wxEvtHandler* owner;
+	wxString name;
+	bool isRunning;
+	long pid;
+	wxTimer timer;
+	int ticksToSample;
+	wxStopWatch runTime;
+
+	Stream out, err;
+	std::deque<wxString> lines;
+	wxString pendingLines; //!< lines not yet sent to the owner
+	size_t lineCount; //!< every line the session wrote
+	size_t loggedCount; //!< lines copied to the log
+
+	bool hasSamples;
+	unsigned long long peakRss; //!< bytes
+	double userSeconds, systemSeconds;
+	long peakThreads;
+
+	GameSupervisor(const GameSupervisor&);
+	GameSupervisor& operator=(const GameSupervisor&);
+
+	DECLARE_EVENT_TABLE()
+};
+
+#endif
@@ -20,8 +20,15 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "generated/configure_launcher.h"
 #include <wx/filename.h>
 #include <wx/html/helpctrl.h>
+#include <wx/tokenzr.h>
+#include <wx/txtstrm.h>
+#include <wx/wfstream.h>
 #include "global/ids.h"
 
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
 #include "global/MemoryDebugging.h"
 
 using namespace HelpManager;
@@ -35,8 +42,11 @@ namespace HelpManager {
 #include "generated/helplinks.cpp"
 	};
 	bool initialized = false;
+	/** Created, and the book loaded into it, when help is first opened. */
 	wxHtmlHelpController *controller = NULL;
 	size_t numberOfHelpLinks = sizeof(HelpManager::helpLinks)/sizeof(HelpManager::helpLink);
+	/** helpLinks sorted by id, made the first time an id is looked up. */
+	std::vector<helpLink> sortedHelpLinks;
 	class ExternLinkHandler: public wxEvtHandler {
 	public:
 		void LinkClicked(wxHtmlLinkEvent &event);
@@ -45,7 +55,29 @@ namespace HelpManager {
 	class HtmlHelpController: public wxHtmlHelpController {
 	public:
 		virtual wxHtmlHelpFrame* CreateHelpFrame(wxHtmlHelpData *data);
+		virtual bool KeywordSearch(const wxString& keyword,
+			wxHelpSearchMode mode = wxHELP_SEARCH_ALL);
+	};
+	void LoadBook();
+
+	/** The full-text index that onlinehelpmaker.py writes next to the help
+	 book, so that searching doesn't mean reading every page. */
+	struct SearchPage {
+		wxString file;
+		wxString title;
 	};
+	struct SearchTerm {
+		wxString word;
+		std::vector<unsigned int> pages; //!< indexes into searchPages, ascending
+	};
+	std::vector<SearchPage> searchPages;
+	std::vector<SearchTerm> searchTerms; //!< sorted by word
+	bool searchIndexLoaded = false;
+	void LoadSearchIndex();
+	std::vector<unsigned int> Search(const wxString& query);
+	wxString FindPage(const wxString& query);
+
+	const wxString SEARCH_INDEX_HEADER(_T("wxLauncher help index 1"));
 };
 
 bool HelpManager::Initialize() {
@@ -53,18 +85,15 @@ bool HelpManager::Initialize() {
 		return false;
 	}
 
-	externLinkHandler = new ExternLinkHandler();
-	controller = new HtmlHelpController();
 	wxFileName file(_T(HELP_HTB_LOCATION));
-	if ( file.FileExists() ) {
-		controller->AddBook(file, false);
-	} else {
+	if ( !file.FileExists() ) {
 		wxLogWarning(_T("Unable to find help file %s"), file.GetFullName().c_str());
-		delete controller;
-		controller = NULL;
 		return false;
 	}
 
+	externLinkHandler = new ExternLinkHandler();
+	controller = NULL;
+
 	HelpManager::initialized = true;
 	return true;
 }
@@ -73,25 +102,209 @@ bool HelpManager::DeInitialize() {
 	if ( HelpManager::IsInitialized()) {
 		HelpManager::initialized = false;
 		delete controller;
+		controller = NULL;
 		delete externLinkHandler;
+		sortedHelpLinks.clear();
+		searchPages.clear();
+		searchTerms.clear();
+		searchIndexLoaded = false;
 	}
 	return true;
 }
 
+/** Creates the help controller and adds the help book to it if that has not
+ been done yet. Most sessions never open help, so this waits for the first
+ request for it. */
+void HelpManager::LoadBook() {
+	if (HelpManager::controller != NULL) {
+		return;
+	}
+	HelpManager::controller = new HtmlHelpController();
+
+	wxFileName file(_T(HELP_HTB_LOCATION));
+	if ( !controller->AddBook(file, false) ) {
+		wxLogWarning(_T("Unable to load help file %s"), file.GetFullName().c_str());
+	}
+}
+
+static bool HelpLinkLess(const helpLink& left, const helpLink& right) {
+	return left.id < right.id;
+}
+
+static bool HelpLinkIdLess(const helpLink& link, WindowIDS id) {
+	return link.id < id;
+}
+
+static bool SearchTermLess(const SearchTerm& left, const SearchTerm& right) {
+	return left.word < right.word;
+}
+
+static bool SearchTermWordLess(const SearchTerm& term, const wxString& word) {
+	return term.word < word;
+}
+
+/** Reads the search index. Leaves searchPages empty if there is no usable
+ index, in which case wxHtmlHelp's own search is used. */
+void HelpManager::LoadSearchIndex() {
+	if (HelpManager::searchIndexLoaded) {
+		return;
+	}
+	HelpManager::searchIndexLoaded = true;
+
+	wxFileName file(_T(HELP_HTB_LOCATION));
+	file.SetExt(_T("idx"));
+	if ( !file.FileExists() ) {
+		wxLogWarning(_T("Unable to find help search index %s"), file.GetFullName().c_str());
+		return;
+	}
+	wxFileInputStream stream(file.GetFullPath());
+	if ( !stream.IsOk() ) {
+		wxLogWarning(_T("Unable to open help search index %s"), file.GetFullName().c_str());
+		return;
+	}
+	wxTextInputStream text(stream, _T("\t"), wxConvUTF8);
+
+	if (text.ReadLine() != SEARCH_INDEX_HEADER) {
+		wxLogWarning(_T("Help search index %s is not in a format I understand"),
+			file.GetFullName().c_str());
+		return;
+	}
+	wxString countText;
+	unsigned long pageCount;
+	if (!text.ReadLine().StartsWith(_T("pages "), &countText)
+		|| !countText.ToULong(&pageCount)) {
+		wxLogWarning(_T("Help search index %s has no page count"),
+			file.GetFullName().c_str());
+		return;
+	}
+
+	std::vector<SearchPage> pages;
+	pages.reserve(pageCount);
+	for (unsigned long i = 0; i < pageCount && !stream.Eof(); ++i) {
+		const wxString line(text.ReadLine());
+		SearchPage page;
+		page.file = line.BeforeFirst(_T('\t'));
+		page.title = line.AfterFirst(_T('\t'));
+		pages.push_back(page);
+	}
+	if (pages.size() != pageCount) {
+		wxLogWarning(_T("Help search index %s ends in its list of pages"),
+			file.GetFullName().c_str());
+		return;
+	}
+
+	std::vector<SearchTerm> terms;
+	while (!stream.Eof()) {
+		const wxString line(text.ReadLine());
+		if (line.IsEmpty()) {
+			continue;
+		}
+		SearchTerm term;
+		term.word = line.BeforeFirst(_T('\t'));
+		wxStringTokenizer numbers(line.AfterFirst(_T('\t')), _T(","));
+		while (numbers.HasMoreTokens()) {
+			unsigned long number;
+			if (numbers.GetNextToken().ToULong(&number) && number < pageCount) {
+				term.pages.push_back(static_cast<unsigned int>(number));
+			}
+		}
+		terms.push_back(term);
+	}
+	// written sorted, but lookups depend on it
+	if (!std::is_sorted(terms.begin(), terms.end(), SearchTermLess)) {
+		std::sort(terms.begin(), terms.end(), SearchTermLess);
+	}
+
+	HelpManager::searchPages.swap(pages);
+	HelpManager::searchTerms.swap(terms);
+	wxLogDebug(_T("Loaded help search index: %lu words in %lu pages"),
+		static_cast<unsigned long>(HelpManager::searchTerms.size()), pageCount);
+}
+
+/** Returns the pages that have every word of query, in book order. Words are
+ split the way onlinehelpmaker.py splits them: runs of lower case ASCII
+ letters and digits, two or more long. */
+std::vector<unsigned int> HelpManager::Search(const wxString& query) {
+	std::vector<unsigned int> matches;
+	const wxString lowerQuery(query.Lower());
+	bool isFirstWord = true;
+	wxString word;
+	for (size_t i = 0; i <= lowerQuery.length(); ++i) {
+		const wxChar c = (i < lowerQuery.length()) ? lowerQuery[i] : _T(' ');
+		if ((c >= _T('a') && c <= _T('z')) || (c >= _T('0') && c <= _T('9'))) {
+			word += c;
+			continue;
+		}
+		if (word.length() < 2) {
+			word.clear();
+			continue;
+		}
+
+		std::vector<SearchTerm>::const_iterator term = std::lower_bound(
+			searchTerms.begin(), searchTerms.end(), word, SearchTermWordLess);
+		if (term == searchTerms.end() || term->word != word) {
+			return std::vector<unsigned int>();
+		}
+		if (isFirstWord) {
+			matches = term->pages;
+			isFirstWord = false;
+		} else {
+			std::vector<unsigned int> both;
+			std::set_intersection(matches.begin(), matches.end(),
+				term->pages.begin(), term->pages.end(), std::back_inserter(both));
+			matches.swap(both);
+		}
+		word.clear();
+	}
+	return matches;
+}
+
+/** Returns what to pass to the help controller to show query: query itself
+ when it names a page, the page with that title, or the first page with all
+ its words. Returns an empty string if there is no such page. */
+wxString HelpManager::FindPage(const wxString& query) {
+	HelpManager::LoadSearchIndex();
+	if (HelpManager::searchPages.empty()) {
+		return query; // no index, so let wxHtmlHelp look for it
+	}
+
+	const wxString file(query.BeforeFirst(_T('#')));
+	for (std::vector<SearchPage>::const_iterator it = searchPages.begin(),
+			end = searchPages.end(); it != end; ++it) {
+		if (it->file == file) {
+			return query;
+		}
+	}
+	for (std::vector<SearchPage>::const_iterator it = searchPages.begin(),
+			end = searchPages.end(); it != end; ++it) {
+		if (it->title == query) {
+			return it->file;
+		}
+	}
+
+	const std::vector<unsigned int> matches(HelpManager::Search(query));
+	return matches.empty() ? wxString() : searchPages[matches.front()].file;
+}
+
 bool HelpManager::IsInitialized() {
 	return HelpManager::initialized;
 }
 
 void HelpManager::OpenHelpById(WindowIDS id) {
 	wxCHECK_RET( HelpManager::IsInitialized(), _("Help manager is not initialized"));
+	HelpManager::LoadBook();
 
-	// find id if it exists
-	for (size_t i = 0; i < HelpManager::numberOfHelpLinks; i++) {
-		if (HelpManager::helpLinks[i].id == id) {
-			HelpManager::controller->Display(
-				HelpManager::helpLinks[i].location);
-			return;
-		}
+	if (HelpManager::sortedHelpLinks.empty()) {
+		HelpManager::sortedHelpLinks.assign(HelpManager::helpLinks,
+			HelpManager::helpLinks + HelpManager::numberOfHelpLinks);
+		std::sort(sortedHelpLinks.begin(), sortedHelpLinks.end(), HelpLinkLess);
+	}
+
+	std::vector<helpLink>::const_iterator link = std::lower_bound(
+		sortedHelpLinks.begin(), sortedHelpLinks.end(), id, HelpLinkIdLess);
+	if (link != sortedHelpLinks.end() && link->id == id) {
+		HelpManager::controller->Display(link->location);
+		return;
 	}
 	wxLogInfo(_(" ID %d does not have more specific help"), id);
 }
@@ -106,18 +319,23 @@ void HelpManager::OpenMainHelpPage() {
 }
 
 /** Opens the help file passing str to the help controller.
-The help controller tries to find a page in the manual in 4 ways:
+The help manager tries to find a page in the manual in 3 ways:
 \li as a direct filename of the document in the manual
-\li as a chapter name (based on the page title displayed in the contents)
-\li a word from the index
-\li any word (will open search pane and do a search)
+\li as a page title (as displayed in the contents)
+\li any words, looked up in the search index built with the manual
 
-\note Capitalization matters.
+\note Capitalization matters for filenames and titles.
 */
 void HelpManager::OpenHelpByString(wxString& str) {
 	wxCHECK_RET( HelpManager::IsInitialized(), _("Help manager is not initialized"));
+	HelpManager::LoadBook();
 
-	HelpManager::controller->Display(str);
+	const wxString page(HelpManager::FindPage(str));
+	if (page.IsEmpty()) {
+		wxLogInfo(_T("No help found for '%s'"), str.c_str());
+		return;
+	}
+	HelpManager::controller->Display(page);
 }
 
 
@@ -140,3 +358,20 @@ wxHtmlHelpFrame* HelpManager::HtmlHelpController::CreateHelpFrame(wxHtmlHelpData
 	m_helpFrame = frame;
 	return frame;
 }
+
+/** Answers from the search index when there is one, showing the best page,
+ rather than having wxHtmlHelp read through every page of the book. */
+bool HelpManager::HtmlHelpController::KeywordSearch(const wxString& keyword,
+	wxHelpSearchMode mode) {
+	HelpManager::LoadSearchIndex();
+	if (HelpManager::searchPages.empty()) {
+		return wxHtmlHelpController::KeywordSearch(keyword, mode);
+	}
+
+	const std::vector<unsigned int> matches(HelpManager::Search(keyword));
+	if (matches.empty()) {
+		wxLogInfo(_T("No help found for '%s'"), keyword.c_str());
+		return false;
+	}
+	return this->Display(HelpManager::searchPages[matches.front()].file);
+}
@@ -17,6 +17,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 */
 
 #include <wx/wx.h>
+#include <wx/timer.h>
 
 #include "apis/JoystickManager.h"
 #include "generated/configure_launcher.h"
@@ -28,8 +29,35 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "global/BasicDefaults.h"
 #include "global/MemoryDebugging.h"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
 #include <vector>
 
+LAUNCHER_DEFINE_EVENT_TYPE(EVT_JOYSTICK_HOTPLUG);
+LAUNCHER_DEFINE_EVENT_TYPE(EVT_JOYSTICK_PROBE_DONE);
+
+#if USE_JOYSTICK && HAS_SDL
+/** Milliseconds between checks for joysticks being plugged in or out.
+ Pumping SDL's events costs next to nothing when nothing has happened, so
+ this is short enough that a joystick shows up as it is plugged in. */
+const int JOYSTICK_HOTPLUG_INTERVAL = 50;
+
+/** Pumps SDL's events for the hotplug monitor. SDL 2.0.3 has no locking
+ around its joystick list, and pumping events updates that list, so this
+ runs on the main thread like every other SDL joystick call. It is also the
+ thread SDL's video was initialized on, where SDL expects its events to be
+ pumped. The main thread can't block on SDL's queue, so it is polled. */
+class HotplugTimer: public wxTimer {
+public:
+	explicit HotplugTimer(wxEvtHandler* handler): handler(handler) { }
+	virtual void Notify();
+
+private:
+	wxEvtHandler* handler;
+};
+#endif
+
 namespace JoyMan {
 #if USE_JOYSTICK
 	ApiType currentApi = API_NATIVE;
@@ -37,6 +65,24 @@ namespace JoyMan {
 	bool isSdlInitialized = false;
 	std::vector<SDL_Joystick*> sdlJoysticks;
 
+	HotplugTimer* hotplugTimer = NULL; //!< NULL when the monitor isn't running
+
+	/** Returns the position in sdlJoysticks of SDL's device deviceIndex, or
+	 -1 if it isn't listed. Opening a device that is already open only takes
+	 another reference to it, which is given back. */
+	int FindListedJoystick(int deviceIndex)
+	{
+		SDL_Joystick* joy = SDL_JoystickOpen(deviceIndex);
+		if (joy == NULL) {
+			return -1;
+		}
+		std::vector<SDL_Joystick*>::const_iterator iter =
+			std::find(sdlJoysticks.begin(), sdlJoysticks.end(), joy);
+		SDL_JoystickClose(joy);
+		return (iter == sdlJoysticks.end()) ? -1 :
+			static_cast<int>(iter - sdlJoysticks.begin());
+	}
+
 	void clearSDLJoystickList()
 	{
 		for (std::vector<SDL_Joystick*>::iterator iter = sdlJoysticks.begin(); iter != sdlJoysticks.end(); ++iter)
@@ -49,6 +95,26 @@ namespace JoyMan {
 #if IS_WIN32
 	bool isWinInitialized = false;
 	wxArrayString winJoysticks;
+
+	/** What a read of the native joysticks found. It is filled in without
+	 logging, so that the read can run on a worker thread. */
+	struct NativeProbeResults {
+		NativeProbeResults(): supported(0), total(0), capsErrors(0) { }
+		UINT supported; //!< the number of joysticks the driver supports
+		int total; //!< the joysticks that exist, plugged in or not
+		wxArrayString names; //!< of the joysticks that are plugged in
+		int capsErrors;
+	};
+
+	bool isNativeProbeRunning = false; //!< until Initialize() joins it
+	std::atomic<bool> isNativeProbeDone(false);
+	std::thread nativeProbeThread;
+	NativeProbeResults nativeProbeResults; //!< only touched by the probe thread while it runs
+
+	void ProbeNativeJoysticks(NativeProbeResults& results);
+	void RunNativeProbe(wxEvtHandler* handler);
+	void ApplyNativeProbe(NativeProbeResults& results);
+	void JoinNativeProbe();
 #endif
 #endif
 };
@@ -97,7 +163,10 @@ bool JoyMan::Initialize(ApiType apiType) {
 	currentApi = apiType;
 
 #if USE_JOYSTICK
-	if ( JoyMan::IsInitialized() ) {
+	// the native API has no device events, so its list is read again on
+	// every detection pass, by StartProbe() or here; SDL's is kept current by
+	// the hotplug monitor
+	if ( currentApi != API_NATIVE && JoyMan::IsInitialized() ) {
 		wxLogDebug(_T("JoyMan already initialized"));
 		return true;
 	}
@@ -110,53 +179,14 @@ bool JoyMan::Initialize(ApiType apiType) {
 #if IS_WIN32
 	if (currentApi == API_NATIVE)
 	{
-		UINT num = joyGetNumDevs(); // get the number of joys supported by windows.
-		if (num > 16) {
-			/* greater than 16 is cause for a warning because according to MSDN,
-			Windows 2000 and later support -1 thru 16 in the MM api (and windows NT
-			only supports 1 or 2).  MSDN also notes if you want more than 16 use
-			DirectInput. */
-			wxLogWarning(_T("Windows reports that the joystick driver ")
-				_T("supports more than 16 joysticks (reports %d)!"), num);
-		}
-
-		MMRESULT result = JOYERR_NOERROR;
-		JOYINFO joyinfo;
-		JOYCAPS joycaps;
-		JoyMan::winJoysticks.clear();
-		int totalNumberOfJoysticks = 0;
-
-		for (UINT counter = 0; counter < num; counter++) {
-			memset(reinterpret_cast<void*>(&joyinfo), 0, sizeof(JOYINFO));
-
-			result = joyGetPos(counter, &joyinfo);
-			wxString joystickName;
-
-			if (result == JOYERR_NOERROR) {
-				// joystick plugged in
-				totalNumberOfJoysticks++;
-				memset(reinterpret_cast<void*>(&joycaps), 0, sizeof(JOYCAPS));
-
-				result = joyGetDevCaps(counter, &joycaps, sizeof(JOYCAPS));
-				if (result == JOYERR_NOERROR) {
-					joystickName = wxString(joycaps.szPname, wxMBConvUTF16());
-					winJoysticks.Add(joystickName);
-				}
-				else {
-					wxLogError(_T("Error in retrieving joystick caps"));
-					continue;
-				}
-			}
-			else if (result == JOYERR_UNPLUGGED) {
-				// unplugged
-				totalNumberOfJoysticks++;
-			}
-			else {
-				// Joystick doesn't exist, do nothing
-			}
+		if (isNativeProbeRunning) {
+			// waits if the read StartProbe() began hasn't finished yet
+			JoyMan::JoinNativeProbe();
+		} else {
+			JoyMan::ProbeNativeJoysticks(nativeProbeResults);
 		}
-		wxLogInfo(_T("Windows reports %d joysticks, %d seem to be plugged in."),
-			totalNumberOfJoysticks, static_cast<int>(winJoysticks.size()));
+		JoyMan::ApplyNativeProbe(nativeProbeResults);
+		JoyMan::isWinInitialized = true;
 		return true;
 	}
 #endif
@@ -178,6 +208,7 @@ bool JoyMan::Initialize(ApiType apiType) {
 			}
 		}
 
+		JoyMan::isSdlInitialized = true;
 		return true;
 	}
 #endif
@@ -195,6 +226,7 @@ bool JoyMan::Initialize(ApiType apiType) {
 bool JoyMan::DeInitialize() {
 #if USE_JOYSTICK
 #if HAS_SDL
+	JoyMan::StopHotplugMonitor();
 	if ( isSdlInitialized ) {
 		JoyMan::isSdlInitialized = false;
 		JoyMan::sdlJoysticks.clear();
@@ -204,6 +236,11 @@ bool JoyMan::DeInitialize() {
 	}
 #endif
 #if IS_WIN32
+	if (isNativeProbeRunning) {
+		// the results are stale by the next Initialize()
+		JoyMan::JoinNativeProbe();
+		JoyMan::nativeProbeResults = NativeProbeResults();
+	}
 	if (isWinInitialized)
 	{
 		JoyMan::isWinInitialized = false;
@@ -222,6 +259,103 @@ bool JoyMan::WasCompiledIn() {
 #endif
 }
 
+#if USE_JOYSTICK && IS_WIN32
+/** Reads the native joysticks into results. Safe on a worker thread. */
+void JoyMan::ProbeNativeJoysticks(NativeProbeResults& results) {
+	results = NativeProbeResults();
+	results.supported = joyGetNumDevs(); // get the number of joys supported by windows.
+
+	MMRESULT result = JOYERR_NOERROR;
+	JOYINFO joyinfo;
+	JOYCAPS joycaps;
+
+	for (UINT counter = 0; counter < results.supported; counter++) {
+		memset(reinterpret_cast<void*>(&joyinfo), 0, sizeof(JOYINFO));
+
+		result = joyGetPos(counter, &joyinfo);
+
+		if (result == JOYERR_NOERROR) {
+			// joystick plugged in
+			results.total++;
+			memset(reinterpret_cast<void*>(&joycaps), 0, sizeof(JOYCAPS));
+
+			result = joyGetDevCaps(counter, &joycaps, sizeof(JOYCAPS));
+			if (result == JOYERR_NOERROR) {
+				results.names.Add(wxString(joycaps.szPname, wxMBConvUTF16()));
+			}
+			else {
+				results.capsErrors++;
+			}
+		}
+		else if (result == JOYERR_UNPLUGGED) {
+			// unplugged
+			results.total++;
+		}
+		else {
+			// Joystick doesn't exist, do nothing
+		}
+	}
+}
+
+/** Runs on the probe thread. */
+void JoyMan::RunNativeProbe(wxEvtHandler* handler) {
+	JoyMan::ProbeNativeJoysticks(nativeProbeResults);
+	isNativeProbeDone = true;
+
+	wxCommandEvent event(EVT_JOYSTICK_PROBE_DONE, wxID_NONE);
+	handler->AddPendingEvent(event);
+}
+
+/** Makes what a read found the current list of joysticks, logging what
+ the read could not. Main thread only. */
+void JoyMan::ApplyNativeProbe(NativeProbeResults& results) {
+	if (results.supported > 16) {
+		/* greater than 16 is cause for a warning because according to MSDN,
+		Windows 2000 and later support -1 thru 16 in the MM api (and windows NT
+		only supports 1 or 2).  MSDN also notes if you want more than 16 use
+		DirectInput. */
+		wxLogWarning(_T("Windows reports that the joystick driver ")
+			_T("supports more than 16 joysticks (reports %d)!"), results.supported);
+	}
+	for (int i = 0; i < results.capsErrors; i++) {
+		wxLogError(_T("Error in retrieving joystick caps"));
+	}
+
+	JoyMan::winJoysticks = results.names;
+	wxLogInfo(_T("Windows reports %d joysticks, %d seem to be plugged in."),
+		results.total, static_cast<int>(winJoysticks.size()));
+	results = NativeProbeResults();
+}
+
+void JoyMan::JoinNativeProbe() {
+	nativeProbeThread.join();
+	isNativeProbeRunning = false;
+	isNativeProbeDone = false;
+}
+#endif
+
+/** Native joysticks are read on a worker thread, since the multimedia API
+ can take a while to answer for each of the joysticks the driver supports.
+ SDL's joystick list has no locking, so SDL is always read on the main thread.
+\sa JoyMan::Initialize() */
+#if USE_JOYSTICK && IS_WIN32
+bool JoyMan::StartProbe(ApiType apiType, wxEvtHandler* handler) {
+	wxCHECK_MSG(handler != NULL, false, _T("StartProbe called without a handler"));
+	if (apiType != API_NATIVE) {
+		return false;
+	}
+	if (isNativeProbeRunning) {
+		return !isNativeProbeDone;
+	}
+	isNativeProbeRunning = true;
+	nativeProbeThread = std::thread(&JoyMan::RunNativeProbe, handler);
+	return true;
+#else
+bool JoyMan::StartProbe(ApiType, wxEvtHandler*) {
+	return false;
+#endif
+}
+
 /** \return number of joysticks that the system reports as existing.
 \sa JoyMan::IsPluggedIn() */
 unsigned int JoyMan::NumberOfJoysticks() {
@@ -393,3 +527,132 @@ bool JoyMan::IsJoystickPluggedIn(unsigned int) {
 	return false;
 #endif
 }
+
+#if USE_JOYSTICK && HAS_SDL
+void HotplugTimer::Notify() {
+	SDL_PumpEvents();
+
+	SDL_Event events[16];
+	int count;
+	while ((count = SDL_PeepEvents(events, 16, SDL_GETEVENT,
+			SDL_JOYDEVICEADDED, SDL_JOYDEVICEREMOVED)) > 0) {
+		for (int i = 0; i < count; ++i) {
+			wxCommandEvent hotplugEvent(EVT_JOYSTICK_HOTPLUG, wxID_NONE);
+			hotplugEvent.SetInt(events[i].type == SDL_JOYDEVICEADDED ?
+				JoyMan::HOTPLUG_ADDED : JoyMan::HOTPLUG_REMOVED);
+			// a device index when added, an instance id when removed; handled
+			// right away, since a device index is only good until SDL's list
+			// changes again
+			hotplugEvent.SetExtraLong(events[i].jdevice.which);
+			this->handler->ProcessEvent(hotplugEvent);
+		}
+	}
+	// nothing else in the launcher reads SDL's events, so don't let the open
+	// joysticks' axis and button events pile up in the queue
+	SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+}
+#endif
+
+/** Starts watching for joysticks being plugged in or unplugged. handler is
+ sent EVT_JOYSTICK_HOTPLUG for each one, from a timer on the main thread.
+ Only SDL reports these, so this does nothing for the native API.
+\return true if the monitor is running. */
+#if USE_JOYSTICK && HAS_SDL
+bool JoyMan::StartHotplugMonitor(wxEvtHandler* handler) {
+	wxCHECK_MSG(handler != NULL, false,
+		_T("StartHotplugMonitor called without a handler"));
+	if (currentApi != API_SDL || !isSdlInitialized) {
+		return false;
+	}
+	if (hotplugTimer != NULL) {
+		return true;
+	}
+
+	// the joysticks that SDL queued as added before this are already in the
+	// list, and ApplyHotplugEvent() ignores them
+	hotplugTimer = new HotplugTimer(handler);
+	hotplugTimer->Start(JOYSTICK_HOTPLUG_INTERVAL);
+	wxLogDebug(_T("Joystick hotplug monitor started"));
+	return true;
+#else
+bool JoyMan::StartHotplugMonitor(wxEvtHandler*) {
+	return false;
+#endif
+}
+
+/** Stops the hotplug monitor. */
+void JoyMan::StopHotplugMonitor() {
+#if USE_JOYSTICK && HAS_SDL
+	if (hotplugTimer == NULL) {
+		return;
+	}
+	hotplugTimer->Stop();
+	delete hotplugTimer;
+	hotplugTimer = NULL;
+	wxLogDebug(_T("Joystick hotplug monitor stopped"));
+#endif
+}
+
+/** Brings the list of joysticks up to date with an EVT_JOYSTICK_HOTPLUG
+ event. Only the joystick concerned is opened or closed. Joystick numbers
+ follow SDL's order, without the devices that couldn't be opened, so the
+ joysticks after one that is added or removed are renumbered by one.
+ Removed joysticks are found by their instance id, and the number of an
+ added one is worked out from the listed joysticks before it, since SDL's
+ device indexes also count the devices that aren't listed.
+\param index set to the number of the joystick added or removed.
+\return what changed, HOTPLUG_NONE if the event was about a joystick
+ that is already known or could not be opened. */
+#if USE_JOYSTICK && HAS_SDL
+JoyMan::HotplugChange JoyMan::ApplyHotplugEvent(const wxCommandEvent& event,
+	unsigned int& index) {
+	wxCHECK_MSG(isSdlInitialized, HOTPLUG_NONE,
+		_T("ApplyHotplugEvent called but SDL joysticks are not initialized"));
+
+	if (event.GetInt() == HOTPLUG_ADDED) {
+		const int deviceIndex = static_cast<int>(event.GetExtraLong());
+		SDL_Joystick* joy = SDL_JoystickOpen(deviceIndex);
+		if (joy == NULL) {
+			wxLogWarning(_T("Unable to open joystick %d that was plugged in: %s"),
+				deviceIndex, wxString::FromUTF8(SDL_GetError()).c_str());
+			return HOTPLUG_NONE;
+		}
+		// SDL also reports the joysticks that were plugged in at startup;
+		// opening one of those again just gives it another reference
+		if (std::find(sdlJoysticks.begin(), sdlJoysticks.end(), joy) != sdlJoysticks.end()) {
+			SDL_JoystickClose(joy);
+			return HOTPLUG_NONE;
+		}
+		// goes after the last listed joystick that SDL has before it
+		index = 0;
+		for (int i = deviceIndex; i-- > 0; ) {
+			const int listed = JoyMan::FindListedJoystick(i);
+			if (listed >= 0) {
+				index = static_cast<unsigned int>(listed) + 1;
+				break;
+			}
+		}
+		sdlJoysticks.insert(sdlJoysticks.begin() + index, joy);
+		wxLogInfo(_T("Joystick %s plugged in"), JoyMan::JoystickName(index).c_str());
+		return HOTPLUG_ADDED;
+	} else if (event.GetInt() == HOTPLUG_REMOVED) {
+		const SDL_JoystickID instanceId = static_cast<SDL_JoystickID>(event.GetExtraLong());
+		for (size_t i = 0; i < sdlJoysticks.size(); ++i) {
+			if (SDL_JoystickInstanceID(sdlJoysticks[i]) == instanceId) {
+				index = static_cast<unsigned int>(i);
+				wxLogInfo(_T("Joystick %s unplugged"), JoyMan::JoystickName(index).c_str());
+				SDL_JoystickClose(sdlJoysticks[i]);
+				sdlJoysticks.erase(sdlJoysticks.begin() + i);
+				return HOTPLUG_REMOVED;
+			}
+		}
+		return HOTPLUG_NONE;
+	}
+	wxFAIL_MSG(wxString::Format(_T("Unknown joystick hotplug change %d"), event.GetInt()));
+	return HOTPLUG_NONE;
+#else
+JoyMan::HotplugChange JoyMan::ApplyHotplugEvent(const wxCommandEvent&,
+	unsigned int&) {
+	return HOTPLUG_NONE;
+#endif
+}
@@ -21,16 +21,37 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 #include <wx/wx.h>
 
+#include "apis/EventHandlers.h"
+
+/** A joystick was plugged in or unplugged while the hotplug monitor was
+ running. Pass the event to JoyMan::ApplyHotplugEvent(). */
+LAUNCHER_DECLARE_EVENT_TYPE(EVT_JOYSTICK_HOTPLUG);
+/** A read started by JoyMan::StartProbe() has finished. The next
+ JoyMan::Initialize() for its API uses what it found. */
+LAUNCHER_DECLARE_EVENT_TYPE(EVT_JOYSTICK_PROBE_DONE);
+
 namespace JoyMan {
 	enum ApiType {
 		API_NATIVE,
 		API_SDL
 	};
 
+	enum HotplugChange {
+		HOTPLUG_NONE,
+		HOTPLUG_ADDED,
+		HOTPLUG_REMOVED
+	};
+
 	bool Initialize(ApiType apiType);
 	bool DeInitialize();
 	bool IsInitialized();
 	bool WasCompiledIn();
+	/** Starts reading the joysticks of apiType on a worker thread, for the
+	 next Initialize(apiType) to use. handler is sent EVT_JOYSTICK_PROBE_DONE
+	 when it finishes.
+	\return false if there is nothing to wait for: apiType is read on the main
+	 thread, as SDL's joysticks are, or a read has already finished. */
+	bool StartProbe(ApiType apiType, wxEvtHandler* handler);
 
 	unsigned int NumberOfJoysticks();
 	unsigned int NumberOfPluggedInJoysticks();
@@ -40,6 +61,10 @@ namespace JoyMan {
 	wxString JoystickName(unsigned int i);
 	wxString JoystickGUID(unsigned int i);
 	bool IsJoystickPluggedIn(unsigned int i);
+
+	bool StartHotplugMonitor(wxEvtHandler* handler);
+	void StopHotplugMonitor();
+	HotplugChange ApplyHotplugEvent(const wxCommandEvent& event, unsigned int& index);
 };
 
 #endif
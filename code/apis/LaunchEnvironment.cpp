@@ -0,0 +1,320 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#include <wx/wx.h>
+#include <wx/config.h>
+#include <wx/tokenzr.h>
+
+#include "apis/LaunchEnvironment.h"
+#include "apis/ProfileManager.h"
+#include "generated/configure_launcher.h"
+
+#include "global/MemoryDebugging.h"
+
+namespace {
+struct EnvironmentTemplate {
+	const wxChar* name;
+	const wxChar* variables; //!< in the profile's format
+};
+
+const EnvironmentTemplate ENVIRONMENT_TEMPLATES[] = {
+	{ wxTRANSLATE("Mesa: threaded OpenGL"),
+		_T("mesa_glthread=true") },
+	{ wxTRANSLATE("Mesa: skip OpenGL error checking"),
+		_T("MESA_NO_ERROR=1") },
+	{ wxTRANSLATE("NVIDIA: threaded optimizations"),
+		_T("__GL_THREADED_OPTIMIZATIONS=1") },
+	{ wxTRANSLATE("Turn off vsync"),
+		_T("vblank_mode=0\n")
+		_T("__GL_SYNC_TO_VBLANK=0") },
+	{ wxTRANSLATE("Larger shader cache"),
+		_T("MESA_SHADER_CACHE_MAX_SIZE=4G\n")
+		_T("__GL_SHADER_DISK_CACHE=1\n")
+		_T("__GL_SHADER_DISK_CACHE_SIZE=4294967296\n")
+		_T("__GL_SHADER_DISK_CACHE_SKIP_CLEANUP=1") },
+	{ wxTRANSLATE("Mesa: separate shader cache"),
+		_T("MESA_SHADER_CACHE_DIR=$HOME/.cache/wxlauncher") },
+};
+const size_t ENVIRONMENT_TEMPLATE_COUNT =
+	sizeof(ENVIRONMENT_TEMPLATES) / sizeof(ENVIRONMENT_TEMPLATES[0]);
+
+bool IsValidName(const wxString& name) {
+	if (name.IsEmpty() || wxIsdigit(name[0])) {
+		return false;
+	}
+	for (size_t i = 0; i < name.Length(); ++i) {
+		const wxChar c = name[i];
+		if (!wxIsalnum(c) && c != _T('_')) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/** Parses one line of the profile's text. Returns false with error empty for
+ blank lines and comments. */
+bool ParseLine(wxString line, EnvironmentVariable& variable, wxString& error) {
+	error.Clear();
+	line.Trim(true).Trim(false);
+	if (line.IsEmpty() || line.StartsWith(_T("#"))) {
+		return false;
+	}
+	if (line.StartsWith(_T("export "))) {
+		line = line.Mid(7);
+		line.Trim(false);
+	}
+
+	const int equals = line.Find(_T('='));
+	if (equals == wxNOT_FOUND) {
+		error = wxString::Format(_("\"%s\" is not NAME=value"), line.c_str());
+		return false;
+	}
+	variable.name = line.Left(equals);
+	variable.name.Trim(true);
+	if (!IsValidName(variable.name)) {
+		error = wxString::Format(_("\"%s\" is not a valid variable name"),
+			variable.name.c_str());
+		return false;
+	}
+	variable.value = line.Mid(equals + 1);
+	variable.value.Trim(false);
+	const size_t length = variable.value.Length();
+	if (length >= 2 && (variable.value[0] == _T('"') || variable.value[0] == _T('\''))
+			&& variable.value[length - 1] == variable.value[0]) {
+		variable.value = variable.value.Mid(1, length - 2);
+	}
+	return true;
+}
+
+/** Windows' variable names are case insensitive, everyone else's aren't. */
+bool IsSameName(const wxString& a, const wxString& b) {
+	return a.IsSameAs(b, !IS_WIN32);
+}
+
+EnvironmentVariables::const_iterator FindVariable(
+		const EnvironmentVariables& variables, const wxString& name) {
+	for (EnvironmentVariables::const_iterator it = variables.begin(), end = variables.end();
+			it != end; ++it) {
+		if (IsSameName(it->name, name)) {
+			return it;
+		}
+	}
+	return variables.end();
+}
+
+wxString Expand(const wxString& value) {
+	return wxExpandEnvVars(value);
+}
+}
+
+bool LaunchEnvironment::Parse(const wxString& text, EnvironmentVariables& variables,
+		wxArrayString& errors) {
+	variables.clear();
+	errors.Clear();
+	wxStringTokenizer lines(text, _T("\n"), wxTOKEN_RET_EMPTY_ALL);
+	int lineNumber = 0;
+	while (lines.HasMoreTokens()) {
+		const wxString line(lines.GetNextToken());
+		++lineNumber;
+		EnvironmentVariable variable;
+		wxString error;
+		if (!ParseLine(line, variable, error)) {
+			if (!error.IsEmpty()) {
+				errors.Add(wxString::Format(_("Line %d: %s"), lineNumber, error.c_str()));
+			}
+			continue;
+		}
+
+		bool isSet = false;
+		for (EnvironmentVariables::iterator it = variables.begin(), end = variables.end();
+				it != end; ++it) {
+			if (IsSameName(it->name, variable.name)) {
+				it->value = variable.value;
+				isSet = true;
+				break;
+			}
+		}
+		if (!isSet) {
+			variables.push_back(variable);
+		}
+	}
+	return errors.IsEmpty();
+}
+
+EnvironmentVariables LaunchEnvironment::ReadFromProfile() {
+	wxString text;
+	ProMan::GetProfileManager()->ProfileRead(PKEY_LAUNCH_ENVIRONMENT, &text);
+
+	EnvironmentVariables variables;
+	wxArrayString errors;
+	if (!Parse(text, variables, errors)) {
+		for (size_t i = 0; i < errors.GetCount(); ++i) {
+			wxLogWarning(_T("Skipping launch environment %s"), errors[i].c_str());
+		}
+	}
+	return variables;
+}
+
+size_t LaunchEnvironment::GetTemplateCount() {
+	return ENVIRONMENT_TEMPLATE_COUNT;
+}
+
+wxString LaunchEnvironment::GetTemplateName(size_t i) {
+	wxCHECK_MSG(i < ENVIRONMENT_TEMPLATE_COUNT, wxEmptyString,
+		wxString::Format(_T("template %lu does not exist"), static_cast<unsigned long>(i)));
+	return wxGetTranslation(ENVIRONMENT_TEMPLATES[i].name);
+}
+
+wxString LaunchEnvironment::AddTemplate(const wxString& text, size_t i) {
+	wxCHECK_MSG(i < ENVIRONMENT_TEMPLATE_COUNT, text,
+		wxString::Format(_T("template %lu does not exist"), static_cast<unsigned long>(i)));
+	EnvironmentVariables added;
+	wxArrayString errors;
+	Parse(ENVIRONMENT_TEMPLATES[i].variables, added, errors);
+	wxASSERT_MSG(errors.IsEmpty(), _T("a built-in environment template does not parse"));
+
+	// keep everything but the lines that the template replaces, and its
+	// heading if it was added before
+	const wxString heading(_T("# ") + GetTemplateName(i));
+	wxString combined;
+	wxStringTokenizer lines(text, _T("\n"), wxTOKEN_RET_EMPTY_ALL);
+	while (lines.HasMoreTokens()) {
+		const wxString line(lines.GetNextToken());
+		EnvironmentVariable variable;
+		wxString error;
+		if (ParseLine(line, variable, error)
+				&& FindVariable(added, variable.name) != added.end()) {
+			continue;
+		}
+		if (wxString(line).Trim(true) == heading) {
+			continue;
+		}
+		combined += line + _T("\n");
+	}
+	combined.Trim(true);
+	if (!combined.IsEmpty()) {
+		combined += _T("\n");
+	}
+
+	combined += heading + _T("\n");
+	for (EnvironmentVariables::const_iterator it = added.begin(), end = added.end();
+			it != end; ++it) {
+		combined += it->name + _T("=") + it->value + _T("\n");
+	}
+	return combined;
+}
+
+wxString LaunchEnvironment::Compare(const wxString& textA, const wxString& nameA,
+		const wxString& textB, const wxString& nameB) {
+	EnvironmentVariables a, b;
+	wxArrayString errors;
+	Parse(textA, a, errors);
+	Parse(textB, b, errors);
+
+	wxArrayString names;
+	for (EnvironmentVariables::const_iterator it = a.begin(), end = a.end(); it != end; ++it) {
+		names.Add(it->name);
+	}
+	for (EnvironmentVariables::const_iterator it = b.begin(), end = b.end(); it != end; ++it) {
+		if (FindVariable(a, it->name) == a.end()) {
+			names.Add(it->name);
+		}
+	}
+	names.Sort();
+
+	wxString differences;
+	for (size_t i = 0; i < names.GetCount(); ++i) {
+		EnvironmentVariables::const_iterator inA = FindVariable(a, names[i]);
+		EnvironmentVariables::const_iterator inB = FindVariable(b, names[i]);
+		if (inB == b.end()) {
+			differences += wxString::Format(_("%s=%s is set only in %s\n"),
+				inA->name.c_str(), inA->value.c_str(), nameA.c_str());
+		} else if (inA == a.end()) {
+			differences += wxString::Format(_("%s=%s is set only in %s\n"),
+				inB->name.c_str(), inB->value.c_str(), nameB.c_str());
+		} else if (inA->value != inB->value) {
+			differences += wxString::Format(_("%s is %s in %s and %s in %s\n"),
+				inA->name.c_str(), inA->value.c_str(), nameA.c_str(),
+				inB->value.c_str(), nameB.c_str());
+		}
+	}
+
+	if (differences.IsEmpty()) {
+		return names.IsEmpty() ?
+			wxString::Format(_("Neither %s nor %s sets any environment variables."),
+				nameA.c_str(), nameB.c_str()) :
+			wxString::Format(_("%s and %s set the same environment variables."),
+				nameA.c_str(), nameB.c_str());
+	}
+	return differences;
+}
+
+#if wxCHECK_VERSION(2, 9, 2)
+void LaunchEnvironment::Apply(const EnvironmentVariables& variables, wxExecuteEnv& env) {
+	if (variables.empty()) {
+		return;
+	}
+	// wxExecute() replaces the whole environment when given one
+	if (env.env.empty() && !wxGetEnvMap(&env.env)) {
+		wxLogWarning(_T("Unable to read the launcher's environment; the game will only get the profile's environment variables"));
+	}
+	for (EnvironmentVariables::const_iterator it = variables.begin(), end = variables.end();
+			it != end; ++it) {
+		env.env[it->name] = Expand(it->value);
+	}
+}
+#else
+LaunchEnvironment::Override::Override(const EnvironmentVariables& variables) {
+	for (EnvironmentVariables::const_iterator it = variables.begin(), end = variables.end();
+			it != end; ++it) {
+		EnvironmentVariable saved;
+		saved.name = it->name;
+		if (wxGetEnv(it->name, &saved.value)) {
+			this->previous.push_back(saved);
+		} else {
+			this->absent.Add(it->name);
+		}
+		if (!wxSetEnv(it->name, Expand(it->value))) {
+			wxLogWarning(_T("Unable to set environment variable %s"), it->name.c_str());
+		}
+	}
+}
+
+LaunchEnvironment::Override::~Override() {
+	for (EnvironmentVariables::const_iterator it = this->previous.begin(),
+			end = this->previous.end(); it != end; ++it) {
+		wxSetEnv(it->name, it->value);
+	}
+	for (size_t i = 0; i < this->absent.GetCount(); ++i) {
+		wxUnsetEnv(this->absent[i]);
+	}
+}
+#endif
+
+void LaunchEnvironment::Log(const EnvironmentVariables& variables, const wxString& name) {
+	if (variables.empty()) {
+		return;
+	}
+	wxLogInfo(_T("Starting %s with %lu environment variables from the profile:"),
+		name.c_str(), static_cast<unsigned long>(variables.size()));
+	for (EnvironmentVariables::const_iterator it = variables.begin(), end = variables.end();
+			it != end; ++it) {
+		wxLogInfo(_T(" %s=%s"), it->name.c_str(), Expand(it->value).c_str());
+	}
+}
@@ -0,0 +1,87 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#ifndef LAUNCHENVIRONMENT_H
+#define LAUNCHENVIRONMENT_H
+
+#include <vector>
+
+#include <wx/wx.h>
+#include <wx/utils.h>
+
+struct EnvironmentVariable {
+	wxString name;
+	wxString value; //!< as written, before $VARIABLE references are expanded
+};
+typedef std::vector<EnvironmentVariable> EnvironmentVariables;
+
+/** LaunchEnvironment - environment variables that a profile sets for the
+ game, such as the GL driver's threading, vsync and shader cache knobs.
+ They are kept in the profile as text, a NAME=value per line; blank lines and
+ lines starting with # are ignored, and a leading "export " is allowed, so
+ that shell snippets can be pasted in. References to the launcher's own
+ variables in values, such as $HOME, are expanded at launch. The variables
+ are set on top of the environment the launcher was started with. */
+class LaunchEnvironment {
+public:
+	/** Parses text into variables, in the order they first appear; a
+	 variable set twice keeps its last value. Lines that can't be parsed are
+	 described in errors. Returns true if there were none. */
+	static bool Parse(const wxString& text, EnvironmentVariables& variables,
+		wxArrayString& errors);
+	/** The current profile's variables. Lines that can't be parsed are
+	 logged and skipped. */
+	static EnvironmentVariables ReadFromProfile();
+
+	/** The built-in templates, which are starting points for common
+	 tuning. */
+	static size_t GetTemplateCount();
+	static wxString GetTemplateName(size_t i);
+	/** Returns text with template i's variables added, replacing the lines
+	 that set the same variables. */
+	static wxString AddTemplate(const wxString& text, size_t i);
+
+	/** Describes how the variables of textA and textB, from the profiles
+	 nameA and nameB, differ. */
+	static wxString Compare(const wxString& textA, const wxString& nameA,
+		const wxString& textB, const wxString& nameB);
+
+#if wxCHECK_VERSION(2, 9, 2)
+	/** Fills env with the launcher's environment and variables on top. Does
+	 nothing if there are no variables, so that the game simply inherits
+	 the launcher's environment. */
+	static void Apply(const EnvironmentVariables& variables, wxExecuteEnv& env);
+#else
+	/** wxExecute() can't be given an environment before wxWidgets 2.9.2, so
+	 the variables are set in the launcher's own environment for as long as
+	 an Override lives, for the game to inherit. */
+	class Override {
+	public:
+		explicit Override(const EnvironmentVariables& variables);
+		~Override();
+	private:
+		EnvironmentVariables previous;
+		wxArrayString absent; //!< variables that weren't set before
+	};
+#endif
+	/** Logs the variables that process name is launched with. */
+	static void Log(const EnvironmentVariables& variables, const wxString& name);
+};
+
+#endif
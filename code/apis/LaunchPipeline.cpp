@@ -0,0 +1,230 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+ 
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <wx/wx.h>
+#include <wx/stopwatch.h>
+
+#include "apis/LaunchPipeline.h"
+#include "apis/FlagListManager.h"
+#include "apis/TCManager.h"
+#include "controls/ModList.h"
+#include "datastructures/ResolutionMap.h"
+#include "global/Compatibility.h"
+#include "global/StartupProfiler.h"
+
+#include "global/MemoryDebugging.h"
+
+/** \class LaunchPipeline
+Pushing a profile reads, rewrites and renames several files, which used to
+happen between the click on Play and the call to wxExecute(). LaunchPipeline
+watches the current profile's generation counter and pushes the profile once
+it has stopped changing for a timer tick, so by the time the user clicks Play
+the artifacts are usually already on disk.
+
+The work is done from a timer on the main thread rather than a worker thread,
+since the profile's wxFileConfig and the logger are not thread safe. */
+
+/** Interval between checks of the current profile, in milliseconds. */
+const int LAUNCH_PIPELINE_INTERVAL = 250;
+
+LaunchPipeline* LaunchPipeline::pipeline = NULL;
+
+void LaunchPipeline::Initialize() {
+	wxASSERT(!IsInitialized());
+	pipeline = new LaunchPipeline();
+}
+
+void LaunchPipeline::DeInitialize() {
+	wxASSERT(IsInitialized());
+	LaunchPipeline* temp = pipeline;
+	pipeline = NULL;
+	delete temp;
+}
+
+bool LaunchPipeline::IsInitialized() {
+	return pipeline != NULL;
+}
+
+LaunchPipeline* LaunchPipeline::Get() {
+	wxCHECK_MSG(IsInitialized(), NULL,
+		_T("LaunchPipeline::Get() called when pipeline wasn't initialized."));
+	return pipeline;
+}
+
+LaunchPipeline::LaunchPipeline()
+: prepareTimer(this),
+  preparedGeneration(0),
+  observedGeneration(0),
+  isPrepared(false),
+  hasAttempted(false),
+  runningGames(0) {
+	FlagListManager::RegisterFlagFileProcessingStatusChanged(this);
+	TCManager::RegisterTCActiveModChanged(this);
+	this->prepareTimer.Start(LAUNCH_PIPELINE_INTERVAL);
+}
+
+LaunchPipeline::~LaunchPipeline() {
+	this->prepareTimer.Stop();
+	ResolutionMan::ModeCatalog::CancelEnumerationEvent(this);
+	ResolutionMan::ModeCatalog::FinishEnumeration();
+	TCManager::UnRegisterTCActiveModChanged(this);
+	FlagListManager::UnRegisterFlagFileProcessingStatusChanged(this);
+}
+
+BEGIN_EVENT_TABLE(LaunchPipeline, wxEvtHandler)
+EVT_TIMER(wxID_ANY, LaunchPipeline::OnPrepareTimer)
+EVT_COMMAND(wxID_NONE, EVT_FLAG_FILE_PROCESSING_STATUS_CHANGED,
+	LaunchPipeline::OnFlagFileProcessingStatusChanged)
+EVT_COMMAND(wxID_NONE, EVT_TC_ACTIVE_MOD_CHANGED, LaunchPipeline::OnActiveModChanged)
+EVT_COMMAND(wxID_NONE, EVT_RESOLUTION_MODES_ENUMERATED, LaunchPipeline::OnModesEnumerated)
+END_EVENT_TABLE()
+
+bool LaunchPipeline::IsPrepared() const {
+	return this->isPrepared
+		&& ProMan::IsInitialized()
+		&& (ProMan::GetProfileManager()->GetCurrentProfileGeneration()
+			== this->preparedGeneration);
+}
+
+void LaunchPipeline::Invalidate() {
+	if (this->hasAttempted) {
+		wxLogDebug(_T("LaunchPipeline: discarding prepared launch artifacts"));
+	}
+	this->isPrepared = false;
+	this->hasAttempted = false;
+}
+
+void LaunchPipeline::GameStarted() {
+	if (this->runningGames++ == 0) {
+		this->prepareTimer.Stop();
+	}
+}
+
+void LaunchPipeline::GameExited() {
+	wxCHECK_RET(this->runningGames > 0,
+		_T("LaunchPipeline::GameExited() called without a game running"));
+	// stale, but the timer only pushes once the profile moves past
+	// preparedGeneration, and EnsurePrepared() pushes on the next start
+	this->isPrepared = false;
+	this->hasAttempted = true;
+	if (--this->runningGames == 0) {
+		this->prepareTimer.Start(LAUNCH_PIPELINE_INTERVAL);
+	}
+}
+
+ProMan::RegistryCodes LaunchPipeline::EnsurePrepared() {
+	if (this->IsPrepared()) {
+		return ProMan::NoError;
+	}
+	return this->Prepare();
+}
+
+/** The flag file tells us whether the binary is an SDL build, which decides
+ where the artifacts go, so anything pushed for the old binary is stale. */
+void LaunchPipeline::OnFlagFileProcessingStatusChanged(wxCommandEvent& event) {
+	this->Invalidate();
+
+	const FlagListManager::FlagFileProcessingStatus status =
+		static_cast<FlagListManager::FlagFileProcessingStatus>(event.GetInt());
+	if (status == FlagListManager::FLAG_FILE_PROCESSING_OK) {
+		this->ChooseResolution();
+	}
+	if (status == FlagListManager::FLAG_FILE_PROCESSING_OK
+		|| status == FlagListManager::FLAG_FILE_PROCESSING_ERROR) {
+		// the first flag file result is the last step of startup
+		StartupProfiler::Finish();
+	}
+}
+
+void LaunchPipeline::OnActiveModChanged(wxCommandEvent& WXUNUSED(event)) {
+	this->ChooseResolution();
+}
+
+void LaunchPipeline::OnModesEnumerated(wxCommandEvent& WXUNUSED(event)) {
+	this->ChooseResolution();
+}
+
+/** The Play button stays disabled until the active mod has a resolution.
+ The Basic Settings page picks one when it lists the resolutions, but it is
+ only built when the user first looks at it. */
+void LaunchPipeline::ChooseResolution() {
+	if (ModList::GetActiveMod() == NULL
+		|| !FlagListManager::GetFlagListManager()->IsProcessingOK()
+		|| ResolutionMap::HasEntryForActiveMod()) {
+		return;
+	}
+	if (ResolutionMap::StartEnumeratingModes(this)) {
+		return; // back in OnModesEnumerated()
+	}
+	ResolutionMan::ResolutionArray resolutions;
+	ResolutionMap::GetModesForActiveMod(resolutions);
+	ResolutionMap::ChooseForActiveMod(resolutions);
+	WX_CLEAR_ARRAY(resolutions);
+}
+
+void LaunchPipeline::OnPrepareTimer(wxTimerEvent& WXUNUSED(event)) {
+	if (!ProMan::IsInitialized() || !FlagListManager::IsInitialized()
+		|| !FlagListManager::GetFlagListManager()->IsProcessingOK()) {
+		return;
+	}
+
+	const unsigned long generation =
+		ProMan::GetProfileManager()->GetCurrentProfileGeneration();
+
+	if (this->hasAttempted && generation == this->preparedGeneration) {
+		return; // either up to date or already failed for this generation
+	}
+
+	// wait for the profile to stay unchanged for a tick so that a burst of
+	// writes (such as selecting a flag set) results in only one push
+	if (generation != this->observedGeneration) {
+		this->observedGeneration = generation;
+		return;
+	}
+
+	this->Prepare();
+}
+
+ProMan::RegistryCodes LaunchPipeline::Prepare() {
+	wxCHECK_MSG(ProMan::IsInitialized(), ProMan::UnknownError,
+		_T("LaunchPipeline::Prepare() called without a profile manager"));
+
+	ProMan* p = ProMan::GetProfileManager();
+	wxStopWatch timer;
+
+	this->isPrepared = false;
+	this->hasAttempted = true;
+	this->preparedGeneration = p->GetCurrentProfileGeneration();
+
+	if (!Compatibility::MigrateOldConfig()) {
+		wxLogError(_T("Failed to migrate old config!!"));
+		return ProMan::UnknownError;
+	}
+
+	const ProMan::RegistryCodes code = p->PushCurrentProfile();
+
+	// pushing may write defaults back into the profile
+	this->preparedGeneration = p->GetCurrentProfileGeneration();
+	this->observedGeneration = this->preparedGeneration;
+	this->isPrepared = (code == ProMan::NoError);
+
+	wxLogDebug(_T("LaunchPipeline: pushed profile '%s' in %ld ms (result %d)"),
+		p->GetCurrentName().c_str(), timer.Time(), static_cast<int>(code));
+
+	return code;
+}
@@ -0,0 +1,84 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+ 
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef LAUNCHPIPELINE_H
+#define LAUNCHPIPELINE_H
+
+#include <wx/wx.h>
+#include <wx/timer.h>
+
+#include "apis/ProfileManager.h"
+
+/** LaunchPipeline - keeps the files FSO reads at startup (fs2_open.ini or
+ the registry, and cmdline_fso.cfg) in sync with the current profile while
+ the launcher is idle, so that starting the game only needs to exec it.
+ It also picks the active mod's resolution, which the Play button waits for,
+ when the Basic Settings page hasn't been built to do it. */
+class LaunchPipeline: public wxEvtHandler {
+public:
+	static void Initialize();
+	static void DeInitialize();
+	static bool IsInitialized();
+	static LaunchPipeline* Get();
+
+	virtual ~LaunchPipeline();
+
+	/** Returns true if the pushed launch artifacts match the current profile. */
+	bool IsPrepared() const;
+
+	/** Makes sure the launch artifacts match the current profile, pushing
+	 the profile right away if they don't. Returns ProMan::NoError on success. */
+	ProMan::RegistryCodes EnsurePrepared();
+
+	/** Forgets the pushed artifacts, so that they are pushed again.
+	 Use this when something outside the profile decides where they go,
+	 such as the binary changing. */
+	void Invalidate();
+
+	/** Call when FS2 or FRED starts. Nothing is pushed while a game is
+	 running, since the game reads its config and may rewrite it. */
+	void GameStarted();
+	/** Call when FS2 or FRED exits. The game may have rewritten its config,
+	 so the artifacts are stale, but they are only pushed again once the
+	 profile changes or the game is started, so what the game wrote stays
+	 until then. */
+	void GameExited();
+
+	void OnFlagFileProcessingStatusChanged(wxCommandEvent& event);
+	void OnActiveModChanged(wxCommandEvent& event);
+	void OnModesEnumerated(wxCommandEvent& event);
+	void OnPrepareTimer(wxTimerEvent& event);
+
+private:
+	LaunchPipeline();
+	static LaunchPipeline* pipeline;
+
+	ProMan::RegistryCodes Prepare();
+	void ChooseResolution();
+
+	wxTimer prepareTimer;
+	unsigned long preparedGeneration; //!< profile generation that was last pushed
+	unsigned long observedGeneration; //!< profile generation seen on the last timer tick
+	bool isPrepared; //!< was the push of preparedGeneration successful
+	bool hasAttempted; //!< has preparedGeneration been pushed at all
+	int runningGames; //!< FS2 and FRED processes started and not yet exited
+
+	DECLARE_EVENT_TABLE()
+};
+
+#endif
@@ -0,0 +1,313 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <algorithm>
+
+#include <wx/wx.h>
+#include <wx/dir.h>
+#include <wx/filename.h>
+#include <wx/tokenzr.h>
+
+#include "apis/ModDataWarmer.h"
+#include "apis/ProfileManager.h"
+#include "apis/TCManager.h"
+#include "apis/VPIndex.h"
+#include "generated/configure_launcher.h"
+#include "global/ProfileKeys.h"
+
+#if IS_WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "global/MemoryDebugging.h"
+
+/** \class ModDataWarmer
+Most of the game's load time on a cold start goes to reading the VP files of
+the active mods. The launcher knows which mods those are well before the user
+clicks Play, so a short while after the active mod changes, a worker thread
+walks the mod chain in the order FSO searches it (the mods of the modline,
+then the TC's root folder) and has the OS read each VP into the page cache.
+
+On Linux this is posix_fadvise(POSIX_FADV_WILLNEED) and on OS X
+fcntl(F_RDADVISE), both of which start the reads and return, so the worker
+only paces how fast reads are issued. Windows has no such hint, so there the
+data is read through and thrown away, which leaves it in the cache just the
+same.
+
+The total is limited by GBL_CFG_OPT_WARMUP_BUDGET, so that a huge mod chain
+doesn't push everything else out of memory, and the rate by WARMUP_RATE, so
+that the launcher stays usable on a slow disk. */
+
+LAUNCHER_DEFINE_EVENT_TYPE(EVT_MOD_DATA_WARMED);
+
+/** Milliseconds to wait after the active mod changes before warming its
+ data, so that clicking through the mod list doesn't start a warmup per mod. */
+const int WARMUP_DELAY = 2000;
+/** Megabytes warmed per active mod chain unless the global config says
+ otherwise. */
+const long WARMUP_DEFAULT_BUDGET = 1024;
+/** Bytes asked for at a time. Cancelling takes effect between chunks. */
+const size_t WARMUP_CHUNK = 4 * 1024 * 1024;
+/** Bytes per second that reads are issued at, at most. */
+const wxFileOffset WARMUP_RATE = 48 * 1024 * 1024;
+
+ModDataWarmer* ModDataWarmer::warmer = NULL;
+
+void ModDataWarmer::Initialize() {
+	wxASSERT(!IsInitialized());
+	warmer = new ModDataWarmer();
+}
+
+void ModDataWarmer::DeInitialize() {
+	wxASSERT(IsInitialized());
+	ModDataWarmer* temp = warmer;
+	warmer = NULL;
+	delete temp;
+}
+
+bool ModDataWarmer::IsInitialized() {
+	return warmer != NULL;
+}
+
+ModDataWarmer* ModDataWarmer::Get() {
+	wxCHECK_MSG(IsInitialized(), NULL,
+		_T("ModDataWarmer::Get() called when warmer wasn't initialized."));
+	return warmer;
+}
+
+ModDataWarmer::ModDataWarmer()
+: startTimer(this),
+  isCancelled(false),
+  generation(0),
+  warmedFiles(0),
+  warmedBytes(0) {
+	TCManager::RegisterTCActiveModChanged(this);
+}
+
+ModDataWarmer::~ModDataWarmer() {
+	TCManager::UnRegisterTCActiveModChanged(this);
+	this->Cancel();
+}
+
+BEGIN_EVENT_TABLE(ModDataWarmer, wxEvtHandler)
+EVT_TIMER(wxID_ANY, ModDataWarmer::OnStartTimer)
+EVT_COMMAND(wxID_NONE, EVT_TC_ACTIVE_MOD_CHANGED, ModDataWarmer::OnActiveModChanged)
+EVT_COMMAND(wxID_NONE, EVT_MOD_DATA_WARMED, ModDataWarmer::OnWarmupDone)
+END_EVENT_TABLE()
+
+void ModDataWarmer::Cancel() {
+	this->startTimer.Stop();
+	if (this->thread.joinable()) {
+		this->isCancelled = true;
+		this->thread.join();
+		wxLogDebug(_T("ModDataWarmer: cancelled after %lu files"),
+			static_cast<unsigned long>(this->warmedFiles.load()));
+	}
+}
+
+void ModDataWarmer::OnActiveModChanged(wxCommandEvent& WXUNUSED(event)) {
+	this->Cancel();
+	this->startTimer.Start(WARMUP_DELAY, wxTIMER_ONE_SHOT);
+}
+
+void ModDataWarmer::OnStartTimer(wxTimerEvent& WXUNUSED(event)) {
+#if !IS_LINUX && !IS_APPLE && !IS_WIN32
+	return; // no way to warm the page cache here, see WarmFile()
+#endif
+	if (!ProMan::IsInitialized()) {
+		return;
+	}
+	long budget;
+	ProMan::GetProfileManager()->GlobalRead(GBL_CFG_OPT_WARMUP_BUDGET,
+		&budget, WARMUP_DEFAULT_BUDGET);
+	if (budget <= 0) {
+		return; // turned off
+	}
+
+	std::vector<wxString> files(this->FindModData());
+	if (files.empty()) {
+		return;
+	}
+
+	wxLogDebug(_T("ModDataWarmer: warming up to %ld MB of %lu VP files"),
+		budget, static_cast<unsigned long>(files.size()));
+	this->isCancelled = false;
+	this->warmedFiles = 0;
+	this->warmedBytes = 0;
+	this->started = std::chrono::steady_clock::now();
+	this->thread = std::thread(&ModDataWarmer::Run, this, ++this->generation,
+		files, static_cast<wxFileOffset>(budget) * 1024 * 1024);
+}
+
+void ModDataWarmer::OnWarmupDone(wxCommandEvent& event) {
+	if (event.GetInt() != this->generation || !this->thread.joinable()) {
+		return; // from a warmup that has since been cancelled
+	}
+	this->thread.join();
+
+	const long elapsed = static_cast<long>(
+		std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::steady_clock::now() - this->started).count());
+	wxLogInfo(_T("Warmed up %lu VP files (%.1f MB) of the active mods in %ld ms"),
+		static_cast<unsigned long>(this->warmedFiles.load()),
+		this->warmedBytes.load() / (1024.0 * 1024.0), elapsed);
+}
+
+/** Returns the active mod chain's VP files in the order FSO searches them.
+ The names are deep copies, since they are handed to the worker thread. */
+std::vector<wxString> ModDataWarmer::FindModData() const {
+	std::vector<wxString> files;
+
+	ProMan* p = ProMan::GetProfileManager();
+	wxString tcPath, modline;
+	p->ProfileRead(PKEY_TC_ROOT_FOLDER, &tcPath);
+	p->ProfileRead(PKEY_TC_CURRENT_MODLINE, &modline);
+	if (tcPath.IsEmpty() || !wxDir::Exists(tcPath)) {
+		return files;
+	}
+
+	wxArrayString folders;
+	wxStringTokenizer tokens(modline, _T(","), wxTOKEN_STRTOK);
+	while (tokens.HasMoreTokens()) {
+		const wxString mod(tokens.GetNextToken().Trim(true).Trim(false));
+		if (!mod.IsEmpty() && folders.Index(mod) == wxNOT_FOUND) {
+			folders.Add(mod);
+		}
+	}
+
+	for (size_t i = 0; i <= folders.GetCount(); ++i) {
+		// the TC's root folder is searched last
+		const wxString folder((i < folders.GetCount()) ?
+			tcPath + wxFileName::GetPathSeparator() + folders[i] : tcPath);
+		std::vector<wxString> found;
+		VPIndex::FindVPFiles(folder, found);
+		for (size_t j = 0; j < found.size(); ++j) {
+			files.push_back(wxString(found[j].c_str()));
+		}
+	}
+	return files;
+}
+
+/** Runs on the worker thread. */
+void ModDataWarmer::Run(ModDataWarmer* self, int generation,
+	std::vector<wxString> files, wxFileOffset budget) {
+	std::vector<char> buffer;
+	wxFileOffset warmed = 0;
+	size_t count = 0;
+	for (std::vector<wxString>::const_iterator it = files.begin(), end = files.end();
+			it != end && warmed < budget && !self->isCancelled; ++it) {
+		if (self->WarmFile(*it, budget, warmed, buffer)) {
+			++count;
+		}
+	}
+
+	self->warmedFiles = count;
+	self->warmedBytes = warmed;
+	if (!self->isCancelled) {
+		wxCommandEvent event(EVT_MOD_DATA_WARMED, wxID_NONE);
+		event.SetInt(generation);
+		self->AddPendingEvent(event);
+	}
+}
+
+/** Warms path until the end of the file or until warmed reaches budget.
+ Returns false if the file couldn't be opened. Runs on the worker thread,
+ so failures are not logged. */
+bool ModDataWarmer::WarmFile(const wxString& path, wxFileOffset budget,
+	wxFileOffset& warmed, std::vector<char>& buffer) {
+#if IS_WIN32
+	HANDLE file = ::CreateFileW(path.wc_str(), GENERIC_READ,
+		FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING,
+		FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	LARGE_INTEGER fileSize;
+	if (!::GetFileSizeEx(file, &fileSize)) {
+		::CloseHandle(file);
+		return false;
+	}
+	const wxFileOffset length = fileSize.QuadPart;
+	buffer.resize(WARMUP_CHUNK);
+#else
+	const int fd = open(path.fn_str(), O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+	struct stat info;
+	if (fstat(fd, &info) != 0) {
+		close(fd);
+		return false;
+	}
+	const wxFileOffset length = info.st_size;
+#endif
+
+	wxFileOffset offset = 0;
+	while (offset < length && warmed < budget && !this->isCancelled) {
+		const size_t chunk = static_cast<size_t>(std::min(
+			std::min(static_cast<wxFileOffset>(WARMUP_CHUNK), length - offset),
+			budget - warmed));
+#if IS_LINUX
+		if (posix_fadvise(fd, offset, chunk, POSIX_FADV_WILLNEED) != 0) {
+			break;
+		}
+#elif IS_APPLE
+		struct radvisory advice;
+		advice.ra_offset = offset;
+		advice.ra_count = static_cast<int>(chunk);
+		if (fcntl(fd, F_RDADVISE, &advice) == -1) {
+			break;
+		}
+#elif IS_WIN32
+		DWORD read = 0;
+		if (!::ReadFile(file, &buffer[0], static_cast<DWORD>(chunk), &read, NULL)
+			|| read == 0) {
+			break;
+		}
+		// the file may have shrunk since it was sized
+		const wxFileOffset advanced = read;
+#endif
+#if IS_LINUX || IS_APPLE
+		const wxFileOffset advanced = chunk;
+#endif
+		offset += advanced;
+		warmed += advanced;
+		this->Pace(warmed);
+	}
+
+#if IS_WIN32
+	::CloseHandle(file);
+#else
+	close(fd);
+#endif
+	return true;
+}
+
+/** Sleeps while the warmup is ahead of WARMUP_RATE, in short naps so that
+ Cancel() doesn't have to wait long. */
+void ModDataWarmer::Pace(wxFileOffset warmed) {
+	const std::chrono::steady_clock::time_point due = this->started
+		+ std::chrono::milliseconds(warmed * 1000 / WARMUP_RATE);
+	while (!this->isCancelled && std::chrono::steady_clock::now() < due) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	}
+}
@@ -0,0 +1,78 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef MODDATAWARMER_H
+#define MODDATAWARMER_H
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <wx/wx.h>
+#include <wx/timer.h>
+
+#include "apis/EventHandlers.h"
+
+/** A warmup has finished. The event's int is the warmup's generation. */
+LAUNCHER_DECLARE_EVENT_TYPE(EVT_MOD_DATA_WARMED);
+
+/** ModDataWarmer - asks the OS to read the active mod chain's VP files into
+ the page cache while the user is still in the launcher, so that the game's
+ first reads of them don't have to wait on the disk or the network. */
+class ModDataWarmer: public wxEvtHandler {
+public:
+	static void Initialize();
+	static void DeInitialize();
+	static bool IsInitialized();
+	static ModDataWarmer* Get();
+
+	virtual ~ModDataWarmer();
+
+	/** Stops a warmup in progress and any that is scheduled, such as when
+	 the game is started and its own reads take over. */
+	void Cancel();
+
+	void OnActiveModChanged(wxCommandEvent& event);
+	void OnStartTimer(wxTimerEvent& event);
+	void OnWarmupDone(wxCommandEvent& event);
+
+private:
+	ModDataWarmer();
+	static ModDataWarmer* warmer;
+
+	std::vector<wxString> FindModData() const;
+	static void Run(ModDataWarmer* self, int generation,
+		std::vector<wxString> files, wxFileOffset budget);
+	bool WarmFile(const wxString& path, wxFileOffset budget,
+		wxFileOffset& warmed, std::vector<char>& buffer);
+	void Pace(wxFileOffset warmed);
+
+	wxTimer startTimer;
+	std::thread thread;
+	std::atomic<bool> isCancelled;
+	int generation; //!< counts warmups, so that a late event can be ignored
+	std::chrono::steady_clock::time_point started; //!< of the current warmup
+	// written by the worker thread before it sends EVT_MOD_DATA_WARMED
+	std::atomic<size_t> warmedFiles;
+	std::atomic<wxFileOffset> warmedBytes;
+
+	DECLARE_EVENT_TABLE()
+};
+
+#endif
@@ -0,0 +1,1238 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <wx/wx.h>
+#include <wx/dir.h>
+#include <wx/ffile.h>
+#include <wx/fileconf.h>
+#include <wx/filename.h>
+#include <wx/filefn.h>
+#include <wx/progdlg.h>
+#include <wx/process.h>
+#include <wx/stopwatch.h>
+#include <wx/textfile.h>
+#include <wx/tokenzr.h>
+#include <wx/wfstream.h>
+
+#include <zlib.h>
+
+#include "apis/ModInstaller.h"
+#include "apis/TCManager.h"
+#include "generated/configure_launcher.h"
+#include "global/ModIniKeys.h"
+#include "global/ParallelJobs.h"
+
+#include "global/MemoryDebugging.h"
+
+/** Packages are extracted into a folder in the TC named after the package,
+ with this in front. ModList skips folders whose names start with '.'. */
+const wxString INSTALL_STAGING_PREFIX(_T(".wxlauncher-install-"));
+/** A mod being replaced is moved aside under this name until the new one is
+ in place. */
+const wxString INSTALL_REPLACED_PREFIX(_T(".wxlauncher-replaced-"));
+/** In the staging folder: which package is being extracted, so that the
+ files left by a different package with the same name aren't reused. */
+const wxString INSTALL_MARKER_FILE_NAME(_T("package.txt"));
+const wxString INSTALL_FILES_FOLDER_NAME(_T("files"));
+/** Extracted files are written under this extension and renamed when
+ complete, so that a file of the right name is always a whole file. */
+const wxString INSTALL_PART_EXTENSION(_T(".part"));
+
+const size_t INSTALL_BUFFER_SIZE = 1024 * 1024;
+/** Bytes of compressed data each decompressing thread reads at a time. */
+const size_t INSTALL_INPUT_SIZE = 64 * 1024;
+/** Buffers in the pool per decompressing thread. */
+const size_t INSTALL_BUFFERS_PER_WORKER = 4;
+/** Milliseconds between progress dialog updates. */
+const int INSTALL_PROGRESS_INTERVAL = 100;
+const int INSTALL_PROGRESS_RANGE = 1000;
+/** How many failed files are named to the user; the log has them all. */
+const size_t INSTALL_MAX_LISTED_FAILURES = 5;
+
+const uint32_t ZIP_LOCAL_HEADER_SIGNATURE = 0x04034b50;
+const uint32_t ZIP_CENTRAL_HEADER_SIGNATURE = 0x02014b50;
+const uint32_t ZIP_END_SIGNATURE = 0x06054b50;
+const uint32_t ZIP64_END_SIGNATURE = 0x06064b50;
+const uint32_t ZIP64_LOCATOR_SIGNATURE = 0x07064b50;
+const size_t ZIP_LOCAL_HEADER_SIZE = 30;
+const size_t ZIP_CENTRAL_HEADER_SIZE = 46;
+const size_t ZIP_END_SIZE = 22;
+const size_t ZIP64_END_SIZE = 56;
+const size_t ZIP64_LOCATOR_SIZE = 20;
+const size_t ZIP_MAX_COMMENT_SIZE = 0xFFFF;
+const uint16_t ZIP_METHOD_STORED = 0;
+const uint16_t ZIP_METHOD_DEFLATED = 8;
+const uint16_t ZIP_FLAG_ENCRYPTED = 0x0001;
+const uint16_t ZIP_FLAG_UTF8 = 0x0800;
+const uint16_t ZIP64_EXTRA_ID = 0x0001;
+
+static uint16_t Read16(const unsigned char* data) {
+	return static_cast<uint16_t>(data[0] | (data[1] << 8));
+}
+
+static uint32_t Read32(const unsigned char* data) {
+	return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8)
+		| (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+static uint64_t Read64(const unsigned char* data) {
+	return static_cast<uint64_t>(Read32(data)) | (static_cast<uint64_t>(Read32(data + 4)) << 32);
+}
+
+/** Zip's CRC-32. The table is filled in on the main thread before any
+ worker starts. */
+static uint32_t crcTable[256];
+
+static void InitCRCTable() {
+	static bool isInitialized = false;
+	if (isInitialized) {
+		return;
+	}
+	for (uint32_t i = 0; i < 256; ++i) {
+		uint32_t crc = i;
+		for (int bit = 0; bit < 8; ++bit) {
+			crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : (crc >> 1);
+		}
+		crcTable[i] = crc;
+	}
+	isInitialized = true;
+}
+
+static uint32_t UpdateCRC(uint32_t crc, const char* data, size_t length) {
+	crc = ~crc;
+	for (size_t i = 0; i < length; ++i) {
+		crc = crcTable[(crc ^ static_cast<unsigned char>(data[i])) & 0xFF] ^ (crc >> 8);
+	}
+	return ~crc;
+}
+
+/** One entry of a zip file's central directory. */
+struct ZipEntry {
+	wxString name; //!< '/' separated, as stored
+	uint64_t compressedSize;
+	uint64_t size;
+	uint64_t headerOffset; //!< of the entry's local header
+	uint32_t crc;
+	uint16_t method;
+	uint16_t flags;
+};
+
+static bool ReadAt(wxFFile& file, wxFileOffset offset, void* data, size_t length) {
+	return file.Seek(offset) && file.Read(data, length) == length;
+}
+
+/** Reads the central directory at the end of a zip file, including the
+ Zip64 extensions used by archives over 4 GB or with over 65535 entries. */
+static bool ReadZipDirectory(wxFFile& file, std::vector<ZipEntry>& entries, wxString& error) {
+	const wxFileOffset length = file.Length();
+	if (length < static_cast<wxFileOffset>(ZIP_END_SIZE)) {
+		error = _("The file is not a zip file.");
+		return false;
+	}
+
+	// the end record is followed by a comment of up to 64 KiB
+	const size_t tailSize = static_cast<size_t>(std::min<wxFileOffset>(length,
+		ZIP_END_SIZE + ZIP_MAX_COMMENT_SIZE + ZIP64_LOCATOR_SIZE));
+	const wxFileOffset tailOffset = length - tailSize;
+	std::vector<unsigned char> tail(tailSize);
+	if (!ReadAt(file, tailOffset, &tail[0], tailSize)) {
+		error = _("The file could not be read.");
+		return false;
+	}
+	size_t end = tailSize - ZIP_END_SIZE + 1;
+	do {
+		--end;
+	} while (end > 0 && Read32(&tail[end]) != ZIP_END_SIGNATURE);
+	if (Read32(&tail[end]) != ZIP_END_SIGNATURE) {
+		error = _("The file is not a zip file.");
+		return false;
+	}
+
+	uint64_t entryCount = Read16(&tail[end + 10]);
+	uint64_t directorySize = Read32(&tail[end + 12]);
+	uint64_t directoryOffset = Read32(&tail[end + 16]);
+	if (end >= ZIP64_LOCATOR_SIZE
+		&& Read32(&tail[end - ZIP64_LOCATOR_SIZE]) == ZIP64_LOCATOR_SIGNATURE) {
+		unsigned char zip64End[ZIP64_END_SIZE];
+		const uint64_t zip64EndOffset = Read64(&tail[end - ZIP64_LOCATOR_SIZE + 8]);
+		if (!ReadAt(file, zip64EndOffset, zip64End, sizeof(zip64End))
+			|| Read32(zip64End) != ZIP64_END_SIGNATURE) {
+			error = _("The zip file is damaged.");
+			return false;
+		}
+		entryCount = Read64(zip64End + 32);
+		directorySize = Read64(zip64End + 40);
+		directoryOffset = Read64(zip64End + 48);
+	}
+	if (directoryOffset + directorySize > static_cast<uint64_t>(length)) {
+		error = _("The zip file is damaged or incomplete.");
+		return false;
+	}
+
+	std::vector<unsigned char> directory(static_cast<size_t>(directorySize) + 1);
+	if (directorySize > 0 && !ReadAt(file, directoryOffset, &directory[0],
+			static_cast<size_t>(directorySize))) {
+		error = _("The file could not be read.");
+		return false;
+	}
+
+	size_t position = 0;
+	for (uint64_t i = 0; i < entryCount; ++i) {
+		if (position + ZIP_CENTRAL_HEADER_SIZE > directorySize
+			|| Read32(&directory[position]) != ZIP_CENTRAL_HEADER_SIGNATURE) {
+			error = _("The zip file is damaged.");
+			return false;
+		}
+		const unsigned char* header = &directory[position];
+		const size_t nameLength = Read16(header + 28);
+		const size_t extraLength = Read16(header + 30);
+		const size_t commentLength = Read16(header + 32);
+		if (position + ZIP_CENTRAL_HEADER_SIZE + nameLength + extraLength + commentLength
+				> directorySize) {
+			error = _("The zip file is damaged.");
+			return false;
+		}
+
+		ZipEntry entry;
+		entry.flags = Read16(header + 8);
+		entry.method = Read16(header + 10);
+		entry.crc = Read32(header + 16);
+		entry.compressedSize = Read32(header + 20);
+		entry.size = Read32(header + 24);
+		entry.headerOffset = Read32(header + 42);
+
+		const std::string name(reinterpret_cast<const char*>(header + ZIP_CENTRAL_HEADER_SIZE),
+			nameLength);
+		entry.name = wxString(name.c_str(), wxConvUTF8);
+		if (entry.name.IsEmpty() && (entry.flags & ZIP_FLAG_UTF8) == 0) {
+			entry.name = wxString(name.c_str(), wxConvISO8859_1);
+		}
+
+		// sizes and offsets that don't fit are in the Zip64 extra field
+		const unsigned char* extra = header + ZIP_CENTRAL_HEADER_SIZE + nameLength;
+		for (size_t field = 0; field + 4 <= extraLength;) {
+			const uint16_t id = Read16(extra + field);
+			const size_t fieldLength = Read16(extra + field + 2);
+			if (field + 4 + fieldLength > extraLength) {
+				break;
+			}
+			if (id == ZIP64_EXTRA_ID) {
+				const unsigned char* value = extra + field + 4;
+				const unsigned char* valueEnd = value + fieldLength;
+				if (entry.size == 0xFFFFFFFF && value + 8 <= valueEnd) {
+					entry.size = Read64(value);
+					value += 8;
+				}
+				if (entry.compressedSize == 0xFFFFFFFF && value + 8 <= valueEnd) {
+					entry.compressedSize = Read64(value);
+					value += 8;
+				}
+				if (entry.headerOffset == 0xFFFFFFFF && value + 8 <= valueEnd) {
+					entry.headerOffset = Read64(value);
+				}
+			}
+			field += 4 + fieldLength;
+		}
+
+		entries.push_back(entry);
+		position += ZIP_CENTRAL_HEADER_SIZE + nameLength + extraLength + commentLength;
+	}
+	return true;
+}
+
+/** Entry names come from the package, so they mustn't be able to put files
+ outside the folder they are extracted into. */
+static bool IsSafeEntryName(const wxString& name) {
+	if (name.IsEmpty() || name.StartsWith(_T("/")) || name.Find(_T(':')) != wxNOT_FOUND) {
+		return false;
+	}
+	wxStringTokenizer components(name, _T("/"), wxTOKEN_STRTOK);
+	while (components.HasMoreTokens()) {
+		if (components.GetNextToken() == _T("..")) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/** Turns a package entry name into a path under folder. */
+static wxString EntryPath(const wxString& folder, wxString name) {
+	name.Replace(_T("\\"), _T("/"));
+	name.Replace(_T("/"), wxString(wxFileName::GetPathSeparator()));
+	return folder + wxFileName::GetPathSeparator() + name;
+}
+
+static FILE* OpenForReading(const wxString& path) {
+#if IS_WIN32
+	return _wfopen(path.wc_str(), L"rb");
+#else
+	return fopen(path.fn_str(), "rb");
+#endif
+}
+
+static bool SeekTo(FILE* file, uint64_t offset) {
+#if IS_WIN32
+	return _fseeki64(file, static_cast<__int64>(offset), SEEK_SET) == 0;
+#else
+	return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+}
+
+static FILE* OpenForWriting(const wxString& path) {
+#if IS_WIN32
+	return _wfopen(path.wc_str(), L"wb");
+#else
+	return fopen(path.fn_str(), "wb");
+#endif
+}
+
+static bool RenameFile(const wxString& from, const wxString& to) {
+#if IS_WIN32
+	_wremove(to.wc_str());
+	return _wrename(from.wc_str(), to.wc_str()) == 0;
+#else
+	return rename(from.fn_str(), to.fn_str()) == 0;
+#endif
+}
+
+static void RemoveFile(const wxString& path) {
+#if IS_WIN32
+	_wremove(path.wc_str());
+#else
+	remove(path.fn_str());
+#endif
+}
+
+enum ExtractProblem {
+	EXTRACT_OK,
+	EXTRACT_CANCELLED,
+	EXTRACT_READ_FAILED,
+	EXTRACT_DAMAGED,	//!< the data doesn't match the entry's size or checksum
+	EXTRACT_WRITE_FAILED
+};
+
+/** A file to be extracted. The worker that claims it reads it; only the
+ writer changes it. */
+struct ExtractJob {
+	wxString name;
+	wxString path;
+	wxString partPath;
+	uint64_t headerOffset;
+	uint64_t compressedSize;
+	uint64_t size;
+	uint32_t crc;
+	uint16_t method;
+	ExtractProblem problem;
+	bool isWritten;
+};
+
+const size_t NO_BUFFER = static_cast<size_t>(-1);
+
+/** Some of a file's data, or with isLast, the news that the file is done. */
+struct ExtractChunk {
+	ExtractChunk(): job(0), buffer(NO_BUFFER), length(0), isLast(false), problem(EXTRACT_OK) { }
+	ExtractChunk(size_t job, size_t buffer, size_t length, bool isLast, ExtractProblem problem)
+	: job(job), buffer(buffer), length(length), isLast(isLast), problem(problem) { }
+
+	size_t job;
+	size_t buffer; //!< NO_BUFFER if the chunk carries no data
+	size_t length;
+	bool isLast;
+	ExtractProblem problem; //!< for the last chunk
+};
+
+/** A fixed set of buffers that the decompressing workers fill and the
+ writer empties, so that however far the workers get ahead of the disk, no
+ more than the pool's buffers of output are held in memory. */
+class ExtractBufferPool {
+public:
+	ExtractBufferPool(size_t count, size_t producers)
+	: buffers(count), producers(producers), isCancelled(false) {
+		for (size_t i = 0; i < count; ++i) {
+			this->buffers[i].resize(INSTALL_BUFFER_SIZE);
+			this->freeBuffers.push_back(i);
+		}
+	}
+
+	/** Waits for a free buffer. Returns NO_BUFFER once cancelled. */
+	size_t Acquire() {
+		std::unique_lock<std::mutex> lock(this->mutex);
+		while (this->freeBuffers.empty() && !this->isCancelled) {
+			this->bufferFreed.wait(lock);
+		}
+		if (this->isCancelled) {
+			return NO_BUFFER;
+		}
+		const size_t buffer = this->freeBuffers.back();
+		this->freeBuffers.pop_back();
+		return buffer;
+	}
+	char* GetBuffer(size_t buffer) {
+		return &this->buffers[buffer][0];
+	}
+	void Release(size_t buffer) {
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->freeBuffers.push_back(buffer);
+		this->bufferFreed.notify_one();
+	}
+
+	void Push(const ExtractChunk& chunk) {
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->chunks.push_back(chunk);
+		this->chunkPushed.notify_one();
+	}
+	/** Waits for the next chunk. Returns false once every producer is done
+	 and there are no chunks left. */
+	bool Pop(ExtractChunk& chunk) {
+		std::unique_lock<std::mutex> lock(this->mutex);
+		while (this->chunks.empty() && this->producers > 0) {
+			this->chunkPushed.wait(lock);
+		}
+		if (this->chunks.empty()) {
+			return false;
+		}
+		chunk = this->chunks.front();
+		this->chunks.pop_front();
+		return true;
+	}
+	void ProducerDone() {
+		std::lock_guard<std::mutex> lock(this->mutex);
+		--this->producers;
+		this->chunkPushed.notify_all();
+	}
+
+	void Cancel() {
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->isCancelled = true;
+		this->bufferFreed.notify_all();
+	}
+	bool IsCancelled() {
+		std::lock_guard<std::mutex> lock(this->mutex);
+		return this->isCancelled;
+	}
+
+private:
+	std::mutex mutex;
+	std::condition_variable bufferFreed;
+	std::condition_variable chunkPushed;
+	std::vector<std::vector<char> > buffers;
+	std::vector<size_t> freeBuffers;
+	std::deque<ExtractChunk> chunks;
+	size_t producers;
+	bool isCancelled;
+};
+
+struct ExtractShared {
+	std::vector<ExtractJob>* jobs;
+	ParallelJobs* parallel;
+	ExtractBufferPool* pool;
+	std::vector<FILE*> archives; //!< one per worker thread
+	WorkProgress progress; //!< counted by the writer
+	std::atomic<bool> isWriterDone;
+};
+
+/** The workers and the writer together. Done once the writer is, which
+ is after the last worker. */
+class ExtractTask: public BackgroundTask {
+public:
+	explicit ExtractTask(ExtractShared& shared): shared(shared) { }
+	virtual bool IsDone() const { return this->shared.isWriterDone; }
+	virtual void Cancel() {
+		this->shared.parallel->Cancel();
+		this->shared.pool->Cancel();
+	}
+private:
+	ExtractShared& shared;
+};
+
+/** Reads an entry's data from a worker's handle on the archive, inflating
+ it if it's deflated. This uses stdio and zlib rather than wx's file and
+ zlib streams, as those log their errors and a worker mustn't log. */
+class EntryReader {
+public:
+	EntryReader(FILE* archive, uint64_t compressedSize, bool isDeflated,
+		std::vector<unsigned char>& input)
+	: archive(archive), inputLeft(compressedSize), isDeflated(isDeflated),
+	  isInflating(false), input(input) {
+		memset(&this->stream, 0, sizeof(this->stream));
+	}
+	~EntryReader() {
+		if (this->isInflating) {
+			inflateEnd(&this->stream);
+		}
+	}
+
+	/** Fills data with the next length bytes of the entry. */
+	ExtractProblem Read(char* data, size_t length) {
+		if (!this->isDeflated) {
+			return this->ReadInput(reinterpret_cast<unsigned char*>(data), length);
+		}
+		if (!this->isInflating) {
+			if (inflateInit2(&this->stream, -MAX_WBITS) != Z_OK) {
+				return EXTRACT_DAMAGED;
+			}
+			this->isInflating = true;
+		}
+		this->stream.next_out = reinterpret_cast<Bytef*>(data);
+		this->stream.avail_out = static_cast<uInt>(length);
+		while (this->stream.avail_out > 0) {
+			if (this->stream.avail_in == 0) {
+				const size_t wanted = static_cast<size_t>(
+					std::min<uint64_t>(this->inputLeft, this->input.size()));
+				if (wanted == 0) {
+					return EXTRACT_DAMAGED; // the compressed data ended early
+				}
+				const ExtractProblem problem = this->ReadInput(&this->input[0], wanted);
+				if (problem != EXTRACT_OK) {
+					return problem;
+				}
+				this->stream.next_in = &this->input[0];
+				this->stream.avail_in = static_cast<uInt>(wanted);
+			}
+			const int status = inflate(&this->stream, Z_NO_FLUSH);
+			if (status == Z_STREAM_END) {
+				return (this->stream.avail_out == 0) ? EXTRACT_OK : EXTRACT_DAMAGED;
+			}
+			if (status != Z_OK && status != Z_BUF_ERROR) {
+				return EXTRACT_DAMAGED;
+			}
+		}
+		return EXTRACT_OK;
+	}
+
+private:
+	/** Reads length bytes of the entry as stored in the archive. */
+	ExtractProblem ReadInput(unsigned char* data, size_t length) {
+		if (length > this->inputLeft) {
+			return EXTRACT_DAMAGED;
+		}
+		if (fread(data, 1, length, this->archive) != length) {
+			return ferror(this->archive) ? EXTRACT_READ_FAILED : EXTRACT_DAMAGED;
+		}
+		this->inputLeft -= length;
+		return EXTRACT_OK;
+	}
+
+	FILE* archive;
+	uint64_t inputLeft; //!< bytes of the entry not yet read from the archive
+	bool isDeflated;
+	bool isInflating;
+	z_stream stream;
+	std::vector<unsigned char>& input;
+};
+
+/** Runs on a worker thread, so nothing here may log. Each worker has a
+ handle on the archive of its own, so they don't have to take turns. */
+static ExtractProblem ExtractEntry(size_t index, ExtractShared& shared,
+	FILE* archive, std::vector<unsigned char>& input) {
+	const ExtractJob& job = (*shared.jobs)[index];
+
+	unsigned char header[ZIP_LOCAL_HEADER_SIZE];
+	if (!SeekTo(archive, job.headerOffset)
+		|| fread(header, 1, sizeof(header), archive) != sizeof(header)
+		|| Read32(header) != ZIP_LOCAL_HEADER_SIGNATURE) {
+		return EXTRACT_READ_FAILED;
+	}
+	const uint64_t dataOffset = job.headerOffset
+		+ ZIP_LOCAL_HEADER_SIZE + Read16(header + 26) + Read16(header + 28);
+	if (!SeekTo(archive, dataOffset)) {
+		return EXTRACT_READ_FAILED;
+	}
+
+	EntryReader reader(archive, job.compressedSize,
+		job.method == ZIP_METHOD_DEFLATED, input);
+	uint64_t remaining = job.size;
+	uint32_t crc = 0;
+	while (remaining > 0) {
+		const size_t buffer = shared.pool->Acquire();
+		if (buffer == NO_BUFFER) {
+			return EXTRACT_CANCELLED;
+		}
+		char* data = shared.pool->GetBuffer(buffer);
+		const size_t length = static_cast<size_t>(
+			std::min<uint64_t>(remaining, INSTALL_BUFFER_SIZE));
+		const ExtractProblem problem = reader.Read(data, length);
+		if (problem != EXTRACT_OK) {
+			shared.pool->Release(buffer);
+			return problem;
+		}
+		crc = UpdateCRC(crc, data, length);
+		shared.pool->Push(ExtractChunk(index, buffer, length, false, EXTRACT_OK));
+		remaining -= length;
+	}
+	return (crc == job.crc) ? EXTRACT_OK : EXTRACT_DAMAGED;
+}
+
+static void RunExtractWorker(ExtractShared* shared, size_t thread) {
+	std::vector<unsigned char> input(INSTALL_INPUT_SIZE);
+	size_t i;
+	while (shared->parallel->Claim(i)) {
+		const ExtractProblem problem = ExtractEntry(i, *shared, shared->archives[thread], input);
+		if (problem == EXTRACT_CANCELLED) {
+			break;
+		}
+		shared->pool->Push(ExtractChunk(i, NO_BUFFER, 0, true, problem));
+	}
+	shared->pool->ProducerDone();
+}
+
+/** Writes the chunks in the order they arrive, keeping a file open for
+ each entry in progress. A file is renamed to its real name only once all
+ of it is written and its checksum matched. */
+static void RunExtractWriter(ExtractShared* shared) {
+	std::map<size_t, FILE*> files;
+	ExtractChunk chunk;
+	while (shared->pool->Pop(chunk)) {
+		ExtractJob& job = (*shared->jobs)[chunk.job];
+		FILE*& file = files[chunk.job];
+
+		if (chunk.buffer != NO_BUFFER) {
+			if (job.problem == EXTRACT_OK && !shared->pool->IsCancelled()) {
+				if (file == NULL) {
+					file = OpenForWriting(job.partPath);
+				}
+				if (file == NULL
+					|| fwrite(shared->pool->GetBuffer(chunk.buffer), 1, chunk.length, file)
+						!= chunk.length) {
+					// most likely the disk is full, so the rest would fail too
+					job.problem = EXTRACT_WRITE_FAILED;
+					shared->pool->Cancel();
+				}
+			}
+			shared->progress.bytesDone += chunk.length;
+			shared->pool->Release(chunk.buffer);
+		}
+
+		if (chunk.isLast) {
+			if (job.problem == EXTRACT_OK) {
+				// some of the file may have been dropped after a cancel
+				job.problem = shared->pool->IsCancelled() ? EXTRACT_CANCELLED : chunk.problem;
+			}
+			if (job.problem == EXTRACT_OK && file == NULL) {
+				file = OpenForWriting(job.partPath); // an empty file
+				if (file == NULL) {
+					job.problem = EXTRACT_WRITE_FAILED;
+				}
+			}
+			if (file != NULL && fclose(file) != 0 && job.problem == EXTRACT_OK) {
+				job.problem = EXTRACT_WRITE_FAILED;
+			}
+			files.erase(chunk.job);
+
+			if (job.problem == EXTRACT_OK && RenameFile(job.partPath, job.path)) {
+				job.isWritten = true;
+			} else {
+				if (job.problem == EXTRACT_OK) {
+					job.problem = EXTRACT_WRITE_FAILED;
+				}
+				RemoveFile(job.partPath);
+			}
+			++shared->progress.itemsDone;
+		}
+	}
+
+	// left by a cancel; the entries are extracted again next time
+	for (std::map<size_t, FILE*>::const_iterator it = files.begin(), end = files.end();
+			it != end; ++it) {
+		if (it->second != NULL) {
+			fclose(it->second);
+		}
+	}
+	shared->isWriterDone = true;
+}
+
+static wxString DescribeProblem(ExtractProblem problem) {
+	switch (problem) {
+		case EXTRACT_READ_FAILED:
+			return _("could not be read");
+		case EXTRACT_DAMAGED:
+			return _("is damaged");
+		case EXTRACT_WRITE_FAILED:
+			return _("could not be written");
+		default:
+			return _("was not extracted");
+	}
+}
+
+/** Collects the folders under a folder, so that they can be removed once
+ the files in them are. */
+class FolderLister: public wxDirTraverser {
+public:
+	virtual wxDirTraverseResult OnFile(const wxString& WXUNUSED(filename)) {
+		return wxDIR_CONTINUE;
+	}
+	virtual wxDirTraverseResult OnDir(const wxString& dirname) {
+		this->folders.Add(dirname);
+		return wxDIR_CONTINUE;
+	}
+	wxArrayString folders;
+};
+
+/** Deletes a folder and everything in it. */
+static bool RemoveTree(const wxString& folder) {
+	if (!wxDir::Exists(folder)) {
+		return true;
+	}
+	wxArrayString files;
+	wxDir::GetAllFiles(folder, &files, wxEmptyString, wxDIR_FILES | wxDIR_DIRS | wxDIR_HIDDEN);
+	for (size_t i = 0; i < files.GetCount(); ++i) {
+		wxRemoveFile(files[i]);
+	}
+	FolderLister lister;
+	wxDir dir(folder);
+	dir.Traverse(lister, wxEmptyString, wxDIR_DIRS | wxDIR_HIDDEN);
+	// deepest first
+	for (size_t i = lister.folders.GetCount(); i > 0; --i) {
+		wxRmdir(lister.folders[i - 1]);
+	}
+	return wxRmdir(folder);
+}
+
+/** Returns the 7-Zip command line tool, or an empty string if there is
+ none. */
+static wxString Find7zTool() {
+	wxPathList paths;
+	paths.AddEnvList(_T("PATH"));
+#if IS_WIN32
+	wxString programFiles;
+	if (wxGetEnv(_T("ProgramFiles"), &programFiles)) {
+		paths.Add(programFiles + _T("\\7-Zip"));
+	}
+	const wxChar* names[] = { _T("7z.exe"), _T("7za.exe") };
+#else
+	const wxChar* names[] = { _T("7z"), _T("7za"), _T("7zr") };
+#endif
+	for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i) {
+		const wxString found(paths.FindAbsoluteValidPath(names[i]));
+		if (!found.IsEmpty()) {
+			return found;
+		}
+	}
+	return wxEmptyString;
+}
+
+/** Tells Extract7z when 7-Zip has exited. */
+class SevenZipProcess: public wxProcess {
+public:
+	SevenZipProcess(): isDone(false), exitCode(-1) { }
+	virtual void OnTerminate(int WXUNUSED(pid), int status) {
+		this->exitCode = status;
+		this->isDone = true;
+	}
+	bool isDone;
+	int exitCode;
+};
+
+static bool CompareJobSizes(const ExtractJob& job1, const ExtractJob& job2) {
+	return job1.size > job2.size;
+}
+
+/** Extracts a zip file. Files already extracted by an interrupted install
+ of the same package are skipped. */
+bool ModInstaller::ExtractZip(const wxString& archive, const wxString& folder,
+	wxWindow* parent, InstallResult& result) {
+	std::vector<ZipEntry> entries;
+	{
+		wxFFile file(archive, _T("rb"));
+		if (!file.IsOpened()) {
+			result.error = _("The package could not be opened.");
+			return false;
+		}
+		wxBusyCursor busy;
+		if (!ReadZipDirectory(file, entries, result.error)) {
+			return false;
+		}
+	}
+
+	std::vector<ExtractJob> jobs;
+	std::set<wxString> folders;
+	uint64_t totalBytes = 0;
+	for (std::vector<ZipEntry>::const_iterator entry = entries.begin(), end = entries.end();
+			entry != end; ++entry) {
+		wxString name(entry->name);
+		name.Replace(_T("\\"), _T("/"));
+		if (!IsSafeEntryName(name)) {
+			wxLogError(_T("Package entry '%s' points outside the mod's folder"), entry->name.c_str());
+			result.error = _("The package contains files that would be written outside the mod's folder.");
+			return false;
+		}
+		if ((entry->flags & ZIP_FLAG_ENCRYPTED) != 0) {
+			result.error = _("The package is password protected, which isn't supported.");
+			return false;
+		}
+		if (entry->method != ZIP_METHOD_STORED && entry->method != ZIP_METHOD_DEFLATED) {
+			if (!Find7zTool().IsEmpty()) {
+				wxLogInfo(_T("%s uses compression method %d, so 7-Zip will extract it"),
+					archive.c_str(), entry->method);
+				result.fileCount = 0;
+				result.resumedCount = 0;
+				return Extract7z(archive, folder, parent, result);
+			}
+			result.error = wxString::Format(
+				_("The package uses compression method %d, which can only be extracted with 7-Zip, and 7-Zip wasn't found."),
+				entry->method);
+			return false;
+		}
+
+		const wxString path(EntryPath(folder, name));
+		if (name.EndsWith(_T("/"))) {
+			if (folders.insert(path).second && !wxFileName::Mkdir(path, 0777, wxPATH_MKDIR_FULL)) {
+				result.error = _("A folder for the mod could not be created.");
+				return false;
+			}
+			continue;
+		}
+		++result.fileCount;
+
+		if (wxFileExists(path) && wxFileName::GetSize(path) == wxULongLong(static_cast<wxULongLong_t>(entry->size))) {
+			++result.resumedCount;
+			continue;
+		}
+		const wxString parentFolder(wxFileName(path).GetPath());
+		if (folders.insert(parentFolder).second && !wxDir::Exists(parentFolder)
+			&& !wxFileName::Mkdir(parentFolder, 0777, wxPATH_MKDIR_FULL)) {
+			result.error = _("A folder for the mod could not be created.");
+			return false;
+		}
+
+		ExtractJob job;
+		job.name = name;
+		job.path = wxString(path.c_str());
+		job.partPath = wxString((path + INSTALL_PART_EXTENSION).c_str());
+		job.headerOffset = entry->headerOffset;
+		job.compressedSize = entry->compressedSize;
+		job.size = entry->size;
+		job.crc = entry->crc;
+		job.method = entry->method;
+		job.problem = EXTRACT_OK;
+		job.isWritten = false;
+		jobs.push_back(job);
+		totalBytes += entry->size;
+	}
+	if (result.resumedCount > 0) {
+		wxLogInfo(_T("Resuming the install of %s: %lu of %lu files are already extracted"),
+			archive.c_str(), static_cast<unsigned long>(result.resumedCount),
+			static_cast<unsigned long>(result.fileCount));
+	}
+	if (jobs.empty()) {
+		return true;
+	}
+
+	// biggest first, so that one huge file doesn't start last and hold up the end
+	std::stable_sort(jobs.begin(), jobs.end(), CompareJobSizes);
+
+	ParallelJobs parallel(jobs.size());
+	ExtractShared shared;
+	for (size_t i = 0; i < parallel.GetThreadCount(); ++i) {
+		FILE* file = OpenForReading(archive);
+		if (file == NULL) {
+			for (size_t j = 0; j < shared.archives.size(); ++j) {
+				fclose(shared.archives[j]);
+			}
+			result.error = _("The package could not be opened.");
+			return false;
+		}
+		shared.archives.push_back(file);
+	}
+
+	InitCRCTable();
+	ExtractBufferPool pool(parallel.GetThreadCount() * INSTALL_BUFFERS_PER_WORKER,
+		parallel.GetThreadCount());
+	shared.jobs = &jobs;
+	shared.parallel = &parallel;
+	shared.pool = &pool;
+	shared.isWriterDone = false;
+
+	std::thread writer(RunExtractWriter, &shared);
+	parallel.Start(RunExtractWorker, &shared);
+
+	ExtractTask task(shared);
+	const bool isCancelled = !WaitWithProgress(task, shared.progress, totalBytes,
+		jobs.size(), parent, _("Installing mod"),
+		wxString::Format(_("Extracting %lu files..."), static_cast<unsigned long>(jobs.size())),
+		_("Extracted %lu of %lu files"));
+	parallel.Join();
+	writer.join();
+	for (size_t i = 0; i < shared.archives.size(); ++i) {
+		fclose(shared.archives[i]);
+	}
+
+	wxArrayString failed;
+	for (std::vector<ExtractJob>::const_iterator job = jobs.begin(), end = jobs.end();
+			job != end; ++job) {
+		if (job->isWritten) {
+			result.writtenBytes += job->size;
+		} else if (job->problem != EXTRACT_OK && job->problem != EXTRACT_CANCELLED) {
+			wxLogError(_T("  %s %s"), job->name.c_str(), DescribeProblem(job->problem).c_str());
+			if (failed.GetCount() < INSTALL_MAX_LISTED_FAILURES) {
+				failed.Add(job->name + _T(" ") + DescribeProblem(job->problem));
+			}
+		}
+	}
+	if (!failed.IsEmpty()) {
+		result.error = _("Some files could not be extracted:");
+		for (size_t i = 0; i < failed.GetCount(); ++i) {
+			result.error += _T("\n") + failed[i];
+		}
+		return false;
+	}
+	if (isCancelled) {
+		result.status = InstallResult::INSTALL_CANCELLED;
+		return false;
+	}
+	return true;
+}
+
+/** Extracts a package with 7-Zip. 7-Zip writes files under their real
+ names, so before resuming, files whose size doesn't match the package's
+ listing are removed as partly written; -aos then skips the rest. */
+bool ModInstaller::Extract7z(const wxString& archive, const wxString& folder,
+	wxWindow* parent, InstallResult& result) {
+	const wxString tool(Find7zTool());
+	if (tool.IsEmpty()) {
+		result.error = _("Installing 7z packages needs 7-Zip, which wasn't found. Install 7-Zip (or p7zip) and try again.");
+		return false;
+	}
+
+	wxArrayString listing, errors;
+	const wxString listCommand(wxString::Format(_T("\"%s\" l -slt \"%s\""),
+		tool.c_str(), archive.c_str()));
+	wxLogDebug(_T("Listing the package: %s"), listCommand.c_str());
+	if (wxExecute(listCommand, listing, errors, wxEXEC_SYNC) != 0) {
+		for (size_t i = 0; i < errors.GetCount(); ++i) {
+			wxLogInfo(_T("  7-Zip: %s"), errors[i].c_str());
+		}
+		result.error = _("7-Zip could not read the package.");
+		return false;
+	}
+
+	// after the "----------" line, each entry is "Key = value" lines
+	wxString path;
+	bool isListingEntries = false;
+	bool isFolder = false;
+	for (size_t i = 0; i <= listing.GetCount(); ++i) {
+		const wxString line((i < listing.GetCount()) ? listing[i] : wxString(wxEmptyString));
+		if (!isListingEntries) {
+			isListingEntries = line.StartsWith(_T("----------"));
+			continue;
+		}
+		if (line.StartsWith(_T("Path = "), &path)) {
+			path.Replace(_T("\\"), _T("/"));
+			if (!IsSafeEntryName(path)) {
+				wxLogError(_T("Package entry '%s' points outside the mod's folder"), path.c_str());
+				result.error = _("The package contains files that would be written outside the mod's folder.");
+				return false;
+			}
+			isFolder = false;
+		} else if (line.StartsWith(_T("Folder = +")) || line.StartsWith(_T("Attributes = D"))) {
+			isFolder = true;
+		} else {
+			wxString sizeText;
+			wxULongLong_t size;
+			if (!isFolder && !path.IsEmpty() && line.StartsWith(_T("Size = "), &sizeText)
+				&& sizeText.ToULongLong(&size)) {
+				++result.fileCount;
+				const wxString extracted(EntryPath(folder, path));
+				if (wxFileExists(extracted)) {
+					if (wxFileName::GetSize(extracted) == wxULongLong(size)) {
+						++result.resumedCount;
+					} else {
+						wxRemoveFile(extracted);
+					}
+				}
+			}
+		}
+	}
+	if (result.resumedCount > 0) {
+		wxLogInfo(_T("Resuming the install of %s: %lu of %lu files are already extracted"),
+			archive.c_str(), static_cast<unsigned long>(result.resumedCount),
+			static_cast<unsigned long>(result.fileCount));
+	}
+
+	const wxString command(wxString::Format(_T("\"%s\" x -y -aos -bd \"-o%s\" \"%s\""),
+		tool.c_str(), folder.c_str(), archive.c_str()));
+	wxLogInfo(_T("Extracting with 7-Zip: %s"), command.c_str());
+	SevenZipProcess* process = new SevenZipProcess();
+	const long pid = wxExecute(command, wxEXEC_ASYNC, process);
+	if (pid == 0) {
+		delete process;
+		result.error = _("7-Zip could not be started.");
+		return false;
+	}
+
+	bool isCancelled = false;
+	{
+		wxProgressDialog progress(_("Installing mod"), _("Extracting with 7-Zip..."),
+			INSTALL_PROGRESS_RANGE, parent,
+			wxPD_APP_MODAL | wxPD_AUTO_HIDE | wxPD_CAN_ABORT | wxPD_ELAPSED_TIME);
+		while (!process->isDone) {
+			if (isCancelled) {
+				// OnTerminate() is delivered through the event loop, which
+				// Pulse() no longer runs once the dialog is cancelled
+				wxTheApp->Yield(true);
+			} else if (!progress.Pulse()) {
+				wxProcess::Kill(pid, wxSIGKILL);
+				isCancelled = true;
+			}
+			wxMilliSleep(INSTALL_PROGRESS_INTERVAL);
+		}
+	}
+	const int exitCode = process->exitCode;
+	delete process;
+
+	if (isCancelled) {
+		result.status = InstallResult::INSTALL_CANCELLED;
+		return false;
+	}
+	// 1 is 7-Zip's "finished with warnings"
+	if (exitCode != 0 && exitCode != 1) {
+		wxLogError(_T("7-Zip exited with %d"), exitCode);
+		result.error = _("7-Zip could not extract the package. See the log for details.");
+		return false;
+	}
+	return true;
+}
+
+/** A package holds the mod's files either at its top, or in a single
+ folder that names the mod. Anything else is not installable as one mod. */
+bool ModInstaller::FindModRoot(const wxString& folder, const wxString& archive,
+	wxString& root, wxString& shortname) {
+	if (wxFileName(folder, _T("mod.ini")).FileExists()) {
+		root = folder;
+		shortname = wxFileName(archive).GetName();
+		return true;
+	}
+
+	wxDir dir(folder);
+	wxString name;
+	wxArrayString subfolders;
+	for (bool found = dir.GetFirst(&name, wxEmptyString, wxDIR_DIRS); found;
+			found = dir.GetNext(&name)) {
+		if (name != _T("__MACOSX")) { // resource forks added by the Finder
+			subfolders.Add(name);
+		}
+	}
+	if (subfolders.GetCount() != 1) {
+		return false;
+	}
+	const wxString subfolder(folder + wxFileName::GetPathSeparator() + subfolders[0]);
+	if (!wxFileName(subfolder, _T("mod.ini")).FileExists()) {
+		return false;
+	}
+	root = subfolder;
+	shortname = subfolders[0];
+	return true;
+}
+
+/** Checks that the mod.ini can be read and reports anything that would
+ stop the mod working. Only an unreadable mod.ini fails the install; the
+ rest are warnings. */
+bool ModInstaller::ValidateModIni(const wxString& modIni, const wxString& tcPath,
+	const wxString& shortname, InstallResult& result) {
+	wxFFileInputStream stream(modIni);
+	if (!stream.IsOk() || stream.GetLength() == 0) {
+		result.error = _("The mod's mod.ini could not be read.");
+		return false;
+	}
+	wxFileConfig config(stream);
+
+	wxString name;
+	if (!config.Read(MOD_INI_KEY_LAUNCHER_MOD_NAME, &name) || name.Trim().IsEmpty()) {
+		result.warnings.Add(_("The mod.ini doesn't give the mod a name, so its folder name will be shown."));
+	}
+
+	// the mods it needs must be in the TC too
+	const wxString lists[] = { MOD_INI_KEY_MULTIMOD_PRIMARY_LIST,
+		MOD_INI_KEY_MULTIMOD_SECONDARY_LIST, MOD_INI_KEY_MULTIMOD_SECONDRY_LIST };
+	for (size_t i = 0; i < sizeof(lists) / sizeof(lists[0]); ++i) {
+		wxString list;
+		if (!config.Read(lists[i], &list)) {
+			continue;
+		}
+		wxStringTokenizer mods(list, _T(","), wxTOKEN_STRTOK);
+		while (mods.HasMoreTokens()) {
+			const wxString mod(mods.GetNextToken().Trim(true).Trim(false));
+			if (mod.IsEmpty() || mod == shortname) {
+				continue;
+			}
+			if (!wxDir::Exists(tcPath + wxFileName::GetPathSeparator() + mod)) {
+				result.warnings.Add(wxString::Format(
+					_("The mod needs the mod '%s', which isn't installed."), mod.c_str()));
+			}
+		}
+	}
+
+	long width, height;
+	if ((config.Read(MOD_INI_KEY_RESOLUTION_MIN_HORIZONTAL_RES, &width) && width <= 0)
+		|| (config.Read(MOD_INI_KEY_RESOLUTION_MIN_VERTICAL_RES, &height) && height <= 0)) {
+		result.warnings.Add(_("The mod.ini has an invalid minimum resolution, so the default will be used."));
+	}
+
+	for (size_t i = 0; i < result.warnings.GetCount(); ++i) {
+		wxLogWarning(_T("%s: %s"), shortname.c_str(), result.warnings[i].c_str());
+	}
+	return true;
+}
+
+InstallResult ModInstaller::Install(const wxString& archive, const wxString& tcPath,
+	wxWindow* parent) {
+	InstallResult result;
+	wxStopWatch timer;
+	wxCHECK_MSG(wxFileExists(archive), result, _T("Install(): package does not exist"));
+	wxCHECK_MSG(wxDir::Exists(tcPath), result, _T("Install(): TC folder does not exist"));
+
+	const wxFileName archiveName(archive);
+	const wxString type(archiveName.GetExt().Lower());
+	if (type != _T("zip") && type != _T("7z")) {
+		result.error = _("Only zip and 7z packages can be installed.");
+		return result;
+	}
+
+	// the marker says which package the staging folder was filled from
+	const wxString staging(tcPath + wxFileName::GetPathSeparator()
+		+ INSTALL_STAGING_PREFIX + archiveName.GetFullName());
+	const wxString marker(staging + wxFileName::GetPathSeparator() + INSTALL_MARKER_FILE_NAME);
+	const wxString folder(staging + wxFileName::GetPathSeparator() + INSTALL_FILES_FOLDER_NAME);
+	const wxDateTime modified(archiveName.GetModificationTime());
+	const wxString identity(wxString::Format(_T("%s\t%s\t%ld"), archive.c_str(),
+		archiveName.GetSize().ToString().c_str(),
+		modified.IsValid() ? static_cast<long>(modified.GetTicks()) : 0L));
+
+	if (wxDir::Exists(staging)) {
+		wxTextFile markerFile;
+		if (!wxFileExists(marker) || !markerFile.Open(marker, wxConvUTF8)
+			|| markerFile.GetLineCount() == 0 || markerFile[0] != identity) {
+			wxLogInfo(_T("Discarding files left by an install of a different %s"),
+				archiveName.GetFullName().c_str());
+			markerFile.Close();
+			RemoveTree(staging);
+		}
+	}
+	if (!wxDir::Exists(folder) && !wxFileName::Mkdir(folder, 0777, wxPATH_MKDIR_FULL)) {
+		result.error = _("The TC folder could not be written to.");
+		return result;
+	}
+	if (!wxFileExists(marker)) {
+		wxTextFile markerFile;
+		if (!markerFile.Create(marker)) {
+			result.error = _("The TC folder could not be written to.");
+			return result;
+		}
+		markerFile.AddLine(identity);
+		markerFile.Write(wxTextFileType_None, wxConvUTF8);
+	}
+
+	wxLogInfo(_T("Installing %s into %s"), archive.c_str(), tcPath.c_str());
+	const bool isExtracted = (type == _T("7z")) ?
+		Extract7z(archive, folder, parent, result) : ExtractZip(archive, folder, parent, result);
+	result.milliseconds = timer.Time();
+	if (!isExtracted) {
+		if (result.status == InstallResult::INSTALL_CANCELLED) {
+			wxLogInfo(_T("Install of %s cancelled; it will resume from here"), archive.c_str());
+		} else {
+			wxLogError(_T("Unable to install %s: %s"), archive.c_str(), result.error.c_str());
+		}
+		return result;
+	}
+
+	wxString root;
+	if (!FindModRoot(folder, archive, root, result.shortname)) {
+		result.error = _("The package has no mod.ini, either at its top or in a single folder, so it can't be installed as a mod.");
+		return result;
+	}
+	if (!ValidateModIni(wxFileName(root, _T("mod.ini")).GetFullPath(), tcPath,
+			result.shortname, result)) {
+		return result;
+	}
+
+	// an existing mod of the same name is kept aside until the new one is in place
+	const wxString target(tcPath + wxFileName::GetPathSeparator() + result.shortname);
+	const wxString replaced(tcPath + wxFileName::GetPathSeparator()
+		+ INSTALL_REPLACED_PREFIX + result.shortname);
+	const bool isUpdate = wxDir::Exists(target);
+	if (isUpdate) {
+		if (wxMessageBox(wxString::Format(
+				_("The mod '%s' is already installed. Replace it with the one in this package?"),
+				result.shortname.c_str()),
+				_("Installing mod"), wxYES_NO | wxICON_QUESTION, parent) != wxYES) {
+			result.status = InstallResult::INSTALL_CANCELLED;
+			return result;
+		}
+		RemoveTree(replaced);
+		if (!wxRenameFile(target, replaced, false)) {
+			result.error = wxString::Format(
+				_("The installed '%s' could not be moved aside. Close anything using its files and try again."),
+				result.shortname.c_str());
+			return result;
+		}
+	}
+	if (!wxRenameFile(root, target, false)) {
+		if (isUpdate) {
+			wxRenameFile(replaced, target, false);
+		}
+		result.error = _("The mod could not be moved into the TC folder.");
+		return result;
+	}
+	if (isUpdate) {
+		RemoveTree(replaced);
+	}
+	RemoveTree(staging);
+
+	result.status = InstallResult::INSTALL_OK;
+	result.milliseconds = timer.Time();
+	wxLogInfo(_T("Installed %s as %s: %lu files, %lu resumed, %.1f MB written in %ld ms"),
+		archive.c_str(), result.shortname.c_str(), static_cast<unsigned long>(result.fileCount),
+		static_cast<unsigned long>(result.resumedCount),
+		result.writtenBytes / (1024.0 * 1024.0), result.milliseconds);
+	TCManager::GenerateTCModInstalled(result.shortname);
+	return result;
+}
+
+wxString ModInstaller::GetWildcard() {
+	return _("Mod packages (*.zip;*.7z)|*.zip;*.ZIP;*.7z;*.7Z|All files|*");
+}
+
+wxString ModInstaller::FormatResult(const InstallResult& result) {
+	switch (result.status) {
+		case InstallResult::INSTALL_OK: {
+			wxString text(wxString::Format(_("Installed '%s'."), result.shortname.c_str()));
+			for (size_t i = 0; i < result.warnings.GetCount(); ++i) {
+				text += _T("\n") + result.warnings[i];
+			}
+			return text;
+		}
+		case InstallResult::INSTALL_CANCELLED:
+			return _("The install was stopped. Install the same package again to continue where it stopped.");
+		default:
+			return result.error;
+	}
+}
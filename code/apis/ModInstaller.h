@@ -0,0 +1,80 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#ifndef MODINSTALLER_H
+#define MODINSTALLER_H
+
+#include <stdint.h>
+
+#include <wx/wx.h>
+
+struct InstallResult {
+	enum Status {
+		INSTALL_OK,
+		INSTALL_CANCELLED, //!< what was extracted is kept for the next try
+		INSTALL_FAILED
+	};
+	InstallResult(): status(INSTALL_FAILED), fileCount(0), resumedCount(0),
+		writtenBytes(0), milliseconds(0) { }
+
+	Status status;
+	wxString shortname; //!< the mod's folder in the TC
+	wxString error; //!< why the install failed, for the user
+	wxArrayString warnings; //!< problems found in the mod's mod.ini
+	size_t fileCount;
+	size_t resumedCount; //!< files left from an interrupted install
+	uint64_t writtenBytes;
+	long milliseconds;
+};
+
+/** ModInstaller - installs a mod from a local package into the TC. Zip
+ files are read directly: the archive is never loaded into memory, entries
+ are decompressed in parallel, one thread per core, and a single writer
+ writes them out through a fixed pool of buffers. 7z files are handed to an
+ external 7-Zip, if one can be found. The package is extracted into a
+ hidden staging folder in the TC, so that an interrupted install picks up
+ where it stopped, and the mod is moved into place only once it is complete
+ and has a usable mod.ini. */
+class ModInstaller {
+public:
+	/** Installs archive into the TC at tcPath. Blocks, showing progress in a
+	 dialog over parent that lets the user cancel. On success, the mod list
+	 is told to read the new mod. */
+	static InstallResult Install(const wxString& archive, const wxString& tcPath,
+		wxWindow* parent);
+
+	/** The file dialog wildcard for the packages that can be installed. */
+	static wxString GetWildcard();
+	/** Describes result for the user. */
+	static wxString FormatResult(const InstallResult& result);
+
+private:
+	static bool ExtractZip(const wxString& archive, const wxString& folder,
+		wxWindow* parent, InstallResult& result);
+	static bool Extract7z(const wxString& archive, const wxString& folder,
+		wxWindow* parent, InstallResult& result);
+	static bool FindModRoot(const wxString& folder, const wxString& archive,
+		wxString& root, wxString& shortname);
+	static bool ValidateModIni(const wxString& modIni, const wxString& tcPath,
+		const wxString& shortname, InstallResult& result);
+
+	ModInstaller();
+};
+
+#endif
@@ -0,0 +1,432 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+
+#include <wx/wx.h>
+#include <wx/dir.h>
+#include <wx/filename.h>
+#include <wx/file.h>
+#include <wx/stopwatch.h>
+#include <wx/textfile.h>
+
+#include "apis/ModVerifier.h"
+#include "generated/configure_launcher.h"
+#include "global/MappedFile.h"
+#include "global/ParallelJobs.h"
+#include "global/ProfileKeys.h"
+#include "global/XXHash64.h"
+
+#include "global/MemoryDebugging.h"
+
+/** The cache of file hashes, in the launcher's profile folder. Each line
+ is the hash, size and modification time of a file, then its full path,
+ separated by tabs. */
+const wxString VERIFY_CACHE_FILE_NAME(_T("verifycache.txt"));
+const wxString VERIFY_CACHE_HEADER(_T("wxLauncher verify cache 1"));
+/** Files up to this size are mapped; bigger ones are read through a buffer,
+ so that a 32 bit launcher doesn't run out of address space. */
+const uint64_t VERIFY_MAP_LIMIT = 256 * 1024 * 1024;
+/** Bytes hashed between checks for cancelling and progress updates, and
+ the size of the read buffer. */
+const size_t VERIFY_SLICE_SIZE = 1024 * 1024;
+
+/** A file to be hashed. */
+struct VerifyJob {
+	wxString path;
+	uint64_t size;
+	long modified;
+	uint64_t hash;
+	bool isHashed;
+};
+
+struct VerifyShared {
+	std::vector<VerifyJob>* jobs;
+	ParallelJobs* parallel;
+	WorkProgress progress;
+};
+
+static FILE* OpenForReading(const wxString& path) {
+#if IS_WIN32
+	return _wfopen(path.wc_str(), L"rb");
+#else
+	return fopen(path.fn_str(), "rb");
+#endif
+}
+
+/** Runs on a worker thread, so nothing here may log. */
+static bool HashFile(VerifyJob& job, VerifyShared& shared, std::vector<char>& buffer) {
+	XXHash64 hasher;
+	uint64_t hashed = 0;
+
+	if (job.size <= VERIFY_MAP_LIMIT) {
+		MappedFile file;
+		wxString error;
+		if (!file.Open(job.path, &error)) {
+			return false;
+		}
+		const unsigned char* data = file.GetData();
+		const size_t size = file.GetSize();
+		for (size_t offset = 0; offset < size; offset += VERIFY_SLICE_SIZE) {
+			if (shared.parallel->IsCancelled()) {
+				return false;
+			}
+			const size_t length = std::min(VERIFY_SLICE_SIZE, size - offset);
+			hasher.Update(data + offset, length);
+			hashed += length;
+			shared.progress.bytesDone += length;
+		}
+	} else {
+		FILE* file = OpenForReading(job.path);
+		if (file == NULL) {
+			return false;
+		}
+		buffer.resize(VERIFY_SLICE_SIZE);
+		size_t length;
+		while ((length = fread(&buffer[0], 1, buffer.size(), file)) > 0) {
+			if (shared.parallel->IsCancelled()) {
+				fclose(file);
+				return false;
+			}
+			hasher.Update(&buffer[0], length);
+			hashed += length;
+			shared.progress.bytesDone += length;
+		}
+		const bool isError = ferror(file) != 0;
+		fclose(file);
+		if (isError) {
+			return false;
+		}
+	}
+
+	if (hashed != job.size) {
+		return false; // the file changed size while it was read
+	}
+	job.hash = hasher.Digest();
+	return true;
+}
+
+static void RunVerifyWorker(VerifyShared* shared, size_t WXUNUSED(thread)) {
+	std::vector<char> buffer;
+	size_t i;
+	while (shared->parallel->Claim(i)) {
+		VerifyJob& job = (*shared->jobs)[i];
+		job.isHashed = HashFile(job, *shared, buffer);
+		++shared->progress.itemsDone;
+	}
+}
+
+/** Turns a path relative to the verified folder into the form the
+ manifest uses, with '/' separators. */
+static wxString ManifestKey(const wxString& path) {
+	wxString key(path);
+	key.Replace(_T("\\"), _T("/"));
+	if (key.StartsWith(_T("./"))) {
+		key.Remove(0, 2);
+	}
+#if IS_WIN32
+	key.MakeLower(); // the file system doesn't care about case, so neither do we
+#endif
+	return key;
+}
+
+static uint64_t ParseUnsigned64(const wxString& text, int base) {
+	return std::strtoull(text.mb_str(wxConvUTF8), NULL, base);
+}
+
+static wxString FormatHash(uint64_t hash) {
+	return wxString::Format(_T("%016") wxLongLongFmtSpec _T("x"),
+		static_cast<wxULongLong_t>(hash));
+}
+
+ModVerifier& ModVerifier::Get() {
+	static ModVerifier verifier;
+	return verifier;
+}
+
+ModVerifier::ModVerifier()
+: isCacheLoaded(false) {
+}
+
+VerifyResult ModVerifier::Verify(const wxString& folder, const wxString& manifest,
+	wxWindow* parent) {
+	VerifyResult result;
+	wxStopWatch timer;
+	this->LoadCache();
+
+	const wxString root(wxFileName::DirName(folder).GetFullPath());
+	wxArrayString files;
+	{
+		wxBusyCursor busy;
+		wxDir::GetAllFiles(root, &files);
+	}
+	files.Sort();
+	result.fileCount = files.GetCount();
+
+	// files that are new or have changed since they were last hashed
+	std::vector<VerifyJob> jobs;
+	uint64_t totalBytes = 0;
+	for (size_t i = 0; i < files.GetCount(); ++i) {
+		const wxFileName file(files[i]);
+		const uint64_t size = file.GetSize().GetValue();
+		const wxDateTime modifiedTime(file.GetModificationTime());
+		const long modified = modifiedTime.IsValid() ? static_cast<long>(modifiedTime.GetTicks()) : 0;
+
+		CacheMap::const_iterator cached = this->cache.find(files[i]);
+		if (cached != this->cache.end() && cached->second.size == size
+			&& cached->second.modified == modified && modified != 0) {
+			continue;
+		}
+		VerifyJob job;
+		job.path = wxString(files[i].c_str());
+		job.size = size;
+		job.modified = modified;
+		job.hash = 0;
+		job.isHashed = false;
+		jobs.push_back(job);
+		totalBytes += size;
+	}
+
+	if (!jobs.empty()) {
+		ParallelJobs parallel(jobs.size());
+		VerifyShared shared;
+		shared.jobs = &jobs;
+		shared.parallel = &parallel;
+
+		parallel.Start(RunVerifyWorker, &shared);
+		result.isCancelled = !WaitWithProgress(parallel, shared.progress, totalBytes,
+			jobs.size(), parent, _("Verifying files"),
+			wxString::Format(_("Checking %lu files..."), static_cast<unsigned long>(jobs.size())),
+			_("Checked %lu of %lu files"));
+		parallel.Join();
+
+		for (std::vector<VerifyJob>::const_iterator job = jobs.begin(), end = jobs.end();
+				job != end; ++job) {
+			if (job->isHashed) {
+				CacheEntry& entry = this->cache[job->path];
+				entry.size = job->size;
+				entry.modified = job->modified;
+				entry.hash = job->hash;
+				++result.hashedCount;
+				result.hashedBytes += job->size;
+			} else {
+				this->cache.erase(job->path);
+				if (!result.isCancelled) {
+					VerifyProblem problem;
+					problem.kind = VerifyProblem::UNREADABLE;
+					problem.path = job->path.Mid(root.Len());
+					result.problems.push_back(problem);
+				}
+			}
+		}
+	}
+
+	// forget files under root that are gone
+	std::set<wxString> present;
+	for (size_t i = 0; i < files.GetCount(); ++i) {
+		present.insert(files[i]);
+	}
+	for (CacheMap::iterator it = this->cache.lower_bound(root);
+			it != this->cache.end() && it->first.StartsWith(root);) {
+		if (present.find(it->first) == present.end()) {
+			this->cache.erase(it++);
+		} else {
+			++it;
+		}
+	}
+	this->SaveCache();
+
+	std::map<wxString, uint64_t> expected;
+	if (!manifest.IsEmpty() && !result.isCancelled) {
+		if (!this->ReadManifest(manifest, expected)) {
+			VerifyProblem problem;
+			problem.kind = VerifyProblem::MISSING;
+			problem.path = wxFileName(manifest).GetFullName();
+			result.problems.push_back(problem);
+		}
+		result.manifestCount = expected.size();
+
+		for (size_t i = 0; i < files.GetCount(); ++i) {
+			std::map<wxString, uint64_t>::iterator listed =
+				expected.find(ManifestKey(files[i].Mid(root.Len())));
+			if (listed == expected.end()) {
+				continue;
+			}
+			CacheMap::const_iterator hashed = this->cache.find(files[i]);
+			if (hashed != this->cache.end() && hashed->second.hash != listed->second) {
+				VerifyProblem problem;
+				problem.kind = VerifyProblem::MISMATCH;
+				problem.path = files[i].Mid(root.Len());
+				result.problems.push_back(problem);
+			}
+			expected.erase(listed);
+		}
+		for (std::map<wxString, uint64_t>::const_iterator it = expected.begin(),
+				end = expected.end(); it != end; ++it) {
+			VerifyProblem problem;
+			problem.kind = VerifyProblem::MISSING;
+			problem.path = it->first;
+			result.problems.push_back(problem);
+		}
+	}
+
+	result.milliseconds = timer.Time();
+	wxLogInfo(_T("Verified %s: %lu files, %lu hashed (%.1f MB) in %ld ms, %lu problems%s"),
+		root.c_str(), static_cast<unsigned long>(result.fileCount),
+		static_cast<unsigned long>(result.hashedCount), result.hashedBytes / (1024.0 * 1024.0),
+		result.milliseconds, static_cast<unsigned long>(result.problems.size()),
+		result.isCancelled ? _T(" (cancelled)") : _T(""));
+	for (std::vector<VerifyProblem>::const_iterator it = result.problems.begin(),
+			end = result.problems.end(); it != end; ++it) {
+		wxLogInfo(_T("  %s: %s"), it->path.c_str(),
+			(it->kind == VerifyProblem::UNREADABLE) ? _T("unreadable") :
+			(it->kind == VerifyProblem::MISMATCH) ? _T("checksum mismatch") : _T("missing"));
+	}
+	return result;
+}
+
+wxString ModVerifier::FormatResult(const VerifyResult& result, size_t maxProblems) {
+	if (result.isCancelled) {
+		return _("Verification was cancelled. The files checked so far won't be checked again unless they change.");
+	}
+
+	wxString text(wxString::Format(_("Checked %lu files."),
+		static_cast<unsigned long>(result.fileCount)));
+	if (result.manifestCount == 0) {
+		text += _T(" ");
+		text += _("This mod has no checksum manifest, so only whether the files can be read was checked.");
+	}
+	if (result.problems.empty()) {
+		text += _T("\n\n");
+		text += _("No problems were found.");
+		return text;
+	}
+
+	text += _T("\n\n");
+	text += wxString::Format(_("%lu files have problems:"),
+		static_cast<unsigned long>(result.problems.size()));
+	for (size_t i = 0; i < result.problems.size() && i < maxProblems; ++i) {
+		const VerifyProblem& problem(result.problems[i]);
+		text += _T("\n");
+		switch (problem.kind) {
+			case VerifyProblem::UNREADABLE:
+				text += wxString::Format(_("%s can't be read"), problem.path.c_str());
+				break;
+			case VerifyProblem::MISMATCH:
+				text += wxString::Format(_("%s is damaged or a different version"), problem.path.c_str());
+				break;
+			default:
+				text += wxString::Format(_("%s is missing"), problem.path.c_str());
+				break;
+		}
+	}
+	if (result.problems.size() > maxProblems) {
+		text += _T("\n");
+		text += _("See the log for the rest.");
+	}
+	return text;
+}
+
+/** Reads a manifest written by xxhsum: a line per file, the hash in hex,
+ then the path relative to the mod's folder after one or two spaces, or a
+ space and '*'. Blank lines and lines starting with '#' are skipped. */
+bool ModVerifier::ReadManifest(const wxString& manifest,
+	std::map<wxString, uint64_t>& hashes) const {
+	wxTextFile file;
+	if (!wxFileExists(manifest) || !file.Open(manifest, wxConvUTF8)) {
+		wxLogError(_T("Unable to read the checksum manifest %s"), manifest.c_str());
+		return false;
+	}
+	for (size_t i = 0; i < file.GetLineCount(); ++i) {
+		wxString line(file[i]);
+		line.Trim(true);
+		if (line.IsEmpty() || line.StartsWith(_T("#"))) {
+			continue;
+		}
+		const wxString hash(line.BeforeFirst(_T(' ')));
+		wxString path(line.AfterFirst(_T(' ')));
+		if (path.StartsWith(_T(" ")) || path.StartsWith(_T("*"))) {
+			path.Remove(0, 1);
+		}
+		if (hash.Len() != 16 || path.IsEmpty()) {
+			wxLogWarning(_T("Skipping a malformed line in %s: %s"),
+				manifest.c_str(), line.c_str());
+			continue;
+		}
+		hashes[ManifestKey(path)] = ParseUnsigned64(hash, 16);
+	}
+	return true;
+}
+
+void ModVerifier::LoadCache() {
+	if (this->isCacheLoaded) {
+		return;
+	}
+	this->isCacheLoaded = true;
+
+	const wxFileName path(GetProfileStorageFolder(), VERIFY_CACHE_FILE_NAME);
+	wxTextFile file;
+	if (!path.FileExists() || !file.Open(path.GetFullPath(), wxConvUTF8)) {
+		return;
+	}
+	if (file.GetLineCount() == 0 || file[0] != VERIFY_CACHE_HEADER) {
+		wxLogDebug(_T("Ignoring %s, which is from another version"),
+			path.GetFullPath().c_str());
+		return;
+	}
+	for (size_t i = 1; i < file.GetLineCount(); ++i) {
+		const wxString& line(file[i]);
+		const wxString hash(line.BeforeFirst(_T('\t')));
+		wxString rest(line.AfterFirst(_T('\t')));
+		const wxString size(rest.BeforeFirst(_T('\t')));
+		rest = rest.AfterFirst(_T('\t'));
+		const wxString modified(rest.BeforeFirst(_T('\t')));
+		const wxString filePath(rest.AfterFirst(_T('\t')));
+		if (filePath.IsEmpty()) {
+			continue;
+		}
+		CacheEntry& entry = this->cache[filePath];
+		entry.hash = ParseUnsigned64(hash, 16);
+		entry.size = ParseUnsigned64(size, 10);
+		entry.modified = static_cast<long>(ParseUnsigned64(modified, 10));
+	}
+	wxLogDebug(_T("Loaded %lu cached file hashes"),
+		static_cast<unsigned long>(this->cache.size()));
+}
+
+void ModVerifier::SaveCache() const {
+	const wxFileName path(GetProfileStorageFolder(), VERIFY_CACHE_FILE_NAME);
+	wxFile file;
+	if (!file.Create(path.GetFullPath(), true)) {
+		return; // logged by wxFile
+	}
+	wxString contents(VERIFY_CACHE_HEADER + _T("\n"));
+	for (CacheMap::const_iterator it = this->cache.begin(), end = this->cache.end();
+			it != end; ++it) {
+		contents += wxString::Format(_T("%s\t%") wxLongLongFmtSpec _T("u\t%ld\t%s\n"),
+			FormatHash(it->second.hash).c_str(),
+			static_cast<wxULongLong_t>(it->second.size),
+			it->second.modified, it->first.c_str());
+	}
+	if (!file.Write(contents, wxConvUTF8)) {
+		wxLogError(_T("Unable to write %s"), path.GetFullPath().c_str());
+	}
+}
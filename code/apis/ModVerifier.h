@@ -0,0 +1,93 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef MODVERIFIER_H
+#define MODVERIFIER_H
+
+#include <map>
+#include <vector>
+
+#include <stdint.h>
+
+#include <wx/wx.h>
+
+/** What ModVerifier found wrong with one file. */
+struct VerifyProblem {
+	enum Kind {
+		UNREADABLE,	//!< the file couldn't be read to the end
+		MISMATCH,	//!< the file's hash isn't the one in the manifest
+		MISSING		//!< the manifest lists the file, but it isn't there
+	};
+	Kind kind;
+	wxString path; //!< relative to the verified folder
+};
+
+struct VerifyResult {
+	VerifyResult(): fileCount(0), hashedCount(0), hashedBytes(0),
+		manifestCount(0), isCancelled(false), milliseconds(0) { }
+
+	size_t fileCount;
+	size_t hashedCount; //!< files that weren't in the cache or had changed
+	uint64_t hashedBytes;
+	size_t manifestCount; //!< files listed in the manifest, 0 if there was none
+	std::vector<VerifyProblem> problems;
+	bool isCancelled;
+	long milliseconds;
+};
+
+/** ModVerifier - hashes every file in a mod's folder, or a whole TC, to
+ find damaged or incomplete installs. Files are hashed with XXH64 on one
+ thread per core. The hash of each file is cached, keyed by its path, size
+ and modification time, so verifying again only hashes what has changed.
+ A mod can name a checksum manifest in its mod.ini, in the format written
+ by xxhsum, that the hashes are compared against. */
+class ModVerifier {
+public:
+	static ModVerifier& Get();
+
+	/** Verifies every file under folder, comparing against the manifest
+	 file if it isn't empty. Blocks, showing progress in a dialog over
+	 parent that lets the user cancel. */
+	VerifyResult Verify(const wxString& folder, const wxString& manifest,
+		wxWindow* parent);
+
+	/** Describes result for the user, listing at most maxProblems files. */
+	static wxString FormatResult(const VerifyResult& result, size_t maxProblems);
+
+private:
+	ModVerifier();
+
+	struct CacheEntry {
+		uint64_t size;
+		long modified; //!< seconds since the epoch
+		uint64_t hash;
+	};
+	typedef std::map<wxString, CacheEntry> CacheMap;
+
+	bool ReadManifest(const wxString& manifest, std::map<wxString, uint64_t>& hashes) const;
+	void LoadCache();
+	void SaveCache() const;
+
+	CacheMap cache; //!< by full path
+	bool isCacheLoaded;
+
+	ModVerifier(const ModVerifier&);
+	ModVerifier& operator=(const ModVerifier&);
+};
+
+#endif
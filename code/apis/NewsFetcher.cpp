@@ -0,0 +1,433 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <wx/wx.h>
+#include <wx/protocol/http.h>
+#include <wx/sckaddr.h>
+#include <wx/socket.h>
+#include <wx/uri.h>
+
+#include "apis/NewsFetcher.h"
+#include "global/version.h"
+
+#include "global/MemoryDebugging.h"
+
+LAUNCHER_DEFINE_EVENT_TYPE(EVT_NEWS_FETCHED);
+
+/** Seconds allowed for connecting and for the server to send the response
+ headers. wxHTTP does both under the socket timeout. Looking the server's
+ name up is left to the system's resolver and its own timeouts. */
+const long NEWS_CONNECT_TIMEOUT = 10;
+/** Seconds allowed for any one read of the response body. */
+const long NEWS_READ_TIMEOUT = 15;
+/** Milliseconds between checks for abandonment while waiting for the
+ body, which bounds how long an abandoned read keeps its thread. */
+const long NEWS_POLL_INTERVAL = 100;
+/** Milliseconds DeInitialize() gives abandoned fetches to stop before
+ leaving them to finish on their own. */
+const long NEWS_EXIT_GRACE = 300;
+/** Seconds allowed for the whole body, so that a server trickling data
+ can't keep the fetch going forever. */
+const long NEWS_TOTAL_TIMEOUT = 30;
+/** The news is a few lines of text; anything bigger is not the news. */
+const size_t NEWS_MAX_SIZE = 256 * 1024;
+
+/** Splits the news into items as it arrives, so that the body is never
+ held in one piece. The news is tab separated title, link and image link
+ fields, repeated; empty fields are skipped. */
+class NewsStreamParser {
+public:
+	explicit NewsStreamParser(std::vector<NewsItem>& items)
+	: items(items), fieldCount(0) { }
+
+	void Feed(const char* data, size_t length) {
+		const char* const end = data + length;
+		while (data < end) {
+			const char* tab = static_cast<const char*>(memchr(data, '\t', end - data));
+			if (tab == NULL) {
+				this->field.append(data, end - data);
+				return;
+			}
+			this->field.append(data, tab - data);
+			this->EndField();
+			data = tab + 1;
+		}
+	}
+	/** Returns false if the news stops part way through an item. */
+	bool Finish() {
+		this->EndField();
+		return (this->fieldCount % 3) == 0;
+	}
+
+private:
+	void EndField() {
+		if (this->field.empty()) {
+			return;
+		}
+		wxString text(this->field.c_str(), wxConvUTF8);
+		if (text.IsEmpty()) {
+			text = wxString(this->field.c_str(), wxConvISO8859_1);
+		}
+		this->field.clear();
+
+		switch (this->fieldCount++ % 3) {
+			case 0:
+				this->items.push_back(NewsItem());
+				this->items.back().title = text;
+				break;
+			case 1:
+				this->items.back().link = text;
+				break;
+			default:
+				this->items.back().imageLink = text;
+				break;
+		}
+	}
+
+	std::vector<NewsItem>& items;
+	size_t fieldCount;
+	std::string field; //!< the field read so far, as sent
+};
+
+wxString NewsFetcher::urlOverride;
+bool NewsFetcher::isInitialized = false;
+NewsFetcher::WorkerList NewsFetcher::workers;
+
+bool NewsFetcher::Initialize() {
+	wxCHECK_MSG(!isInitialized, true, wxT_2("NewsFetcher is already initialized"));
+	// must happen on the main thread for sockets to be usable from workers
+	if (!wxSocketBase::Initialize()) {
+		return false;
+	}
+	isInitialized = true;
+	return true;
+}
+
+void NewsFetcher::DeInitialize() {
+	if (!isInitialized) {
+		return;
+	}
+	if (!workers.empty()) {
+		wxLogDebug(wxT_2("Waiting for %lu news downloads to stop"),
+			static_cast<unsigned long>(workers.size()));
+	}
+	for (WorkerList::iterator it = workers.begin(), end = workers.end(); it != end; ++it) {
+		Abandon(*it->state);
+	}
+	const std::chrono::steady_clock::time_point deadline =
+		std::chrono::steady_clock::now() + std::chrono::milliseconds(NEWS_EXIT_GRACE);
+	JoinFinishedWorkers();
+	while (!workers.empty() && std::chrono::steady_clock::now() < deadline) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		JoinFinishedWorkers();
+	}
+	isInitialized = false;
+	if (!workers.empty()) {
+		// stuck resolving or connecting; each thread holds its own reference
+		// to the state it shares, so it can finish or die with the process
+		wxLogDebug(wxT_2("Leaving %lu news downloads to stop on their own"),
+			static_cast<unsigned long>(workers.size()));
+		for (WorkerList::iterator it = workers.begin(), end = workers.end(); it != end; ++it) {
+			it->thread.detach();
+		}
+		workers.clear();
+		return;
+	}
+	wxSocketBase::Shutdown();
+}
+
+NewsFetcher::NewsFetcher(wxEvtHandler* owner)
+: owner(owner), nextId(0) {
+	wxCHECK_RET(owner != NULL, wxT_2("NewsFetcher created without an owner"));
+	wxASSERT_MSG(isInitialized, wxT_2("NewsFetcher created before NewsFetcher::Initialize()"));
+}
+
+NewsFetcher::~NewsFetcher() {
+	for (FetchMap::iterator it = this->fetches.begin(), end = this->fetches.end();
+			it != end; ++it) {
+		Abandon(*it->second.state);
+	}
+}
+
+void NewsFetcher::Abandon(FetchState& state) {
+	std::lock_guard<std::mutex> lock(state.mutex);
+	state.owner = NULL;
+}
+
+bool NewsFetcher::IsAbandoned(FetchState& state) {
+	std::lock_guard<std::mutex> lock(state.mutex);
+	return state.owner == NULL;
+}
+
+void NewsFetcher::JoinFinishedWorkers() {
+	WorkerList::iterator it = workers.begin();
+	while (it != workers.end()) {
+		bool isDone;
+		{
+			std::lock_guard<std::mutex> lock(it->state->mutex);
+			isDone = it->state->isDone;
+		}
+		if (isDone) {
+			// a thread that is done has at most its return left to run
+			it->thread.join();
+			it = workers.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+int NewsFetcher::Start(const NewsFetchRequest& request) {
+	for (FetchMap::iterator it = this->fetches.begin(), end = this->fetches.end();
+			it != end; ++it) {
+		if (it->second.sourceName == request.sourceName) {
+			Abandon(*it->second.state);
+			this->fetches.erase(it);
+			break;
+		}
+	}
+
+	// deep copies, since wxString's reference counting isn't thread safe
+	NewsFetchRequest copy;
+	copy.sourceName = wxString(request.sourceName.c_str());
+	copy.url = wxString(urlOverride.IsEmpty() ?
+		request.url.c_str() : urlOverride.c_str());
+	copy.etag = wxString(request.etag.c_str());
+	copy.lastModified = wxString(request.lastModified.c_str());
+
+	const int id = this->nextId++;
+	Fetch& fetch = this->fetches[id];
+	fetch.sourceName = request.sourceName;
+	fetch.state.reset(new FetchState);
+	fetch.state->owner = this->owner;
+	fetch.state->isDone = false;
+
+	wxLogDebug(wxT_2("Fetching news for %s from %s"),
+		copy.sourceName.c_str(), copy.url.c_str());
+	JoinFinishedWorkers();
+	workers.push_back(Worker());
+	workers.back().state = fetch.state;
+	workers.back().thread = std::thread(&NewsFetcher::Run, fetch.state, id, copy);
+	return id;
+}
+
+bool NewsFetcher::IsFetching(const wxString& sourceName) const {
+	for (FetchMap::const_iterator it = this->fetches.begin(), end = this->fetches.end();
+			it != end; ++it) {
+		if (it->second.sourceName == sourceName) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool NewsFetcher::TakeResult(int id, NewsFetchResult& result) {
+	FetchMap::iterator it = this->fetches.find(id);
+	if (it == this->fetches.end()) {
+		return false;
+	}
+	{
+		FetchState& state = *it->second.state;
+		std::lock_guard<std::mutex> lock(state.mutex);
+		if (!state.isDone) {
+			return false;
+		}
+		const NewsFetchResult& fetched = state.result;
+		result.status = fetched.status;
+		result.sourceName = it->second.sourceName;
+		result.items.clear();
+		for (std::vector<NewsItem>::const_iterator item = fetched.items.begin(),
+				end = fetched.items.end(); item != end; ++item) {
+			NewsItem copy;
+			copy.title = wxString(item->title.c_str());
+			copy.link = wxString(item->link.c_str());
+			copy.imageLink = wxString(item->imageLink.c_str());
+			result.items.push_back(copy);
+		}
+		result.etag = wxString(fetched.etag.c_str());
+		result.lastModified = wxString(fetched.lastModified.c_str());
+		result.error = wxString(fetched.error.c_str());
+	}
+	this->fetches.erase(it);
+	return true;
+}
+
+void NewsFetcher::SetUrlOverride(const wxString& url) {
+	urlOverride = url;
+}
+
+/** Runs on the worker thread. Nothing reads state->result until isDone is
+ set, so Download() fills it in without holding the lock. */
+void NewsFetcher::Run(std::shared_ptr<FetchState> state, int id, NewsFetchRequest request) {
+	Download(request, *state);
+
+	std::lock_guard<std::mutex> lock(state->mutex);
+	state->isDone = true;
+	if (state->owner == NULL) {
+		return; // abandoned
+	}
+	wxCommandEvent event(EVT_NEWS_FETCHED, wxID_NONE);
+	event.SetInt(id);
+	state->owner->AddPendingEvent(event);
+}
+
+void NewsFetcher::Download(const NewsFetchRequest& request, FetchState& state) {
+	NewsFetchResult& result = state.result;
+	wxURI uri(request.url);
+	if (uri.GetScheme() != wxT_2("http") || uri.GetServer().IsEmpty()) {
+		result.error = wxString::Format(wxT_2("%s is not an http URL"),
+			request.url.c_str());
+		return;
+	}
+	unsigned short port = 80;
+	if (uri.HasPort()) {
+		long portNumber;
+		if (!uri.GetPort().ToLong(&portNumber) || portNumber <= 0 || portNumber > 65535) {
+			result.error = wxString::Format(wxT_2("bad port in %s"),
+				request.url.c_str());
+			return;
+		}
+		port = static_cast<unsigned short>(portNumber);
+	}
+	wxString path(uri.GetPath());
+	if (path.IsEmpty()) {
+		path = wxT_2("/");
+	}
+	if (uri.HasQuery()) {
+		path += wxT_2("?") + uri.GetQuery();
+	}
+
+	wxIPV4address address;
+	if (!address.Hostname(uri.GetServer())) {
+		result.error = wxString::Format(wxT_2("unable to resolve %s"),
+			uri.GetServer().c_str());
+		return;
+	}
+	address.Service(port);
+	if (IsAbandoned(state)) {
+		return;
+	}
+
+	wxHTTP http;
+	// off the main thread the socket must block rather than run the event
+	// loop while it waits; the timeouts still apply
+	http.SetFlags(wxSOCKET_BLOCK | wxSOCKET_WAITALL);
+	http.SetTimeout(NEWS_CONNECT_TIMEOUT);
+	// only records the address; GetInputStream() connects, within the timeout
+	http.Connect(address, false);
+	http.SetHeader(wxT_2("Host"), (port == 80) ? uri.GetServer() :
+		wxString::Format(wxT_2("%s:%u"), uri.GetServer().c_str(),
+			static_cast<unsigned int>(port)));
+	http.SetHeader(wxT_2("User-Agent"), wxString::Format(wxT_2("wxLauncher/%d.%d.%d"),
+		MAJOR_VERSION, MINOR_VERSION, PATCH_VERSION));
+	if (!request.etag.IsEmpty()) {
+		http.SetHeader(wxT_2("If-None-Match"), request.etag);
+	}
+	if (!request.lastModified.IsEmpty()) {
+		http.SetHeader(wxT_2("If-Modified-Since"), request.lastModified);
+	}
+
+	std::unique_ptr<wxInputStream> in(http.GetInputStream(path));
+	if (!in && !http.IsConnected()) {
+		result.error = wxString::Format(wxT_2("unable to connect to %s port %u"),
+			uri.GetServer().c_str(), static_cast<unsigned int>(port));
+		return;
+	}
+	const int response = http.GetResponse();
+	if (response == 304) {
+		result.status = NewsFetchResult::NEWS_FETCH_NOT_MODIFIED;
+		result.etag = request.etag;
+		result.lastModified = request.lastModified;
+		return;
+	}
+	if (!in || response != 200) {
+		result.error = (response == 0) ?
+			wxString(wxT_2("no response from the server")) :
+			wxString::Format(wxT_2("the server answered %d"), response);
+		return;
+	}
+
+	// reads return whatever has arrived, and wait in short steps, so that an
+	// abandoned fetch notices within NEWS_POLL_INTERVAL
+	http.SetFlags(wxSOCKET_BLOCK);
+	http.SetTimeout(NEWS_READ_TIMEOUT);
+	const std::chrono::steady_clock::time_point deadline =
+		std::chrono::steady_clock::now() + std::chrono::seconds(NEWS_TOTAL_TIMEOUT);
+	std::chrono::steady_clock::time_point lastData = std::chrono::steady_clock::now();
+	NewsStreamParser parser(result.items);
+	size_t total = 0;
+	char buffer[4096];
+	while (!in->Eof()) {
+		if (IsAbandoned(state)) {
+			result.error = wxT_2("abandoned");
+			return;
+		}
+		const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		if (now > deadline) {
+			result.error = wxT_2("timed out reading the news");
+			return;
+		}
+		if (!http.WaitForRead(0, NEWS_POLL_INTERVAL)) {
+			if (now - lastData > std::chrono::seconds(NEWS_READ_TIMEOUT)) {
+				result.error = wxT_2("timed out reading the news");
+				return;
+			}
+			continue;
+		}
+		lastData = std::chrono::steady_clock::now();
+		in->Read(buffer, sizeof(buffer));
+		const size_t read = in->LastRead();
+		parser.Feed(buffer, read);
+		total += read;
+		if (read == 0 && in->GetLastError() != wxSTREAM_NO_ERROR) {
+			break;
+		}
+		if (total > NEWS_MAX_SIZE) {
+			result.error = wxT_2("the news is too big");
+			return;
+		}
+	}
+	if (in->GetLastError() == wxSTREAM_READ_ERROR) {
+		result.error = wxT_2("the connection failed while reading the news");
+		return;
+	}
+	if (!parser.Finish()) {
+		result.error = wxT_2("the news ends part way through an item");
+		return;
+	}
+
+	result.etag = http.GetHeader(wxT_2("ETag"));
+	result.lastModified = http.GetHeader(wxT_2("Last-Modified"));
+	result.status = NewsFetchResult::NEWS_FETCH_OK;
+}
+
+wxString NewsFetcher::FormatNews(const std::vector<NewsItem>& items) {
+	wxString formatted(wxT_2("<ul>"));
+	for (std::vector<NewsItem>::const_iterator it = items.begin(), end = items.end();
+			it != end; ++it) {
+		formatted += wxString::Format(wxT_2("\n<li><a href='%s'>%s</a><!-- %s --></li>"),
+			it->link.c_str(), it->title.c_str(), it->imageLink.c_str());
+	}
+	formatted += wxT_2("\n</ul>");
+	return formatted;
+}
@@ -0,0 +1,151 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef NEWSFETCHER_H
+#define NEWSFETCHER_H
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <wx/wx.h>
+
+#include "apis/EventHandlers.h"
+
+/** A news fetch has finished. The event's int is the id that Start()
+ returned; call NewsFetcher::TakeResult() with it for the result. */
+LAUNCHER_DECLARE_EVENT_TYPE(EVT_NEWS_FETCHED);
+
+/** What NewsFetcher sends and gets back for one news source. */
+struct NewsFetchRequest {
+	wxString sourceName;
+	wxString url;
+	wxString etag; //!< validators from the last download, empty if none
+	wxString lastModified;
+};
+
+struct NewsItem {
+	wxString title;
+	wxString link;
+	wxString imageLink;
+};
+
+struct NewsFetchResult {
+	enum Status {
+		NEWS_FETCH_OK,
+		NEWS_FETCH_NOT_MODIFIED, //!< the news we have is still current
+		NEWS_FETCH_FAILED
+	};
+	NewsFetchResult(): status(NEWS_FETCH_FAILED) { }
+
+	Status status;
+	wxString sourceName;
+	std::vector<NewsItem> items; //!< for NEWS_FETCH_OK
+	wxString etag;
+	wxString lastModified;
+	wxString error; //!< why the fetch failed, for the log
+};
+
+/** NewsFetcher - downloads the news over HTTP on worker threads, one per
+ news source, so that a slow or dead server can't freeze the launcher or
+ hold up the other sources. The news is parsed as it arrives. Each request
+ carries the validators from the last download, so that the server can
+ answer with a bodyless 304 when the news hasn't changed. When a fetch is
+ done the owner is sent EVT_NEWS_FETCHED on the main thread.
+
+ The worker threads can outlive the NewsFetcher that started them, so they
+ are kept track of for the whole session; DeInitialize() stops them before
+ wx's sockets are shut down. */
+class NewsFetcher {
+public:
+	/** Sets up wx's sockets for the worker threads. Call on the main thread
+	 before any NewsFetcher is created. */
+	static bool Initialize();
+	/** Abandons the fetches still in progress and shuts wx's sockets down.
+	 A thread reading the news stops within NEWS_POLL_INTERVAL, but one that
+	 is still looking the server up or connecting can't be interrupted; it
+	 is detached after a short wait, and the sockets are left up for it,
+	 so that quitting never waits on the network. */
+	static void DeInitialize();
+	static bool IsInitialized() { return isInitialized; }
+
+	explicit NewsFetcher(wxEvtHandler* owner);
+	/** Does not wait for fetches in progress; their results are thrown away. */
+	~NewsFetcher();
+
+	/** Starts fetching, abandoning a fetch for the same source that is
+	 still in progress. Returns the id of the new fetch. */
+	int Start(const NewsFetchRequest& request);
+	/** Returns true if a fetch for the source is in progress. */
+	bool IsFetching(const wxString& sourceName) const;
+	/** Moves the result of the finished fetch id into result. Call from the
+	 EVT_NEWS_FETCHED handler. Returns false if there is no such finished
+	 fetch, as when the event was sent by a fetch that was abandoned. */
+	bool TakeResult(int id, NewsFetchResult& result);
+
+	/** Turns news items into the HTML list shown on the welcome page. */
+	static wxString FormatNews(const std::vector<NewsItem>& items);
+
+	/** Fetches from url instead of the news sources' own URLs, such as a
+	 local server used for testing. */
+	static void SetUrlOverride(const wxString& url);
+	static const wxString& GetUrlOverride() { return urlOverride; }
+
+private:
+	/** The parts of a fetch shared with its worker thread, which may
+	 outlive the NewsFetcher. */
+	struct FetchState {
+		std::mutex mutex;
+		wxEvtHandler* owner; //!< NULL once the fetch is abandoned
+		bool isDone;
+		NewsFetchResult result;
+	};
+	struct Fetch {
+		wxString sourceName; //!< main thread's copy
+		std::shared_ptr<FetchState> state;
+	};
+	typedef std::map<int, Fetch> FetchMap;
+	struct Worker {
+		std::thread thread;
+		std::shared_ptr<FetchState> state;
+	};
+	typedef std::list<Worker> WorkerList;
+
+	static void Run(std::shared_ptr<FetchState> state, int id, NewsFetchRequest request);
+	static void Download(const NewsFetchRequest& request, FetchState& state);
+	static bool IsAbandoned(FetchState& state);
+	static void Abandon(FetchState& state);
+	/** Joins the threads of the fetches that are done. */
+	static void JoinFinishedWorkers();
+
+	wxEvtHandler* owner;
+	FetchMap fetches;
+	int nextId;
+
+	static wxString urlOverride;
+	static bool isInitialized;
+	static WorkerList workers; //!< main thread only
+
+	NewsFetcher(const NewsFetcher&);
+	NewsFetcher& operator=(const NewsFetcher&);
+};
+
+#endif
@@ -16,8 +16,14 @@ along with this program; if not, write to the Free Software
 Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 */
 
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <wx/wx.h>
 #include <wx/dynlib.h>
+#include <wx/filename.h>
+#include <wx/tokenzr.h>
 #include "generated/configure_launcher.h"
 #include "apis/FlagListManager.h"
 #include "apis/OpenALManager.h"
@@ -45,44 +51,253 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #define ALC_ALL_DEVICES_SPECIFIER                0x1013
 #endif
 
+LAUNCHER_DEFINE_EVENT_TYPE(EVT_OPENAL_PROBE_DONE);
+
 const wxByte BUILD_CAP_NEW_SND = 1<<2;
 
 #if USE_OPENAL
+typedef const ALCchar* (ALC_APIENTRY *alcGetStringType)(ALCdevice*, ALenum);
+typedef ALCboolean (ALC_APIENTRY *alcIsExtensionPresentType)(ALCdevice*, const ALchar*);
+typedef const ALchar* (AL_APIENTRY *alGetStringType)(ALenum);
+typedef ALenum (AL_APIENTRY *alGetErrorType)(void);
+typedef ALCdevice* (ALC_APIENTRY *alcOpenDeviceType)(const ALCchar *);
+typedef ALCboolean (ALC_APIENTRY *alcCloseDeviceType)(ALCdevice *);
+typedef ALCcontext* (ALC_APIENTRY *alcCreateContextType)(const ALCdevice*, const ALCint*);
+typedef ALCboolean (ALC_APIENTRY *alcMakeContextCurrentType)(ALCcontext*);
+typedef void (ALC_APIENTRY *alcDestroyContextType)(ALCcontext*);
+
 namespace OpenALMan {
+/** The OpenAL entry points the launcher uses, looked up once when the
+ library is loaded. An entry is NULL if the library doesn't have it. */
+struct Functions {
+	alcGetStringType alcGetString;
+	alcIsExtensionPresentType alcIsExtensionPresent;
+	alGetStringType alGetString;
+	alGetErrorType alGetError;
+	alcOpenDeviceType alcOpenDevice;
+	alcCloseDeviceType alcCloseDevice;
+	alcCreateContextType alcCreateContext;
+	alcMakeContextCurrentType alcMakeContextCurrent;
+	alcDestroyContextType alcDestroyContext;
+};
+
+/** What a probe found, in the form OpenAL gives it, so that the probe
+ thread never touches a wxString. Errors are logged once it has finished. */
+struct ProbeResults {
+	std::vector<std::string> playbackDevices;
+	std::vector<std::string> captureDevices;
+	std::string defaultPlaybackDevice;
+	std::string defaultCaptureDevice;
+	std::string version;
+	std::vector<std::string> efxDevices;
+	std::vector<std::string> errors;
+};
+
+struct Capabilities {
+	wxArrayString playbackDevices;
+	wxArrayString captureDevices;
+	wxString defaultPlaybackDevice;
+	wxString defaultCaptureDevice;
+	wxString version;
+	wxArrayString efxDevices; //!< the playback devices that support EFX
+
+	bool operator==(const Capabilities& other) const {
+		return (this->playbackDevices == other.playbackDevices)
+			&& (this->captureDevices == other.captureDevices)
+			&& (this->defaultPlaybackDevice == other.defaultPlaybackDevice)
+			&& (this->defaultCaptureDevice == other.defaultCaptureDevice)
+			&& (this->version == other.version)
+			&& (this->efxDevices == other.efxDevices);
+	}
+};
+
+enum ProbeState {
+	PROBE_NOT_STARTED,
+	PROBE_RUNNING, //!< until FinishProbe() has collected the results
+	PROBE_DONE
+};
+
 wxDynamicLibrary OpenALLib;
 bool isInitialized = false;
+Functions functions;
+/** Identifies the loaded library in the cache: its path and modification time. */
+wxString libraryKey;
+Capabilities capabilities;
+bool hasCapabilities = false;
+ProbeState probeState = PROBE_NOT_STARTED;
+std::thread probeThread;
+ProbeResults probeResults; //!< only touched by the probe thread while it runs
+
+
+template< typename funcPtrType> 
+funcPtrType GetOpenALFunctionPointer(const wxString& name);
+void ResolveFunctions();
+wxString GetLibraryKey(const wxString& loadedName);
+void LoadCachedCapabilities();
+void SaveCachedCapabilities();
+void RunProbe(wxEvtHandler* handler);
 };
 using namespace OpenALMan;
+
+template< typename funcPtrType> 
+funcPtrType 
+OpenALMan::GetOpenALFunctionPointer(const wxString& name) {
+	if ( !OpenALLib.HasSymbol(name) ) {
+		wxLogError(_T("OpenAL does not have %s()"), name.c_str());
+		return NULL;
+	}
+
+	funcPtrType pointer = NULL;
+
+	pointer = reinterpret_cast<funcPtrType>(
+		OpenALLib.GetSymbol(name));
+
+	if ( pointer == NULL ) {
+		wxLogError(_T("Unable to get %s() function from OpenAL, even though it apparently exists"), name.c_str());
+		return NULL;
+	}
+
+	return pointer;
+}
+
+#define RESOLVE_OAL_FUNC(name) \
+	functions.name = GetOpenALFunctionPointer<name##Type>(_T(#name))
+
+void OpenALMan::ResolveFunctions() {
+	RESOLVE_OAL_FUNC(alcGetString);
+	RESOLVE_OAL_FUNC(alcIsExtensionPresent);
+	RESOLVE_OAL_FUNC(alGetString);
+	RESOLVE_OAL_FUNC(alGetError);
+	RESOLVE_OAL_FUNC(alcOpenDevice);
+	RESOLVE_OAL_FUNC(alcCloseDevice);
+	RESOLVE_OAL_FUNC(alcCreateContext);
+	RESOLVE_OAL_FUNC(alcMakeContextCurrent);
+	RESOLVE_OAL_FUNC(alcDestroyContext);
+}
+
+#undef RESOLVE_OAL_FUNC
+
+/** The modification time stands in for the library's version, which can
+ only be asked for once a device has been opened. */
+wxString OpenALMan::GetLibraryKey(const wxString& loadedName) {
+	wxString path;
+#if wxUSE_DYNAMIC_LOADER
+	const wxDynamicLibraryDetailsArray loaded(wxDynamicLibrary::ListLoaded());
+	for (size_t i = 0; i < loaded.GetCount(); ++i) {
+		if (loaded[i].GetName().Lower().Contains(_T("openal"))) {
+			path = loaded[i].GetPath();
+			break;
+		}
+	}
+#endif
+	if (path.IsEmpty()) {
+		path = loadedName; // not all platforms can list loaded libraries
+	}
+
+	wxString key(path);
+	if (wxFileName::FileExists(path)) {
+		key += wxString::Format(_T(" %ld"),
+			static_cast<long>(wxFileName(path).GetModificationTime().GetTicks()));
+	}
+	return key;
+}
+
+static wxString JoinDevices(const wxArrayString& devices) {
+	wxString joined;
+	for (size_t i = 0; i < devices.GetCount(); ++i) {
+		if (i > 0) {
+			joined += _T("\n");
+		}
+		joined += devices[i];
+	}
+	return joined;
+}
+
+static wxArrayString SplitDevices(const wxString& joined) {
+	wxArrayString devices;
+	wxStringTokenizer tokenizer(joined, _T("\n"), wxTOKEN_STRTOK);
+	while (tokenizer.HasMoreTokens()) {
+		devices.Add(tokenizer.GetNextToken());
+	}
+	return devices;
+}
+
+void OpenALMan::LoadCachedCapabilities() {
+	ProMan* proman = ProMan::GetProfileManager();
+	wxString cachedLibrary;
+	if (!proman->GlobalRead(GBL_CFG_OPENAL_CACHE_LIBRARY, &cachedLibrary)
+		|| (cachedLibrary != libraryKey)) {
+		wxLogDebug(_T("No cached OpenAL devices for %s"), libraryKey.c_str());
+		return;
+	}
+
+	wxString devices;
+	proman->GlobalRead(GBL_CFG_OPENAL_CACHE_PLAYBACK, &devices, wxEmptyString);
+	capabilities.playbackDevices = SplitDevices(devices);
+	proman->GlobalRead(GBL_CFG_OPENAL_CACHE_CAPTURE, &devices, wxEmptyString);
+	capabilities.captureDevices = SplitDevices(devices);
+	proman->GlobalRead(GBL_CFG_OPENAL_CACHE_EFX, &devices, wxEmptyString);
+	capabilities.efxDevices = SplitDevices(devices);
+	proman->GlobalRead(GBL_CFG_OPENAL_CACHE_DEFAULT_PLAYBACK,
+		&capabilities.defaultPlaybackDevice, wxEmptyString);
+	proman->GlobalRead(GBL_CFG_OPENAL_CACHE_DEFAULT_CAPTURE,
+		&capabilities.defaultCaptureDevice, wxEmptyString);
+	proman->GlobalRead(GBL_CFG_OPENAL_CACHE_VERSION,
+		&capabilities.version, wxEmptyString);
+	hasCapabilities = true;
+
+	wxLogDebug(_T("Using cached OpenAL devices for %s"), libraryKey.c_str());
+}
+
+void OpenALMan::SaveCachedCapabilities() {
+	ProMan* proman = ProMan::GetProfileManager();
+	proman->GlobalWrite(GBL_CFG_OPENAL_CACHE_LIBRARY, libraryKey);
+	proman->GlobalWrite(GBL_CFG_OPENAL_CACHE_PLAYBACK,
+		JoinDevices(capabilities.playbackDevices));
+	proman->GlobalWrite(GBL_CFG_OPENAL_CACHE_CAPTURE,
+		JoinDevices(capabilities.captureDevices));
+	proman->GlobalWrite(GBL_CFG_OPENAL_CACHE_EFX,
+		JoinDevices(capabilities.efxDevices));
+	proman->GlobalWrite(GBL_CFG_OPENAL_CACHE_DEFAULT_PLAYBACK,
+		capabilities.defaultPlaybackDevice);
+	proman->GlobalWrite(GBL_CFG_OPENAL_CACHE_DEFAULT_CAPTURE,
+		capabilities.defaultCaptureDevice);
+	proman->GlobalWrite(GBL_CFG_OPENAL_CACHE_VERSION, capabilities.version);
+}
 #endif
 
 bool OpenALMan::Initialize() {
 #if USE_OPENAL
 	if ( isInitialized ) {
 		return true;
+	}
+
+	struct LibraryName {
+		const wxChar* name;
+		int flags;
+	};
+	static const LibraryName libraryNames[] = {
 #if IS_APPLE
-	} else if ( OpenALLib.Load(_T("/System/Library/Frameworks/OpenAL.framework/OpenAL"),
-							   wxDL_VERBATIM) ) {
-		isInitialized = true;
-		return true;
-	} else if ( OpenALLib.Load(_T("/Library/Frameworks/OpenAL.framework/OpenAL"),
-							   wxDL_VERBATIM) ) {
-		isInitialized = true;
-		return true;
+		{ _T("/System/Library/Frameworks/OpenAL.framework/OpenAL"), wxDL_VERBATIM },
+		{ _T("/Library/Frameworks/OpenAL.framework/OpenAL"), wxDL_VERBATIM },
 #elif IS_WIN32
-	} else if ( OpenALLib.Load(_T("OpenAL32")) ) {
-		isInitialized = true;
-		return true;
+		{ _T("OpenAL32"), wxDL_DEFAULT },
 #else
-	} else if ( OpenALLib.Load(_T("libopenal")) ) {
-		isInitialized = true;
-		return true;
+		{ _T("libopenal"), wxDL_DEFAULT },
 #endif
-	} else if ( OpenALLib.Load(_T("OpenAL")) ) {
-		isInitialized = true;
-		return true;
-	} else {
-		return false;
+		{ _T("OpenAL"), wxDL_DEFAULT }
+	};
+
+	for (size_t i = 0; i < WXSIZEOF(libraryNames); ++i) {
+		if ( OpenALLib.Load(libraryNames[i].name, libraryNames[i].flags) ) {
+			isInitialized = true;
+			ResolveFunctions();
+			libraryKey = GetLibraryKey(libraryNames[i].name);
+			LoadCachedCapabilities();
+			return true;
+		}
 	}
+	return false;
 #else
 	return false;
 #endif
@@ -90,6 +305,15 @@ bool OpenALMan::Initialize() {
 
 bool OpenALMan::DeInitialize() {
 #if USE_OPENAL
+	// the probe uses the library, so it must finish first
+	if (probeThread.joinable()) {
+		probeThread.join();
+	}
+	probeState = PROBE_NOT_STARTED;
+	hasCapabilities = false;
+	capabilities = Capabilities();
+	isInitialized = false;
+
 	OpenALLib.Unload();
 	return true;
 #else
@@ -114,128 +338,210 @@ bool OpenALMan::WasCompiledIn() {
 }
 
 #if USE_OPENAL
-typedef const ALCchar* (ALC_APIENTRY *alcGetStringType)(ALCdevice*, ALenum);
-typedef ALCboolean (ALC_APIENTRY *alcIsExtensionPresentType)(ALCdevice*, const ALchar*);
-typedef const ALchar* (AL_APIENTRY *alGetStringType)(ALenum);
-typedef ALenum (AL_APIENTRY *alGetErrorType)(void);
-typedef ALCdevice* (ALC_APIENTRY *alcOpenDeviceType)(const ALCchar *);
-typedef ALCboolean (ALC_APIENTRY *alcCloseDeviceType)(ALCdevice *);
-typedef ALCcontext* (ALC_APIENTRY *alcCreateContextType)(const ALCdevice*, const ALCint*);
-typedef ALCboolean (ALC_APIENTRY *alcMakeContextCurrentType)(ALCcontext*);
-typedef void (ALC_APIENTRY *alcDestroyContextType)(ALCcontext*);
+static void SplitDeviceList(const ALCchar* devices, std::vector<std::string>& out) {
+	size_t len;
+	size_t offset = 0;
+	do {
+		len = strlen(devices+offset);
+		if ( len > 0 ) {
+			out.push_back(std::string(devices+offset, len));
+		}
+		offset += len+1;
+	} while ( len != 0 );
+}
 
-namespace OpenALMan {
-	template< typename funcPtrType> 
-	funcPtrType GetOpenALFunctionPointer(const wxString& name, size_t line);
-	bool checkForALError_(size_t line);
-};
-#define ___GetOALFuncPtr(type, name, line) GetOpenALFunctionPointer<type>(_T(name), line)
-#define GetOALFuncPtr(type, name) ___GetOALFuncPtr(type, #name, __LINE__)
-#define checkForALError() OpenALMan::checkForALError_(__LINE__)
+static void ProbeDevices(const ALenum deviceType, std::vector<std::string>& out,
+	ProbeResults& results) {
+	if ( (*functions.alcIsExtensionPresent)(NULL, "ALC_ENUMERATION_EXT") != AL_TRUE ) {
+		results.errors.push_back("OpenAL does not seem to support device enumeration.");
+		return;
+	}
 
-template< typename funcPtrType> 
-funcPtrType 
-OpenALMan::GetOpenALFunctionPointer(const wxString& name, size_t line) {
-	if ( !OpenALLib.HasSymbol(name) ) {
-		wxLogError(
-			_T("OpenAL does not have %s() for function containing line %d"),
-			name.c_str(), line);
-		return NULL;
+	ALenum adjustedDeviceType = deviceType;
+	if ((deviceType == ALC_DEVICE_SPECIFIER) &&
+			(*functions.alcIsExtensionPresent)(NULL, "ALC_ENUMERATE_ALL_EXT") == AL_TRUE) {
+		adjustedDeviceType = ALC_ALL_DEVICES_SPECIFIER;
 	}
 
-	funcPtrType pointer = NULL;
+	const ALCchar* devices = (*functions.alcGetString)(NULL, adjustedDeviceType);
+	if ( devices == NULL ) {
+		results.errors.push_back("OpenAL gave NULL for list of devices.");
+		return;
+	}
+	SplitDeviceList(devices, out);
+}
 
-	pointer = reinterpret_cast<funcPtrType>(
-		OpenALLib.GetSymbol(name));
+static std::string ProbeDefaultDevice(const ALenum deviceType, ProbeResults& results) {
+	ALenum adjustedDeviceType = deviceType;
+	if ((deviceType == ALC_DEFAULT_DEVICE_SPECIFIER) &&
+		((*functions.alcIsExtensionPresent)(NULL, "ALC_ENUMERATE_ALL_EXT") == AL_TRUE)) {
+			adjustedDeviceType = ALC_DEFAULT_ALL_DEVICES_SPECIFIER;
+	}
 
-	if ( pointer == NULL ) {
-		wxLogError(_T("Unable to get %s() function from OpenAL, even though it apparently exists for function containing line %d"), name.c_str(), line);
-		return NULL;
+	const ALCchar* defaultDevice = (*functions.alcGetString)(NULL, adjustedDeviceType);
+	if ( defaultDevice == NULL ) {
+		results.errors.push_back((deviceType == ALC_CAPTURE_DEFAULT_DEVICE_SPECIFIER) ?
+			"Unable to get system default OpenAL capture device" :
+			"Unable to get system default OpenAL device");
+		return std::string();
 	}
+	return std::string(defaultDevice);
+}
 
-	return pointer;
+/** AL_VERSION can only be read with a current context, so this opens the
+ default device for it. */
+static void ProbeVersion(ProbeResults& results) {
+	ALCdevice* device = (*functions.alcOpenDevice)(NULL);
+	if ( device == NULL ) {
+		results.errors.push_back("alcOpenDevice returned NULL for the default device");
+		return;
+	}
+
+	ALCcontext* context = (*functions.alcCreateContext)(device, NULL);
+	if ( context == NULL ) {
+		results.errors.push_back("Error in opening context");
+		(*functions.alcCloseDevice)(device);
+		return;
+	}
+
+	if ( (*functions.alcMakeContextCurrent)(context) == ALC_TRUE
+		&& (*functions.alGetError)() == AL_NO_ERROR ) {
+		const ALchar* version = (*functions.alGetString)(AL_VERSION);
+		if ( (*functions.alGetError)() == AL_NO_ERROR && version != NULL ) {
+			results.version = version;
+		} else {
+			results.errors.push_back("OpenAL: Unable to retrieve Version String");
+		}
+		// unset the current context
+		(*functions.alcMakeContextCurrent)(NULL);
+	} else {
+		results.errors.push_back("Error in setting context as current");
+	}
+
+	(*functions.alcDestroyContext)(context);
+	(*functions.alcCloseDevice)(device);
 }
 
-bool OpenALMan::checkForALError_(size_t line) {
-	alGetErrorType getError = GetOALFuncPtr(alGetErrorType, alGetError);
-	if ( getError == NULL ) {
-		return false;
+// bits are adapted from FSO, sound/ds.cpp, ds_init()
+static void ProbeEFX(ProbeResults& results) {
+	for (std::vector<std::string>::const_iterator it = results.playbackDevices.begin(),
+			end = results.playbackDevices.end(); it != end; ++it) {
+		ALCdevice* playbackDevice = (*functions.alcOpenDevice)(it->c_str());
+		if (playbackDevice == NULL) {
+			results.errors.push_back(
+				"alcOpenDevice returned NULL when checking device '" + *it + "' for EFX");
+			continue;
+		}
+		if ((*functions.alcIsExtensionPresent)(playbackDevice, "ALC_EXT_EFX") == AL_TRUE) {
+			results.efxDevices.push_back(*it);
+		}
+		(*functions.alcCloseDevice)(playbackDevice);
 	}
-	ALenum errorcode = (*getError)();
-	if ( errorcode == AL_NO_ERROR ) {
-		return true;
-	} else if ( errorcode == AL_INVALID_NAME ) {
-		wxLogError(_T("OpenAL:%ld: a bad name (ID) was passed to an OpenAL function"), line);
-	} else if ( errorcode == AL_INVALID_ENUM ) {
-		wxLogError(_T("OpenAL:%ld: an invalid enum value was passed to an OpenAL function"), line);
+}
+
+/** Runs on the probe thread, filling in probeResults. */
+void OpenALMan::RunProbe(wxEvtHandler* handler) {
+	ProbeResults& results = probeResults;
+	results = ProbeResults();
+
+	if (functions.alcGetString == NULL || functions.alcIsExtensionPresent == NULL
+		|| functions.alGetString == NULL || functions.alGetError == NULL
+		|| functions.alcOpenDevice == NULL || functions.alcCloseDevice == NULL
+		|| functions.alcCreateContext == NULL || functions.alcMakeContextCurrent == NULL
+		|| functions.alcDestroyContext == NULL) {
+		results.errors.push_back("OpenAL is missing functions needed to probe the devices");
 	} else {
-		wxLogError(_T("OpenAL:%ld: Unknown error number 0x%08x"), line, errorcode);
+		ProbeDevices(ALC_DEVICE_SPECIFIER, results.playbackDevices, results);
+		ProbeDevices(ALC_CAPTURE_DEVICE_SPECIFIER, results.captureDevices, results);
+		results.defaultPlaybackDevice =
+			ProbeDefaultDevice(ALC_DEFAULT_DEVICE_SPECIFIER, results);
+		results.defaultCaptureDevice =
+			ProbeDefaultDevice(ALC_CAPTURE_DEFAULT_DEVICE_SPECIFIER, results);
+		ProbeVersion(results);
+		ProbeEFX(results);
 	}
-	return false;
+
+	wxCommandEvent event(EVT_OPENAL_PROBE_DONE, wxID_NONE);
+	handler->AddPendingEvent(event);
+}
+
+static wxArrayString ToArrayString(const std::vector<std::string>& strings) {
+	wxArrayString arr;
+	for (std::vector<std::string>::const_iterator it = strings.begin(),
+			end = strings.end(); it != end; ++it) {
+		arr.Add(wxString(it->c_str(), *wxConvCurrent));
+	}
+	return arr;
 }
 #endif
 
+void OpenALMan::StartProbe(wxEvtHandler* handler) {
 #if USE_OPENAL
-wxArrayString GetAvailableDevices(const ALenum deviceType) {
-	wxArrayString arr;
-	wxCHECK_MSG(OpenALMan::IsInitialized(), arr,
-		_T("GetAvailableDevices called but OpenALMan not initialized"));
-	
-	wxCHECK_MSG(deviceType == ALC_DEVICE_SPECIFIER ||
-		deviceType == ALC_CAPTURE_DEVICE_SPECIFIER, arr,
-		wxString::Format(_T("GetAvailableDevices given invalid specifier %d"),
-			deviceType));
+	wxCHECK_RET(OpenALMan::IsInitialized(),
+		_T("StartProbe called but OpenALMan not initialized"));
+	wxCHECK_RET(handler != NULL, _T("StartProbe called without a handler"));
 
-	ALenum adjustedDeviceType = deviceType;
-	
-	alcIsExtensionPresentType isExtensionPresent =
-		GetOALFuncPtr(alcIsExtensionPresentType, alcIsExtensionPresent);
+	// cached for this library and its modification time, so nothing to probe
+	if (hasCapabilities || probeState != PROBE_NOT_STARTED) {
+		return;
+	}
+	probeState = PROBE_RUNNING;
+	probeThread = std::thread(&OpenALMan::RunProbe, handler);
+#endif
+}
 
-	if ( isExtensionPresent != NULL ) {
-		if ( (*isExtensionPresent)(NULL, "ALC_ENUMERATION_EXT") != AL_TRUE ) {
-			wxLogFatalError(_T("OpenAL does not seem to support device enumeration."));
-			return arr;
-		}
-	} else {
-		return arr;
+bool OpenALMan::FinishProbe() {
+#if USE_OPENAL
+	if (probeState != PROBE_RUNNING) {
+		return false;
+	}
+	if (probeThread.joinable()) {
+		probeThread.join();
 	}
+	probeState = PROBE_DONE;
 
-	if ((deviceType == ALC_DEVICE_SPECIFIER) &&
-			(*isExtensionPresent)(NULL, "ALC_ENUMERATE_ALL_EXT") == AL_TRUE) {
-		adjustedDeviceType = ALC_ALL_DEVICES_SPECIFIER;
+	for (std::vector<std::string>::const_iterator it = probeResults.errors.begin(),
+			end = probeResults.errors.end(); it != end; ++it) {
+		wxLogError(_T("%s"), wxString(it->c_str(), *wxConvCurrent).c_str());
 	}
-	
-	alcGetStringType GetString = GetOALFuncPtr(alcGetStringType, alcGetString);
-
-	if ( GetString != NULL ) {
-		const ALCchar* devices = (*GetString)(NULL, adjustedDeviceType);
-		if ( devices != NULL ) {
-			size_t len;
-			size_t offset = 0;
-			do {
-				len = strlen(devices+offset);
-				if ( len > 0 ) {
-					wxString device(devices+offset, *wxConvCurrent);
-					arr.Add(device);
-				}
-				offset += len+1;
-			} while ( len != 0 );
-		} else {
-			wxLogError(_T("OpenAL gave NULL for list of devices."));
-			return arr;
-		}
-	} else {
-		return arr;
+
+	Capabilities probed;
+	probed.playbackDevices = ToArrayString(probeResults.playbackDevices);
+	probed.captureDevices = ToArrayString(probeResults.captureDevices);
+	probed.defaultPlaybackDevice =
+		wxString(probeResults.defaultPlaybackDevice.c_str(), *wxConvCurrent);
+	probed.defaultCaptureDevice =
+		wxString(probeResults.defaultCaptureDevice.c_str(), *wxConvCurrent);
+	probed.version = wxString(probeResults.version.c_str(), wxConvUTF8);
+	probed.efxDevices = ToArrayString(probeResults.efxDevices);
+	probeResults = ProbeResults();
+
+	const bool isChanged = !hasCapabilities || !(probed == capabilities);
+	capabilities = probed;
+	hasCapabilities = true;
+	if (isChanged) {
+		wxLogDebug(_T("OpenAL devices have changed since they were cached"));
+		SaveCachedCapabilities();
 	}
-	return arr;
+	return isChanged;
+#else
+	return false;
+#endif
 }
+
+bool OpenALMan::HasCapabilities() {
+#if USE_OPENAL
+	return hasCapabilities;
+#else
+	return false;
 #endif
+}
 
 wxArrayString OpenALMan::GetAvailablePlaybackDevices() {
 #if USE_OPENAL
 	wxCHECK_MSG(OpenALMan::IsInitialized(), wxArrayString(),
 		_T("GetAvailablePlaybackDevices called but OpenALMan not initialized"));
-	return GetAvailableDevices(ALC_DEVICE_SPECIFIER);
+	return capabilities.playbackDevices;
 #else
 	return wxArrayString();
 #endif	
@@ -245,61 +551,17 @@ wxArrayString OpenALMan::GetAvailableCaptureDevices() {
 #if USE_OPENAL
 	wxCHECK_MSG(OpenALMan::IsInitialized(), wxArrayString(),
 		_T("GetAvailableCaptureDevices called but OpenALMan not initialized"));
-	return GetAvailableDevices(ALC_CAPTURE_DEVICE_SPECIFIER);
+	return capabilities.captureDevices;
 #else
 	return wxArrayString();
 #endif
 }
 
-#if USE_OPENAL
-wxString GetSystemDefaultDevice(const ALenum deviceType) {
-	wxCHECK_MSG( OpenALMan::IsInitialized(), wxEmptyString,
-		_T("GetSystemDefaultDevice called but OpenALMan not initialized"));
-	wxCHECK_MSG(deviceType == ALC_DEFAULT_DEVICE_SPECIFIER ||
-		deviceType == ALC_CAPTURE_DEFAULT_DEVICE_SPECIFIER, wxEmptyString,
-		wxString::Format(_T("GetSystemDefaultDevice given invalid specifier %d"),
-			deviceType));
-	
-	ALenum adjustedDeviceType = deviceType;
-	
-	alcIsExtensionPresentType isExtensionPresent =
-		GetOALFuncPtr(alcIsExtensionPresentType, alcIsExtensionPresent);
-	
-	if ((isExtensionPresent != NULL) &&
-		(deviceType == ALC_DEFAULT_DEVICE_SPECIFIER) &&
-		((*isExtensionPresent)(NULL, "ALC_ENUMERATE_ALL_EXT") == AL_TRUE)) {
-			adjustedDeviceType = ALC_DEFAULT_ALL_DEVICES_SPECIFIER;
-	}
-	
-	alcGetStringType GetString = GetOALFuncPtr(alcGetStringType, alcGetString);
-
-	if ( GetString == NULL ) {
-		return wxEmptyString;
-	} else {
-		const ALCchar* defaultDevice = (*GetString)(NULL, adjustedDeviceType);
-		if ( defaultDevice == NULL ) {
-			wxLogError(_("Unable to get system default OpenAL %sdevice"),
-				(deviceType == ALC_CAPTURE_DEFAULT_DEVICE_SPECIFIER ?
-					_T("capture ") : wxEmptyString));
-			return wxEmptyString;
-		} else {
-			wxString defaultDeviceStr(defaultDevice, *wxConvCurrent);
-			wxLogDebug(_("System default OpenAL %sdevice: %s"),
-				(deviceType == ALC_CAPTURE_DEFAULT_DEVICE_SPECIFIER ?
-					_T("capture ") : wxEmptyString),
-				defaultDeviceStr.c_str());
-			return defaultDeviceStr;
-		}
-	}
-	return wxEmptyString;
-}
-#endif
-
 wxString OpenALMan::GetSystemDefaultPlaybackDevice() {
 #if USE_OPENAL
 	wxCHECK_MSG(OpenALMan::IsInitialized(), wxEmptyString,
 		_T("GetSystemDefaultPlaybackDevice called but OpenALMan not initialized"));
-	return GetSystemDefaultDevice(ALC_DEFAULT_DEVICE_SPECIFIER);
+	return capabilities.defaultPlaybackDevice;
 #else
 	return wxEmptyString;
 #endif
@@ -309,7 +571,7 @@ wxString OpenALMan::GetSystemDefaultCaptureDevice() {
 #if USE_OPENAL
 	wxCHECK_MSG(OpenALMan::IsInitialized(), wxEmptyString,
 		_T("GetSystemDefaultCaptureDevice called but OpenALMan not initialized"));
-	return GetSystemDefaultDevice(ALC_CAPTURE_DEFAULT_DEVICE_SPECIFIER);
+	return capabilities.defaultCaptureDevice;
 #else
 	return wxEmptyString;
 #endif
@@ -318,84 +580,18 @@ wxString OpenALMan::GetSystemDefaultCaptureDevice() {
 
 wxString OpenALMan::GetCurrentVersion() {
 #if USE_OPENAL
-	alGetStringType GetString = GetOALFuncPtr(alGetStringType,alGetString);
-
-	if ( GetString == NULL ) {
+	wxCHECK_MSG(OpenALMan::IsInitialized(), _("Unknown version"),
+		_T("GetCurrentVersion called but OpenALMan not initialized"));
+	if ( capabilities.version.IsEmpty() ) {
 		return _("Unknown version");
 	}
-	
-	wxString selectedDevice;
-	ProMan::GetProfileManager()->ProfileRead(PRO_CFG_OPENAL_DEVICE, &selectedDevice);
-
-	alcOpenDeviceType OpenDevice = 
-		GetOALFuncPtr(alcOpenDeviceType,alcOpenDevice);
-	if ( OpenDevice == NULL) {
-		return _("Unable to get open device function");
-	}
-
-	ALCdevice* device = (*OpenDevice)(selectedDevice.char_str());
-	if ( device == NULL) {
-		wxLogError(_T("alcOpenDevice returned NULL for selected device '%s'"),
-			selectedDevice.c_str());
-		return _("Error opening device");
-	}
-
-	alcCreateContextType CreateContext =
-		GetOALFuncPtr(alcCreateContextType,alcCreateContext);
-	if ( CreateContext == NULL) {
-		return _("Unable to get open context on device function");
-	}
-
-	ALCint attributes = 0;
-	ALCcontext* context = (*CreateContext)(device,NULL);
-	if ( context == NULL) {
-		return _("Error in opening context");
-	}
-
-	alcMakeContextCurrentType MakeContextCurrent =
-		GetOALFuncPtr(alcMakeContextCurrentType,alcMakeContextCurrent);
-	if ( MakeContextCurrent == NULL) {
-		return _("Unable to get the set context as current function");
-	}
-
-	if ( (*MakeContextCurrent)(context) != ALC_TRUE || checkForALError() == false ) {
-		return _("Error in setting context as current");
-	}
-	
-	const ALCchar* version = (*GetString)(AL_VERSION);
-	if ( !checkForALError() || version == NULL ) {
-		wxLogError(_T("OpenAL: Unable to retrieve Version String"));
-		return _("Unknown version");
-	}
-	wxString Version(version, wxConvUTF8);
-
-	// unset the current context
-	(*MakeContextCurrent)(NULL);
-
-	alcDestroyContextType DestroyContext =
-		GetOALFuncPtr(alcDestroyContextType,alcDestroyContext);
-	if ( DestroyContext == NULL ) {
-		return _("Unable to destroy context");
-	}
-
-	(*DestroyContext)(context);
-	context = NULL;
-
-	alcCloseDeviceType CloseDevice =
-		GetOALFuncPtr(alcCloseDeviceType,alcCloseDevice);
-	if ( CloseDevice == NULL ) {
-		return _("Unable to close device");
-	}
-
-	(*CloseDevice)(device);
-
-	return wxString::Format(_("Detected OpenAL version: %s"), Version.c_str());
+	return wxString::Format(_("Detected OpenAL version: %s"),
+		capabilities.version.c_str());
 #else
 	return wxEmptyString;
 #endif
 }
 
-// bits are adapted from GetCurrentVersion() and FSO, sound/ds.cpp, ds_init()
 bool OpenALMan::IsEFXSupported(const wxString& playbackDeviceName) {
 #if USE_OPENAL
 	wxCHECK_MSG( OpenALMan::IsInitialized(), false,
@@ -406,45 +602,7 @@ bool OpenALMan::IsEFXSupported(const wxString& playbackDeviceName) {
 		return false;
 	}
 	
-	alcOpenDeviceType OpenDevice = 
-		GetOALFuncPtr(alcOpenDeviceType, alcOpenDevice);
-
-	if (OpenDevice == NULL) {
-		wxLogError(_T("IsEFXSupported: Unable to open device."));
-		return false;
-	}
-
-	ALCdevice* playbackDevice = (*OpenDevice)(playbackDeviceName.char_str());
-	
-	if (playbackDevice == NULL) {
-		wxLogError(
-			_T("IsEFXSupported: alcOpenDevice returned NULL when opening device '%s'"),
-			playbackDeviceName.c_str());
-		return false;
-	}
-
-	alcIsExtensionPresentType isExtensionPresent =
-		GetOALFuncPtr(alcIsExtensionPresentType, alcIsExtensionPresent);
-	
-	if (isExtensionPresent == NULL) {
-		wxLogError(
-			_T("IsEFXSupported: Could not get alcIsExtensionPresent function."));
-		return false;
-	}
-	
-	bool hasEFX = (*isExtensionPresent)(playbackDevice, "ALC_EXT_EFX") == AL_TRUE;
-
-	alcCloseDeviceType CloseDevice =
-		GetOALFuncPtr(alcCloseDeviceType, alcCloseDevice);
-	
-	if (CloseDevice == NULL) {
-		wxLogError(_T("IsEFXSupported: Unable to close device."));
-		return false;
-	}
-
-	(*CloseDevice)(playbackDevice);
-
-	return hasEFX;
+	return capabilities.efxDevices.Index(playbackDeviceName) != wxNOT_FOUND;
 #else
 	return false;
 #endif
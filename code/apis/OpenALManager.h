@@ -21,16 +21,36 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 #include <wx/wx.h>
 
+#include "apis/EventHandlers.h"
+
 #if wxUSE_DYNLIB_CLASS == 0 && USE_OPENAL == 1
 #error Cannot compile OPENAL into launcher if wxWidgets has wxUSE_DYNLIB_CLASS set to 0
 #endif
 
+/** A probe started by OpenALMan::StartProbe() has finished. Call
+ OpenALMan::FinishProbe() to use its results. */
+LAUNCHER_DECLARE_EVENT_TYPE(EVT_OPENAL_PROBE_DONE);
+
 namespace OpenALMan {
 	bool Initialize();
 	bool DeInitialize();
 	bool WasCompiledIn();
 	bool IsInitialized();
 	
+	/** Starts probing the devices and their EFX support on a worker thread,
+	 unless they are already known from the cache, which holds for as long as
+	 the library's path and modification time don't change, or from an
+	 earlier probe. handler is sent EVT_OPENAL_PROBE_DONE when it finishes. */
+	void StartProbe(wxEvtHandler* handler);
+	/** Waits for the probe, then makes its results current and caches
+	 them. Returns true if they differ from what was known before. */
+	bool FinishProbe();
+	/** Returns true if the device information below is known, from the
+	 cache or a finished probe. */
+	bool HasCapabilities();
+	
+	/** These never wait for a probe: until HasCapabilities(), they return
+	 empty lists and strings, and no device supports EFX. */
 	wxArrayString GetAvailablePlaybackDevices();
 	wxArrayString GetAvailableCaptureDevices();
 	
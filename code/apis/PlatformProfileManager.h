@@ -21,12 +21,13 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include <wx/fileconf.h>
 #include "apis/ProfileManager.h"
 
-ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg);
+/** The push functions write out the current profile of proman. */
+ProMan::RegistryCodes RegistryPushProfile(ProMan* proman);
 ProMan::RegistryCodes RegistryPullProfile(wxFileConfig *cfg);
 
-ProMan::RegistryCodes FilePushProfile(wxFileConfig *cfg);
+ProMan::RegistryCodes FilePushProfile(ProMan* proman);
 ProMan::RegistryCodes FilePullProfile(wxFileConfig *cfg);
 
-ProMan::RegistryCodes PushCmdlineFSO(wxFileConfig *cfg);
+ProMan::RegistryCodes PushCmdlineFSO(ProMan* proman);
 
 #endif
\ No newline at end of file
@@ -23,17 +23,16 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "generated/configure_launcher.h"
 #include "apis/PlatformProfileManager.h"
 #include "controls/LightingPresets.h"
-#include "global/ProfileKeys.h"
 
-ProMan::RegistryCodes PushCmdlineFSO(wxFileConfig *cfg) {
+ProMan::RegistryCodes PushCmdlineFSO(ProMan* proman) {
 	wxString modLine, flagLine, tcPath;
-	cfg->Read(PRO_CFG_TC_CURRENT_MODLINE, &modLine);
-	cfg->Read(PRO_CFG_TC_CURRENT_FLAG_LINE, &flagLine);
-	cfg->Read(PRO_CFG_TC_ROOT_FOLDER, &tcPath);
+	proman->ProfileRead(PKEY_TC_CURRENT_MODLINE, &modLine);
+	proman->ProfileRead(PKEY_TC_CURRENT_FLAG_LINE, &flagLine);
+	proman->ProfileRead(PKEY_TC_ROOT_FOLDER, &tcPath);
 	
 	wxString presetName;
 	wxString lightingPresetFlagSet;
-	if (cfg->Read(PRO_CFG_LIGHTING_PRESET, &presetName)) {
+	if (proman->ProfileRead(PKEY_LIGHTING_PRESET, &presetName)) {
 		lightingPresetFlagSet = LightingPresets::PresetNameToPresetFlagSet(presetName);
 	}
 
@@ -0,0 +1,254 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#include <algorithm>
+
+#include <wx/wx.h>
+#include <wx/tokenzr.h>
+
+#include "apis/ProcessPriority.h"
+#include "apis/ProfileManager.h"
+#include "generated/configure_launcher.h"
+#include "global/BasicDefaults.h"
+
+#if IS_LINUX
+#include <dirent.h>
+#include <errno.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "global/MemoryDebugging.h"
+
+/** CPU numbers above this are refused, as they don't fit a cpu_set_t. */
+const int MAX_CPU_NUMBER = 1023;
+
+LaunchPriority::LaunchPriority()
+: cpus(DEFAULT_LAUNCH_CPU_AFFINITY), nice(DEFAULT_LAUNCH_NICE),
+  ioClass(DEFAULT_LAUNCH_IO_CLASS), ioPriority(DEFAULT_LAUNCH_IO_PRIORITY) {
+}
+
+bool ProcessPriority::IsSupported() {
+#if IS_LINUX
+	return true;
+#else
+	return false;
+#endif
+}
+
+LaunchPriority ProcessPriority::ReadFromProfile() {
+	ProMan* proman = ProMan::GetProfileManager();
+	LaunchPriority priority;
+	proman->ProfileRead(PKEY_LAUNCH_CPU_AFFINITY, &priority.cpus);
+	proman->ProfileRead(PKEY_LAUNCH_NICE, &priority.nice);
+	proman->ProfileRead(PKEY_LAUNCH_IO_CLASS, &priority.ioClass);
+	proman->ProfileRead(PKEY_LAUNCH_IO_PRIORITY, &priority.ioPriority);
+	return priority;
+}
+
+bool ProcessPriority::ParseCpuList(const wxString& cpus, std::vector<int>& cpuNumbers) {
+	cpuNumbers.clear();
+	wxStringTokenizer tokens(cpus, _T(","), wxTOKEN_STRTOK);
+	while (tokens.HasMoreTokens()) {
+		wxString token(tokens.GetNextToken());
+		token.Trim(true).Trim(false);
+		if (token.IsEmpty()) {
+			continue;
+		}
+		long first, last;
+		const int dash = token.Find(_T('-'));
+		if (dash == wxNOT_FOUND) {
+			if (!token.ToLong(&first)) {
+				return false;
+			}
+			last = first;
+		} else if (!token.Left(dash).Trim(true).ToLong(&first)
+			|| !token.Mid(dash + 1).Trim(false).ToLong(&last)) {
+			return false;
+		}
+		if (first < 0 || last < first || last > MAX_CPU_NUMBER) {
+			return false;
+		}
+		for (long cpu = first; cpu <= last; ++cpu) {
+			cpuNumbers.push_back(static_cast<int>(cpu));
+		}
+	}
+	std::sort(cpuNumbers.begin(), cpuNumbers.end());
+	cpuNumbers.erase(std::unique(cpuNumbers.begin(), cpuNumbers.end()), cpuNumbers.end());
+	return true;
+}
+
+wxString ProcessPriority::FormatCpuList(const std::vector<int>& cpuNumbers) {
+	wxString formatted;
+	for (size_t i = 0; i < cpuNumbers.size(); ) {
+		size_t last = i;
+		while (last + 1 < cpuNumbers.size() && cpuNumbers[last + 1] == cpuNumbers[last] + 1) {
+			++last;
+		}
+		if (!formatted.IsEmpty()) {
+			formatted += _T(",");
+		}
+		formatted += (last == i) ?
+			wxString::Format(_T("%d"), cpuNumbers[i]) :
+			wxString::Format(_T("%d-%d"), cpuNumbers[i], cpuNumbers[last]);
+		i = last + 1;
+	}
+	return formatted;
+}
+
+#if IS_LINUX
+// from linux/ioprio.h, which the C library doesn't wrap
+const int IOPRIO_CLASS_SHIFT = 13;
+const int IOPRIO_PRIORITY_MASK = (1 << IOPRIO_CLASS_SHIFT) - 1;
+const int IOPRIO_WHO_PROCESS = 1;
+
+static wxString FormatIOPriority(int value) {
+	const int ioClass = value >> IOPRIO_CLASS_SHIFT;
+	const int level = value & IOPRIO_PRIORITY_MASK;
+	switch (ioClass) {
+		case LAUNCH_IO_CLASS_REALTIME:
+			return wxString::Format(_T("realtime %d"), level);
+		case LAUNCH_IO_CLASS_BEST_EFFORT:
+			return wxString::Format(_T("best effort %d"), level);
+		case LAUNCH_IO_CLASS_IDLE:
+			return _T("idle");
+		default:
+			return _T("default");
+	}
+}
+
+/** The ids of the process's threads, or just pid if they can't be listed. */
+static std::vector<pid_t> ListThreads(long pid) {
+	std::vector<pid_t> threads;
+	const wxCharBuffer folder(wxString::Format(_T("/proc/%ld/task"), pid).fn_str());
+	DIR* dir = opendir(folder.data());
+	if (dir != NULL) {
+		struct dirent* entry;
+		while ((entry = readdir(dir)) != NULL) {
+			char* end;
+			const long thread = strtol(entry->d_name, &end, 10);
+			if (*end == '\0' && thread > 0) {
+				threads.push_back(static_cast<pid_t>(thread));
+			}
+		}
+		closedir(dir);
+	}
+	if (threads.empty()) {
+		threads.push_back(static_cast<pid_t>(pid));
+	}
+	return threads;
+}
+
+static void LogFailure(const wxString& what, const wxString& name, int error) {
+	wxString hint;
+	if (error == EPERM || error == EACCES) {
+		hint = _T(" Raising a priority needs the CAP_SYS_NICE capability or a higher RLIMIT_NICE.");
+	}
+	wxLogWarning(_T("Unable to set the %s of %s: %s.%s"),
+		what.c_str(), name.c_str(), wxSysErrorMsg(error), hint.c_str());
+}
+#endif
+
+void ProcessPriority::Apply(long pid, const wxString& name, const LaunchPriority& priority) {
+#if IS_LINUX
+	bool isAffinitySet = !priority.cpus.IsEmpty();
+	cpu_set_t cpuSet;
+	CPU_ZERO(&cpuSet);
+	if (isAffinitySet) {
+		std::vector<int> cpuNumbers;
+		if (!ParseCpuList(priority.cpus, cpuNumbers) || cpuNumbers.empty()) {
+			wxLogWarning(_T("The CPU list '%s' is not valid, so %s may use every CPU."),
+				priority.cpus.c_str(), name.c_str());
+			isAffinitySet = false;
+		}
+		for (size_t i = 0; i < cpuNumbers.size(); ++i) {
+			CPU_SET(cpuNumbers[i], &cpuSet);
+		}
+	}
+	const bool isNiceSet = priority.nice != 0;
+	const bool isIOSet = priority.ioClass >= LAUNCH_IO_CLASS_REALTIME
+		&& priority.ioClass <= LAUNCH_IO_CLASS_IDLE;
+	const long ioLevel = std::min(std::max(priority.ioPriority, 0L), LAUNCH_IO_PRIORITY_LOWEST);
+	const int ioValue = static_cast<int>((priority.ioClass << IOPRIO_CLASS_SHIFT)
+		| ((priority.ioClass == LAUNCH_IO_CLASS_IDLE) ? 0 : ioLevel));
+
+	int affinityError = 0, niceError = 0, ioError = 0;
+	if (isAffinitySet || isNiceSet || isIOSet) {
+		const std::vector<pid_t> threads(ListThreads(pid));
+		for (size_t i = 0; i < threads.size(); ++i) {
+			// a thread that has exited since it was listed is not a failure
+			if (isAffinitySet && sched_setaffinity(threads[i], sizeof(cpuSet), &cpuSet) != 0
+				&& errno != ESRCH) {
+				affinityError = errno;
+			}
+			if (isNiceSet && setpriority(PRIO_PROCESS, threads[i], priority.nice) != 0
+				&& errno != ESRCH) {
+				niceError = errno;
+			}
+			if (isIOSet && syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, threads[i], ioValue) != 0
+				&& errno != ESRCH) {
+				ioError = errno;
+			}
+		}
+	}
+	if (affinityError != 0) {
+		LogFailure(_T("CPU affinity"), name, affinityError);
+	}
+	if (niceError != 0) {
+		LogFailure(_T("nice level"), name, niceError);
+	}
+	if (ioError != 0) {
+		LogFailure(_T("I/O priority"), name, ioError);
+	}
+
+	// what the process has now, which may not be what was asked for
+	wxString cpus(_T("unknown"));
+	cpu_set_t actualSet;
+	CPU_ZERO(&actualSet);
+	if (sched_getaffinity(static_cast<pid_t>(pid), sizeof(actualSet), &actualSet) == 0) {
+		std::vector<int> cpuNumbers;
+		for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+			if (CPU_ISSET(cpu, &actualSet)) {
+				cpuNumbers.push_back(cpu);
+			}
+		}
+		cpus = FormatCpuList(cpuNumbers);
+	}
+	wxString nice(_T("unknown"));
+	errno = 0;
+	const int actualNice = getpriority(PRIO_PROCESS, static_cast<id_t>(pid));
+	if (errno == 0) {
+		nice = wxString::Format(_T("%d"), actualNice);
+	}
+	wxString io(_T("unknown"));
+	const long actualIO = syscall(SYS_ioprio_get, IOPRIO_WHO_PROCESS, static_cast<pid_t>(pid));
+	if (actualIO >= 0) {
+		io = FormatIOPriority(static_cast<int>(actualIO));
+	}
+
+	wxLogInfo(_T("%s (pid %ld) runs on CPUs %s at nice level %s with %s I/O priority"),
+		name.c_str(), pid, cpus.c_str(), nice.c_str(), io.c_str());
+#else
+	wxUnusedVar(pid);
+	wxUnusedVar(name);
+	wxUnusedVar(priority);
+#endif
+}
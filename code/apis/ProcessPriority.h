@@ -0,0 +1,71 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#ifndef PROCESSPRIORITY_H
+#define PROCESSPRIORITY_H
+
+#include <vector>
+
+#include <wx/wx.h>
+
+/** The I/O scheduling classes, numbered as Linux's ioprio_set() numbers
+ them. */
+enum LaunchIOClass {
+	LAUNCH_IO_CLASS_DEFAULT = 0, //!< left to the kernel, which follows the nice level
+	LAUNCH_IO_CLASS_REALTIME,
+	LAUNCH_IO_CLASS_BEST_EFFORT,
+	LAUNCH_IO_CLASS_IDLE
+};
+
+/** The lowest of the I/O priorities within a class; 0 is the highest. */
+const long LAUNCH_IO_PRIORITY_LOWEST = 7;
+const long LAUNCH_NICE_HIGHEST = -20;
+const long LAUNCH_NICE_LOWEST = 19;
+
+/** How the game is to be scheduled, as set in the profile. */
+struct LaunchPriority {
+	LaunchPriority();
+
+	wxString cpus; //!< CPU list such as "0-3,6", empty for every CPU
+	long nice; //!< 0 leaves the game at the launcher's nice level
+	long ioClass; //!< a LaunchIOClass
+	long ioPriority; //!< for the realtime and best effort classes
+};
+
+/** ProcessPriority - applies the profile's CPU affinity, nice level and I/O
+ priority to the game. wxExecute() offers no way to run code between fork
+ and exec, so they are set on the new process right after it is spawned,
+ on each of its threads, and are inherited by the threads it starts later.
+ What the process ends up with is read back and logged. Only Linux is
+ supported; elsewhere Apply() does nothing. */
+class ProcessPriority {
+public:
+	static bool IsSupported();
+	static LaunchPriority ReadFromProfile();
+	/** Parses a CPU list such as "0-3,6" into CPU numbers, in order and
+	 without repeats. Returns false if the list is malformed. An empty list
+	 is valid and has no CPUs. */
+	static bool ParseCpuList(const wxString& cpus, std::vector<int>& cpuNumbers);
+	/** Turns CPU numbers, in order, back into a CPU list. */
+	static wxString FormatCpuList(const std::vector<int>& cpuNumbers);
+	/** Applies priority to the process pid, called name in the log. */
+	static void Apply(long pid, const wxString& name, const LaunchPriority& priority);
+};
+
+#endif
@@ -27,6 +27,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include <wx/dir.h>
 
 #include "generated/configure_launcher.h"
+#include "apis/EventDispatcher.h"
 #include "apis/EventHandlers.h"
 #include "apis/ProfileManager.h"
 #include "apis/PlatformProfileManager.h"
@@ -52,25 +53,13 @@ LAUNCHER_DEFINE_EVENT_TYPE(EVT_CURRENT_PROFILE_CHANGED);
 void ProMan::GenerateChangeEvent() {
 	wxCommandEvent event(EVT_PROFILE_CHANGE, wxID_NONE);
 	wxLogDebug(wxT_2("Generating profile change event"));
-	EventHandlers::iterator iter = this->eventHandlers.begin();
-	while (iter != this->eventHandlers.end()) {
-		wxEvtHandler* current = *iter;
-		current->AddPendingEvent(event);
-		wxLogDebug(wxT_2(" Sent Profile Change event to %p"), current);
-		iter++;
-	}
+	EventDispatcher::Post(this->eventHandlers, event);
 }
 
 void ProMan::GenerateCurrentProfileChangedEvent() {
 	wxCommandEvent event(EVT_CURRENT_PROFILE_CHANGED, wxID_NONE);
 	wxLogDebug(wxT_2("Generating current profile changed event"));
-	EventHandlers::iterator iter = this->eventHandlers.begin();
-	while (iter != this->eventHandlers.end()) {
-		wxEvtHandler* current = *iter;
-		current->AddPendingEvent(event);
-		wxLogDebug(wxT_2(" Sent current profile changed event to %p"), current);
-		iter++;
-	} 
+	EventDispatcher::Post(this->eventHandlers, event);
 }
 
 void ProMan::AddEventHandler(wxEvtHandler *handler) {
@@ -89,8 +78,10 @@ void ProMan::RemoveEventHandler(wxEvtHandler *handler) {
 	this->eventHandlers.DeleteObject(handler);
 }
 
-NewsData::NewsData(const wxString& theNews, const wxDateTime& lastDownloadNews)
-: theNews(theNews), lastDownloadNews(lastDownloadNews) {
+NewsData::NewsData(const wxString& theNews, const wxDateTime& lastDownloadNews,
+	const wxString& etag, const wxString& lastModified)
+: theNews(theNews), lastDownloadNews(lastDownloadNews),
+etag(etag), lastModified(lastModified) {
 	wxASSERT(!theNews.IsEmpty());
 	wxASSERT(lastDownloadNews.IsValid());
 }
@@ -225,6 +216,11 @@ ProMan::ProMan() {
 	this->globalProfile = NULL;
 	this->isAutoSaving = true;
 	this->currentProfile = NULL;
+	this->currentProfileGeneration = 0;
+	this->profileValueCacheGeneration = 0;
+	for (int i = 0; i < PROFILE_KEY_COUNT; ++i) {
+		this->profileValueCache[i].isCached = false;
+	}
 	
 	this->privateCopyFilename = wxFileName::CreateTempFileName(wxT_2("wxLtest"));
 	wxFFileInputStream instream(this->privateCopyFilename);
@@ -233,6 +229,8 @@ ProMan::ProMan() {
 
 /** Destructor. */
 ProMan::~ProMan() {
+	EventDispatcher::Discard(this->eventHandlers);
+
 	// don't leak the wxFileConfigs
 	ProfileMap::iterator iter = this->profiles.begin();
 	while ( iter != this->profiles.end() ) {
@@ -310,7 +308,9 @@ void ProMan::LoadNewsMapFromGlobalProfile() {
 			if ((!theNews.IsEmpty()) &&
 				(NULL != lastDownloadNews.ParseFormat(
 					lastDownloadNewsStr, NEWS_LAST_TIME_FORMAT))) {
-				newsMap[groupName] = NewsData(theNews, lastDownloadNews);
+				newsMap[groupName] = NewsData(theNews, lastDownloadNews,
+					globalProfile->Read(GBL_CFG_NET_NEWS_ETAG, wxEmptyString),
+					globalProfile->Read(GBL_CFG_NET_NEWS_LAST_MODIFIED, wxEmptyString));
 				
 				wxLogDebug(wxT_2("Created news map entry for source %s"),
 					groupName.c_str());
@@ -337,6 +337,8 @@ void ProMan::SaveNewsMapToGlobalProfile() {
 		globalProfile->Write(GBL_CFG_NET_THE_NEWS, newsData.theNews);
 		globalProfile->Write(GBL_CFG_NET_NEWS_LAST_TIME,
 			newsData.lastDownloadNews.Format(NEWS_LAST_TIME_FORMAT));
+		globalProfile->Write(GBL_CFG_NET_NEWS_ETAG, newsData.etag);
+		globalProfile->Write(GBL_CFG_NET_NEWS_LAST_MODIFIED, newsData.lastModified);
 		globalProfile->SetPath(wxT_2(".."));
 	}
 	
@@ -639,6 +641,7 @@ bool ProMan::ProfileRead(const wxString& key, bool* b, bool defaultVal, bool wri
 			wxLogDebug(wxT_2("entry %s in current profile is absent. writing default value %s to it."),
 				key.c_str(), defaultVal ? wxT_2("true") : wxT_2("false"));
 			this->currentProfile->Write(key, defaultVal);
+			this->currentProfileGeneration++;
 		}
 		return readSuccess;
 	}
@@ -673,6 +676,7 @@ bool ProMan::ProfileRead(const wxString& key, wxString* str, const wxString& def
 			wxLogDebug(wxT_2("entry %s in current profile is absent. writing default value %s to it."),
 				key.c_str(), defaultVal.c_str());
 			this->currentProfile->Write(key, defaultVal);
+			this->currentProfileGeneration++;
 		}
 		return readSuccess;
 	}
@@ -707,6 +711,7 @@ bool ProMan::ProfileRead(const wxString& key, long* l, long defaultVal, bool wri
 			wxLogDebug(wxT_2("entry %s in current profile is absent. writing default value %ld to it."),
 				key.c_str(), defaultVal);
 			this->currentProfile->Write(key, defaultVal);
+			this->currentProfileGeneration++;
 		}
 		return readSuccess;
 	}
@@ -730,6 +735,7 @@ bool ProMan::ProfileWrite(const wxString& key, const wxString& value) {
 					oldValue.c_str(), value.c_str(), key.c_str());
 			}
 		}
+		this->currentProfileGeneration++;
 		return this->currentProfile->Write(key, value);
 	}
 }
@@ -752,6 +758,7 @@ bool ProMan::ProfileWrite(const wxString& key, const wxChar* value) {
 						   oldValue.c_str(), value, key.c_str());
 			}
 		}
+		this->currentProfileGeneration++;
 		return this->currentProfile->Write(key, value);
 	}
 }
@@ -774,6 +781,7 @@ bool ProMan::ProfileWrite(const wxString& key, long value) {
 					oldValue, value, key.c_str());
 			}
 		}
+		this->currentProfileGeneration++;
 		return this->currentProfile->Write(key, value);
 	}
 }
@@ -799,6 +807,7 @@ bool ProMan::ProfileWrite(const wxString& key, bool value) {
 			}
 		}
 		
+		this->currentProfileGeneration++;
 		return this->currentProfile->Write(key, value);
 	}
 }
@@ -816,10 +825,158 @@ bool ProMan::ProfileDeleteEntry(const wxString& key, bool bDeleteGroupIfEmpty) {
 			wxLogDebug(wxT_2("deleting key %s in profile"),
 				key.c_str());
 		}
+		this->currentProfileGeneration++;
 		return this->currentProfile->DeleteEntry(key, bDeleteGroupIfEmpty);
 	}
 }
 
+bool ProMan::ProfileReadFrom(const wxString& profileName, const wxString& key,
+		wxString* str) const {
+	ProfileMap::const_iterator iter = this->profiles.find(profileName);
+	if (iter == this->profiles.end()) {
+		wxLogWarning(wxT_2("attempt to read string for key %s from nonexistent profile %s"),
+			key.c_str(), profileName.c_str());
+		return false;
+	}
+	return iter->second->Read(key, str);
+}
+
+/** Returns the cached value for a key in PROFILE_KEY_TABLE, reading it from
+ the current profile if the cache doesn't have it. The whole cache is dropped
+ whenever the current profile's generation has moved on, since a write through
+ a string key can't tell which entry it touched without parsing the key.
+ Returns NULL if there is no current profile or the type doesn't match. */
+const ProMan::CachedProfileValue* ProMan::GetCachedProfileValue(
+		ProfileKeyId key, ProfileKeyType type) {
+	wxCHECK_MSG(key >= 0 && key < PROFILE_KEY_COUNT, NULL,
+		wxString::Format(wxT_2("invalid profile key id %d"), static_cast<int>(key)));
+	const ProfileKeyDescriptor& desc = GetProfileKeyDescriptor(key);
+	wxCHECK_MSG(desc.type == type, NULL,
+		wxString::Format(wxT_2("profile key %s read or written with the wrong type"),
+			desc.path));
+
+	if (this->currentProfile == NULL) {
+		wxLogWarning(wxT_2("attempt to read key %s from null current profile"),
+			desc.path);
+		return NULL;
+	}
+
+	if (this->profileValueCacheGeneration != this->currentProfileGeneration) {
+		for (int i = 0; i < PROFILE_KEY_COUNT; ++i) {
+			this->profileValueCache[i].isCached = false;
+		}
+		this->profileValueCacheGeneration = this->currentProfileGeneration;
+	}
+
+	CachedProfileValue& value = this->profileValueCache[key];
+	if (!value.isCached) {
+		const wxString path(desc.path);
+		switch (desc.type) {
+			case PROFILE_KEY_BOOL: {
+				bool b;
+				value.isPresent = this->currentProfile->Read(path, &b, desc.defaultLong != 0);
+				value.longValue = b ? 1 : 0;
+				break;
+			}
+			case PROFILE_KEY_LONG:
+				value.isPresent = this->currentProfile->Read(path, &value.longValue, desc.defaultLong);
+				break;
+			case PROFILE_KEY_STRING:
+				value.isPresent = this->currentProfile->Read(path, &value.stringValue,
+					wxString(desc.defaultString));
+				break;
+		}
+		value.isCached = true;
+	}
+	return &value;
+}
+
+/** Stores a value that was just written through a typed ProfileWrite().
+ If the cache was in sync before the write, the write is the only change
+ since then, so the cache stays valid and only this entry is updated. */
+void ProMan::UpdateCachedProfileValue(ProfileKeyId key,
+		unsigned long generationBeforeWrite, long longValue, const wxString& stringValue) {
+	if (this->profileValueCacheGeneration != generationBeforeWrite) {
+		return; // cache was already stale, will be refilled on the next read
+	}
+	this->profileValueCacheGeneration = this->currentProfileGeneration;
+
+	CachedProfileValue& value = this->profileValueCache[key];
+	value.isCached = true;
+	value.isPresent = true;
+	value.longValue = longValue;
+	value.stringValue = stringValue;
+}
+
+bool ProMan::ProfileRead(ProfileKeyId key, bool* b) {
+	const CachedProfileValue* value = this->GetCachedProfileValue(key, PROFILE_KEY_BOOL);
+	if (value == NULL) {
+		return false;
+	}
+	*b = (value->longValue != 0);
+	return value->isPresent;
+}
+
+bool ProMan::ProfileRead(ProfileKeyId key, long* l) {
+	const CachedProfileValue* value = this->GetCachedProfileValue(key, PROFILE_KEY_LONG);
+	if (value == NULL) {
+		return false;
+	}
+	*l = value->longValue;
+	return value->isPresent;
+}
+
+bool ProMan::ProfileRead(ProfileKeyId key, wxString* str) {
+	const CachedProfileValue* value = this->GetCachedProfileValue(key, PROFILE_KEY_STRING);
+	if (value == NULL) {
+		return false;
+	}
+	*str = value->stringValue;
+	return value->isPresent;
+}
+
+bool ProMan::ProfileWrite(ProfileKeyId key, bool value) {
+	wxCHECK_MSG(key >= 0 && key < PROFILE_KEY_COUNT, false,
+		wxString::Format(wxT_2("invalid profile key id %d"), static_cast<int>(key)));
+	wxCHECK_MSG(GetProfileKeyDescriptor(key).type == PROFILE_KEY_BOOL, false,
+		wxT_2("ProfileWrite(bool) used on a non-bool key"));
+
+	const unsigned long generation = this->currentProfileGeneration;
+	if (!this->ProfileWrite(wxString(GetProfileKeyDescriptor(key).path), value)) {
+		return false;
+	}
+	this->UpdateCachedProfileValue(key, generation, value ? 1 : 0, wxEmptyString);
+	return true;
+}
+
+bool ProMan::ProfileWrite(ProfileKeyId key, long value) {
+	wxCHECK_MSG(key >= 0 && key < PROFILE_KEY_COUNT, false,
+		wxString::Format(wxT_2("invalid profile key id %d"), static_cast<int>(key)));
+	wxCHECK_MSG(GetProfileKeyDescriptor(key).type == PROFILE_KEY_LONG, false,
+		wxT_2("ProfileWrite(long) used on a non-long key"));
+
+	const unsigned long generation = this->currentProfileGeneration;
+	if (!this->ProfileWrite(wxString(GetProfileKeyDescriptor(key).path), value)) {
+		return false;
+	}
+	this->UpdateCachedProfileValue(key, generation, value, wxEmptyString);
+	return true;
+}
+
+bool ProMan::ProfileWrite(ProfileKeyId key, const wxString& value) {
+	wxCHECK_MSG(key >= 0 && key < PROFILE_KEY_COUNT, false,
+		wxString::Format(wxT_2("invalid profile key id %d"), static_cast<int>(key)));
+	wxCHECK_MSG(GetProfileKeyDescriptor(key).type == PROFILE_KEY_STRING, false,
+		wxT_2("ProfileWrite(wxString) used on a non-string key"));
+
+	const unsigned long generation = this->currentProfileGeneration;
+	if (!this->ProfileWrite(wxString(GetProfileKeyDescriptor(key).path), value)) {
+		return false;
+	}
+	this->UpdateCachedProfileValue(key, generation, 0, value);
+	return true;
+}
+
 const NewsData* ProMan::NewsRead(const wxString& newsSource) const {
 	wxCHECK_MSG(!newsSource.IsEmpty(), NULL, wxT_2("NewsRead: newsSource is empty!"));
 	
@@ -975,6 +1132,7 @@ void ProMan::SaveCurrentProfile(bool quiet) {
 void ProMan::RevertCurrentProfile() {
 	ClearConfig(*(this->currentProfile));
 	CopyConfig(*(this->privateCopy), *(this->currentProfile));
+	this->currentProfileGeneration++;
 }
 
 bool ProMan::HasUnsavedChanges() {
@@ -1005,6 +1163,7 @@ bool ProMan::SwitchTo(wxString name) {
 		}
 		this->currentProfileName = name;
 		this->currentProfile = this->profiles.find(name)->second;
+		this->currentProfileGeneration++;
 		wxFileConfig::Set(this->currentProfile);
 		if ( !(ProMan::flags & NoUpdateLastProfile) )
 			this->globalProfile->Write(GBL_CFG_MAIN_LASTPROFILE, name);
@@ -1463,29 +1622,22 @@ void ProMan::TestConfigFunctions(wxConfigBase& src) {
 }
 
 /** Applies the current profile to the registry where 
- Freespace 2 can read it. */
+ Freespace 2 can read it. The settings are read through the typed
+ ProfileRead(), so a push that follows another costs no string lookups. */
 ProMan::RegistryCodes ProMan::PushCurrentProfile() {
 	if (this->currentProfile == NULL) {
 		wxLogError(_T("PushCurrentProfile: attempt to push null current profile"));
 		return ProMan::UnknownError;
-	} else {
-		return ProMan::PushProfile(this->currentProfile);
 	}
-}
-
-/** Applies the passed wxFileConfig profile to the registry where 
-Freespace 2 can read it. */
-ProMan::RegistryCodes ProMan::PushProfile(wxFileConfig *cfg) {
-	wxCHECK_MSG(cfg != NULL, ProMan::UnknownError, _T("ProMan::PushProfile given null wxFileConfig!"));
 #if IS_WIN32
 	// check if binary supports configfile
 	if (FlagListManager::GetFlagListManager()->GetBuildCaps() & FlagListManager::BUILD_CAPS_SDL) {
-		return FilePushProfile(cfg);
+		return FilePushProfile(this);
 	} else {
-		return RegistryPushProfile(cfg);
+		return RegistryPushProfile(this);
 	}	
 #elif IS_LINUX || IS_APPLE
-	return FilePushProfile(cfg);
+	return FilePushProfile(this);
 #else
 #error "One of IS_WIN32, IS_LINUX, IS_APPLE must evaluate to true"
 #endif
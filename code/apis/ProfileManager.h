@@ -25,6 +25,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include <wx/filename.h>
 
 #include "apis/EventHandlers.h"
+#include "global/ProfileKeyTable.h"
 
 WX_DECLARE_STRING_HASH_MAP( wxFileConfig*, ProfileMap );
 
@@ -36,10 +37,16 @@ LAUNCHER_DECLARE_EVENT_TYPE(EVT_CURRENT_PROFILE_CHANGED);
 /** Stores data about downloaded news. */
 struct NewsData {
 	NewsData() { } // required for wxHashMap, unfortunately
-	NewsData(const wxString& theNews, const wxDateTime& lastDownloadNews);
+	NewsData(const wxString& theNews, const wxDateTime& lastDownloadNews,
+		const wxString& etag = wxEmptyString,
+		const wxString& lastModified = wxEmptyString);
 	bool IsValid() const { return (!theNews.IsEmpty()) && lastDownloadNews.IsValid(); }
 	wxString theNews;
 	wxDateTime lastDownloadNews;
+	/** Validators the server sent with the news, sent back on the next
+	 download so that the server can say that the news hasn't changed. */
+	wxString etag;
+	wxString lastModified;
 };
 
 /** Maps a news source by name to the locally stored data on it. */
@@ -92,6 +99,23 @@ public:
 	bool ProfileWrite(const wxString& key, bool value);
 	
 	bool ProfileDeleteEntry(const wxString& key, bool bDeleteGroupIfEmpty = true);
+
+	/** Reads a string from the profile profileName, which need not be the
+	 current profile. Returns false if there is no such profile or entry. */
+	bool ProfileReadFrom(const wxString& profileName, const wxString& key, wxString* str) const;
+
+	/** Typed reads of the keys in PROFILE_KEY_TABLE. These are served from a
+	 cache of the current profile's values, so they are cheap enough for paint
+	 handlers. The value is the key's default if the entry is absent.
+	 Returns true if the entry is present in the current profile. */
+	bool ProfileRead(ProfileKeyId key, bool* b);
+	bool ProfileRead(ProfileKeyId key, long* l);
+	bool ProfileRead(ProfileKeyId key, wxString* str);
+
+	/** Typed writes of the keys in PROFILE_KEY_TABLE, which keep the cache in sync. */
+	bool ProfileWrite(ProfileKeyId key, bool value);
+	bool ProfileWrite(ProfileKeyId key, long value);
+	bool ProfileWrite(ProfileKeyId key, const wxString& value);
 	
 	/** Returns NULL if not found in global profile (or found but invalid). */
 	const NewsData* NewsRead(const wxString& newsSource) const;
@@ -136,6 +160,10 @@ public:
 
 	RegistryCodes PushCurrentProfile(); //!< push current profile into registry
 
+	/** Returns a counter that changes whenever the contents of the current
+	 profile may have changed, including switching to another profile. */
+	unsigned long GetCurrentProfileGeneration() const { return this->currentProfileGeneration; }
+
 	static const wxString& DEFAULT_PROFILE_NAME;
 private:
 	static ProMan* proman;
@@ -143,11 +171,24 @@ private:
 	static Flags flags;
 	wxFileConfig* currentProfile;
 	wxString currentProfileName;
+	unsigned long currentProfileGeneration; //!< bumped on every change to the current profile
+
+	/** A cached value of a key in PROFILE_KEY_TABLE. */
+	struct CachedProfileValue {
+		bool isCached;
+		bool isPresent; //!< is the entry in the current profile
+		long longValue; //!< value of bool and long keys
+		wxString stringValue; //!< value of string keys
+	};
+	CachedProfileValue profileValueCache[PROFILE_KEY_COUNT];
+	unsigned long profileValueCacheGeneration; //!< generation the cache was filled from
+	const CachedProfileValue* GetCachedProfileValue(ProfileKeyId key, ProfileKeyType type);
+	void UpdateCachedProfileValue(ProfileKeyId key, unsigned long generationBeforeWrite,
+		long longValue, const wxString& stringValue);
 	
 	bool CreateNewProfile(wxString newName);
 	static wxString GenerateNewProfileFileName();
 
-	static RegistryCodes PushProfile(wxFileConfig *cfg); //!< push profile into registry
 	static RegistryCodes PullProfile(wxFileConfig *cfg); //!< pull profile from registry
 
 	static void CopyConfig(const wxConfigBase& src, wxConfigBase &dest, const bool includeMainGroup = true, const wxString path = _T("/"));
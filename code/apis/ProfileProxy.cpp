@@ -38,6 +38,12 @@ void ProfileProxy::RegisterProxyReset(wxEvtHandler *handler) {
 			_T("RegisterProxyReset(): Handler at %p already registered."),
 			handler));
 	this->resetEventHandlers.Append(handler);
+	// a handler registering between a reset and the start of flag file
+	// processing, such as a page built late, must still see the reset
+	if (this->isResetPending) {
+		wxCommandEvent event(EVT_PROXY_RESET, wxID_NONE);
+		handler->AddPendingEvent(event);
+	}
 }
 
 void ProfileProxy::UnRegisterProxyReset(wxEvtHandler *handler) {
@@ -56,6 +62,10 @@ void ProfileProxy::RegisterProxyFlagDataReady(wxEvtHandler *handler) {
 			_T("RegisterProxyFlagDataReady(): Handler at %p already registered."),
 			handler));
 	this->readyEventHandlers.Append(handler);
+	if (this->IsFlagDataReady()) {
+		wxCommandEvent event(EVT_PROXY_FLAG_DATA_READY, wxID_NONE);
+		handler->AddPendingEvent(event);
+	}
 }
 
 void ProfileProxy::UnRegisterProxyFlagDataReady(wxEvtHandler *handler) {
@@ -129,7 +139,7 @@ bool ProfileProxy::IsInitialized() {
 }
 
 ProfileProxy::ProfileProxy()
-: isFlagDataReady(false) {
+: isFlagDataReady(false), isResetPending(false) {
 	FlagListManager::RegisterFlagFileProcessingStatusChanged(this);
 }
 
@@ -149,6 +159,8 @@ void ProfileProxy::OnFlagFileProcessingStatusChanged(wxCommandEvent &event) {
 	const FlagListManager::FlagFileProcessingStatus status =
 		static_cast<FlagListManager::FlagFileProcessingStatus>(event.GetInt());
 	
+	this->isResetPending = (status == FlagListManager::FLAG_FILE_PROCESSING_RESET);
+	
 	if (status == FlagListManager::FLAG_FILE_PROCESSING_OK) {
 		wxCHECK_RET(!this->IsFlagDataReady(),
 			_T("ProfileProxy received FLAG_FILE_PROCESSING_OK when flag data is ready."));
@@ -170,10 +182,35 @@ void ProfileProxy::OnFlagFileProcessingStatusChanged(wxCommandEvent &event) {
 		delete proxyData;
 	} else if (status == FlagListManager::FLAG_FILE_PROCESSING_RESET) {
 		this->Reset();
-		this->GenerateProxyReset();	
+		this->GenerateProxyReset();
+		if (!this->IsProfileInitialized()) {
+			this->FinishProfileInitialization();
+		}
+		// the launch needs the flag data, so the flag file is read whether
+		// or not the Advanced Settings page has been built
+		FlagListManager::GetFlagListManager()->BeginFlagFileProcessing();
 	} 
 }
 
+void ProfileProxy::ReloadFlagLine() {
+	wxCHECK_RET(this->IsFlagDataReady(),
+		_T("ReloadFlagLine() called when proxy flag data isn't ready."));
+	
+	this->enabledFlags.clear();
+	this->customFlags.Empty();
+	this->isFlagDataReady = false;
+	
+	this->ProcessFlagLine();
+	
+	this->isFlagDataReady = true;
+	
+	if (!this->IsProfileInitialized()) {
+		this->FinishProfileInitialization();
+	}
+	
+	GenerateProxyFlagDataReady();
+}
+
 void ProfileProxy::SetFlag(const wxString& flag, const bool isChecked) {
 	wxCHECK_RET(this->IsFlagDataReady(),
 		_T("SetFlag() called when proxy flag data isn't ready."));
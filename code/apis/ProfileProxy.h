@@ -92,6 +92,11 @@ public:
 	 The profile must have a non-empty lighting preset name.*/
 	void CopyPresetToCustomFlags();
 	
+	/** Re-reads the flag line after a switch to a profile that uses the same
+	 FSO binary, keeping the flag data, and sends EVT_PROXY_FLAG_DATA_READY.
+	 Flag data must be ready. */
+	void ReloadFlagLine();
+	
 	/** Returns whether the current profile has been initialized. */
 	bool IsProfileInitialized() const;
 	
@@ -135,6 +140,7 @@ private:
 	wxString customFlags;
 	
 	bool isFlagDataReady;
+	bool isResetPending; //!< reset sent, flag file processing not yet begun
 	
 	DECLARE_EVENT_TABLE()
 };
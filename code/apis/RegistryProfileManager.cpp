@@ -220,7 +220,7 @@ HKEY GetRegistryKeyname(wxString& out_keyname)
 /* File contains the Win32 incatations for Pushing and Pulling the passed
 profile to/from the registry. */
 
-ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
+ProMan::RegistryCodes RegistryPushProfile(ProMan* proman) {
 #if PLATFORM_USES_REGISTRY == 1
 	wxString keyName;
 	HKEY useKey = GetRegistryKeyname(keyName);
@@ -261,12 +261,13 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 	}
 
 	// Video
-	int width, height, bitdepth;
-	cfg->Read(PRO_CFG_VIDEO_RESOLUTION_WIDTH, &width, DEFAULT_VIDEO_RESOLUTION_WIDTH);
-	cfg->Read(PRO_CFG_VIDEO_RESOLUTION_HEIGHT, &height, DEFAULT_VIDEO_RESOLUTION_HEIGHT);
-	cfg->Read(PRO_CFG_VIDEO_BIT_DEPTH, &bitdepth, DEFAULT_VIDEO_BIT_DEPTH);
+	// REG_DWORD values are read into longs, which are 32 bits on Windows
+	long width, height, bitdepth;
+	proman->ProfileRead(PKEY_VIDEO_RESOLUTION_WIDTH, &width);
+	proman->ProfileRead(PKEY_VIDEO_RESOLUTION_HEIGHT, &height);
+	proman->ProfileRead(PKEY_VIDEO_BIT_DEPTH, &bitdepth);
 
-	wxString videocardValue = wxString::Format(_T("OGL -(%dx%d)x%d bit"), width, height, bitdepth);
+	wxString videocardValue = wxString::Format(_T("OGL -(%ldx%ld)x%ld bit"), width, height, bitdepth);
 	ret = RegSetValueExW(
 		regHandle,
 		REG_KEY_VIDEO_RESOLUTION_DEPTH.wc_str(),
@@ -278,7 +279,7 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 
 
 	wxString filterMethod;
-	cfg->Read(PRO_CFG_VIDEO_TEXTURE_FILTER, &filterMethod, DEFAULT_VIDEO_TEXTURE_FILTER);
+	proman->ProfileRead(PKEY_VIDEO_TEXTURE_FILTER, &filterMethod);
 	int filterMethodValue = ( filterMethod.StartsWith(_T("Bilinear"))) ? 0 : 1;
 
 	ret = RegSetValueExW(
@@ -291,14 +292,12 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 	ReturnChecker(ret, __LINE__);
 
 
-	int oglAnisotropicFilterInt;
-	cfg->Read(PRO_CFG_VIDEO_ANISOTROPIC,
-		&oglAnisotropicFilterInt,
-		DEFAULT_VIDEO_ANISOTROPIC);
+	long oglAnisotropicFilterInt;
+	proman->ProfileRead(PKEY_VIDEO_ANISOTROPIC, &oglAnisotropicFilterInt);
 
 	// Since FSO expects anisotropic to be a string, we must convert it
 	wxString oglAnisotropicFilter(
-		wxString::Format(_T("%d"), oglAnisotropicFilterInt));
+		wxString::Format(_T("%ld"), oglAnisotropicFilterInt));
 
 	ret = RegSetValueExW(
 		regHandle,
@@ -310,8 +309,8 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 	ReturnChecker(ret, __LINE__);
 
 
-	int oglAntiAliasSample;
-	cfg->Read(PRO_CFG_VIDEO_ANTI_ALIAS, &oglAntiAliasSample, DEFAULT_VIDEO_ANTI_ALIAS);
+	long oglAntiAliasSample;
+	proman->ProfileRead(PKEY_VIDEO_ANTI_ALIAS, &oglAntiAliasSample);
 		
 	ret = RegSetValueExW(
 		regHandle,
@@ -325,7 +324,7 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 
 	// Audio
 	wxString soundDevice;
-	cfg->Read(PRO_CFG_OPENAL_DEVICE, &soundDevice, DEFAULT_AUDIO_OPENAL_DEVICE);
+	const bool hasSoundDevice = proman->ProfileRead(PKEY_OPENAL_DEVICE, &soundDevice);
 
 	ret = RegSetValueExW(
 		regHandle,
@@ -352,11 +351,9 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 	ReturnChecker(ret, __LINE__);
 
 
-	wxString playbackDevice;
-	cfg->Read(
-		PRO_CFG_OPENAL_DEVICE,
-		&playbackDevice,
-		DEFAULT_AUDIO_OPENAL_PLAYBACK_DEVICE);
+	// the same entry, with a different default
+	const wxString playbackDevice(hasSoundDevice ?
+		soundDevice : DEFAULT_AUDIO_OPENAL_PLAYBACK_DEVICE);
 
 	ret = RegSetValueExW(
 		audioRegHandle,
@@ -369,10 +366,7 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 
 
 	wxString captureDevice;
-	bool hasEntry = cfg->Read(
-		PRO_CFG_OPENAL_CAPTURE_DEVICE,
-		&captureDevice,
-		DEFAULT_AUDIO_OPENAL_CAPTURE_DEVICE);
+	bool hasEntry = proman->ProfileRead(PKEY_OPENAL_CAPTURE_DEVICE, &captureDevice);
 
 	if (hasEntry) {
 		ret = RegSetValueExW(
@@ -386,10 +380,11 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 	}
 
 
-	int enableEFX;
-	hasEntry = cfg->Read(PRO_CFG_OPENAL_EFX, &enableEFX, DEFAULT_AUDIO_OPENAL_EFX);
+	bool efx;
+	hasEntry = proman->ProfileRead(PKEY_OPENAL_EFX, &efx);
 
 	if (hasEntry) {
+		DWORD enableEFX = efx ? 1 : 0;
 		ret = RegSetValueExW(
 			audioRegHandle,
 			REG_KEY_AUDIO_OPENAL_EFX.wc_str(),
@@ -401,11 +396,8 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 	}
 
 
-	int sampleRate;
-	cfg->Read(
-		PRO_CFG_OPENAL_SAMPLE_RATE,
-		&sampleRate,
-		DEFAULT_AUDIO_OPENAL_SAMPLE_RATE);
+	long sampleRate;
+	proman->ProfileRead(PKEY_OPENAL_SAMPLE_RATE, &sampleRate);
 
 	if (sampleRate != DEFAULT_AUDIO_OPENAL_SAMPLE_RATE) {
 		ret = RegSetValueExW(
@@ -423,8 +415,8 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 
 
 	// Speech
-	int speechVoice;
-	cfg->Read(PRO_CFG_SPEECH_VOICE, &speechVoice, DEFAULT_SPEECH_VOICE);
+	long speechVoice;
+	proman->ProfileRead(PKEY_SPEECH_VOICE, &speechVoice);
 
 	ret = RegSetValueExW(
 		regHandle,
@@ -436,8 +428,8 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 	ReturnChecker(ret, __LINE__);
 
 
-	int speechVolume;
-	cfg->Read(PRO_CFG_SPEECH_VOLUME, &speechVolume, DEFAULT_SPEECH_VOLUME);
+	long speechVolume;
+	proman->ProfileRead(PKEY_SPEECH_VOLUME, &speechVolume);
 
 	ret = RegSetValueExW(
 		regHandle,
@@ -449,11 +441,15 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 	ReturnChecker(ret, __LINE__);
 
 
-	int inTechroom, inBriefings, inGame, inMulti;
-	cfg->Read(PRO_CFG_SPEECH_IN_TECHROOM, &inTechroom, DEFAULT_SPEECH_IN_TECHROOM);
-	cfg->Read(PRO_CFG_SPEECH_IN_BRIEFINGS, &inBriefings, DEFAULT_SPEECH_IN_BRIEFINGS);
-	cfg->Read(PRO_CFG_SPEECH_IN_GAME, &inGame, DEFAULT_SPEECH_IN_GAME);
-	cfg->Read(PRO_CFG_SPEECH_IN_MULTI, &inMulti, DEFAULT_SPEECH_IN_MULTI);
+	bool techroom, briefings, game, multi;
+	proman->ProfileRead(PKEY_SPEECH_IN_TECHROOM, &techroom);
+	proman->ProfileRead(PKEY_SPEECH_IN_BRIEFINGS, &briefings);
+	proman->ProfileRead(PKEY_SPEECH_IN_GAME, &game);
+	proman->ProfileRead(PKEY_SPEECH_IN_MULTI, &multi);
+	DWORD inTechroom = techroom ? 1 : 0;
+	DWORD inBriefings = briefings ? 1 : 0;
+	DWORD inGame = game ? 1 : 0;
+	DWORD inMulti = multi ? 1 : 0;
 
 	ret = RegSetValueExW(
 		regHandle,
@@ -493,8 +489,8 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 
 
 	// Joystick
-	int currentJoystick;
-	cfg->Read(PRO_CFG_JOYSTICK_ID, &currentJoystick, DEFAULT_JOYSTICK_ID);
+	long currentJoystick;
+	proman->ProfileRead(PKEY_JOYSTICK_ID, &currentJoystick);
 
 	ret = RegSetValueExW(
 		regHandle,
@@ -518,11 +514,9 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 	ReturnChecker(ret, __LINE__);
 
 	
-	int joystickForceFeedback;
-	cfg->Read(
-		PRO_CFG_JOYSTICK_FORCE_FEEDBACK,
-		&joystickForceFeedback,
-		DEFAULT_JOYSTICK_FORCE_FEEDBACK);
+	bool forceFeedback;
+	proman->ProfileRead(PKEY_JOYSTICK_FORCE_FEEDBACK, &forceFeedback);
+	DWORD joystickForceFeedback = forceFeedback ? 1 : 0;
 
 	ret = RegSetValueExW(
 		regHandle,
@@ -534,8 +528,9 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 	ReturnChecker(ret, __LINE__);
 
 
-	int joystickHit;
-	cfg->Read(PRO_CFG_JOYSTICK_DIRECTIONAL, &joystickHit, DEFAULT_JOYSTICK_DIRECTIONAL);
+	bool directional;
+	proman->ProfileRead(PKEY_JOYSTICK_DIRECTIONAL, &directional);
+	DWORD joystickHit = directional ? 1 : 0;
 
 	ret = RegSetValueExW(
 		regHandle,
@@ -549,7 +544,7 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 
 	// Network
 	wxString networkConnectionValue;
-	cfg->Read(PRO_CFG_NETWORK_TYPE, &networkConnectionValue, DEFAULT_NETWORK_TYPE);
+	proman->ProfileRead(PKEY_NETWORK_TYPE, &networkConnectionValue);
 
 	ret = RegSetValueExW(
 		regHandle,
@@ -562,7 +557,7 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 
 
 	wxString connectionSpeedValue;
-	cfg->Read(PRO_CFG_NETWORK_SPEED, &connectionSpeedValue, DEFAULT_NETWORK_SPEED);
+	proman->ProfileRead(PKEY_NETWORK_SPEED, &connectionSpeedValue);
 
 	ret = RegSetValueExW(
 		regHandle,
@@ -574,8 +569,8 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 	ReturnChecker(ret, __LINE__);
 
 
-	int forcedport;
-	cfg->Read(PRO_CFG_NETWORK_PORT, &forcedport, DEFAULT_NETWORK_PORT);
+	long forcedport;
+	proman->ProfileRead(PKEY_NETWORK_PORT, &forcedport);
 
 	if (forcedport != DEFAULT_NETWORK_PORT) {
 		ret = RegSetValueExW(
@@ -600,7 +595,7 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 
 
 	wxString networkIP;
-	cfg->Read(PRO_CFG_NETWORK_IP, &networkIP, DEFAULT_NETWORK_IP);
+	proman->ProfileRead(PKEY_NETWORK_IP, &networkIP);
 
 	// Network folder (for custom IP address)
 	HKEY networkRegHandle = 0;
@@ -642,7 +637,7 @@ ProMan::RegistryCodes RegistryPushProfile(wxFileConfig *cfg) {
 
 	RegCloseKey(regHandle);
 
-	return PushCmdlineFSO(cfg);
+	return PushCmdlineFSO(proman);
 #else // PLATFORM_USES_REGISTRY
 	return ProMan::SupportNotCompiledIn;
 #endif // PLATFORM_USES_REGISTRY
@@ -18,6 +18,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 #include "apis/SkinManager.h"
 #include "global/SkinDefaults.h"
+#include "global/ResourceBundle.h"
 #include <wx/filename.h>
 #include "generated/configure_launcher.h"
 
@@ -385,20 +386,21 @@ void SkinSystem::InitializeDefaultSkin() {
 			DEFAULT_SKIN_WINDOW_TITLE.c_str());
 	}
 	
-	wxFileName filename(_T(RESOURCES_PATH), DEFAULT_SKIN_WINDOW_ICON);
+	// all of the images come from the one resource bundle file
+	ResourceBundle& resources = ResourceBundle::Get();
+
 	success = this->defaultSkin.SetWindowIcon(
-		wxIcon(filename.GetFullPath(), wxBITMAP_TYPE_ICO));
+		resources.LoadIcon(DEFAULT_SKIN_WINDOW_ICON));
 	if (!success) {
 		wxLogFatalError(_T("Setting default window icon '%s' failed"),
-			filename.GetFullPath().c_str());
+			ResourceBundle::GetResourcePath(DEFAULT_SKIN_WINDOW_ICON).c_str());
 	}
 	
-	filename = wxFileName(_T(RESOURCES_PATH), DEFAULT_SKIN_BANNER);
 	success = this->defaultSkin.SetBanner(
-		wxBitmap(filename.GetFullPath(), wxBITMAP_TYPE_ANY));
+		resources.LoadBitmap(DEFAULT_SKIN_BANNER));
 	if (!success) {
 		wxLogFatalError(_T("Setting default banner '%s' failed"),
-			filename.GetFullPath().c_str());
+			ResourceBundle::GetResourcePath(DEFAULT_SKIN_BANNER).c_str());
 	}
 
 	success = this->defaultSkin.SetWelcomeText(DEFAULT_SKIN_WELCOME_TEXT);
@@ -407,92 +409,81 @@ void SkinSystem::InitializeDefaultSkin() {
 			DEFAULT_SKIN_WELCOME_TEXT.c_str());
 	}
 	
-	filename = wxFileName(_T(RESOURCES_PATH), DEFAULT_SKIN_MOD_IMAGE_255X112);
 	success = this->defaultSkin.SetModImage(
-		wxBitmap(filename.GetFullPath(), wxBITMAP_TYPE_ANY));
+		resources.LoadBitmap(DEFAULT_SKIN_MOD_IMAGE_255X112));
 	if (!success) {
 		wxLogFatalError(_T("Setting default mod image '%s' failed"),
-			filename.GetFullPath().c_str());
+			ResourceBundle::GetResourcePath(DEFAULT_SKIN_MOD_IMAGE_255X112).c_str());
 	}
 	
-	filename = wxFileName(_T(RESOURCES_PATH), DEFAULT_SKIN_MOD_IMAGE_182X80);
 	success = this->defaultSkin.SetSmallModImage(
-		wxBitmap(filename.GetFullPath(), wxBITMAP_TYPE_ANY));
+		resources.LoadBitmap(DEFAULT_SKIN_MOD_IMAGE_182X80));
 	if (!success) {
 		wxLogFatalError(_T("Setting default small mod image '%s' failed"),
-			filename.GetFullPath().c_str());
+			ResourceBundle::GetResourcePath(DEFAULT_SKIN_MOD_IMAGE_182X80).c_str());
 	}
 	
-	filename = wxFileName(_T(RESOURCES_PATH), DEFAULT_SKIN_ICON_OK);
 	success = this->defaultSkin.SetOkIcon(
-		wxBitmap(filename.GetFullPath(), wxBITMAP_TYPE_ANY));
+		resources.LoadBitmap(DEFAULT_SKIN_ICON_OK));
 	if (!success) {
 		wxLogFatalError(_T("Setting default ok icon '%s' failed"),
-			filename.GetFullPath().c_str());
+			ResourceBundle::GetResourcePath(DEFAULT_SKIN_ICON_OK).c_str());
 	}
 	
-	filename = wxFileName(_T(RESOURCES_PATH), DEFAULT_SKIN_ICON_WARNING);
 	success = this->defaultSkin.SetWarningIcon(
-		wxBitmap(filename.GetFullPath(), wxBITMAP_TYPE_ANY));
+		resources.LoadBitmap(DEFAULT_SKIN_ICON_WARNING));
 	if (!success) {
 		wxLogFatalError(_T("Setting default warning icon '%s' failed"),
-			filename.GetFullPath().c_str());
+			ResourceBundle::GetResourcePath(DEFAULT_SKIN_ICON_WARNING).c_str());
 	}
 	
-	filename = wxFileName(_T(RESOURCES_PATH), DEFAULT_SKIN_ICON_WARNING_BIG);
 	success = this->defaultSkin.SetBigWarningIcon(
-		wxBitmap(filename.GetFullPath(), wxBITMAP_TYPE_ANY));
+		resources.LoadBitmap(DEFAULT_SKIN_ICON_WARNING_BIG));
 	if (!success) {
 		wxLogFatalError(_T("Setting default big warning icon '%s' failed"),
-			filename.GetFullPath().c_str());
+			ResourceBundle::GetResourcePath(DEFAULT_SKIN_ICON_WARNING_BIG).c_str());
 	}
 	
-	filename = wxFileName(_T(RESOURCES_PATH), DEFAULT_SKIN_ICON_ERROR);
 	success = this->defaultSkin.SetErrorIcon(
-		wxBitmap(filename.GetFullPath(), wxBITMAP_TYPE_ANY));
+		resources.LoadBitmap(DEFAULT_SKIN_ICON_ERROR));
 	if (!success) {
 		wxLogFatalError(_T("Setting default error icon '%s' failed"),
-			filename.GetFullPath().c_str());
+			ResourceBundle::GetResourcePath(DEFAULT_SKIN_ICON_ERROR).c_str());
 	}
 	
-	filename = wxFileName(_T(RESOURCES_PATH), DEFAULT_SKIN_ICON_INFO);
 	success = this->defaultSkin.SetInfoIcon(
-		wxBitmap(filename.GetFullPath(), wxBITMAP_TYPE_ANY));
+		resources.LoadBitmap(DEFAULT_SKIN_ICON_INFO));
 	if (!success) {
 		wxLogFatalError(_T("Setting default info icon '%s' failed"),
-			filename.GetFullPath().c_str());
+			ResourceBundle::GetResourcePath(DEFAULT_SKIN_ICON_INFO).c_str());
 	}
 	
-	filename = wxFileName(_T(RESOURCES_PATH), DEFAULT_SKIN_ICON_INFO_BIG);
 	success = this->defaultSkin.SetBigInfoIcon(
-		wxBitmap(filename.GetFullPath(), wxBITMAP_TYPE_ANY));
+		resources.LoadBitmap(DEFAULT_SKIN_ICON_INFO_BIG));
 	if (!success) {
 		wxLogFatalError(_T("Setting default big info icon '%s' failed"),
-			filename.GetFullPath().c_str());
+			ResourceBundle::GetResourcePath(DEFAULT_SKIN_ICON_INFO_BIG).c_str());
 	}
 	
-	filename = wxFileName(_T(RESOURCES_PATH), DEFAULT_SKIN_ICON_HELP);
 	success = this->defaultSkin.SetHelpIcon(
-		wxBitmap(filename.GetFullPath(), wxBITMAP_TYPE_ANY));
+		resources.LoadBitmap(DEFAULT_SKIN_ICON_HELP));
 	if (!success) {
 		wxLogFatalError(_T("Setting default help icon '%s' failed"),
-			filename.GetFullPath().c_str());
+			ResourceBundle::GetResourcePath(DEFAULT_SKIN_ICON_HELP).c_str());
 	}
 	
-	filename = wxFileName(_T(RESOURCES_PATH), DEFAULT_SKIN_ICON_HELP_BIG);
 	success = this->defaultSkin.SetBigHelpIcon(
-		wxBitmap(filename.GetFullPath(), wxBITMAP_TYPE_ANY));
+		resources.LoadBitmap(DEFAULT_SKIN_ICON_HELP_BIG));
 	if (!success) {
 		wxLogFatalError(_T("Setting default big help icon '%s' failed"),
-			filename.GetFullPath().c_str());
+			ResourceBundle::GetResourcePath(DEFAULT_SKIN_ICON_HELP_BIG).c_str());
 	}
 	
-	filename = wxFileName(_T(RESOURCES_PATH), DEFAULT_SKIN_ICON_IDEAL);
-	this->defaultSkin.SetIdealIcon( 
-		wxBitmap(filename.GetFullPath(), wxBITMAP_TYPE_ANY));
+	success = this->defaultSkin.SetIdealIcon(
+		resources.LoadBitmap(DEFAULT_SKIN_ICON_IDEAL));
 	if (!success) {
 		wxLogFatalError(_T("Setting default ideal icon '%s' failed"),
-			filename.GetFullPath().c_str());
+			ResourceBundle::GetResourcePath(DEFAULT_SKIN_ICON_IDEAL).c_str());
 	}
 	
 	success = this->defaultSkin.SetNewsSource(
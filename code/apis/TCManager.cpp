@@ -17,7 +17,10 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 */
 
 #include "apis/TCManager.h"
+#include "apis/EventDispatcher.h"
 #include "apis/ProfileManager.h"
+#include "apis/ProfileProxy.h"
+#include "global/ProfileKeys.h"
 
 #include "global/MemoryDebugging.h"
 
@@ -47,6 +50,16 @@ EventHandlers TCManager::TCChangedHandlers;
 EventHandlers TCManager::TCBinaryChangedHandlers;
 EventHandlers TCManager::TCActiveModChangedHandlers;
 EventHandlers TCManager::TCFredBinaryChangedHandlers;
+EventHandlers TCManager::TCProfileModChangedHandlers;
+EventHandlers TCManager::TCModInstalledHandlers;
+bool TCManager::isTCChangedGenerated = false;
+bool TCManager::isTCBinaryChangedGenerated = false;
+bool TCManager::isTCActiveModChangedGenerated = false;
+bool TCManager::isTCFredBinaryChangedGenerated = false;
+wxString TCManager::currentTCRootFolder;
+wxString TCManager::currentBinary;
+wxString TCManager::currentFredBinary;
+wxString TCManager::currentMod;
 
 void TCManager::Initialize() {
 	if ( !IsInitialized() ) {
@@ -79,13 +92,22 @@ LAUNCHER_DEFINE_EVENT_TYPE(EVT_TC_CHANGED);
 LAUNCHER_DEFINE_EVENT_TYPE(EVT_TC_BINARY_CHANGED);
 LAUNCHER_DEFINE_EVENT_TYPE(EVT_TC_ACTIVE_MOD_CHANGED);
 LAUNCHER_DEFINE_EVENT_TYPE(EVT_TC_FRED_BINARY_CHANGED);
+LAUNCHER_DEFINE_EVENT_TYPE(EVT_TC_PROFILE_MOD_CHANGED);
+LAUNCHER_DEFINE_EVENT_TYPE(EVT_TC_MOD_INSTALLED);
 
+/** The Register functions send a handler the event right away if it has
+ already gone out, so that a handler created later (such as a page built on
+ first use) catches up with the current state. */
 void TCManager::RegisterTCBinaryChanged(wxEvtHandler *handler) {
 	wxASSERT_MSG(TCBinaryChangedHandlers.IndexOf(handler) == wxNOT_FOUND,
 		wxString::Format(
 			_T("RegisterTCBinaryChanged(): Handler at %p already registered."),
 			handler));
 	TCBinaryChangedHandlers.Append(handler);
+	if (isTCBinaryChangedGenerated) {
+		wxCommandEvent event(EVT_TC_BINARY_CHANGED, wxID_NONE);
+		EventDispatcher::PostTo(TCBinaryChangedHandlers, handler, event);
+	}
 }
 void TCManager::UnRegisterTCBinaryChanged(wxEvtHandler *handler) {
 	wxASSERT_MSG(TCBinaryChangedHandlers.IndexOf(handler) != wxNOT_FOUND,
@@ -100,6 +122,10 @@ void TCManager::RegisterTCChanged(wxEvtHandler *handler) {
 			_T("RegisterTCChanged(): Handler at %p already registered."),
 			handler));
 	TCChangedHandlers.Append(handler);
+	if (isTCChangedGenerated) {
+		wxCommandEvent event(EVT_TC_CHANGED, wxID_NONE);
+		EventDispatcher::PostTo(TCChangedHandlers, handler, event);
+	}
 }
 void TCManager::UnRegisterTCChanged(wxEvtHandler *handler) {
 	wxASSERT_MSG(TCChangedHandlers.IndexOf(handler) != wxNOT_FOUND,
@@ -114,6 +140,10 @@ void TCManager::RegisterTCActiveModChanged(wxEvtHandler *handler) {
 			_T("RegisterTCActiveModChanged(): Handler at %p already registered."),
 			handler));
 	TCActiveModChangedHandlers.Append(handler);
+	if (isTCActiveModChangedGenerated) {
+		wxCommandEvent event(EVT_TC_ACTIVE_MOD_CHANGED, wxID_NONE);
+		EventDispatcher::PostTo(TCActiveModChangedHandlers, handler, event);
+	}
 }
 void TCManager::UnRegisterTCActiveModChanged(wxEvtHandler *handler) {
 	wxASSERT_MSG(TCActiveModChangedHandlers.IndexOf(handler) != wxNOT_FOUND,
@@ -128,6 +158,10 @@ void TCManager::RegisterTCFredBinaryChanged(wxEvtHandler *handler) {
 			_T("RegisterTCFredBinaryChanged(): Handler at %p already registered."),
 			handler));
 	TCFredBinaryChangedHandlers.Append(handler);
+	if (isTCFredBinaryChangedGenerated) {
+		wxCommandEvent event(EVT_TC_FRED_BINARY_CHANGED, wxID_NONE);
+		EventDispatcher::PostTo(TCFredBinaryChangedHandlers, handler, event);
+	}
 }
 void TCManager::UnRegisterTCFredBinaryChanged(wxEvtHandler *handler) {
 	wxASSERT_MSG(TCFredBinaryChangedHandlers.IndexOf(handler) != wxNOT_FOUND,
@@ -136,56 +170,128 @@ void TCManager::UnRegisterTCFredBinaryChanged(wxEvtHandler *handler) {
 			handler));
 	TCFredBinaryChangedHandlers.DeleteObject(handler);
 }
+/** Unlike the other TC events, this one is not sent on registration, since
+ it is a request to the mod list rather than a change of state. */
+void TCManager::RegisterTCProfileModChanged(wxEvtHandler *handler) {
+	wxASSERT_MSG(TCProfileModChangedHandlers.IndexOf(handler) == wxNOT_FOUND,
+		wxString::Format(
+			_T("RegisterTCProfileModChanged(): Handler at %p already registered."),
+			handler));
+	TCProfileModChangedHandlers.Append(handler);
+}
+void TCManager::UnRegisterTCProfileModChanged(wxEvtHandler *handler) {
+	wxASSERT_MSG(TCProfileModChangedHandlers.IndexOf(handler) != wxNOT_FOUND,
+		wxString::Format(
+			_T("UnRegisterTCProfileModChanged(): Handler at %p not registered."),
+			handler));
+	TCProfileModChangedHandlers.DeleteObject(handler);
+}
+/** Not sent on registration either: it only says what just changed. */
+void TCManager::RegisterTCModInstalled(wxEvtHandler *handler) {
+	wxASSERT_MSG(TCModInstalledHandlers.IndexOf(handler) == wxNOT_FOUND,
+		wxString::Format(
+			_T("RegisterTCModInstalled(): Handler at %p already registered."),
+			handler));
+	TCModInstalledHandlers.Append(handler);
+}
+void TCManager::UnRegisterTCModInstalled(wxEvtHandler *handler) {
+	wxASSERT_MSG(TCModInstalledHandlers.IndexOf(handler) != wxNOT_FOUND,
+		wxString::Format(
+			_T("UnRegisterTCModInstalled(): Handler at %p not registered."),
+			handler));
+	TCModInstalledHandlers.DeleteObject(handler);
+}
+/** A new TC also means that the binaries have to be checked again, so the
+ binary changed events follow, whether or not the pages that show the
+ binaries have been built. */
 void TCManager::GenerateTCChanged() {
 	wxCommandEvent event(EVT_TC_CHANGED, wxID_NONE);
 	wxLogDebug(_T("Generating EVT_TC_CHANGED event"));
-	EventHandlers::iterator iter = TCChangedHandlers.begin();
-	while (iter != TCChangedHandlers.end()) {
-		wxEvtHandler* current = *iter;
-		current->AddPendingEvent(event);
-		wxLogDebug(_T(" Sent EVT_TC_CHANGED event to %p"), current);
-		iter++;
+	isTCChangedGenerated = true;
+	ProMan::GetProfileManager()->ProfileRead(
+		PRO_CFG_TC_ROOT_FOLDER, &currentTCRootFolder, wxEmptyString);
+	EventDispatcher::Post(TCChangedHandlers, event);
+
+	TCManager::GenerateTCBinaryChanged();
+	bool fredEnabled;
+	ProMan::GetProfileManager()->GlobalRead(GBL_CFG_OPT_CONFIG_FRED, &fredEnabled, false);
+	if (fredEnabled) {
+		TCManager::GenerateTCFredBinaryChanged();
 	}
 }
 void TCManager::GenerateTCBinaryChanged() {
 	wxCommandEvent event(EVT_TC_BINARY_CHANGED, wxID_NONE);
 	wxLogDebug(_T("Generating EVT_TC_BINARY_CHANGED event"));
-	EventHandlers::iterator iter = TCBinaryChangedHandlers.begin();
-	while (iter != TCBinaryChangedHandlers.end()) {
-		wxEvtHandler* current = *iter;
-		current->AddPendingEvent(event);
-		wxLogDebug(_T(" Sent EVT_TC_BINARY_CHANGED event to %p"), current);
-		iter++;
-	}
+	isTCBinaryChangedGenerated = true;
+	ProMan::GetProfileManager()->ProfileRead(
+		PRO_CFG_TC_CURRENT_BINARY, &currentBinary, wxEmptyString);
+	EventDispatcher::Post(TCBinaryChangedHandlers, event);
 }
 void TCManager::GenerateTCActiveModChanged() {
 	wxCommandEvent event(EVT_TC_ACTIVE_MOD_CHANGED, wxID_NONE);
 	wxLogDebug(_T("Generating EVT_TC_ACTIVE_MOD_CHANGED event"));
-	EventHandlers::iterator iter = TCActiveModChangedHandlers.begin();
-	while (iter != TCActiveModChangedHandlers.end()) {
-		wxEvtHandler* current = *iter;
-		current->AddPendingEvent(event);
-		wxLogDebug(_T(" Sent EVT_TC_ACTIVE_MOD_CHANGED event to %p"), current);
-		iter++;
-	}
+	isTCActiveModChangedGenerated = true;
+	ProMan::GetProfileManager()->ProfileRead(
+		PRO_CFG_TC_CURRENT_MOD, &currentMod, wxEmptyString);
+	EventDispatcher::Post(TCActiveModChangedHandlers, event);
 }
 void TCManager::GenerateTCFredBinaryChanged() {
 	wxCommandEvent event(EVT_TC_FRED_BINARY_CHANGED, wxID_NONE);
 	wxLogDebug(_T("Generating EVT_TC_FRED_BINARY_CHANGED event"));
-	EventHandlers::iterator iter = TCFredBinaryChangedHandlers.begin();
-	while (iter != TCFredBinaryChangedHandlers.end()) {
-		wxEvtHandler* current = *iter;
-		current->AddPendingEvent(event);
-		wxLogDebug(_T(" Sent EVT_TC_FRED_BINARY_CHANGED event to %p"), current);
-		iter++;
-	}
+	isTCFredBinaryChangedGenerated = true;
+	ProMan::GetProfileManager()->ProfileRead(
+		PRO_CFG_TC_CURRENT_FRED, &currentFredBinary, wxEmptyString);
+	EventDispatcher::Post(TCFredBinaryChangedHandlers, event);
+}
+void TCManager::GenerateTCProfileModChanged() {
+	wxCommandEvent event(EVT_TC_PROFILE_MOD_CHANGED, wxID_NONE);
+	wxLogDebug(_T("Generating EVT_TC_PROFILE_MOD_CHANGED event"));
+	EventDispatcher::Post(TCProfileModChangedHandlers, event);
+}
+void TCManager::GenerateTCModInstalled(const wxString& shortname) {
+	wxCommandEvent event(EVT_TC_MOD_INSTALLED, wxID_NONE);
+	event.SetString(shortname);
+	wxLogDebug(_T("Generating EVT_TC_MOD_INSTALLED event for %s"), shortname.c_str());
+	EventDispatcher::Post(TCModInstalledHandlers, event);
 }
 
+/** Sends only the events whose inputs differ between the profile that the
+ last events were sent for and the newly selected one. A new TC folder
+ restarts the whole chain, as before. With the same folder, a new binary
+ re-probes the flags, and a new mod re-selects it in the already scanned
+ mod list. If nothing changed, the proxy just re-reads the new profile's flag
+ line, so that switching between profiles that only differ in settings
+ doesn't touch the filesystem. */
 void TCManager::CurrentProfileChanged(wxCommandEvent &WXUNUSED(event)) {
+	ProMan* proman = ProMan::GetProfileManager();
+	wxString tcRootFolder, binary, fredBinary, mod;
+	proman->ProfileRead(PKEY_TC_ROOT_FOLDER, &tcRootFolder);
+	proman->ProfileRead(PKEY_TC_CURRENT_BINARY, &binary);
+	proman->ProfileRead(PKEY_TC_CURRENT_FRED, &fredBinary);
+	proman->ProfileRead(PKEY_TC_CURRENT_MOD, &mod);
 
-	TCManager::GenerateTCChanged();
-//	it's assumed that BasicSettingsPage::OnTCChanged() (which is called on an EVT_TC_CHANGED event)
-//	calls TCManager::GenerateTCBinaryChanged() unconditionally, so no need to explicitly call it here
-//	it's also assumed that BasicSettingsPage::OnTCChanged() calls TCManager::GenerateTCFredBinaryChanged()
-//	unconditionally if FRED launching is enabled
+	if (!isTCChangedGenerated || tcRootFolder != currentTCRootFolder) {
+		// also sends the binary changed events
+		TCManager::GenerateTCChanged();
+		return;
+	}
+
+	wxLogDebug(_T("New profile uses the same game root folder, not rescanning it"));
+
+	if (binary != currentBinary) {
+		TCManager::GenerateTCBinaryChanged();
+	} else if (ProfileProxy::IsInitialized()
+		&& ProfileProxy::GetProxy()->IsFlagDataReady()) {
+		ProfileProxy::GetProxy()->ReloadFlagLine();
+	}
+
+	bool fredEnabled;
+	proman->GlobalRead(GBL_CFG_OPT_CONFIG_FRED, &fredEnabled, false);
+	if (fredEnabled && fredBinary != currentFredBinary) {
+		TCManager::GenerateTCFredBinaryChanged();
+	}
+
+	if (mod != currentMod) {
+		TCManager::GenerateTCProfileModChanged();
+	}
 }
@@ -33,6 +33,12 @@ LAUNCHER_DECLARE_EVENT_TYPE(EVT_TC_BINARY_CHANGED);
 LAUNCHER_DECLARE_EVENT_TYPE(EVT_TC_ACTIVE_MOD_CHANGED);
 /** Selected FRED binary has changed. */
 LAUNCHER_DECLARE_EVENT_TYPE(EVT_TC_FRED_BINARY_CHANGED);
+/** The newly selected profile names a different mod in the same TC, so the
+ mod list should select it without rescanning the TC. */
+LAUNCHER_DECLARE_EVENT_TYPE(EVT_TC_PROFILE_MOD_CHANGED);
+/** A mod was installed or updated in the current TC. The event's string is
+ the mod's shortname, so that only that mod needs to be read again. */
+LAUNCHER_DECLARE_EVENT_TYPE(EVT_TC_MOD_INSTALLED);
 
 class TCManager: public wxEvtHandler {
 public:
@@ -58,15 +64,35 @@ public:
 	static void UnRegisterTCActiveModChanged(wxEvtHandler *handler);
 	static void RegisterTCFredBinaryChanged(wxEvtHandler *handler);
 	static void UnRegisterTCFredBinaryChanged(wxEvtHandler *handler);
+	static void RegisterTCProfileModChanged(wxEvtHandler *handler);
+	static void UnRegisterTCProfileModChanged(wxEvtHandler *handler);
+	static void RegisterTCModInstalled(wxEvtHandler *handler);
+	static void UnRegisterTCModInstalled(wxEvtHandler *handler);
 	static void GenerateTCChanged();
 	static void GenerateTCBinaryChanged();
 	static void GenerateTCActiveModChanged();
 	static void GenerateTCFredBinaryChanged();
+	static void GenerateTCProfileModChanged();
+	static void GenerateTCModInstalled(const wxString& shortname);
 private:
 	static EventHandlers TCChangedHandlers,
 		TCBinaryChangedHandlers,
 		TCActiveModChangedHandlers,
-		TCFredBinaryChangedHandlers;
+		TCFredBinaryChangedHandlers,
+		TCProfileModChangedHandlers,
+		TCModInstalledHandlers;
+	/** Whether each event has been sent at least once, so that handlers
+	 registering later are sent it on registration. */
+	static bool isTCChangedGenerated,
+		isTCBinaryChangedGenerated,
+		isTCActiveModChangedGenerated,
+		isTCFredBinaryChangedGenerated;
+	/** The profile values that the last events were sent for, compared
+	 against the next profile on a profile switch. */
+	static wxString currentTCRootFolder,
+		currentBinary,
+		currentFredBinary,
+		currentMod;
 	DECLARE_EVENT_TABLE();
 };
 #endif
\ No newline at end of file
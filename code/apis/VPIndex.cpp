@@ -0,0 +1,338 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <iterator>
+#include <set>
+
+#include <wx/wx.h>
+#include <wx/dir.h>
+#include <wx/filename.h>
+#include <wx/stopwatch.h>
+
+#include "apis/VPIndex.h"
+#include "global/MappedFile.h"
+#include "global/ParallelJobs.h"
+
+#include "global/MemoryDebugging.h"
+
+LAUNCHER_DEFINE_EVENT_TYPE(EVT_VP_INDEX_DONE);
+
+/** A VP starts with "VPVP", the version, the offset of the directory and
+ the number of directory entries, as 32 bit little endian integers. */
+const size_t VP_HEADER_SIZE = 16;
+/** A directory entry is the offset and size of the file, its name padded
+ with NULs to 32 bytes, and its timestamp. Folders are entries of size 0,
+ and an entry named ".." goes back up one folder. */
+const size_t VP_ENTRY_SIZE = 44;
+const size_t VP_NAME_SIZE = 32;
+/** Files listed per overlap in a ChainReport. */
+const size_t VP_OVERLAP_EXAMPLES = 5;
+
+VPIndex& VPIndex::Get() {
+	static VPIndex index;
+	return index;
+}
+
+static unsigned long ReadLittleEndian32(const unsigned char* bytes) {
+	return static_cast<unsigned long>(bytes[0])
+		| (static_cast<unsigned long>(bytes[1]) << 8)
+		| (static_cast<unsigned long>(bytes[2]) << 16)
+		| (static_cast<unsigned long>(bytes[3]) << 24);
+}
+
+static void AppendLower(std::string& path, const char* name, size_t length) {
+	for (size_t i = 0; i < length; ++i) {
+		path += static_cast<char>(tolower(static_cast<unsigned char>(name[i])));
+	}
+}
+
+bool VPIndex::ParseArchive(const unsigned char* data, size_t size,
+	std::vector<std::string>& paths, std::string& error) {
+	if (size < VP_HEADER_SIZE || memcmp(data, "VPVP", 4) != 0) {
+		error = "not a VP archive";
+		return false;
+	}
+	const unsigned long directoryOffset = ReadLittleEndian32(data + 8);
+	const unsigned long entryCount = ReadLittleEndian32(data + 12);
+	if (directoryOffset > size
+		|| entryCount > (size - directoryOffset) / VP_ENTRY_SIZE) {
+		error = "the directory runs past the end of the file";
+		return false;
+	}
+
+	std::string folder; // the folder the entries are in, ending in '/'
+	std::vector<size_t> parents; // the length of folder before each level was entered
+	const unsigned char* entry = data + directoryOffset;
+	for (unsigned long i = 0; i < entryCount; ++i, entry += VP_ENTRY_SIZE) {
+		const char* name = reinterpret_cast<const char*>(entry + 8);
+		const char* nameEnd = static_cast<const char*>(memchr(name, '\0', VP_NAME_SIZE));
+		const size_t nameLength = (nameEnd != NULL) ? nameEnd - name : VP_NAME_SIZE;
+
+		if (ReadLittleEndian32(entry + 4) != 0) {
+			paths.push_back(folder);
+			AppendLower(paths.back(), name, nameLength);
+		} else if (nameLength == 2 && name[0] == '.' && name[1] == '.') {
+			if (parents.empty()) {
+				error = "the directory goes up past its root";
+				return false;
+			}
+			folder.resize(parents.back());
+			parents.pop_back();
+		} else {
+			parents.push_back(folder.size());
+			AppendLower(folder, name, nameLength);
+			folder += '/';
+		}
+	}
+	return true;
+}
+
+void VPIndex::FindVPFiles(const wxString& folder, std::vector<wxString>& files) {
+	if (!wxDir::Exists(folder)) {
+		return;
+	}
+	wxArrayString found;
+	wxDir::GetAllFiles(folder, &found, wxEmptyString, wxDIR_FILES);
+	found.Sort();
+	for (size_t i = 0; i < found.GetCount(); ++i) {
+		if (wxFileName(found[i]).GetExt().Lower() == _T("vp")) {
+			files.push_back(found[i]);
+		}
+	}
+}
+
+/** One VP to be parsed by the workers. */
+struct VPIndexJob {
+	wxString path;
+	wxDateTime modified;
+	wxULongLong size;
+	std::vector<std::string> paths;
+	wxString error;
+};
+
+/** An update started by StartUpdate(). While the update runs, its thread
+ touches only jobs and parallel; the rest is the main thread's. */
+struct VPIndex::PendingUpdate {
+	PendingUpdate(): vpCount(0) { }
+
+	FolderMap folders; //!< replaces the index's folders when finished
+	std::vector<VPIndexJob> jobs;
+	std::unique_ptr<ParallelJobs> parallel;
+	size_t vpCount;
+	wxStopWatch timer;
+};
+
+VPIndex::VPIndex() {
+}
+
+VPIndex::~VPIndex() {
+	this->CancelUpdate();
+}
+
+void VPIndex::ParseVPs(PendingUpdate* update, size_t WXUNUSED(thread)) {
+	MappedFile file;
+	size_t i;
+	while (update->parallel->Claim(i)) {
+		VPIndexJob& job = update->jobs[i];
+		if (!file.Open(job.path, &job.error)) {
+			continue;
+		}
+		std::string error;
+		if (VPIndex::ParseArchive(file.GetData(), file.GetSize(), job.paths, error)) {
+			std::sort(job.paths.begin(), job.paths.end());
+			job.paths.erase(std::unique(job.paths.begin(), job.paths.end()), job.paths.end());
+		} else {
+			job.paths.clear();
+			job.error = wxString(error.c_str(), wxConvUTF8);
+		}
+		file.Close();
+	}
+}
+
+/** Runs on the update's thread. */
+void VPIndex::RunUpdate(PendingUpdate* update, wxEvtHandler* owner) {
+	// the directories are small and spread over many files, so on a cold
+	// cache the time goes to seeking; several readers keep the disk busy
+	update->parallel->Start(ParseVPs, update);
+	update->parallel->Join();
+	if (!update->parallel->IsCancelled()) {
+		wxCommandEvent event(EVT_VP_INDEX_DONE, wxID_NONE);
+		owner->AddPendingEvent(event);
+	}
+}
+
+void VPIndex::StartUpdate(wxEvtHandler* owner, const wxArrayString& folders) {
+	wxCHECK_RET(owner != NULL, _T("StartUpdate(): VP index update has no owner"));
+	this->CancelUpdate();
+
+	std::unique_ptr<PendingUpdate> update(new PendingUpdate());
+	for (size_t i = 0; i < folders.GetCount(); ++i) {
+		std::vector<wxString>& vps = update->folders[folders[i]];
+		FindVPFiles(folders[i], vps);
+		update->vpCount += vps.size();
+
+		for (std::vector<wxString>::const_iterator it = vps.begin(), end = vps.end();
+				it != end; ++it) {
+			const wxFileName file(*it);
+			const wxDateTime modified(file.GetModificationTime());
+			const wxULongLong size(file.GetSize());
+			ArchiveMap::const_iterator archive = this->archives.find(*it);
+			if (archive != this->archives.end()
+				&& archive->second.size == size
+				&& archive->second.modified.IsValid() && modified.IsValid()
+				&& archive->second.modified == modified) {
+				continue;
+			}
+			update->jobs.push_back(VPIndexJob());
+			update->jobs.back().path = wxString(it->c_str());
+			update->jobs.back().modified = modified;
+			update->jobs.back().size = size;
+		}
+	}
+	update->parallel.reset(new ParallelJobs(update->jobs.size()));
+
+	this->pending.reset(update.release());
+	this->thread = std::thread(RunUpdate, this->pending.get(), owner);
+}
+
+void VPIndex::CancelUpdate() {
+	if (this->pending.get() != NULL) {
+		this->pending->parallel->Cancel();
+	}
+	if (this->thread.joinable()) {
+		this->thread.join();
+	}
+	this->pending.reset();
+}
+
+bool VPIndex::FinishUpdate() {
+	if (this->pending.get() == NULL) {
+		return false;
+	}
+	if (this->thread.joinable()) {
+		this->thread.join();
+	}
+	std::unique_ptr<PendingUpdate> update(this->pending.release());
+	if (update->parallel->IsCancelled()) {
+		return false;
+	}
+
+	for (std::vector<VPIndexJob>::iterator job = update->jobs.begin(),
+			end = update->jobs.end(); job != end; ++job) {
+		if (!job->error.IsEmpty()) {
+			wxLogWarning(_T("Unable to index %s: %s"),
+				job->path.c_str(), job->error.c_str());
+		}
+		// kept even if it couldn't be parsed, so that it isn't tried again until it changes
+		Archive& archive = this->archives[job->path];
+		archive.modified = job->modified;
+		archive.size = job->size;
+		archive.paths.swap(job->paths);
+	}
+	this->folders.swap(update->folders);
+
+	// forget the VPs that were deleted or whose folder is no longer indexed
+	std::set<wxString> listed;
+	for (FolderMap::const_iterator folder = this->folders.begin(),
+			end = this->folders.end(); folder != end; ++folder) {
+		listed.insert(folder->second.begin(), folder->second.end());
+	}
+	size_t forgotten = 0;
+	for (ArchiveMap::iterator it = this->archives.begin(); it != this->archives.end();) {
+		if (listed.find(it->first) == listed.end()) {
+			this->archives.erase(it++);
+			++forgotten;
+		} else {
+			++it;
+		}
+	}
+
+	wxLogDebug(_T("VPIndex: %lu VPs in %lu folders, %lu parsed, %lu forgotten, in %ld ms"),
+		static_cast<unsigned long>(update->vpCount),
+		static_cast<unsigned long>(this->folders.size()),
+		static_cast<unsigned long>(update->jobs.size()),
+		static_cast<unsigned long>(forgotten), update->timer.Time());
+	return true;
+}
+
+/** Puts the files of all of folder's VPs into paths, sorted, without
+ duplicates. */
+void VPIndex::FolderFiles(const wxString& folder, std::vector<std::string>& paths) const {
+	paths.clear();
+	FolderMap::const_iterator vps = this->folders.find(folder);
+	if (vps == this->folders.end()) {
+		return;
+	}
+	for (std::vector<wxString>::const_iterator it = vps->second.begin(),
+			end = vps->second.end(); it != end; ++it) {
+		ArchiveMap::const_iterator archive = this->archives.find(*it);
+		if (archive != this->archives.end()) {
+			paths.insert(paths.end(),
+				archive->second.paths.begin(), archive->second.paths.end());
+		}
+	}
+	std::sort(paths.begin(), paths.end());
+	paths.erase(std::unique(paths.begin(), paths.end()), paths.end());
+}
+
+VPIndex::ChainReport VPIndex::Compare(const wxArrayString& chain, size_t position) const {
+	ChainReport report;
+	wxCHECK_MSG(position < chain.GetCount(), report,
+		_T("VPIndex::Compare() called with a position outside the chain"));
+
+	FolderMap::const_iterator vps = this->folders.find(chain[position]);
+	if (vps != this->folders.end()) {
+		report.vpCount = vps->second.size();
+	}
+	std::vector<std::string> files;
+	this->FolderFiles(chain[position], files);
+	report.fileCount = files.size();
+	if (files.empty()) {
+		return report;
+	}
+
+	std::vector<std::string> otherFiles, common;
+	for (size_t i = 0; i < chain.GetCount(); ++i) {
+		if (i == position || chain[i] == chain[position]) {
+			continue;
+		}
+		this->FolderFiles(chain[i], otherFiles);
+		common.clear();
+		std::set_intersection(files.begin(), files.end(),
+			otherFiles.begin(), otherFiles.end(), std::back_inserter(common));
+		if (common.empty()) {
+			continue;
+		}
+
+		Overlap overlap;
+		overlap.folder = chain[i];
+		overlap.count = common.size();
+		for (size_t j = 0; j < common.size() && j < VP_OVERLAP_EXAMPLES; ++j) {
+			wxString example(common[j].c_str(), wxConvUTF8);
+			if (example.IsEmpty()) {
+				example = wxString(common[j].c_str(), wxConvISO8859_1);
+			}
+			overlap.examples.Add(example);
+		}
+		((i > position) ? report.overrides : report.shadowedBy).push_back(overlap);
+	}
+	return report;
+}
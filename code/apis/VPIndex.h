@@ -0,0 +1,114 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef VPINDEX_H
+#define VPINDEX_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <wx/wx.h>
+#include <wx/datetime.h>
+
+#include "apis/EventHandlers.h"
+
+/** A VPIndex update has finished. Call VPIndex::FinishUpdate() to bring
+ it into the index. */
+LAUNCHER_DECLARE_EVENT_TYPE(EVT_VP_INDEX_DONE);
+
+/** VPIndex - knows which files are in the VP archives of a TC's mods, and
+ from that which of a mod's files override or are shadowed by the other mods
+ in its mod chain. Each VP is memory-mapped and its directory read in place;
+ the VPs are parsed in parallel, off the main thread, and the result for a
+ VP is kept until the VP changes on disk, so that only new or changed VPs
+ are parsed again. */
+class VPIndex {
+public:
+	static VPIndex& Get();
+	~VPIndex();
+
+	/** Files of one folder that are also in another folder of the chain. */
+	struct Overlap {
+		wxString folder;
+		size_t count;
+		wxArrayString examples; //!< a few of the files, for display
+	};
+	/** How one folder of a mod chain relates to the others. */
+	struct ChainReport {
+		ChainReport(): vpCount(0), fileCount(0) { }
+		size_t vpCount;
+		size_t fileCount;
+		std::vector<Overlap> overrides; //!< folders later in the chain whose files this one replaces
+		std::vector<Overlap> shadowedBy; //!< folders earlier in the chain that replace this one's files
+	};
+
+	/** Lists the VPs in folders and starts parsing the new or changed ones
+	 on threads of their own. owner is sent EVT_VP_INDEX_DONE when done.
+	 Cancels an update already in progress. */
+	void StartUpdate(wxEvtHandler* owner, const wxArrayString& folders);
+	/** Stops the update in progress and waits for its threads, so that
+	 owner isn't sent anything once this returns. */
+	void CancelUpdate();
+	/** Brings the finished update into the index. The index then holds only
+	 the folders given to StartUpdate(), and forgets the VPs that are no
+	 longer in any of them. Returns false if there is no finished update. */
+	bool FinishUpdate();
+	/** Compares chain[position] against the other folders of chain, which
+	 is in the order the game searches it, highest priority first. The
+	 folders must have been indexed by an update. */
+	ChainReport Compare(const wxArrayString& chain, size_t position) const;
+
+	/** Puts the VP files directly in folder into files, sorted by name. */
+	static void FindVPFiles(const wxString& folder, std::vector<wxString>& files);
+
+	/** Reads the directory of the VP archive in data, appending the full
+	 path of each file, in lower case, to paths. Returns false with error
+	 set if the archive is malformed. Safe to call from any thread. */
+	static bool ParseArchive(const unsigned char* data, size_t size,
+		std::vector<std::string>& paths, std::string& error);
+
+private:
+	VPIndex();
+
+	struct PendingUpdate;
+
+	struct Archive {
+		wxDateTime modified;
+		wxULongLong size;
+		std::vector<std::string> paths; //!< sorted, without duplicates
+	};
+	typedef std::map<wxString, Archive> ArchiveMap;
+	typedef std::map<wxString, std::vector<wxString> > FolderMap;
+
+	void FolderFiles(const wxString& folder, std::vector<std::string>& paths) const;
+	static void RunUpdate(PendingUpdate* update, wxEvtHandler* owner);
+	static void ParseVPs(PendingUpdate* update, size_t thread);
+
+	ArchiveMap archives; //!< by the VP's full path
+	FolderMap folders; //!< the VPs in each indexed folder
+	std::thread thread;
+	std::unique_ptr<PendingUpdate> pending; //!< the update thread is working on
+
+	VPIndex(const VPIndex&);
+	VPIndex& operator=(const VPIndex&);
+};
+
+#endif
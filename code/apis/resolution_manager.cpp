@@ -18,6 +18,10 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 #include "generated/configure_launcher.h"
 
+#include <algorithm>
+#include <mutex>
+#include <thread>
+
 #include "apis/resolution_manager.hpp"
 #include "global/ProfileKeys.h"
 
@@ -25,6 +29,8 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "SDL.h"
 #endif
 
+LAUNCHER_DEFINE_EVENT_TYPE(EVT_RESOLUTION_MODES_ENUMERATED);
+
 /** \namespace ResolutionMan
 The ResolutionMan namespace contains the code that gets the
 available resolutions for the BasicSettingsTab.
@@ -48,180 +54,108 @@ Resolution* Resolution::New() const {
 }
 
 // sort by aspect ratio, then by size, in descending order
-int CompareResolutions(Resolution **resp1, Resolution **resp2) {
-
-	wxASSERT_MSG(resp1 != NULL, _T("CompareResolutions: provided resp1 is NULL"));
-	wxASSERT_MSG((*resp1) != NULL, _T("CompareResolutions: resp1 points to NULL"));
-	wxASSERT_MSG(resp2 != NULL, _T("CompareResolutions: provided resp2 is NULL"));
-	wxASSERT_MSG((*resp2) != NULL, _T("CompareResolutions: resp2 points to NULL"));
-
-	// compare the two width/height ratios by cross-multiplying and comparing the results
-	const int width1 = (*resp1)->GetWidth();
-	const int height1 = (*resp1)->GetHeight();
-	const int width2 = (*resp2)->GetWidth();
-	const int height2 = (*resp2)->GetHeight();
-
-	wxASSERT_MSG(width1 > 0, wxString::Format(_T("CompareResolutions: width1 %d is invalid"), width1));
-	wxASSERT_MSG(height1 > 0, wxString::Format(_T("CompareResolutions: height1 %d is invalid"), height1));
-	wxASSERT_MSG(width2 > 0, wxString::Format(_T("CompareResolutions: width2 %d is invalid"), width2));
-	wxASSERT_MSG(height2 > 0, wxString::Format(_T("CompareResolutions: height2 %d is invalid"), height2));
-
-	const int value1 = width1 * height2;
-	const int value2 = width2 * height1;
-	int result;
-	// first compare aspect ratio
-	if (value1 < value2) {
-		result = -1;
-	}
-	else if (value1 > value2) {
-		result = 1;
-	}
-	else { // then compare size if aspect ratios are equal
-		if (width1 < width2) {
-			result = -1;
-		}
-		else if (width1 > width2) {
-			result = 1;
-		}
-		else {
-			result = 0;
-		}
+static bool IsModeBefore(const DisplayMode& mode1, const DisplayMode& mode2) {
+	// compare the two width/height ratios by cross-multiplying
+	const int value1 = mode1.width * mode2.height;
+	const int value2 = mode2.width * mode1.height;
+	if (value1 != value2) {
+		return value1 > value2;
 	}
+	return mode1.width > mode2.width;
+}
 
-	return (-1) * result; // for reverse comparison (descending order)
+static bool IsSameMode(const DisplayMode& mode1, const DisplayMode& mode2) {
+	return (mode1.width == mode2.width) && (mode1.height == mode2.height);
 }
 
 // brought to you by http://en.wikipedia.org/wiki/Euclidean_algorithm#Implementations
-int ComputeGCD(int a, int b) {
+static int ComputeGCD(int a, int b) {
 	wxASSERT_MSG(a > 0, wxString::Format(_T("ComputeGCD(a=%d, b=%d): a must be positive"), a, b));
 	wxASSERT_MSG(b > 0, wxString::Format(_T("ComputeGCD(a=%d, b=%d): b must be positive"), a, b));
 
-	//	part of the original algorithm, but irrelevant, since a and b are positive
-	//	if (a == 0) {
-	//		return b;
-	//	}
 	while (b != 0) {
-		if (a > b) {
-			a = a - b;
-		}
-		else {
-			b = b - a;
-		}
+		const int remainder = a % b;
+		a = b;
+		b = remainder;
 	}
 	return a;
 }
 
-// Assumed resolutions has been sorted using CompareResolutions
-void AddHeaders(ResolutionArray &resolutions) {
-	if (resolutions.IsEmpty()) {
-		wxLogWarning(_T("AddHeaders: provided ResolutionArray is empty"));
+/** Doesn't log, since the Win32 modes are read on a worker thread. */
+static void AddMode(std::vector<DisplayMode>& modes, const int width, const int height) {
+	if ((width <= 0) || (height <= 0)) {
 		return;
 	}
-
-	ResolutionArray headers;
-	wxArrayInt headerIndexes;
-
-	int lastAspectWidth = -1;
-	int lastAspectHeight = -1;
-	int width;
-	int height;
-	int gcd;
-
-	// find aspect ratios and determine where the aspect ratio headers should be inserted
-	for (int i = 0, n = resolutions.GetCount(); i < n; ++i) {
-		width = resolutions.Item(i)->GetWidth();
-		height = resolutions.Item(i)->GetHeight();
-		gcd = ComputeGCD(width, height);
-		width /= gcd;
-		height /= gcd;
-
-		// special exception: 8:5 should be 16:10
-		if ((width == 8) && (height == 5)) {
-			width *= 2;
-			height *= 2;
-		}
-
-		if ((width != lastAspectWidth) || (height != lastAspectHeight)) {
-			wxLogDebug(_T(" found aspect ratio %d:%d"), width, height);
-			headers.Add(new Resolution(width, height, true));
-			headerIndexes.Add(i);
-			lastAspectWidth = width;
-			lastAspectHeight = height;
-		}
-	}
-
-	// now insert the headers into resolutions
-	// must insert in reverse to avoid messing up insertion indexes
-	for (int i = headerIndexes.GetCount() - 1; i >= 0; --i) {
-		resolutions.Insert(headers.Item(i), headerIndexes.Item(i));
-	}
+	DisplayMode mode;
+	mode.width = width;
+	mode.height = height;
+	modes.push_back(mode);
 }
 
 
 #ifdef WIN32
-void EnumerateGraphicsModes_win32(
-	ResolutionArray &out_modes,
-	const DWORD minHorizontalRes,
-	const DWORD minVerticalRes)
+static void EnumerateDisplayModes_win32(
+	const TCHAR* deviceName,
+	std::vector<DisplayMode> &modes)
 {
 	DEVMODE deviceMode;
 	DWORD modeCounter = 0;
 	BOOL result;
 
-	wxLogDebug(_T("Enumerating graphics modes with Win32"));
-
 	do {
 		memset(&deviceMode, 0, sizeof(DEVMODE));
 		deviceMode.dmSize = sizeof(DEVMODE);
 
-		result = EnumDisplaySettings(NULL, modeCounter, &deviceMode);
+		result = EnumDisplaySettings(deviceName, modeCounter, &deviceMode);
 
 		if (result == TRUE) {
-			wxLogDebug(_T(" %dx%d %d bit %d hertz (%d)"),
-				deviceMode.dmPelsWidth,
-				deviceMode.dmPelsHeight,
-				deviceMode.dmBitsPerPel,
-				deviceMode.dmDisplayFrequency,
-				deviceMode.dmDisplayFlags);
-
-			Resolution candidate(
-				deviceMode.dmPelsWidth, deviceMode.dmPelsHeight, false);
-
-			// check to see if the resolution has already been added
-			// since the current out_modes list is unsorted we need to
-			// iterate over all of the existing ones
-			bool resExists = false;
-			for (auto it = out_modes.begin(), end = out_modes.end();
-				it != end; ++it)
-			{
-				Resolution* p = (Resolution*)(*it);
-				if ((p)->IsSameResolution(candidate)) {
-					resExists = true;
-					break; // no need to keep looking
-				}
-			}
-
-			if (!resExists &&
-				(deviceMode.dmPelsWidth >= minHorizontalRes) &&
-				(deviceMode.dmPelsHeight >= minVerticalRes))
-			{
-				out_modes.Add(candidate.New());
-			}
+			// duplicates (other depths and refresh rates) are removed later
+			AddMode(modes, deviceMode.dmPelsWidth, deviceMode.dmPelsHeight);
 		}
 		modeCounter++;
 	} while (result == TRUE);
 }
+
+/** Runs on the worker thread that ModeCatalog::StartEnumeration() starts,
+ so it must not log. */
+static void EnumerateGraphicsModes_win32(
+	std::vector<std::vector<DisplayMode> > &out_displays)
+{
+	DISPLAY_DEVICE device;
+	for (DWORD i = 0; ; ++i) {
+		memset(&device, 0, sizeof(DISPLAY_DEVICE));
+		device.cb = sizeof(DISPLAY_DEVICE);
+		if (!EnumDisplayDevices(NULL, i, &device, 0)) {
+			break;
+		}
+		if (!(device.StateFlags & DISPLAY_DEVICE_ATTACHED_TO_DESKTOP)) {
+			continue;
+		}
+
+		std::vector<DisplayMode> modes;
+		EnumerateDisplayModes_win32(device.DeviceName, modes);
+
+		// the primary display always comes first
+		if (device.StateFlags & DISPLAY_DEVICE_PRIMARY_DEVICE) {
+			out_displays.insert(out_displays.begin(), modes);
+		} else {
+			out_displays.push_back(modes);
+		}
+	}
+
+	if (out_displays.empty()) {
+		// no displays found, so use the current display
+		out_displays.push_back(std::vector<DisplayMode>());
+		EnumerateDisplayModes_win32(NULL, out_displays.back());
+	}
+}
 #endif
 
 #if HAS_SDL
-void EnumerateGraphicsModes_sdl(
-	ResolutionArray &out_modes,
-	const int minHorizontalRes,
-	const int minVerticalRes)
+static void EnumerateGraphicsModes_sdl(
+	std::vector<std::vector<DisplayMode> > &out_displays)
 {
 	wxLogDebug(_T("Enumerating graphics modes with SDL"));
-	// FSO currently only supports the primary display
-	const int DISPLAY_INDEX = 0;
 
 #if IS_APPLE || IS_WIN32
 	// It seems that linux cannot handle having the video subsystem inited
@@ -231,20 +165,23 @@ void EnumerateGraphicsModes_sdl(
 	}
 #endif
 
-	if (SDL_GetNumVideoDisplays() > 0) {
-		int numDisplayModes = SDL_GetNumDisplayModes(DISPLAY_INDEX);
-
+	const int numDisplays = SDL_GetNumVideoDisplays();
+	if (numDisplays > 0) {
 		SDL_DisplayMode mode;
 
-		for (int i = 0; i < numDisplayModes; ++i) {
-			if (SDL_GetDisplayMode(DISPLAY_INDEX, i, &mode) != 0) {
-				wxLogWarning(_T("SDL_GetDisplayMode failed: %s"),
-					SDL_GetError());
-				continue;
-			}
-
-			if ((mode.w >= minHorizontalRes) && (mode.h >= minVerticalRes)) {
-				out_modes.Add(new Resolution(mode.w, mode.h, false));
+		// SDL numbers the primary display 0
+		for (int display = 0; display < numDisplays; ++display) {
+			wxLogDebug(_T("Display %d"), display);
+			out_displays.push_back(std::vector<DisplayMode>());
+			const int numDisplayModes = SDL_GetNumDisplayModes(display);
+
+			for (int i = 0; i < numDisplayModes; ++i) {
+				if (SDL_GetDisplayMode(display, i, &mode) != 0) {
+					wxLogWarning(_T("SDL_GetDisplayMode failed: %s"),
+						SDL_GetError());
+					continue;
+				}
+				AddMode(out_displays.back(), mode.w, mode.h);
 			}
 		}
 	}
@@ -255,35 +192,207 @@ void EnumerateGraphicsModes_sdl(
 #if IS_APPLE || IS_WIN32
 	SDL_QuitSubSystem(SDL_INIT_VIDEO);
 #endif
-#endif
 }
+#endif
 
 #if !HAS_SDL && !defined(WIN32)
 #error No implementation of EnumerateGraphicsModes available
 #endif
 
-/** Get available graphics modes for API and return them sorted */
-void ResolutionMan::EnumerateGraphicsModes(
-	ApiType type, ResolutionArray& out_modes,
-	const long minHorizontalRes, const long minVerticalRes)
-{
+#if IS_WIN32
+/** Set while the worker thread started by StartEnumeration() exists, that
+ is, until FinishEnumeration() joins it. Only the Win32 catalog is
+ enumerated on a worker thread. */
+static bool isWorkerRunning = false;
+static std::thread worker;
+/** Only touched by the worker thread while it runs. */
+static std::vector<std::vector<DisplayMode> > workerDisplays;
+static std::mutex workerMutex; //!< guards isWorkerDone and workerHandlers
+static bool isWorkerDone = false;
+/** Sent EVT_RESOLUTION_MODES_ENUMERATED when the worker finishes. */
+static std::vector<wxEvtHandler*> workerHandlers;
+
+static void RunEnumeration() {
+	EnumerateGraphicsModes_win32(workerDisplays);
+
+	std::lock_guard<std::mutex> lock(workerMutex);
+	isWorkerDone = true;
+	for (std::vector<wxEvtHandler*>::iterator it = workerHandlers.begin(),
+			end = workerHandlers.end(); it != end; ++it) {
+		wxCommandEvent event(EVT_RESOLUTION_MODES_ENUMERATED, wxID_NONE);
+		(*it)->AddPendingEvent(event);
+	}
+	workerHandlers.clear();
+}
+#endif
+
+ModeCatalog& ModeCatalog::Catalog(ApiType type) {
+	static ModeCatalog catalogs[API_SDL + 1];
+	wxASSERT_MSG(type >= API_WIN32 && type <= API_SDL,
+		wxString::Format(_T("ModeCatalog::Catalog: invalid API type %d"), type));
+	return catalogs[type];
+}
+
+const ModeCatalog& ModeCatalog::Get(ApiType type) {
+	if (type == API_WIN32) {
+		FinishEnumeration();
+	}
+	ModeCatalog& catalog = Catalog(type);
+	if (!catalog.isEnumerated) {
+		catalog.Enumerate(type);
+	}
+	return catalog;
+}
+
+bool ModeCatalog::StartEnumeration(ApiType type, wxEvtHandler* handler) {
+	wxCHECK_MSG(handler != NULL, false,
+		_T("ModeCatalog::StartEnumeration called without a handler"));
+#if IS_WIN32
+	if (type != API_WIN32 || Catalog(type).isEnumerated) {
+		return false;
+	}
+	if (!isWorkerRunning) {
+		wxLogDebug(_T("Enumerating graphics modes with Win32 in the background"));
+		isWorkerDone = false;
+		workerHandlers.push_back(handler);
+		isWorkerRunning = true;
+		worker = std::thread(RunEnumeration);
+		return true;
+	}
+
+	std::lock_guard<std::mutex> lock(workerMutex);
+	if (isWorkerDone) {
+		return false;
+	}
+	if (std::find(workerHandlers.begin(), workerHandlers.end(), handler)
+			== workerHandlers.end()) {
+		workerHandlers.push_back(handler);
+	}
+	return true;
+#else
+	return false;
+#endif
+}
+
+void ModeCatalog::CancelEnumerationEvent(wxEvtHandler* handler) {
+#if IS_WIN32
+	std::lock_guard<std::mutex> lock(workerMutex);
+	workerHandlers.erase(
+		std::remove(workerHandlers.begin(), workerHandlers.end(), handler),
+		workerHandlers.end());
+#endif
+}
+
+void ModeCatalog::FinishEnumeration() {
+#if IS_WIN32
+	if (!isWorkerRunning) {
+		return;
+	}
+	worker.join();
+	isWorkerRunning = false;
+	Catalog(API_WIN32).AddDisplays(workerDisplays);
+	workerDisplays.clear();
+#endif
+}
+
+void ModeCatalog::Enumerate(ApiType type) {
+	std::vector<std::vector<DisplayMode> > displayModes;
 #if IS_WIN32
 	if (type == ResolutionMan::API_WIN32) {
-		EnumerateGraphicsModes_win32(out_modes,
-			static_cast<DWORD>(minHorizontalRes),
-			static_cast<DWORD>(minVerticalRes));
+		wxLogDebug(_T("Enumerating graphics modes with Win32"));
+		EnumerateGraphicsModes_win32(displayModes);
 	}
 #endif
 #if HAS_SDL
 	if (type == ResolutionMan::API_SDL) {
-		EnumerateGraphicsModes_sdl(out_modes,
-			static_cast<int>(minHorizontalRes),
-			static_cast<int>(minVerticalRes));
+		EnumerateGraphicsModes_sdl(displayModes);
 	}
 #endif
 
-	// then arrange the resolutions for drop down box and insert them
-	out_modes.Sort(CompareResolutions);
+	this->AddDisplays(displayModes);
+}
+
+void ModeCatalog::AddDisplays(std::vector<std::vector<DisplayMode> >& displayModes) {
+	for (size_t i = 0; i < displayModes.size(); ++i) {
+		wxLogDebug(_T("Display %lu has %lu modes"), static_cast<unsigned long>(i),
+			static_cast<unsigned long>(displayModes[i].size()));
+		this->AddDisplay(displayModes[i]);
+	}
+	this->isEnumerated = true;
+}
+
+/** Sorts and deduplicates modes, then finds where each aspect ratio starts. */
+void ModeCatalog::AddDisplay(std::vector<DisplayMode>& modes) {
+	std::sort(modes.begin(), modes.end(), IsModeBefore);
+	modes.erase(std::unique(modes.begin(), modes.end(), IsSameMode), modes.end());
 
-	AddHeaders(out_modes);
-}
\ No newline at end of file
+	this->displays.push_back(Display());
+	Display& display = this->displays.back();
+	display.modes.swap(modes);
+
+	for (size_t i = 0, n = display.modes.size(); i < n; ++i) {
+		const int gcd = ComputeGCD(display.modes[i].width, display.modes[i].height);
+		int aspectWidth = display.modes[i].width / gcd;
+		int aspectHeight = display.modes[i].height / gcd;
+
+		// special exception: 8:5 should be 16:10
+		if ((aspectWidth == 8) && (aspectHeight == 5)) {
+			aspectWidth *= 2;
+			aspectHeight *= 2;
+		}
+
+		if (display.groups.empty()
+			|| (display.groups.back().aspectWidth != aspectWidth)
+			|| (display.groups.back().aspectHeight != aspectHeight)) {
+			wxLogDebug(_T(" found aspect ratio %d:%d"), aspectWidth, aspectHeight);
+			AspectGroup group;
+			group.aspectWidth = aspectWidth;
+			group.aspectHeight = aspectHeight;
+			group.begin = i;
+			display.groups.push_back(group);
+		}
+		display.groups.back().end = i + 1;
+	}
+}
+
+void ModeCatalog::GetModes(size_t displayIndex, ResolutionArray& out_modes,
+	const long minHorizontalRes, const long minVerticalRes) const
+{
+	if (displayIndex >= this->displays.size()) {
+		wxLogWarning(_T("GetModes: display %lu not found, %lu displays enumerated"),
+			static_cast<unsigned long>(displayIndex),
+			static_cast<unsigned long>(this->displays.size()));
+		return;
+	}
+	const Display& display = this->displays[displayIndex];
+
+	for (std::vector<AspectGroup>::const_iterator group = display.groups.begin(),
+			end = display.groups.end(); group != end; ++group) {
+		bool hasHeader = false;
+		for (size_t i = group->begin; i < group->end; ++i) {
+			const DisplayMode& mode = display.modes[i];
+			if ((mode.width < minHorizontalRes) || (mode.height < minVerticalRes)) {
+				continue;
+			}
+			if (!hasHeader) {
+				out_modes.Add(new Resolution(group->aspectWidth, group->aspectHeight, true));
+				hasHeader = true;
+			}
+			out_modes.Add(new Resolution(mode.width, mode.height, false));
+		}
+	}
+
+	if (out_modes.IsEmpty()) {
+		wxLogWarning(_T("GetModes: no modes are at least %ldx%ld"),
+			minHorizontalRes, minVerticalRes);
+	}
+}
+
+/** Get available graphics modes for API and return them sorted */
+void ResolutionMan::EnumerateGraphicsModes(
+	ApiType type, ResolutionArray& out_modes,
+	const long minHorizontalRes, const long minVerticalRes)
+{
+	ModeCatalog::Get(type).GetModes(PRIMARY_DISPLAY, out_modes,
+		minHorizontalRes, minVerticalRes);
+}
@@ -19,9 +19,17 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #ifndef APIS_RESOLUTION_MANAGER_H
 #define APIS_RESOLUTION_MANAGER_H
 
+#include <vector>
+
 #include <wx/wx.h>
 #include <wx/dynarray.h>
 
+#include "apis/EventHandlers.h"
+
+/** The displays that ResolutionMan::ModeCatalog::StartEnumeration() began
+ enumerating have been, so ModeCatalog::Get() won't wait for them. */
+LAUNCHER_DECLARE_EVENT_TYPE(EVT_RESOLUTION_MODES_ENUMERATED);
+
 namespace ResolutionMan {
 	enum ApiType {
 		API_WIN32,
@@ -51,6 +59,66 @@ namespace ResolutionMan {
 
 	WX_DEFINE_ARRAY_PTR(Resolution *, ResolutionArray);
 
+	/** FSO currently only supports the primary display. */
+	const size_t PRIMARY_DISPLAY = 0;
+
+	struct DisplayMode {
+		int width;
+		int height;
+	};
+
+	/** ModeCatalog - the display modes of every display for one API.
+	 The displays are enumerated the first time the catalog is used, and the
+	 modes are deduplicated, sorted and grouped by aspect ratio once, so that
+	 a mod's minimum resolution only filters the catalog. */
+	class ModeCatalog {
+	public:
+		/** Returns the catalog for type, enumerating the displays if this
+		 is the first call for it. Must be called from the main thread. */
+		static const ModeCatalog& Get(ApiType type);
+		/** Starts enumerating the displays for type on a worker thread.
+		 handler is sent EVT_RESOLUTION_MODES_ENUMERATED when it finishes.
+		 \return false if there is nothing to wait for: the catalog is
+		 already enumerated or done being, or type is enumerated on the main
+		 thread, as SDL's video functions must be. */
+		static bool StartEnumeration(ApiType type, wxEvtHandler* handler);
+		/** Stops handler from being sent EVT_RESOLUTION_MODES_ENUMERATED,
+		 such as when it is being destroyed. */
+		static void CancelEnumerationEvent(wxEvtHandler* handler);
+		/** Waits for the worker thread that StartEnumeration() started, if
+		 any, and adds the displays it found to its catalog. */
+		static void FinishEnumeration();
+
+		size_t GetDisplayCount() const { return this->displays.size(); }
+		/** Appends the modes of display that are at least minHorizontalRes
+		 by minVerticalRes to out_modes, sorted by aspect ratio then size,
+		 in descending order, with a header before each aspect ratio. */
+		void GetModes(size_t display, ResolutionArray& out_modes,
+			const long minHorizontalRes, const long minVerticalRes) const;
+
+	private:
+		ModeCatalog(): isEnumerated(false) { }
+		static ModeCatalog& Catalog(ApiType type);
+		void Enumerate(ApiType type);
+		void AddDisplays(std::vector<std::vector<DisplayMode> >& displayModes);
+		void AddDisplay(std::vector<DisplayMode>& modes);
+
+		/** Consecutive modes of a display that have the same aspect ratio. */
+		struct AspectGroup {
+			int aspectWidth;
+			int aspectHeight;
+			size_t begin;
+			size_t end;
+		};
+		struct Display {
+			std::vector<DisplayMode> modes;
+			std::vector<AspectGroup> groups;
+		};
+		std::vector<Display> displays;
+		bool isEnumerated;
+	};
+
+	/** Gets the modes of the primary display from the catalog for type. */
 	void EnumerateGraphicsModes(ApiType type, ResolutionArray& out_modes,
 		const long minHorizontalRes, const long minVerticalRes);
 };
@@ -110,8 +110,8 @@ wxString FixBinaryName(const wxString& binaryName) {
 
 void BottomButtons::OnTCChanges(wxCommandEvent &WXUNUSED(event)) {
 	wxString tc, binary, fredBinary;
-	ProMan::GetProfileManager()->ProfileRead(PRO_CFG_TC_ROOT_FOLDER, &tc, wxEmptyString);
-	ProMan::GetProfileManager()->ProfileRead(PRO_CFG_TC_CURRENT_BINARY, &binary, wxEmptyString);
+	ProMan::GetProfileManager()->ProfileRead(PKEY_TC_ROOT_FOLDER, &tc);
+	ProMan::GetProfileManager()->ProfileRead(PKEY_TC_CURRENT_BINARY, &binary);
 	if ( tc.IsEmpty() || binary.IsEmpty() || ModList::GetActiveMod() == NULL || !ResolutionMap::HasEntryForActiveMod()) {
 		this->play->Disable();
 	} else if ( wxFileName(tc + wxFileName::GetPathSeparator() + binary).FileExists() ) {
@@ -120,7 +120,7 @@ void BottomButtons::OnTCChanges(wxCommandEvent &WXUNUSED(event)) {
 		wxLogWarning(_("Executable %s does not exist"), FixBinaryName(binary).c_str());
 		this->play->Disable();
 	}
-	ProMan::GetProfileManager()->ProfileRead(PRO_CFG_TC_CURRENT_FRED, &fredBinary, wxEmptyString);
+	ProMan::GetProfileManager()->ProfileRead(PKEY_TC_CURRENT_FRED, &fredBinary);
 	if ( this->fred == NULL ) {
 		// do nothing, no button to manipulate
 	} else if ( tc.IsEmpty() || fredBinary.IsEmpty() || (!wxFileName::DirExists(tc)) ||
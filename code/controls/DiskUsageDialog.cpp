@@ -0,0 +1,350 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#include <algorithm>
+
+#include <wx/wx.h>
+#include <wx/listctrl.h>
+
+#include "controls/DiskUsageDialog.h"
+#include "global/ids.h"
+
+#include "global/MemoryDebugging.h"
+
+/** Milliseconds between updates of the scan's progress. */
+const int DISK_USAGE_PROGRESS_INTERVAL = 200;
+
+enum ModColumn {
+	MOD_COLUMN_NAME,
+	MOD_COLUMN_FILES,
+	MOD_COLUMN_SIZE,
+	MOD_COLUMN_ON_DISK,
+	MOD_COLUMN_VP,
+	MOD_COLUMN_DATA,
+	MOD_COLUMN_OTHER
+};
+
+enum TypeColumn {
+	TYPE_COLUMN_NAME,
+	TYPE_COLUMN_FILES,
+	TYPE_COLUMN_SIZE,
+	TYPE_COLUMN_ON_DISK
+};
+
+static wxString FormatCount(uint64_t count) {
+	return wxULongLong(static_cast<wxULongLong_t>(count)).ToString();
+}
+
+static wxString ModName(const wxString& shortname) {
+	return shortname.IsEmpty() ? wxString(_("(No mod)")) : shortname;
+}
+
+static wxString TypeName(const wxString& type) {
+	return type.IsEmpty() ? wxString(_("(none)")) : type;
+}
+
+/** The number shown in a column of the mods list. The VP, data and other
+ columns are what those files take up on the disk. */
+static uint64_t ModColumnValue(const ModUsage& mod, int column) {
+	switch (column) {
+		case MOD_COLUMN_FILES:
+			return mod.total.fileCount;
+		case MOD_COLUMN_SIZE:
+			return mod.total.apparentBytes;
+		case MOD_COLUMN_ON_DISK:
+			return mod.total.allocatedBytes;
+		case MOD_COLUMN_VP:
+			return mod.vp.allocatedBytes;
+		case MOD_COLUMN_DATA:
+			return mod.data.allocatedBytes;
+		default:
+			return mod.other.allocatedBytes;
+	}
+}
+
+static uint64_t TypeColumnValue(const UsageTotals& totals, int column) {
+	switch (column) {
+		case TYPE_COLUMN_FILES:
+			return totals.fileCount;
+		case TYPE_COLUMN_SIZE:
+			return totals.apparentBytes;
+		default:
+			return totals.allocatedBytes;
+	}
+}
+
+/** Orders indexes into the scanned mods by a column of the mods list,
+ breaking ties by name. */
+class ModOrder {
+public:
+	ModOrder(const std::vector<ModUsage>& mods, int column, bool isAscending)
+	: mods(mods), column(column), isAscending(isAscending) { }
+
+	bool operator()(size_t left, size_t right) const {
+		const ModUsage& a = this->mods[this->isAscending ? left : right];
+		const ModUsage& b = this->mods[this->isAscending ? right : left];
+		if (this->column != MOD_COLUMN_NAME) {
+			const uint64_t valueA = ModColumnValue(a, this->column);
+			const uint64_t valueB = ModColumnValue(b, this->column);
+			if (valueA != valueB) {
+				return valueA < valueB;
+			}
+		}
+		return a.shortname.CmpNoCase(b.shortname) < 0;
+	}
+
+private:
+	const std::vector<ModUsage>& mods;
+	int column;
+	bool isAscending;
+};
+
+typedef std::map<wxString, UsageTotals>::const_iterator TypeIterator;
+
+class TypeOrder {
+public:
+	TypeOrder(int column, bool isAscending)
+	: column(column), isAscending(isAscending) { }
+
+	bool operator()(const TypeIterator& left, const TypeIterator& right) const {
+		const TypeIterator& a = this->isAscending ? left : right;
+		const TypeIterator& b = this->isAscending ? right : left;
+		if (this->column != TYPE_COLUMN_NAME) {
+			const uint64_t valueA = TypeColumnValue(a->second, this->column);
+			const uint64_t valueB = TypeColumnValue(b->second, this->column);
+			if (valueA != valueB) {
+				return valueA < valueB;
+			}
+		}
+		return a->first < b->first;
+	}
+
+private:
+	int column;
+	bool isAscending;
+};
+
+BEGIN_EVENT_TABLE(DiskUsageDialog, wxDialog)
+EVT_COMMAND(wxID_NONE, EVT_DISK_USAGE_DONE, DiskUsageDialog::OnScanDone)
+EVT_TIMER(ID_DISK_USAGE_TIMER, DiskUsageDialog::OnTimer)
+EVT_BUTTON(ID_DISK_USAGE_RESCAN_BUTTON, DiskUsageDialog::OnRescan)
+EVT_LIST_ITEM_SELECTED(ID_DISK_USAGE_MODS, DiskUsageDialog::OnModSelected)
+EVT_LIST_COL_CLICK(ID_DISK_USAGE_MODS, DiskUsageDialog::OnModColumnClicked)
+EVT_LIST_COL_CLICK(ID_DISK_USAGE_TYPES, DiskUsageDialog::OnTypeColumnClicked)
+END_EVENT_TABLE()
+
+DiskUsageDialog::DiskUsageDialog(wxWindow* parent, const wxString& tcPath,
+	const wxArrayString& mods, const wxString& selectedMod)
+: wxDialog(parent, wxID_ANY, _("Disk usage"), wxDefaultPosition, wxDefaultSize,
+	wxDEFAULT_DIALOG_STYLE | wxRESIZE_BORDER),
+  tcPath(tcPath), mods(mods), selectedMod(selectedMod),
+  timer(this, ID_DISK_USAGE_TIMER),
+  modColumn(MOD_COLUMN_ON_DISK), isModAscending(false),
+  typeColumn(TYPE_COLUMN_ON_DISK), isTypeAscending(false) {
+	this->status = new wxStaticText(this, wxID_ANY, wxEmptyString);
+
+	this->modList = new wxListCtrl(this, ID_DISK_USAGE_MODS, wxDefaultPosition,
+		wxSize(640, 220), wxLC_REPORT | wxLC_SINGLE_SEL);
+	this->modList->InsertColumn(MOD_COLUMN_NAME, _("Mod"), wxLIST_FORMAT_LEFT, 180);
+	this->modList->InsertColumn(MOD_COLUMN_FILES, _("Files"), wxLIST_FORMAT_RIGHT, 70);
+	this->modList->InsertColumn(MOD_COLUMN_SIZE, _("Size"), wxLIST_FORMAT_RIGHT, 75);
+	this->modList->InsertColumn(MOD_COLUMN_ON_DISK, _("On disk"), wxLIST_FORMAT_RIGHT, 75);
+	this->modList->InsertColumn(MOD_COLUMN_VP, _("VP"), wxLIST_FORMAT_RIGHT, 75);
+	this->modList->InsertColumn(MOD_COLUMN_DATA, _("Loose data"), wxLIST_FORMAT_RIGHT, 80);
+	this->modList->InsertColumn(MOD_COLUMN_OTHER, _("Other"), wxLIST_FORMAT_RIGHT, 75);
+
+	this->typeList = new wxListCtrl(this, ID_DISK_USAGE_TYPES, wxDefaultPosition,
+		wxSize(640, 160), wxLC_REPORT | wxLC_SINGLE_SEL);
+	this->typeList->InsertColumn(TYPE_COLUMN_NAME, _("Type"), wxLIST_FORMAT_LEFT, 180);
+	this->typeList->InsertColumn(TYPE_COLUMN_FILES, _("Files"), wxLIST_FORMAT_RIGHT, 70);
+	this->typeList->InsertColumn(TYPE_COLUMN_SIZE, _("Size"), wxLIST_FORMAT_RIGHT, 75);
+	this->typeList->InsertColumn(TYPE_COLUMN_ON_DISK, _("On disk"), wxLIST_FORMAT_RIGHT, 75);
+
+	this->rescan = new wxButton(this, ID_DISK_USAGE_RESCAN_BUTTON, _("Rescan"));
+	this->rescan->SetToolTip(_("Scan every folder again, as when files have been changed in place"));
+	wxButton* close = new wxButton(this, wxID_CANCEL, _("Close"));
+
+	wxBoxSizer* buttonSizer = new wxBoxSizer(wxHORIZONTAL);
+	buttonSizer->Add(this->rescan);
+	buttonSizer->AddSpacer(5);
+	buttonSizer->Add(close);
+
+	wxBoxSizer* sizer = new wxBoxSizer(wxVERTICAL);
+	sizer->Add(this->status, wxSizerFlags().Expand().Border(wxALL, 5));
+	sizer->Add(this->modList, wxSizerFlags(2).Expand().Border(wxLEFT | wxRIGHT, 5));
+	sizer->Add(new wxStaticText(this, wxID_ANY, _("File types in the selected mod:")),
+		wxSizerFlags().Border(wxALL, 5));
+	sizer->Add(this->typeList, wxSizerFlags(1).Expand().Border(wxLEFT | wxRIGHT, 5));
+	sizer->Add(buttonSizer, wxSizerFlags().Right().Border(wxALL, 5));
+	this->SetSizerAndFit(sizer);
+	this->CentreOnParent();
+
+	this->StartScan(true);
+}
+
+DiskUsageDialog::~DiskUsageDialog() {
+	this->timer.Stop();
+	DiskUsageScanner::Get().Cancel();
+}
+
+void DiskUsageDialog::StartScan(bool useCache) {
+	this->result = DiskUsageResult();
+	this->modOrder.clear();
+	this->modList->DeleteAllItems();
+	this->typeList->DeleteAllItems();
+	this->rescan->Disable();
+	this->status->SetLabel(_("Scanning..."));
+
+	this->timer.Start(DISK_USAGE_PROGRESS_INTERVAL);
+	DiskUsageScanner::Get().Start(this, this->tcPath, this->mods, useCache);
+}
+
+void DiskUsageDialog::OnTimer(wxTimerEvent& WXUNUSED(event)) {
+	uint64_t folders, files;
+	DiskUsageScanner::Get().GetProgress(folders, files);
+	this->status->SetLabel(wxString::Format(_("Scanning... %s folders, %s files"),
+		FormatCount(folders).c_str(), FormatCount(files).c_str()));
+}
+
+void DiskUsageDialog::OnScanDone(wxCommandEvent& WXUNUSED(event)) {
+	this->timer.Stop();
+	DiskUsageResult done;
+	if (!DiskUsageScanner::Get().TakeResult(done) || done.isCancelled) {
+		return;
+	}
+	this->result = done;
+	this->rescan->Enable();
+
+	UsageTotals total;
+	for (size_t i = 0; i < this->result.mods.size(); ++i) {
+		total.Add(this->result.mods[i].total);
+	}
+	this->status->SetLabel(wxString::Format(
+		_("%s files in %s folders, %s on disk (%s of data). Scanned in %.1f seconds; %s folders were unchanged."),
+		FormatCount(total.fileCount).c_str(),
+		FormatCount(this->result.folderCount).c_str(),
+		DiskUsageScanner::FormatSize(total.allocatedBytes).c_str(),
+		DiskUsageScanner::FormatSize(total.apparentBytes).c_str(),
+		this->result.milliseconds / 1000.0,
+		FormatCount(this->result.cachedFolderCount).c_str()));
+	this->Layout();
+
+	this->modOrder.clear();
+	for (size_t i = 0; i < this->result.mods.size(); ++i) {
+		this->modOrder.push_back(i);
+	}
+	this->FillMods();
+}
+
+void DiskUsageDialog::OnRescan(wxCommandEvent& WXUNUSED(event)) {
+	this->StartScan(false);
+}
+
+void DiskUsageDialog::OnModSelected(wxListEvent& event) {
+	const long row = event.GetIndex();
+	wxCHECK_RET(row >= 0 && static_cast<size_t>(row) < this->modOrder.size(),
+		_T("Selected a mod that isn't in the list"));
+	this->selectedMod = this->result.mods[this->modOrder[row]].shortname;
+	this->FillTypes();
+}
+
+/** Clicking the sorted column again reverses the order. Names sort A to Z
+ first, and sizes largest first. */
+void DiskUsageDialog::OnModColumnClicked(wxListEvent& event) {
+	const int column = event.GetColumn();
+	if (column < 0) {
+		return;
+	}
+	this->isModAscending = (column == this->modColumn) ?
+		!this->isModAscending : (column == MOD_COLUMN_NAME);
+	this->modColumn = column;
+	this->FillMods();
+}
+
+void DiskUsageDialog::OnTypeColumnClicked(wxListEvent& event) {
+	const int column = event.GetColumn();
+	if (column < 0) {
+		return;
+	}
+	this->isTypeAscending = (column == this->typeColumn) ?
+		!this->isTypeAscending : (column == TYPE_COLUMN_NAME);
+	this->typeColumn = column;
+	this->FillTypes();
+}
+
+void DiskUsageDialog::FillMods() {
+	std::stable_sort(this->modOrder.begin(), this->modOrder.end(),
+		ModOrder(this->result.mods, this->modColumn, this->isModAscending));
+
+	this->modList->Freeze();
+	this->modList->DeleteAllItems();
+	long selectedRow = -1;
+	for (size_t i = 0; i < this->modOrder.size(); ++i) {
+		const ModUsage& mod = this->result.mods[this->modOrder[i]];
+		const long row = this->modList->InsertItem(static_cast<long>(i), ModName(mod.shortname));
+		this->modList->SetItem(row, MOD_COLUMN_FILES, FormatCount(mod.total.fileCount));
+		this->modList->SetItem(row, MOD_COLUMN_SIZE, DiskUsageScanner::FormatSize(mod.total.apparentBytes));
+		this->modList->SetItem(row, MOD_COLUMN_ON_DISK, DiskUsageScanner::FormatSize(mod.total.allocatedBytes));
+		this->modList->SetItem(row, MOD_COLUMN_VP, DiskUsageScanner::FormatSize(mod.vp.allocatedBytes));
+		this->modList->SetItem(row, MOD_COLUMN_DATA, DiskUsageScanner::FormatSize(mod.data.allocatedBytes));
+		this->modList->SetItem(row, MOD_COLUMN_OTHER, DiskUsageScanner::FormatSize(mod.other.allocatedBytes));
+		if (mod.shortname == this->selectedMod) {
+			selectedRow = row;
+		}
+	}
+	this->modList->Thaw();
+
+	if (selectedRow == -1 && !this->modOrder.empty()) {
+		selectedRow = 0;
+	}
+	if (selectedRow != -1) {
+		this->selectedMod = this->result.mods[this->modOrder[selectedRow]].shortname;
+		this->modList->SetItemState(selectedRow,
+			wxLIST_STATE_SELECTED | wxLIST_STATE_FOCUSED,
+			wxLIST_STATE_SELECTED | wxLIST_STATE_FOCUSED);
+		this->modList->EnsureVisible(selectedRow);
+	}
+	this->FillTypes();
+}
+
+void DiskUsageDialog::FillTypes() {
+	std::vector<TypeIterator> types;
+	for (size_t i = 0; i < this->result.mods.size(); ++i) {
+		const ModUsage& mod = this->result.mods[i];
+		if (mod.shortname == this->selectedMod) {
+			for (TypeIterator it = mod.byType.begin(), end = mod.byType.end(); it != end; ++it) {
+				types.push_back(it);
+			}
+			break;
+		}
+	}
+	std::stable_sort(types.begin(), types.end(),
+		TypeOrder(this->typeColumn, this->isTypeAscending));
+
+	this->typeList->Freeze();
+	this->typeList->DeleteAllItems();
+	for (size_t i = 0; i < types.size(); ++i) {
+		const UsageTotals& totals = types[i]->second;
+		const long row = this->typeList->InsertItem(static_cast<long>(i), TypeName(types[i]->first));
+		this->typeList->SetItem(row, TYPE_COLUMN_FILES, FormatCount(totals.fileCount));
+		this->typeList->SetItem(row, TYPE_COLUMN_SIZE, DiskUsageScanner::FormatSize(totals.apparentBytes));
+		this->typeList->SetItem(row, TYPE_COLUMN_ON_DISK, DiskUsageScanner::FormatSize(totals.allocatedBytes));
+	}
+	this->typeList->Thaw();
+}
@@ -0,0 +1,73 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#ifndef DISKUSAGEDIALOG_H
+#define DISKUSAGEDIALOG_H
+
+#include <vector>
+
+#include <wx/wx.h>
+#include <wx/listctrl.h>
+
+#include "apis/DiskUsage.h"
+
+/** DiskUsageDialog - shows how much disk each mod of the TC uses, and what
+ kinds of files make it up, as scanned by DiskUsageScanner. The scan runs
+ while the dialog is open; both lists sort by the column clicked. */
+class DiskUsageDialog: public wxDialog {
+public:
+	/** mods are the shortnames of the TC's mods, the empty one for the TC's
+	 own folder. selectedMod is shown first. */
+	DiskUsageDialog(wxWindow* parent, const wxString& tcPath,
+		const wxArrayString& mods, const wxString& selectedMod);
+	~DiskUsageDialog();
+
+	void OnScanDone(wxCommandEvent& event);
+	void OnTimer(wxTimerEvent& event);
+	void OnRescan(wxCommandEvent& event);
+	void OnModSelected(wxListEvent& event);
+	void OnModColumnClicked(wxListEvent& event);
+	void OnTypeColumnClicked(wxListEvent& event);
+
+private:
+	void StartScan(bool useCache);
+	void FillMods();
+	void FillTypes();
+
+	wxString tcPath;
+	wxArrayString mods;
+	wxString selectedMod;
+
+	wxStaticText* status;
+	wxListCtrl* modList;
+	wxListCtrl* typeList;
+	wxButton* rescan;
+	wxTimer timer;
+
+	DiskUsageResult result;
+	std::vector<size_t> modOrder; //!< indexes into result.mods, as shown
+	int modColumn;
+	bool isModAscending;
+	int typeColumn;
+	bool isTypeAscending;
+
+	DECLARE_EVENT_TABLE()
+};
+
+#endif
@@ -0,0 +1,171 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#include <wx/wx.h>
+
+#include "apis/LaunchEnvironment.h"
+#include "apis/ProfileManager.h"
+#include "controls/EnvironmentDialog.h"
+#include "global/ids.h"
+#include "global/ProfileKeys.h"
+
+#include "global/MemoryDebugging.h"
+
+BEGIN_EVENT_TABLE(EnvironmentDialog, wxDialog)
+EVT_TEXT(ID_ENVIRONMENT_TEXT, EnvironmentDialog::OnTextChanged)
+EVT_BUTTON(ID_ENVIRONMENT_ADD_TEMPLATE_BUTTON, EnvironmentDialog::OnAddTemplate)
+EVT_CHOICE(ID_ENVIRONMENT_COMPARE_CHOICE, EnvironmentDialog::OnSelectCompareProfile)
+EVT_BUTTON(wxID_OK, EnvironmentDialog::OnOK)
+END_EVENT_TABLE()
+
+EnvironmentDialog::EnvironmentDialog(wxWindow* parent)
+: wxDialog(parent, wxID_ANY, _("Launch environment"), wxDefaultPosition, wxDefaultSize,
+	wxDEFAULT_DIALOG_STYLE | wxRESIZE_BORDER) {
+	ProMan* proman = ProMan::GetProfileManager();
+	this->profileName = proman->GetCurrentName();
+	this->SetTitle(wxString::Format(_("Launch environment for %s"),
+		this->profileName.c_str()));
+
+	wxString environment;
+	proman->ProfileRead(PKEY_LAUNCH_ENVIRONMENT, &environment);
+
+	wxStaticText* explanation = new wxStaticText(this, wxID_ANY,
+		_("Environment variables to set for the game, one NAME=value per line. "
+		  "Lines starting with # are ignored, and $VARIABLE is replaced with the "
+		  "launcher's own variable."));
+	explanation->Wrap(480);
+	this->text = new wxTextCtrl(this, ID_ENVIRONMENT_TEXT, environment,
+		wxDefaultPosition, wxSize(480, 160), wxTE_MULTILINE | wxHSCROLL);
+	this->errorText = new wxStaticText(this, wxID_ANY, wxEmptyString);
+	this->errorText->SetForegroundColour(*wxRED);
+
+	this->templateChoice = new wxChoice(this, ID_ENVIRONMENT_TEMPLATE_CHOICE);
+	for (size_t i = 0; i < LaunchEnvironment::GetTemplateCount(); ++i) {
+		this->templateChoice->Append(LaunchEnvironment::GetTemplateName(i));
+	}
+	this->templateChoice->SetSelection(0);
+	wxButton* addTemplate = new wxButton(this, ID_ENVIRONMENT_ADD_TEMPLATE_BUTTON, _("Add"));
+	addTemplate->SetToolTip(_("Add the template's variables, replacing the lines that set the same variables"));
+
+	wxBoxSizer* templateSizer = new wxBoxSizer(wxHORIZONTAL);
+	templateSizer->Add(new wxStaticText(this, wxID_ANY, _("Template:")),
+		wxSizerFlags().Center().Border(wxRIGHT, 5));
+	templateSizer->Add(this->templateChoice, wxSizerFlags(1).Center().Border(wxRIGHT, 5));
+	templateSizer->Add(addTemplate, wxSizerFlags().Center());
+
+	this->compareChoice = new wxChoice(this, ID_ENVIRONMENT_COMPARE_CHOICE);
+	const wxArrayString profiles(proman->GetAllProfileNames());
+	for (size_t i = 0; i < profiles.GetCount(); ++i) {
+		if (profiles[i] != this->profileName) {
+			this->compareChoice->Append(profiles[i]);
+		}
+	}
+	this->comparison = new wxTextCtrl(this, wxID_ANY, wxEmptyString,
+		wxDefaultPosition, wxSize(480, 80), wxTE_MULTILINE | wxTE_READONLY);
+	if (this->compareChoice->GetCount() == 0) {
+		this->compareChoice->Disable();
+		this->comparison->Disable();
+	} else {
+		this->compareChoice->SetSelection(0);
+	}
+
+	wxBoxSizer* compareSizer = new wxBoxSizer(wxHORIZONTAL);
+	compareSizer->Add(new wxStaticText(this, wxID_ANY, _("Compare with:")),
+		wxSizerFlags().Center().Border(wxRIGHT, 5));
+	compareSizer->Add(this->compareChoice, wxSizerFlags(1).Center());
+
+	wxBoxSizer* sizer = new wxBoxSizer(wxVERTICAL);
+	sizer->Add(explanation, wxSizerFlags().Border(wxALL, 5));
+	sizer->Add(this->text, wxSizerFlags(2).Expand().Border(wxLEFT | wxRIGHT, 5));
+	sizer->Add(this->errorText, wxSizerFlags().Expand().Border(wxALL, 5));
+	sizer->Add(templateSizer, wxSizerFlags().Expand().Border(wxLEFT | wxRIGHT | wxBOTTOM, 5));
+	sizer->Add(compareSizer, wxSizerFlags().Expand().Border(wxLEFT | wxRIGHT | wxBOTTOM, 5));
+	sizer->Add(this->comparison, wxSizerFlags(1).Expand().Border(wxLEFT | wxRIGHT, 5));
+	sizer->Add(this->CreateButtonSizer(wxOK | wxCANCEL), wxSizerFlags().Right().Border(wxALL, 5));
+	this->SetSizerAndFit(sizer);
+	this->CentreOnParent();
+
+	this->UpdateErrors();
+	this->UpdateComparison();
+}
+
+void EnvironmentDialog::UpdateErrors() {
+	EnvironmentVariables variables;
+	wxArrayString errors;
+	if (LaunchEnvironment::Parse(this->text->GetValue(), variables, errors)) {
+		this->errorText->SetLabel(wxEmptyString);
+	} else if (errors.GetCount() == 1) {
+		this->errorText->SetLabel(errors[0]);
+	} else {
+		this->errorText->SetLabel(wxString::Format(_("%s, and %lu more lines that can't be used"),
+			errors[0].c_str(), static_cast<unsigned long>(errors.GetCount() - 1)));
+	}
+}
+
+void EnvironmentDialog::UpdateComparison() {
+	const int selection = this->compareChoice->GetSelection();
+	if (selection == wxNOT_FOUND) {
+		return;
+	}
+	const wxString otherName(this->compareChoice->GetString(selection));
+	wxString otherEnvironment;
+	ProMan::GetProfileManager()->ProfileReadFrom(otherName,
+		PRO_CFG_LAUNCH_ENVIRONMENT, &otherEnvironment);
+	this->comparison->ChangeValue(LaunchEnvironment::Compare(
+		this->text->GetValue(), this->profileName, otherEnvironment, otherName));
+}
+
+void EnvironmentDialog::OnTextChanged(wxCommandEvent& WXUNUSED(event)) {
+	this->UpdateErrors();
+	this->UpdateComparison();
+}
+
+void EnvironmentDialog::OnAddTemplate(wxCommandEvent& WXUNUSED(event)) {
+	const int selection = this->templateChoice->GetSelection();
+	wxCHECK_RET(selection != wxNOT_FOUND, _T("no environment template is selected"));
+	// SetValue() sends the text event, which updates the rest
+	this->text->SetValue(LaunchEnvironment::AddTemplate(this->text->GetValue(),
+		static_cast<size_t>(selection)));
+	this->text->SetInsertionPointEnd();
+}
+
+void EnvironmentDialog::OnSelectCompareProfile(wxCommandEvent& WXUNUSED(event)) {
+	this->UpdateComparison();
+}
+
+void EnvironmentDialog::OnOK(wxCommandEvent& WXUNUSED(event)) {
+	const wxString environment(this->text->GetValue());
+	EnvironmentVariables variables;
+	wxArrayString errors;
+	if (!LaunchEnvironment::Parse(environment, variables, errors)) {
+		wxString message(_("These lines can't be used and will be skipped when the game is launched:\n"));
+		for (size_t i = 0; i < errors.GetCount(); ++i) {
+			message += _T("\n") + errors[i];
+		}
+		message += _("\n\nSave the environment anyway?");
+		if (wxMessageBox(message, _("Launch environment"), wxYES_NO | wxICON_WARNING, this) != wxYES) {
+			return;
+		}
+	}
+
+	ProMan::GetProfileManager()->ProfileWrite(PRO_CFG_LAUNCH_ENVIRONMENT, environment);
+	wxLogDebug(_T("Profile %s now launches with %lu environment variables"),
+		this->profileName.c_str(), static_cast<unsigned long>(variables.size()));
+	this->EndModal(wxID_OK);
+}
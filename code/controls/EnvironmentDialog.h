@@ -0,0 +1,52 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#ifndef ENVIRONMENTDIALOG_H
+#define ENVIRONMENTDIALOG_H
+
+#include <wx/wx.h>
+
+/** EnvironmentDialog - edits the environment variables that the current
+ profile launches the game with, as read by LaunchEnvironment. The built-in
+ templates can be added to it, and it can be compared with another
+ profile's. The profile is only written when OK is pressed. */
+class EnvironmentDialog: public wxDialog {
+public:
+	explicit EnvironmentDialog(wxWindow* parent);
+
+	void OnTextChanged(wxCommandEvent& event);
+	void OnAddTemplate(wxCommandEvent& event);
+	void OnSelectCompareProfile(wxCommandEvent& event);
+	void OnOK(wxCommandEvent& event);
+
+private:
+	void UpdateErrors();
+	void UpdateComparison();
+
+	wxString profileName;
+	wxTextCtrl* text;
+	wxStaticText* errorText;
+	wxChoice* templateChoice;
+	wxChoice* compareChoice;
+	wxTextCtrl* comparison;
+
+	DECLARE_EVENT_TABLE()
+};
+
+#endif
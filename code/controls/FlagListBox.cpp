@@ -18,6 +18,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 #include "generated/configure_launcher.h"
 #include "controls/FlagListBox.h"
+#include "apis/EventDispatcher.h"
 #include "apis/ProfileProxy.h"
 #include "apis/SkinManager.h"
 #include "global/ids.h"
@@ -325,6 +326,25 @@ void FlagListBox::LoadEnabledFlags() {
 	this->flagsLoaded = true;
 }
 
+void FlagListBox::UnloadEnabledFlags() {
+	wxCHECK_RET(this->IsReady(),
+		_T("UnloadEnabledFlags() called when flag list box is not ready."));
+	
+	for (FlagListCheckBoxItems::iterator
+		 it = this->checkBoxes.begin(), end = this->checkBoxes.end();
+		 it != end;
+		 ++it) {
+		FlagListCheckBoxItem* item = *it;
+		
+		if (item->GetCheckBox() != NULL) {
+			item->GetCheckBox()->SetValue(false);
+		}
+	}
+	
+	this->flagsLoaded = false;
+	this->Refresh();
+}
+
 bool FlagListBox::SetFlag(
 	 const wxString& flagString, const bool state, const bool updateProxy) {
 	wxCHECK_MSG(this->IsReady(), false,
@@ -367,6 +387,9 @@ bool FlagListBox::SetFlagSet(const wxString& setToFind) {
 		return false;
 	}
 
+	// each SetFlag() announces a command line change; deliver just one
+	EventBatch batch;
+
 	wxArrayString::const_iterator disableIter =
 		flagSet->flagsToDisable.begin();
 	while ( disableIter != flagSet->flagsToDisable.end() ) {
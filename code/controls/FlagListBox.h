@@ -82,6 +82,10 @@ public:
 	/** Loads enabled flags from the proxy and checks the corresponding boxes. */
 	void LoadEnabledFlags();
 	
+	/** Unchecks every box without touching the proxy, so that the enabled
+	 flags of another profile can be loaded. */
+	void UnloadEnabledFlags();
+	
 	/** Tries to find the flagSet specified and then set or unset all flags
 	contained in the flag set, returns true on success, returns false
 	iff it cannot find the flagset.  That is, will return true if none of
@@ -0,0 +1,89 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <wx/wx.h>
+
+#include "controls/GameConsole.h"
+#include "apis/GameSupervisor.h"
+#include "apis/SkinManager.h"
+#include "generated/configure_launcher.h"
+
+#include "global/MemoryDebugging.h"
+
+GameConsole::GameConsole(wxWindow* parent)
+: wxFrame(parent, wxID_ANY, _T("Game console"), wxDefaultPosition, wxSize(640, 400)),
+  lineCount(0) {
+	this->text = new wxTextCtrl(this, wxID_ANY, wxEmptyString,
+		wxDefaultPosition, wxDefaultSize,
+		wxTE_MULTILINE | wxTE_READONLY | wxTE_DONTWRAP | wxTE_RICH2);
+	this->text->SetFont(wxFont(9, wxFONTFAMILY_TELETYPE, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL));
+
+	wxBoxSizer* sizer = new wxBoxSizer(wxVERTICAL);
+	sizer->Add(this->text, wxSizerFlags(1).Expand());
+	this->SetSizer(sizer);
+
+#if IS_WIN32 || IS_LINUX
+	this->SetIcon(SkinSystem::GetSkinSystem()->GetWindowIcon());
+#endif
+}
+
+BEGIN_EVENT_TABLE(GameConsole, wxFrame)
+EVT_CLOSE(GameConsole::OnClose)
+END_EVENT_TABLE()
+
+void GameConsole::SetLines(const wxString& title, const std::deque<wxString>& lines) {
+	this->SetTitle(title);
+
+	wxString contents;
+	for (std::deque<wxString>::const_iterator it = lines.begin(), end = lines.end();
+			it != end; ++it) {
+		contents += *it;
+		contents += _T("\n");
+	}
+	this->text->ChangeValue(contents);
+	this->lineCount = lines.size();
+	this->text->ShowPosition(this->text->GetLastPosition());
+}
+
+void GameConsole::AppendLines(const wxString& text) {
+	this->text->AppendText(text + _T("\n"));
+	this->lineCount += text.Freq(_T('\n')) + 1;
+	this->Trim();
+}
+
+/** Removes the oldest lines once there are more than GAME_CONSOLE_MAX_LINES. */
+void GameConsole::Trim() {
+	if (this->lineCount <= GAME_CONSOLE_MAX_LINES) {
+		return;
+	}
+	const size_t excess = this->lineCount - GAME_CONSOLE_MAX_LINES;
+	const long end = this->text->XYToPosition(0, static_cast<long>(excess));
+	if (end > 0) {
+		this->text->Remove(0, end);
+		this->lineCount = GAME_CONSOLE_MAX_LINES;
+	}
+}
+
+void GameConsole::OnClose(wxCloseEvent& event) {
+	if (event.CanVeto()) {
+		event.Veto();
+		this->Hide();
+	} else {
+		this->Destroy();
+	}
+}
@@ -0,0 +1,50 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef GAMECONSOLE_H
+#define GAMECONSOLE_H
+
+#include <deque>
+
+#include <wx/wx.h>
+
+/** GameConsole - a window showing the output of the game, as captured by
+ GameSupervisor. Like the supervisor's buffer it only keeps the most recent
+ lines. Closing the window hides it, so that it can be shown again with its
+ contents intact. */
+class GameConsole: public wxFrame {
+public:
+	explicit GameConsole(wxWindow* parent);
+
+	/** Replaces the contents with lines, such as when a new session starts. */
+	void SetLines(const wxString& title, const std::deque<wxString>& lines);
+	/** Adds lines separated by '\n' to the end. */
+	void AppendLines(const wxString& text);
+
+	void OnClose(wxCloseEvent& event);
+
+private:
+	void Trim();
+
+	wxTextCtrl* text;
+	size_t lineCount;
+
+	DECLARE_EVENT_TABLE()
+};
+
+#endif
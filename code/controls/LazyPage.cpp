@@ -0,0 +1,49 @@
+/*
+Copyright (C) 2026 wxLauncher Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#include <wx/wx.h>
+
+#include "controls/LazyPage.h"
+#include "global/StartupProfiler.h"
+
+#include "global/MemoryDebugging.h" // Last include for memory debugging
+
+LazyPage::LazyPage(wxWindow* parent, PageFactory factory, const wxString& name)
+: wxPanel(parent, wxID_ANY), factory(factory), name(name), page(NULL) {
+	wxASSERT(factory != NULL);
+}
+
+wxWindow* LazyPage::Build() {
+	if (this->IsBuilt()) {
+		return this->page;
+	}
+
+	wxLogDebug(_T("Building %s"), this->name.c_str());
+	StartupProbe probe(this->name);
+
+	this->Freeze();
+	this->page = this->factory(this);
+
+	wxBoxSizer* sizer = new wxBoxSizer(wxVERTICAL);
+	sizer->Add(this->page, wxSizerFlags().Proportion(1).Expand());
+	this->SetSizer(sizer);
+	this->Layout();
+	this->Thaw();
+
+	return this->page;
+}
@@ -0,0 +1,49 @@
+/*
+Copyright (C) 2026 wxLauncher Team
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+*/
+
+#ifndef LAZYPAGE_H
+#define LAZYPAGE_H
+
+#include <wx/wx.h>
+
+/** Placeholder notebook page that builds the real page inside itself the
+first time Build() is called. */
+class LazyPage: public wxPanel {
+public:
+	/** Creates the real page as a child of parent. */
+	typedef wxWindow* (*PageFactory)(wxWindow* parent);
+
+	LazyPage(wxWindow* parent, PageFactory factory, const wxString& name);
+
+	/** Builds the page if it has not been built yet. Returns the page. */
+	wxWindow* Build();
+	bool IsBuilt() const { return this->page != NULL; }
+
+private:
+	PageFactory factory;
+	wxString name; //!< for the log and the startup profiler
+	wxWindow* page;
+};
+
+/** PageFactory for a page class whose constructor takes just the parent. */
+template <class Page>
+wxWindow* CreateLazyPage(wxWindow* parent) {
+	return new Page(parent);
+}
+
+#endif
@@ -17,54 +17,167 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 */
 
 #include <wx/wx.h>
-#include <wx/wfstream.h>
-#include <wx/datetime.h>
 #include <wx/filename.h>
 #include <wx/stdpaths.h>
+#include <wx/thread.h>
+#include <wx/wfstream.h>
+#include <wx/zstream.h>
 
-#include <wchar.h>
+#include <chrono>
+#include <cstring>
+#include <ctime>
 
 #include "controls/Logger.h"
 #include "controls/StatusBar.h"
+#include "generated/configure_launcher.h"
+#include "global/LogRingBuffer.h"
 
 #include "global/MemoryDebugging.h"
 
+LAUNCHER_DEFINE_EVENT_TYPE(EVT_LOG_STATUS_MESSAGE);
+
 ////// Logger
-const wxString levels[] = {
-	wxT_2("FATAL"),
-	wxT_2("ERROR"),
-	wxT_2("WARN "),
-	wxT_2("MSG  "),
-	wxT_2("STSBR"),
-	wxT_2("INFO "),
-	wxT_2("DEBUG"),
+const char* const levels[] = {
+	"FATAL",
+	"ERROR",
+	"WARN ",
+	"MSG  ",
+	"STSBR",
+	"INFO ",
+	"DEBUG",
 };
-/** Constructor. */
-Logger::Logger() {
+const size_t LOG_BUFFER_CAPACITY = 4096;
+/** How often the writer thread wakes up on its own to write out the buffer. */
+const int LOG_FLUSH_INTERVAL_MS = 500;
+/** Size at which the log file is archived and a new one started, so that a
+ long session can't fill the disk. */
+const size_t LOG_MAX_FILE_SIZE = 4 * 1024 * 1024;
+/** Number of archived logs (wxLauncher.1.log.gz being the newest) to keep. */
+const int LOG_ARCHIVE_COUNT = 5;
+
+/** Returns the path of archive number n, next to the log file. */
+static wxString GetArchivedLogPath(const wxString& logFilePath, int n) {
+	wxFileName archiveName(logFilePath);
+	archiveName.SetFullName(wxString::Format(wxT_2("wxLauncher.%d.log.gz"), n));
+	return archiveName.GetFullPath();
+}
+
+/** Writes a gzip-compressed copy of source to destination. */
+static bool CompressFile(const wxString& source, const wxString& destination) {
+	wxFFileInputStream in(source);
+	if (!in.IsOk()) {
+		return false;
+	}
+	wxFFileOutputStream out(destination);
+	if (!out.IsOk()) {
+		return false;
+	}
+	wxZlibOutputStream zout(out, -1, wxZLIB_GZIP);
+	zout.Write(in);
+	const bool isCompressed = zout.Close() && in.GetLastError() == wxSTREAM_EOF;
+	return out.Close() && isCompressed;
+}
+
+/** Opens a new log file and writes the UTF-8 byte order mark. */
+static FILE* OpenLogFile(const wxString& path) {
+#if IS_WIN32
+	FILE* file = _wfopen(path.wc_str(), L"wb");
+#else
+	FILE* file = fopen(path.fn_str(), "wb");
+#endif
+	if (file != NULL) {
+		fwrite("\357\273\277", 1, 3, file);
+	}
+	return file;
+}
+
+/** Plain rename, as wxRenameFile() may log, which mustn't happen while the
+ log file is locked. */
+static bool RenameLogFile(const wxString& from, const wxString& to) {
+#if IS_WIN32
+	return _wrename(from.wc_str(), to.wc_str()) == 0;
+#else
+	return rename(from.fn_str(), to.fn_str()) == 0;
+#endif
+}
+
+/** Formats a line of the log file from text in UTF-8. The time is written
+ in GMT, as the year, the day of the year, and the time of day. */
+static std::string FormatLine(unsigned long level, time_t time, const char* text) {
+	struct tm parts;
+#if IS_WIN32
+	gmtime_s(&parts, &time);
+#else
+	gmtime_r(&time, &parts);
+#endif
+	char stamp[16];
+	strftime(stamp, sizeof(stamp), "%y%j%H%M%S", &parts);
+
+	const size_t levelIndex = (level < WXSIZEOF(levels)) ? level : WXSIZEOF(levels) - 1;
+	std::string line(stamp);
+	line += ':';
+	line += levels[levelIndex];
+	line += ':';
+	line += text;
+	line += '\n';
+	return line;
+}
+
+/** Constructor. The previous session's log is moved aside and then
+ archived on the first Flush(), so that it survives the restart without
+ holding up startup. */
+Logger::Logger()
+: statusBar(NULL), buffer(new LogRingBuffer(LOG_BUFFER_CAPACITY)),
+droppedCount(0), isFlushRequested(false), isStopping(false),
+outFile(NULL), fileSize(0), isNewFileDue(false), isArchivePending(false) {
 	wxFileName outFileName(wxStandardPaths::Get().GetUserDataDir(), wxT_2("wxLauncher.log"));
 	if (!outFileName.DirExists() && 
 		!wxFileName::Mkdir(outFileName.GetPath(), 0700, wxPATH_MKDIR_FULL) ) {
 			wxLogFatalError(_("Unable to create folder to place log in. (%s)"), outFileName.GetPath().c_str());
 	}
 
-	this->outFile = new wxFFile(outFileName.GetFullPath(), wxT_2("wb"));
-	if (!outFile->IsOpened()) {
-		wxLogFatalError(_("Unable to open log output file. (%s)"), outFileName.GetFullPath().c_str());
+	this->logFilePath = outFileName.GetFullPath();
+	wxFileName previousName(outFileName);
+	previousName.SetFullName(wxT_2("wxLauncher.previous.log"));
+	this->previousLogFilePath = previousName.GetFullPath();
+
+	// only left over if the launcher exited while archiving it last time
+	if (wxFileName::FileExists(this->previousLogFilePath)) {
+		this->ArchivePreviousLog();
+	}
+	if (wxFileName::FileExists(this->logFilePath)) {
+		this->isArchivePending =
+			wxRenameFile(this->logFilePath, this->previousLogFilePath);
+	}
+
+	this->outFile = OpenLogFile(this->logFilePath);
+	if (this->outFile == NULL) {
+		wxLogFatalError(_("Unable to open log output file. (%s)"), this->logFilePath.c_str());
 	}
-	this->out = new wxFFileOutputStream(*outFile);
-	wxASSERT_MSG(out->IsOk(), wxT_2("Log output file is not valid!"));
-	this->out->Write("\357\273\277", 3);
+	this->fileSize = 3;
 
-	this->statusBar = NULL;
+	this->writer = std::thread(&Logger::WriterLoop, this);
 }
 
-/** Destructor. */
+/** Destructor. Stops the writer thread and writes out whatever is left. */
 Logger::~Logger() {
-	char exitmsg[] = "\nLog closed.\n";
-	this->out->Write(exitmsg, strlen(exitmsg));
-	this->out->Close();
-	delete this->out;
-	delete this->outFile;
+	{
+		std::lock_guard<std::mutex> lock(this->wakeMutex);
+		this->isStopping.store(true);
+	}
+	this->wakeCondition.notify_one();
+	if (this->writer.joinable()) {
+		this->writer.join();
+	}
+
+	std::lock_guard<std::mutex> lock(this->fileMutex);
+	this->Drain();
+	if (this->outFile != NULL) {
+		this->Write("\nLog closed.\n");
+		fclose(this->outFile);
+		this->outFile = NULL;
+	}
+	delete this->buffer;
 }
 
 /** Overridden as per wxWidgets docs to implement a wxLog. */
@@ -75,47 +188,202 @@ void Logger::DoLog(
 		const wxChar *msg,
 		time_t time)
 {
-	wxString timestr = wxDateTime(time).Format(
-		wxT_2("%y%j%H%M%S"),
-		wxDateTime::GMT0);
+	wxString buf(msg);
+	this->Enqueue(level, buf, time);
+	this->SendToStatusBar(level, buf);
+}
 #else
 void Logger::DoLogRecord(
 	wxLogLevel level,
 	const wxString& msg,
 	const wxLogRecordInfo& info)
 {
-	wxString timestr = wxDateTime(info.timestamp).Format(
-		wxT_2("%y%j%H%M%S"),
-		wxDateTime::GMT0);
+	this->Enqueue(level, msg, info.timestamp);
+	this->SendToStatusBar(level, msg);
+}
 #endif
-	wxString str = wxString::Format(
-    wxT_2("%s:%s:"), timestr.c_str(), levels[level].c_str());
-	wxString buf(msg);
-	out->Write(str.mb_str(wxConvUTF8), str.size());
-	out->Write(buf.mb_str(wxConvUTF8), buf.size());
-	out->Write("\n", 1);
-
-	if ( this->statusBar != NULL ) {
-		if ( level == 1 ) { // error
-			this->statusBar->SetMainStatusText(buf, ID_SB_ERROR);
-		} else if ( level == 2 ) { // warning
-			this->statusBar->SetMainStatusText(buf, ID_SB_WARNING);
-		} else if ( level == 3 || level == 4 ) { // message, statubar
-			this->statusBar->SetMainStatusText(buf, ID_SB_OK);
-		} else if ( level == 5 ) { // info
-			this->statusBar->SetMainStatusText(buf, ID_SB_INFO);
+
+void Logger::Enqueue(wxLogLevel level, const wxString& msg, time_t time) {
+	const wxCharBuffer utf8(msg.mb_str(wxConvUTF8));
+	LogEntry entry;
+	entry.text = FormatLine(level, time, (utf8.data() != NULL) ? utf8.data() : "");
+
+	if (level <= wxLOG_Error) {
+		// on disk before returning, since a crash or abort may follow
+		this->WriteNow(entry.text);
+		return;
+	}
+	if (!this->buffer->TryPush(entry)) {
+		this->droppedCount.fetch_add(1, std::memory_order_relaxed);
+		this->WakeWriter();
+	}
+}
+
+void Logger::WriteNow(const std::string& line) {
+	std::lock_guard<std::mutex> lock(this->fileMutex);
+	// keep the log in order: whatever was logged before the error goes first
+	this->Drain();
+	this->Write(line);
+	if (this->outFile != NULL) {
+		fflush(this->outFile);
+	}
+}
+
+void Logger::SendToStatusBar(wxLogLevel level, const wxString& msg) {
+	StatusBar* bar = this->statusBar.load();
+	if ( bar == NULL ) {
+		return;
+	}
+
+	int icon;
+	if ( level == 1 ) { // error
+		icon = ID_SB_ERROR;
+	} else if ( level == 2 ) { // warning
+		icon = ID_SB_WARNING;
+	} else if ( level == 3 || level == 4 ) { // message, statubar
+		icon = ID_SB_OK;
+	} else if ( level == 5 ) { // info
+		icon = ID_SB_INFO;
+	} else {
+		return;
+	}
+
+	if (wxThread::IsMain()) {
+		bar->SetMainStatusText(msg, icon);
+	} else {
+		wxCommandEvent event(EVT_LOG_STATUS_MESSAGE, wxID_NONE);
+		event.SetString(wxString(msg.c_str())); // not shared with this thread
+		event.SetInt(icon);
+		bar->AddPendingEvent(event);
+	}
+}
+
+/** Producers don't take the mutex, so a wake-up can be missed if the writer
+ is just about to wait; it then writes the message out on its next periodic
+ wake-up instead. */
+void Logger::WakeWriter() {
+	this->isFlushRequested.store(true);
+	this->wakeCondition.notify_one();
+}
+
+void Logger::WriterLoop() {
+	std::unique_lock<std::mutex> lock(this->wakeMutex);
+	while (!this->isStopping.load()) {
+		if (!this->isFlushRequested.load()) {
+			this->wakeCondition.wait_for(lock,
+				std::chrono::milliseconds(LOG_FLUSH_INTERVAL_MS));
+		}
+		this->isFlushRequested.store(false);
+
+		lock.unlock();
+		{
+			std::lock_guard<std::mutex> fileLock(this->fileMutex);
+			this->Drain();
+		}
+		lock.lock();
+	}
+}
+
+void Logger::Drain() {
+	bool isWritten = false;
+	LogEntry entry;
+	while (this->buffer->TryPop(entry)) {
+		this->Write(entry.text);
+		isWritten = true;
+	}
+
+	const unsigned long dropped = this->droppedCount.exchange(0);
+	if (dropped > 0) {
+		const std::string note(std::to_string(dropped)
+			+ " log messages were dropped because the log buffer was full.");
+		this->Write(FormatLine(wxLOG_Warning, time(NULL), note.c_str()));
+		isWritten = true;
+	}
+
+	if (isWritten && this->outFile != NULL) {
+		fflush(this->outFile);
+	}
+	if (this->fileSize >= LOG_MAX_FILE_SIZE) {
+		this->isNewFileDue.store(true);
+	}
+}
+
+/** stdio buffers the writes, so lines are written one at a time. */
+void Logger::Write(const std::string& line) {
+	if (this->outFile != NULL) {
+		fwrite(line.data(), 1, line.size(), this->outFile);
+		this->fileSize += line.size();
+	}
+}
+
+/** Archives the full log file and carries on in an empty one. */
+void Logger::StartNewLogFile() {
+	bool isRenamed = false;
+	{
+		std::lock_guard<std::mutex> lock(this->fileMutex);
+		this->Drain();
+		if (this->outFile != NULL) {
+			this->Write(FormatLine(wxLOG_Info, time(NULL),
+				"Log file size limit reached, continuing in a new log file."));
+			fclose(this->outFile);
 		}
-	}		
+		isRenamed = RenameLogFile(this->logFilePath, this->previousLogFilePath);
+
+		// if this fails, nothing more can be logged; Write() drops the lines
+		this->outFile = OpenLogFile(this->logFilePath);
+		this->fileSize = 3;
+		this->Write(FormatLine(wxLOG_Info, time(NULL),
+			"Continued from the log archived as wxLauncher.1.log.gz."));
+		this->isNewFileDue.store(false);
+	}
+	if (isRenamed) {
+		this->ArchivePreviousLog();
+	}
 }
 
+/** Shifts the archives up by one, dropping the oldest, then compresses the
+ previous log file into archive 1. Runs on the main thread, without the
+ log file locked, as it uses wx's file functions, which may log. */
+void Logger::ArchivePreviousLog() {
+	const wxString oldest(GetArchivedLogPath(this->logFilePath, LOG_ARCHIVE_COUNT));
+	if (wxFileName::FileExists(oldest)) {
+		wxRemoveFile(oldest);
+	}
+	for (int i = LOG_ARCHIVE_COUNT - 1; i >= 1; --i) {
+		const wxString archive(GetArchivedLogPath(this->logFilePath, i));
+		if (wxFileName::FileExists(archive)) {
+			wxRenameFile(archive, GetArchivedLogPath(this->logFilePath, i + 1));
+		}
+	}
+
+	if (!CompressFile(this->previousLogFilePath,
+			GetArchivedLogPath(this->logFilePath, 1))) {
+		wxLogWarning(_T("Unable to compress the previous log file; it has been discarded."));
+	}
+	// removed even on failure, so that the logs on disk stay bounded
+	wxRemoveFile(this->previousLogFilePath);
+}
+
+/** Asks the writer thread to write out what it has buffered. wxWidgets calls
+ this from the main loop, so it must not wait for the write; the archiving
+ it does is of a few MB at most, and only once a session or per full log. */
 void Logger::Flush() {
-	outFile->Flush(); // Warning: ignoring return value from Flush().	
+	this->WakeWriter();
+	if (!wxThread::IsMain()) {
+		return;
+	}
+	if (this->isArchivePending) {
+		this->isArchivePending = false;
+		this->ArchivePreviousLog();
+	}
+	if (this->isNewFileDue.load()) {
+		this->StartNewLogFile();
+	}
 }
 
 /** Stores the pointer the status bar that I am to send status messages to.
 If a status bar is already set, function will do nothing to the old statusbar.
 Logger does not take over managment of the statusbar passed in. */
 void Logger::SetStatusBarTarget(StatusBar *bar) {
-	this->statusBar = bar;
+	this->statusBar.store(bar);
 }
-
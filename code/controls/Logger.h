@@ -19,10 +19,36 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #ifndef LAUNCHERLOGGER_H
 #define LAUNCHERLOGGER_H
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+
 #include <wx/wx.h>
-#include <wx/wfstream.h>
+#include "apis/EventHandlers.h"
 #include "controls/StatusBar.h"
 
+class LogRingBuffer;
+
+/** A status bar message logged from a thread other than the main one.
+ The string is the message and the int is the status bar icon. */
+LAUNCHER_DECLARE_EVENT_TYPE(EVT_LOG_STATUS_MESSAGE);
+
+/** Logger - writes the log file and forwards messages to the status bar.
+ The logging thread formats each message into a UTF-8 line of the log file
+ and pushes it onto a ring buffer; a writer thread writes the lines out in
+ batches with plain stdio, flushing the file periodically. The writer does
+ nothing else, so it never calls into wx. If the buffer fills up, messages
+ are dropped and the number dropped is written to the log once there is
+ room again. Errors are never dropped: the thread logging one writes out
+ the buffer and then the error itself before it returns, so that the
+ message reaches the disk even when a crash, or wx's abort after a fatal
+ error, follows.
+ The log file is archived, gzip-compressed, when it reaches a size limit
+ and at the start of the next session; the last few archives are kept.
+ Archiving uses wx, so it is done on the main thread, from Flush(). */
 class Logger: public wxLog {
 public:
 	Logger();
@@ -43,11 +69,41 @@ public:
 		const wxLogRecordInfo& info);
 #endif
 	
+	/** Asks the writer thread to write out what it has, without waiting.
+	 On the main thread, also archives the log files that are due. */
 	virtual void Flush();
 private:
-	wxFFileOutputStream *out;
-	StatusBar *statusBar;
-	wxFFile *outFile;
+	void Enqueue(wxLogLevel level, const wxString& msg, time_t time);
+	void SendToStatusBar(wxLogLevel level, const wxString& msg);
+	void WakeWriter();
+	void WriterLoop();
+	/** Writes an error line and everything queued before it, then flushes. */
+	void WriteNow(const std::string& line);
+	/** Writes everything in the buffer to the file. Call with fileMutex
+	 held. */
+	void Drain();
+	void Write(const std::string& line);
+	void StartNewLogFile();
+	void ArchivePreviousLog();
+
+	std::atomic<StatusBar*> statusBar;
+
+	LogRingBuffer* buffer;
+	std::atomic<unsigned long> droppedCount;
+	std::atomic<bool> isFlushRequested;
+	std::atomic<bool> isStopping;
+	std::mutex wakeMutex;
+	std::condition_variable wakeCondition;
+	std::thread writer;
+	std::mutex fileMutex; //!< guards outFile and fileSize
+	FILE* outFile;
+	size_t fileSize;
+	std::atomic<bool> isNewFileDue; //!< the log file has reached its size limit
+
+	// used on the main thread only
+	wxString logFilePath;
+	wxString previousLogFilePath; //!< the log file while it is being archived
+	bool isArchivePending; //!< the previous session's log still needs archiving
 };
 
 #endif
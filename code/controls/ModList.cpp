@@ -34,12 +34,17 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "apis/SkinManager.h"
 #include "global/ids.h"
 #include "global/ProfileKeys.h"
+#include "global/LogDetail.h"
 #include "global/ModDefaults.h"
 #include "global/ModIniKeys.h"
+#include "global/StartupProfiler.h"
 #include "global/Utils.h"
 #include "controls/ModList.h"
+#include "controls/DiskUsageDialog.h"
 #include "apis/ProfileManager.h"
 #include "apis/TCManager.h"
+#include "apis/ModVerifier.h"
+#include "apis/VPIndex.h"
 
 #include "global/MemoryDebugging.h"
 
@@ -52,8 +57,11 @@ const size_t MAX_PRESET_NAME_LENGTH = 32;
 
 class ModInfoDialog: wxDialog {
 public:
-	ModInfoDialog(ModItem* item, wxWindow* parent);
+	ModInfoDialog(ModItem* item, const wxArrayString& tcMods, wxWindow* parent);
 	void OnLinkClicked(wxHtmlLinkEvent &event);
+	void OnVerify(wxCommandEvent &event);
+	void OnDiskUsage(wxCommandEvent &event);
+	void OnVPIndexDone(wxCommandEvent &event);
 
 private:
 	class ImageDrawer: public wxPanel {
@@ -70,6 +78,10 @@ private:
 	friend class ImageDrawer;
 
 	ModItem* item;
+	wxString modFolder;
+	wxString tcPath;
+	wxArrayString tcMods;
+	wxHtmlWindow* packages;
 };
 
 
@@ -186,11 +198,14 @@ void ModList::SetSkinBitmap(
 
 ModList::ModList(wxWindow *parent, wxSize& size, wxString tcPath)
 : configFiles(new ConfigArray()), tableData(new ModItemArray()), TCSkin(NULL) {
+	StartupProbe probe(_T("ModList"));
 	this->Create(parent, ID_MODLISTBOX, wxDefaultPosition, size, 
 		wxLB_SINGLE | wxLB_ALWAYS_SB | wxBORDER);
 	this->SetMargins(10, 10);
 	
 	SkinSystem::RegisterTCSkinChanged(this);
+	TCManager::RegisterTCProfileModChanged(this);
+	TCManager::RegisterTCModInstalled(this);
 
 	std::vector<ModItem*> modsTemp; // for use in presorting
 
@@ -235,7 +250,7 @@ ModList::ModList(wxWindow *parent, wxSize& size, wxString tcPath)
 
 	wxLogDebug(_T("Starting to parse mod.ini's..."));
 	for (size_t i = 0; i < foundInis.Count(); i++) {
-		wxLogDebug(_T("  Parsing %s"), foundInis.Item(i).c_str());
+		LOG_DEBUG_PARSE(_T("  Parsing %s"), foundInis.Item(i).c_str());
 
 		if (!ParseModIni(foundInis.Item(i), tcPath)) {
 			wxLogError(_T("  Parsing %s failed."), foundInis.Item(i).c_str());
@@ -246,360 +261,368 @@ ModList::ModList(wxWindow *parent, wxSize& size, wxString tcPath)
 	wxLogDebug(_T("Transforming mod.ini's"));
 	
 	for(size_t i = 0; i < this->configFiles->size(); i++) {
-		wxString shortname = this->configFiles->Item(i).shortname;
-		wxFileConfig* config = this->configFiles->Item(i).config;
-		ModItem* item = new ModItem();
-		wxLogDebug(_T(" %s"), shortname.c_str());
+		modsTemp.push_back(this->MakeModItem(this->configFiles->Item(i), tcPath, i == 0));
+	}
+	
+	std::sort(modsTemp.begin(), modsTemp.end(), CompareModItems);
+	
+	for (std::vector<ModItem*>::const_iterator it = modsTemp.begin();
+		 it != modsTemp.end(); ++it) {
+		this->tableData->Add(*it);
+	}
 
-		item->shortname = shortname;
+	this->SetItemCount(this->tableData->Count());
+
+	SetSelectedMod();
 
-		readIniFileString(config, MOD_INI_KEY_LAUNCHER_MOD_NAME, item->name);
 
-		wxString image255x112path;
-		readIniFileString(config, MOD_INI_KEY_LAUNCHER_IMAGE_255X112, image255x112path);
+	this->infoButton = 
+		new wxButton(this, ID_MODLISTBOX_INFO_BUTTON, _("Info"));
+	this->activateButton = 
+		new wxButton(this, ID_MODLISTBOX_ACTIVATE_BUTTON, _("Activate"));
+	this->warnBitmap =
+		new wxStaticBitmap(this, wxID_ANY, SkinSystem::GetSkinSystem()->GetWarningIcon());
+	this->warnBitmap->SetToolTip(_("This mod requires your attention before playing it. Click Info for more details."));
+
+	this->buttonSizer = new wxBoxSizer(wxVERTICAL);
+	this->buttonSizer->AddStretchSpacer(2);
+	this->buttonSizer->Add(this->activateButton, wxSizerFlags().Expand().ReserveSpaceEvenIfHidden());
+	this->buttonSizer->AddStretchSpacer(1);
+	this->buttonSizer->Add(this->infoButton, wxSizerFlags().Expand().ReserveSpaceEvenIfHidden());
+	this->buttonSizer->AddStretchSpacer(2);
+
+	wxSizer* warningSizer = new wxBoxSizer(wxVERTICAL);
+	warningSizer->AddStretchSpacer(1);
+	warningSizer->Add(this->warnBitmap, wxSizerFlags().ReserveSpaceEvenIfHidden());
+	warningSizer->AddStretchSpacer(1);
+
+	this->sizer = new wxBoxSizer(wxHORIZONTAL);
+	this->sizer->AddStretchSpacer(1);
+	this->sizer->Add(warningSizer, wxSizerFlags().Expand().ReserveSpaceEvenIfHidden());
+	this->sizer->AddStretchSpacer(1);
+	this->sizer->Add(this->buttonSizer, wxSizerFlags().Expand().ReserveSpaceEvenIfHidden());
+	this->sizer->AddStretchSpacer(2);
+	this->buttonSizer->Show(false);
+	this->warnBitmap->Show(false);
+
+
+}
+
+/** Turns one parsed mod.ini into a ModItem. isTC is true for the mod.ini in
+ the root TC folder, which is the only one that can set the skin. */
+ModItem* ModList::MakeModItem(const ConfigPair& pair, const wxString& tcPath, bool isTC) {
+	const wxString& shortname(pair.shortname);
+	wxFileConfig* config = pair.config;
+	ModItem* item = new ModItem();
+	LOG_DEBUG_PARSE(_T(" %s"), shortname.c_str());
+
+	item->shortname = shortname;
+
+	readIniFileString(config, MOD_INI_KEY_LAUNCHER_MOD_NAME, item->name);
+
+	wxString image255x112path;
+	readIniFileString(config, MOD_INI_KEY_LAUNCHER_IMAGE_255X112, image255x112path);
+	
+	if (!image255x112path.IsEmpty()) {
+		wxFileName filename;
+		wxString searchShortname(isTC ? wxString(wxEmptyString) : shortname);
 		
-		if (!image255x112path.IsEmpty()) {
-			wxFileName filename;
-			wxString searchShortname((i == 0) ? wxString(wxEmptyString) : shortname);
+		if (SkinSystem::SearchFile(filename, tcPath, searchShortname, image255x112path)) {
+			wxImage image(filename.GetFullPath());
 			
-			if (SkinSystem::SearchFile(filename, tcPath, searchShortname, image255x112path)) {
-				wxImage image(filename.GetFullPath());
-				
-				if (image.IsOk()) {
-					if ((image.GetWidth() == SkinSystem::ModInfoDialogImageWidth) &&
-						(image.GetHeight() == SkinSystem::ModInfoDialogImageHeight)) {
-						item->image255x112 = wxBitmap(image);
-					} else {
-						wxLogWarning(_T("image255x112 has invalid dimensions %dx%d"),
-							image.GetWidth(), image.GetHeight());
-					}
+			if (image.IsOk()) {
+				if ((image.GetWidth() == SkinSystem::ModInfoDialogImageWidth) &&
+					(image.GetHeight() == SkinSystem::ModInfoDialogImageHeight)) {
+					item->image255x112 = wxBitmap(image);
 				} else {
-					wxLogWarning(_T("Could not set image255x112 file to '%s'"),
-						filename.GetFullPath().c_str());
+					wxLogWarning(_T("image255x112 has invalid dimensions %dx%d"),
+						image.GetWidth(), image.GetHeight());
 				}
 			} else {
-				wxLogWarning(_T("Could not find image255x112 file %s%s"),
-					(searchShortname.IsEmpty() ? wxEmptyString :
-						wxString(searchShortname + wxFileName::GetPathSeparator()).c_str()),
-					image255x112path.c_str());
+				wxLogWarning(_T("Could not set image255x112 file to '%s'"),
+					filename.GetFullPath().c_str());
 			}
+		} else {
+			wxLogWarning(_T("Could not find image255x112 file %s%s"),
+				(searchShortname.IsEmpty() ? wxEmptyString :
+					wxString(searchShortname + wxFileName::GetPathSeparator()).c_str()),
+				image255x112path.c_str());
 		}
+	}
+	
+	wxString image182x80path;
+	readIniFileString(config, MOD_INI_KEY_LAUNCHER_IMAGE_182X80, image182x80path);
+	
+	if (!image182x80path.IsEmpty()) {
+		wxFileName filename;
+		wxString searchShortname(isTC ? wxString(wxEmptyString) : shortname);
 		
-		wxString image182x80path;
-		readIniFileString(config, MOD_INI_KEY_LAUNCHER_IMAGE_182X80, image182x80path);
-		
-		if (!image182x80path.IsEmpty()) {
-			wxFileName filename;
-			wxString searchShortname((i == 0) ? wxString(wxEmptyString) : shortname);
+		if (SkinSystem::SearchFile(filename, tcPath, searchShortname, image182x80path)) {
+			wxImage image(filename.GetFullPath());
 			
-			if (SkinSystem::SearchFile(filename, tcPath, searchShortname, image182x80path)) {
-				wxImage image(filename.GetFullPath());
-				
-				if (image.IsOk()) {
-					if ((image.GetWidth() == SkinSystem::ModListImageWidth) &&
-						(image.GetHeight() == SkinSystem::ModListImageHeight)) {
-						item->image182x80 = wxBitmap(image);
-					} else {
-						wxLogWarning(_T("image182x80 has invalid dimensions %dx%d"),
-							image.GetWidth(), image.GetHeight());
-					}
+			if (image.IsOk()) {
+				if ((image.GetWidth() == SkinSystem::ModListImageWidth) &&
+					(image.GetHeight() == SkinSystem::ModListImageHeight)) {
+					item->image182x80 = wxBitmap(image);
 				} else {
-					wxLogWarning(_T("Could not set image182x80 file to '%s'"),
-						filename.GetFullPath().c_str());
+					wxLogWarning(_T("image182x80 has invalid dimensions %dx%d"),
+						image.GetWidth(), image.GetHeight());
 				}
 			} else {
-				wxLogWarning(_T("Could not find image182x80 file %s%s"),
-					(searchShortname.IsEmpty() ? wxEmptyString :
-						wxString(searchShortname + wxFileName::GetPathSeparator()).c_str()),
-							image182x80path.c_str());
+				wxLogWarning(_T("Could not set image182x80 file to '%s'"),
+					filename.GetFullPath().c_str());
 			}
+		} else {
+			wxLogWarning(_T("Could not find image182x80 file %s%s"),
+				(searchShortname.IsEmpty() ? wxEmptyString :
+					wxString(searchShortname + wxFileName::GetPathSeparator()).c_str()),
+						image182x80path.c_str());
 		}
+	}
 
-		// other cases, which don't require handling here:
-		// if both images are Ok, then we just use them
-		// if both images are not Ok, then we use SkinSystem::modImage/smallModImage
-		if (item->image255x112.IsOk() && !item->image182x80.IsOk()) {
-			item->image182x80 = SkinSystem::MakeModListImage(item->image255x112);
-		} else if (!item->image255x112.IsOk() && item->image182x80.IsOk()) {
-			item->image255x112 = SkinSystem::MakeModInfoDialogImage(item->image182x80);
-		}
+	// other cases, which don't require handling here:
+	// if both images are Ok, then we just use them
+	// if both images are not Ok, then we use SkinSystem::modImage/smallModImage
+	if (item->image255x112.IsOk() && !item->image182x80.IsOk()) {
+		item->image182x80 = SkinSystem::MakeModListImage(item->image255x112);
+	} else if (!item->image255x112.IsOk() && item->image182x80.IsOk()) {
+		item->image255x112 = SkinSystem::MakeModInfoDialogImage(item->image182x80);
+	}
 
-		wxASSERT(item->image255x112.IsOk() == item->image182x80.IsOk());
-		
-		readIniFileString(config, MOD_INI_KEY_LAUNCHER_INFO_TEXT, item->infotext);
+	wxASSERT(item->image255x112.IsOk() == item->image182x80.IsOk());
+	
+	readIniFileString(config, MOD_INI_KEY_LAUNCHER_INFO_TEXT, item->infotext);
 
-		readIniFileString(config, MOD_INI_KEY_LAUNCHER_AUTHOR, item->author);
+	readIniFileString(config, MOD_INI_KEY_LAUNCHER_AUTHOR, item->author);
 
-		readIniFileString(config, MOD_INI_KEY_LAUNCHER_NOTES, item->notes);
+	readIniFileString(config, MOD_INI_KEY_LAUNCHER_NOTES, item->notes);
 
-		config->Read(MOD_INI_KEY_LAUNCHER_WARN, &(item->warn), false);
+	config->Read(MOD_INI_KEY_LAUNCHER_WARN, &(item->warn), false);
 
-		readIniFileString(config, MOD_INI_KEY_LAUNCHER_WEBSITE, item->website);
-		readIniFileString(config, MOD_INI_KEY_LAUNCHER_FORUM, item->forum);
-		readIniFileString(config, MOD_INI_KEY_LAUNCHER_BUGS, item->bugs);
-		readIniFileString(config, MOD_INI_KEY_LAUNCHER_SUPPORT, item->support);
-		
-		config->Read(
-			MOD_INI_KEY_RESOLUTION_MIN_HORIZONTAL_RES,
-			&item->minhorizontalres,
-			DEFAULT_MOD_RESOLUTION_MIN_HORIZONTAL_RES);
-		config->Read(
-			MOD_INI_KEY_RESOLUTION_MIN_VERTICAL_RES,
-			&item->minverticalres,
-			DEFAULT_MOD_RESOLUTION_MIN_VERTICAL_RES);
-		
-		if ((item->minhorizontalres < DEFAULT_MOD_RESOLUTION_MIN_HORIZONTAL_RES) ||
-				(item->minverticalres < DEFAULT_MOD_RESOLUTION_MIN_VERTICAL_RES)) {
-			wxLogWarning(_T("Invalid minimum resolution %ldx%ld, using default"),
-				item->minhorizontalres, item->minverticalres);
-			item->minhorizontalres = DEFAULT_MOD_RESOLUTION_MIN_HORIZONTAL_RES;
-			item->minverticalres = DEFAULT_MOD_RESOLUTION_MIN_VERTICAL_RES;
-		}
-		
-		readIniFileString(
-			config,
-			MOD_INI_KEY_RECOMMENDED_LIGHTING_NAME,
-			item->recommendedlightingname);
-		readIniFileString(
-			config,
-			MOD_INI_KEY_RECOMMENDED_LIGHTING_FLAGSET,
-			item->recommendedlightingflagset);
-		
-		if (!item->recommendedlightingflagset.IsEmpty()) {
-			if (item->recommendedlightingname.IsEmpty()) {
-				item->recommendedlightingname =
-					(i == 0) ? _("TC recommended") : _("Mod recommended");
-				
-				// required because & is interpreted as setting keyboard shortcut
-				// see http://docs.wxwidgets.org/stable/wx_wxcontrol.html#wxcontrolsetlabel
-				item->recommendedlightingname.Replace(_T("&"), _T("&&"));
-			} else {
-				item->recommendedlightingname.Trim(true).Trim(false);
-				item->recommendedlightingname.Truncate(MAX_PRESET_NAME_LENGTH);
-			}
+	readIniFileString(config, MOD_INI_KEY_LAUNCHER_WEBSITE, item->website);
+	readIniFileString(config, MOD_INI_KEY_LAUNCHER_FORUM, item->forum);
+	readIniFileString(config, MOD_INI_KEY_LAUNCHER_BUGS, item->bugs);
+	readIniFileString(config, MOD_INI_KEY_LAUNCHER_SUPPORT, item->support);
+	
+	config->Read(
+		MOD_INI_KEY_RESOLUTION_MIN_HORIZONTAL_RES,
+		&item->minhorizontalres,
+		DEFAULT_MOD_RESOLUTION_MIN_HORIZONTAL_RES);
+	config->Read(
+		MOD_INI_KEY_RESOLUTION_MIN_VERTICAL_RES,
+		&item->minverticalres,
+		DEFAULT_MOD_RESOLUTION_MIN_VERTICAL_RES);
+	
+	if ((item->minhorizontalres < DEFAULT_MOD_RESOLUTION_MIN_HORIZONTAL_RES) ||
+			(item->minverticalres < DEFAULT_MOD_RESOLUTION_MIN_VERTICAL_RES)) {
+		wxLogWarning(_T("Invalid minimum resolution %ldx%ld, using default"),
+			item->minhorizontalres, item->minverticalres);
+		item->minhorizontalres = DEFAULT_MOD_RESOLUTION_MIN_HORIZONTAL_RES;
+		item->minverticalres = DEFAULT_MOD_RESOLUTION_MIN_VERTICAL_RES;
+	}
+	
+	readIniFileString(
+		config,
+		MOD_INI_KEY_RECOMMENDED_LIGHTING_NAME,
+		item->recommendedlightingname);
+	readIniFileString(
+		config,
+		MOD_INI_KEY_RECOMMENDED_LIGHTING_FLAGSET,
+		item->recommendedlightingflagset);
+	
+	if (!item->recommendedlightingflagset.IsEmpty()) {
+		if (item->recommendedlightingname.IsEmpty()) {
+			item->recommendedlightingname =
+				isTC ? _("TC recommended") : _("Mod recommended");
+			
+			// required because & is interpreted as setting keyboard shortcut
+			// see http://docs.wxwidgets.org/stable/wx_wxcontrol.html#wxcontrolsetlabel
+			item->recommendedlightingname.Replace(_T("&"), _T("&&"));
 		} else {
-			wxLogDebug(_T("Recommended lighting flagset is missing or empty; using defaults."));
-			item->recommendedlightingname = DEFAULT_MOD_RECOMMENDED_LIGHTING_NAME;
-			item->recommendedlightingflagset = DEFAULT_MOD_RECOMMENDED_LIGHTING_FLAGSET;
+			item->recommendedlightingname.Trim(true).Trim(false);
+			item->recommendedlightingname.Truncate(MAX_PRESET_NAME_LENGTH);
 		}
+	} else {
+		wxLogDebug(_T("Recommended lighting flagset is missing or empty; using defaults."));
+		item->recommendedlightingname = DEFAULT_MOD_RECOMMENDED_LIGHTING_NAME;
+		item->recommendedlightingflagset = DEFAULT_MOD_RECOMMENDED_LIGHTING_FLAGSET;
+	}
 
-		readIniFileString(config, MOD_INI_KEY_EXTREMEFORCE_FORCED_FLAGS_ON, item->forcedon);
-		readIniFileString(config, MOD_INI_KEY_EXTREMEFORCE_FORCED_FLAGS_OFF, item->forcedoff);
+	readIniFileString(config, MOD_INI_KEY_EXTREMEFORCE_FORCED_FLAGS_ON, item->forcedon);
+	readIniFileString(config, MOD_INI_KEY_EXTREMEFORCE_FORCED_FLAGS_OFF, item->forcedoff);
 
-		readIniFileString(config, MOD_INI_KEY_MULTIMOD_PRIMARY_LIST, item->primarylist);
-		// Log the warning for any mod authors, specifically for those who indicate
-		// that they are mod authors by their having FRED launching enabled
-		bool fredEnabled;
-		ProMan::GetProfileManager()->GlobalRead(GBL_CFG_OPT_CONFIG_FRED, &fredEnabled, false);
-		
-		if ( config->Exists(MOD_INI_KEY_MULTIMOD_SECONDRY_LIST) && fredEnabled) {
-			wxLogInfo(_T("  DEPRECATION WARNING: Mod '%s' uses deprecated mod.ini parameter 'secondrylist'"),
-				shortname.c_str());
-		}
-		readIniFileString(config, MOD_INI_KEY_MULTIMOD_SECONDARY_LIST, item->secondarylist);
-		if (item->secondarylist.IsEmpty()) {
-			readIniFileString(config, MOD_INI_KEY_MULTIMOD_SECONDRY_LIST, item->secondarylist);
-		}
+	readIniFileString(config, MOD_INI_KEY_INTEGRITY_MANIFEST, item->manifest);
 
-		// flag sets
-		if ( config->Exists(_T("/flagsetideal")) ) {
-			item->flagsets = new FlagSets();
+	readIniFileString(config, MOD_INI_KEY_MULTIMOD_PRIMARY_LIST, item->primarylist);
+	// Log the warning for any mod authors, specifically for those who indicate
+	// that they are mod authors by their having FRED launching enabled
+	bool fredEnabled;
+	ProMan::GetProfileManager()->GlobalRead(GBL_CFG_OPT_CONFIG_FRED, &fredEnabled, false);
+	
+	if ( config->Exists(MOD_INI_KEY_MULTIMOD_SECONDRY_LIST) && fredEnabled) {
+		wxLogInfo(_T("  DEPRECATION WARNING: Mod '%s' uses deprecated mod.ini parameter 'secondrylist'"),
+			shortname.c_str());
+	}
+	readIniFileString(config, MOD_INI_KEY_MULTIMOD_SECONDARY_LIST, item->secondarylist);
+	if (item->secondarylist.IsEmpty()) {
+		readIniFileString(config, MOD_INI_KEY_MULTIMOD_SECONDRY_LIST, item->secondarylist);
+	}
 
-			FlagSetItem* flagset = new FlagSetItem();
+	// flag sets
+	if ( config->Exists(_T("/flagsetideal")) ) {
+		item->flagsets = new FlagSets();
 
-			readFlagSet(config, _T("/flagsetideal"), *flagset);
+		FlagSetItem* flagset = new FlagSetItem();
 
-			item->flagsets->Add(flagset);
+		readFlagSet(config, _T("/flagsetideal"), *flagset);
 
-			unsigned int counter = 1;
-			bool done = false;
-			do {
-				wxString sectionname = wxString::Format(_T("/flagset%u"), counter);
-				if ( config->Exists( sectionname )) {
-					FlagSetItem* numberedflagset = new FlagSetItem();
+		item->flagsets->Add(flagset);
 
-					readFlagSet(config, sectionname, *numberedflagset);
-					
-					item->flagsets->Add(numberedflagset);
-				} else {
-					done = true;
-				}
-				counter++;
-			} while ( !done );
-		} else {
+		unsigned int counter = 1;
+		bool done = false;
+		do {
+			wxString sectionname = wxString::Format(_T("/flagset%u"), counter);
+			if ( config->Exists( sectionname )) {
+				FlagSetItem* numberedflagset = new FlagSetItem();
+
+				readFlagSet(config, sectionname, *numberedflagset);
+				
+				item->flagsets->Add(numberedflagset);
+			} else {
+				done = true;
+			}
+			counter++;
+		} while ( !done );
+	} else {
 #if 0 // preprocessing out until this functionality is complete
-			wxLogDebug(_T("  Does Not Contain An idealflagset Section."));
+		wxLogDebug(_T("  Does Not Contain An idealflagset Section."));
 #endif
-		}
+	}
 
-		// skin (only available to TCs)
-		if ( i == 0 ) {
-			if ( config->Exists(_T("/skin")) ) {
-				// deleting any existing TCSkin will be handled by SkinSystem::ResetTCSkin()
-				// so it shouldn't be deleted here
-				this->TCSkin = new Skin();
-				
-				wxString windowTitle;
-				readIniFileString(config, MOD_INI_KEY_SKIN_WINDOW_TITLE, windowTitle);
-				
-				if (!windowTitle.IsEmpty()) {
-					this->TCSkin->SetWindowTitle(windowTitle);
-				}
-				
-				SetSkinBitmap(*config, MOD_INI_KEY_SKIN_BANNER,
-					tcPath, _T("banner"), &Skin::SetBanner);
-				
-				wxString windowIconPath;
-				readIniFileString(config, MOD_INI_KEY_SKIN_WINDOW_ICON, windowIconPath);
+	// skin (only available to TCs)
+	if ( isTC ) {
+		if ( config->Exists(_T("/skin")) ) {
+			// deleting any existing TCSkin will be handled by SkinSystem::ResetTCSkin()
+			// so it shouldn't be deleted here
+			this->TCSkin = new Skin();
+			
+			wxString windowTitle;
+			readIniFileString(config, MOD_INI_KEY_SKIN_WINDOW_TITLE, windowTitle);
+			
+			if (!windowTitle.IsEmpty()) {
+				this->TCSkin->SetWindowTitle(windowTitle);
+			}
+			
+			SetSkinBitmap(*config, MOD_INI_KEY_SKIN_BANNER,
+				tcPath, _T("banner"), &Skin::SetBanner);
+			
+			wxString windowIconPath;
+			readIniFileString(config, MOD_INI_KEY_SKIN_WINDOW_ICON, windowIconPath);
+			
+			if (!windowIconPath.IsEmpty()) {
+				wxFileName filename;
 				
-				if (!windowIconPath.IsEmpty()) {
-					wxFileName filename;
-					
-					if (SkinSystem::SearchFile(filename, tcPath, wxEmptyString, windowIconPath)) {
-						if (this->TCSkin->SetWindowIcon(wxIcon(filename.GetFullPath(), wxBITMAP_TYPE_ICO))) {
-							wxLogDebug(_T("Set skin window icon to '%s'"),
-								filename.GetFullPath().c_str());
-						} else {
-							wxLogWarning(_T("Could not set skin window icon to '%s'"),
-								filename.GetFullPath().c_str());
-						}
+				if (SkinSystem::SearchFile(filename, tcPath, wxEmptyString, windowIconPath)) {
+					if (this->TCSkin->SetWindowIcon(wxIcon(filename.GetFullPath(), wxBITMAP_TYPE_ICO))) {
+						wxLogDebug(_T("Set skin window icon to '%s'"),
+							filename.GetFullPath().c_str());
 					} else {
-						wxLogWarning(_T("Could not find skin window icon file."));
+						wxLogWarning(_T("Could not set skin window icon to '%s'"),
+							filename.GetFullPath().c_str());
 					}
+				} else {
+					wxLogWarning(_T("Could not find skin window icon file."));
 				}
+			}
+			
+			wxString welcomeText;
+			readIniFileString(config, MOD_INI_KEY_SKIN_WELCOME_TEXT, welcomeText);
+			
+			if (!welcomeText.IsEmpty()) {
+				this->TCSkin->SetWelcomeText(welcomeText);
+			}
+			
+			SetSkinBitmap(*config, MOD_INI_KEY_SKIN_MOD_IMAGE_255X112,
+				tcPath, _T("mod image"), &Skin::SetModImage);
+			
+			SetSkinBitmap(*config, MOD_INI_KEY_SKIN_MOD_IMAGE_182X80,
+				tcPath, _T("small mod image"), &Skin::SetSmallModImage);
+			
+			// if one mod image is missing, create it by scaling the other one
+			if (this->TCSkin->GetModImage().IsOk() && !this->TCSkin->GetSmallModImage().IsOk()) {
+				this->TCSkin->SetSmallModImage(
+					SkinSystem::MakeModListImage(this->TCSkin->GetModImage()));
+			} else if (!this->TCSkin->GetModImage().IsOk() && this->TCSkin->GetSmallModImage().IsOk()) {
+				this->TCSkin->SetModImage(
+					SkinSystem::MakeModInfoDialogImage(this->TCSkin->GetSmallModImage()));
+			}
+			
+			SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_OK,
+				tcPath, _T("ok icon"), &Skin::SetOkIcon);
+			
+			SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_WARNING,
+				tcPath, _T("warning icon"), &Skin::SetWarningIcon);
+			
+			SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_WARNING_BIG,
+				tcPath, _T("big warning icon"), &Skin::SetBigWarningIcon);
+			
+			SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_ERROR,
+				tcPath, _T("error icon"), &Skin::SetErrorIcon);
+			
+			SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_INFO,
+				tcPath, _T("info icon"), &Skin::SetInfoIcon);
+			
+			SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_INFO_BIG,
+				tcPath, _T("big info icon"), &Skin::SetBigInfoIcon);
+			
+			SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_HELP,
+				tcPath, _T("help icon"), &Skin::SetHelpIcon);
+			
+			SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_HELP_BIG,
+				tcPath, _T("big help icon"), &Skin::SetBigHelpIcon);
+			
+			SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_IDEAL,
+				tcPath, _T("ideal icon"), &Skin::SetIdealIcon);
+			
+			wxString newsSourceName;
+			readIniFileString(config, MOD_INI_KEY_SKIN_NEWS_SOURCE, newsSourceName);
+			
+			if (!newsSourceName.IsEmpty()) {
+				const NewsSource* source = NewsSource::FindSource(newsSourceName);
 				
-				wxString welcomeText;
-				readIniFileString(config, MOD_INI_KEY_SKIN_WELCOME_TEXT, welcomeText);
-				
-				if (!welcomeText.IsEmpty()) {
-					this->TCSkin->SetWelcomeText(welcomeText);
-				}
-				
-				SetSkinBitmap(*config, MOD_INI_KEY_SKIN_MOD_IMAGE_255X112,
-					tcPath, _T("mod image"), &Skin::SetModImage);
-				
-				SetSkinBitmap(*config, MOD_INI_KEY_SKIN_MOD_IMAGE_182X80,
-					tcPath, _T("small mod image"), &Skin::SetSmallModImage);
-				
-				// if one mod image is missing, create it by scaling the other one
-				if (this->TCSkin->GetModImage().IsOk() && !this->TCSkin->GetSmallModImage().IsOk()) {
-					this->TCSkin->SetSmallModImage(
-						SkinSystem::MakeModListImage(this->TCSkin->GetModImage()));
-				} else if (!this->TCSkin->GetModImage().IsOk() && this->TCSkin->GetSmallModImage().IsOk()) {
-					this->TCSkin->SetModImage(
-						SkinSystem::MakeModInfoDialogImage(this->TCSkin->GetSmallModImage()));
-				}
-				
-				SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_OK,
-					tcPath, _T("ok icon"), &Skin::SetOkIcon);
-				
-				SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_WARNING,
-					tcPath, _T("warning icon"), &Skin::SetWarningIcon);
-				
-				SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_WARNING_BIG,
-					tcPath, _T("big warning icon"), &Skin::SetBigWarningIcon);
-				
-				SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_ERROR,
-					tcPath, _T("error icon"), &Skin::SetErrorIcon);
-				
-				SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_INFO,
-					tcPath, _T("info icon"), &Skin::SetInfoIcon);
-				
-				SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_INFO_BIG,
-					tcPath, _T("big info icon"), &Skin::SetBigInfoIcon);
-				
-				SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_HELP,
-					tcPath, _T("help icon"), &Skin::SetHelpIcon);
-				
-				SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_HELP_BIG,
-					tcPath, _T("big help icon"), &Skin::SetBigHelpIcon);
-				
-				SetSkinBitmap(*config, MOD_INI_KEY_SKIN_ICON_IDEAL,
-					tcPath, _T("ideal icon"), &Skin::SetIdealIcon);
-				
-				wxString newsSourceName;
-				readIniFileString(config, MOD_INI_KEY_SKIN_NEWS_SOURCE, newsSourceName);
-				
-				if (!newsSourceName.IsEmpty()) {
-					const NewsSource* source = NewsSource::FindSource(newsSourceName);
-					
-					if (source != NULL) {
-						this->TCSkin->SetNewsSource(source);
-					}
+				if (source != NULL) {
+					this->TCSkin->SetNewsSource(source);
 				}
-				
-				SkinSystem::GetSkinSystem()->SetTCSkin(this->TCSkin);
-				this->TCSkin = NULL;
-			} else {
-				wxLogDebug(_T("  Does Not Contain A skin Section."));
-				SkinSystem::GetSkinSystem()->ResetTCSkin();
 			}
+			
+			SkinSystem::GetSkinSystem()->SetTCSkin(this->TCSkin);
+			this->TCSkin = NULL;
+		} else {
+			wxLogDebug(_T("  Does Not Contain A skin Section."));
+			SkinSystem::GetSkinSystem()->ResetTCSkin();
 		}
+	}
 
 #ifdef MOD_TEXT_LOCALIZATION // mod text localization is not supported for now
-		// langauges
-		for ( size_t i = 0;	i < SupportedLanguages.Count(); i++ ) {
-			wxString section = wxString::Format(_T("/%s"), SupportedLanguages[i].c_str());
-			if ( config->Exists(section) ) {
-				if ( item->i18n == NULL ) {
-					item->i18n = new I18nData();
-				}
-			}
-			I18nItem *temp = NULL;
-
-			readTranslation(config, SupportedLanguages[i], &temp);
-			
-			if ( temp != NULL ) {
-				(*(item->i18n))[SupportedLanguages[i]] = temp;
+	// langauges
+	for ( size_t i = 0;	i < SupportedLanguages.Count(); i++ ) {
+		wxString section = wxString::Format(_T("/%s"), SupportedLanguages[i].c_str());
+		if ( config->Exists(section) ) {
+			if ( item->i18n == NULL ) {
+				item->i18n = new I18nData();
 			}
 		}
-#endif
+		I18nItem *temp = NULL;
 
-		modsTemp.push_back(item);
-	}
-	
-	std::sort(modsTemp.begin(), modsTemp.end(), CompareModItems);
-	
-	for (std::vector<ModItem*>::const_iterator it = modsTemp.begin();
-		 it != modsTemp.end(); ++it) {
-		this->tableData->Add(*it);
+		readTranslation(config, SupportedLanguages[i], &temp);
+		
+		if ( temp != NULL ) {
+			(*(item->i18n))[SupportedLanguages[i]] = temp;
+		}
 	}
+#endif
 
-	this->SetItemCount(this->tableData->Count());
-
-	SetSelectedMod();
-
-
-	this->infoButton = 
-		new wxButton(this, ID_MODLISTBOX_INFO_BUTTON, _("Info"));
-	this->activateButton = 
-		new wxButton(this, ID_MODLISTBOX_ACTIVATE_BUTTON, _("Activate"));
-	this->warnBitmap =
-		new wxStaticBitmap(this, wxID_ANY, SkinSystem::GetSkinSystem()->GetWarningIcon());
-	this->warnBitmap->SetToolTip(_("This mod requires your attention before playing it. Click Info for more details."));
-
-	this->buttonSizer = new wxBoxSizer(wxVERTICAL);
-	this->buttonSizer->AddStretchSpacer(2);
-	this->buttonSizer->Add(this->activateButton, wxSizerFlags().Expand().ReserveSpaceEvenIfHidden());
-	this->buttonSizer->AddStretchSpacer(1);
-	this->buttonSizer->Add(this->infoButton, wxSizerFlags().Expand().ReserveSpaceEvenIfHidden());
-	this->buttonSizer->AddStretchSpacer(2);
-
-	wxSizer* warningSizer = new wxBoxSizer(wxVERTICAL);
-	warningSizer->AddStretchSpacer(1);
-	warningSizer->Add(this->warnBitmap, wxSizerFlags().ReserveSpaceEvenIfHidden());
-	warningSizer->AddStretchSpacer(1);
-
-	this->sizer = new wxBoxSizer(wxHORIZONTAL);
-	this->sizer->AddStretchSpacer(1);
-	this->sizer->Add(warningSizer, wxSizerFlags().Expand().ReserveSpaceEvenIfHidden());
-	this->sizer->AddStretchSpacer(1);
-	this->sizer->Add(this->buttonSizer, wxSizerFlags().Expand().ReserveSpaceEvenIfHidden());
-	this->sizer->AddStretchSpacer(2);
-	this->buttonSizer->Show(false);
-	this->warnBitmap->Show(false);
-
-
+	return item;
 }
 
 /** the dtor.  Cleans up stuff. */
@@ -607,6 +630,8 @@ ModList::~ModList() {
 	if (SkinSystem::IsInitialized()) {
 		SkinSystem::UnRegisterTCSkinChanged(this);
 	}
+	TCManager::UnRegisterTCProfileModChanged(this);
+	TCManager::UnRegisterTCModInstalled(this);
 	
 	if ( this->configFiles != NULL ) {
 		delete this->configFiles;
@@ -637,7 +662,7 @@ void ModList::readIniFileString(const wxFileConfig* config,
 		}
 	}
 
-	wxLogDebug(wxT_2("  %s:'%s'"),
+	LOG_DEBUG_PARSE(wxT_2("  %s:'%s'"),
 		key.c_str(),
 		location.IsEmpty() ? wxT_2("Not Specified") : escapeSpecials(location).c_str());
 }
@@ -708,7 +733,7 @@ bool ModList::ParseModIni(const wxString& modIniPath, const wxString& tcPath, co
 	wxFFileInputStream stream(modIniPath);
 
 	if ( stream.IsOk() ) {
-		wxLogDebug(_T("   Opened ok"));
+		LOG_DEBUG_PARSE(_T("   Opened ok"));
 	} else {
 		wxLogError(_T("   Open failed!"));
 		return false;
@@ -765,10 +790,10 @@ bool ModList::ParseModIni(const wxString& modIniPath, const wxString& tcPath, co
 	wxString shortname(isNoMod ? NO_MOD : GetShortName(modIniPath, tcPath));
 	
 	if (!isNoMod) {
-		wxLogDebug(_T("   Mod fancy name is: %s"),
+		LOG_DEBUG_PARSE(_T("   Mod fancy name is: %s"),
 			config->Read(MOD_INI_KEY_LAUNCHER_MOD_NAME, _T("Not specified")).c_str());
 
-		wxLogDebug(_T("   Mod short name is: %s"), shortname.c_str());
+		LOG_DEBUG_PARSE(_T("   Mod short name is: %s"), shortname.c_str());
 	} 
 
 	this->configFiles->Add(new ConfigPair(shortname, config));
@@ -824,7 +849,7 @@ wxString ModList::GetShortName(const wxString& modIniPath, const wxString& tcPat
 }
 
 void ModList::OnDrawItem(wxDC &dc, const wxRect &rect, size_t n) const {
-	wxLogDebug(_T(" Draw %04d,%04d = %04d,%04d"), rect.x, rect.y, rect.width, rect.height);
+	LOG_DEBUG_DRAW(_T(" Draw %04d,%04d = %04d,%04d"), rect.x, rect.y, rect.width, rect.height);
 	this->tableData->Item(n).Draw(dc, rect, this->IsSelected(n), this->sizer, this->buttonSizer, this->warnBitmap);
 }
 
@@ -833,12 +858,15 @@ void ModList::OnDrawSeparator(wxDC &WXUNUSED(dc), wxRect& WXUNUSED(rect), size_t
 }
 
 void ModList::OnDrawBackground(wxDC &dc, const wxRect& rect, size_t n) const {
-	wxLogDebug(_T(" Background %04d,%04d = %04d,%04d"), rect.x, rect.y, rect.width, rect.height);
+	LOG_DEBUG_DRAW(_T(" Background %04d,%04d = %04d,%04d"), rect.x, rect.y, rect.width, rect.height);
 	dc.DestroyClippingRegion();
 	wxColour highlighted = wxSystemSettings::GetColour(wxSYS_COLOUR_HIGHLIGHT);
 	wxColour background = wxSystemSettings::GetColour(wxSYS_COLOUR_WINDOW);
 	wxString activeMod;
-	ProMan::GetProfileManager()->ProfileRead(PRO_CFG_TC_CURRENT_MOD, &activeMod, NO_MOD, true);
+	if (!ProMan::GetProfileManager()->ProfileRead(PKEY_TC_CURRENT_MOD, &activeMod)) {
+		// absent, so write back the default
+		ProMan::GetProfileManager()->ProfileRead(PRO_CFG_TC_CURRENT_MOD, &activeMod, NO_MOD, true);
+	}
 	wxBrush b;
 	wxRect selectedRect(rect.x+2, rect.y+2, rect.width-4, rect.height-4);
 	wxRect activeRect(selectedRect.x+3, selectedRect.y+3, selectedRect.width-7, selectedRect.height-7);
@@ -895,13 +923,27 @@ void ModList::OnActivateMod(wxCommandEvent &WXUNUSED(event)) {
 	
 	ModList::activeMod = &this->tableData->Item(selected);
 
-	wxString modline;
 	const wxString& shortname(this->tableData->Item(selected).shortname);
+	wxCHECK_RET( !shortname.IsEmpty(), _T("Mod shortname is empty!"));
 	this->prependmods = this->tableData->Item(selected).primarylist;
 	this->appendmods = this->tableData->Item(selected).secondarylist;
 
-	if ( !this->prependmods.IsEmpty() ) {
-		wxStringTokenizer prependtokens(this->prependmods, _T(","), wxTOKEN_STRTOK); // no empty tokens
+	const wxString modline(MakeModline(this->tableData->Item(selected)));
+
+	wxLogDebug(_T("New modline is %s"), modline.c_str());
+
+	ProMan::GetProfileManager()->ProfileWrite(PRO_CFG_TC_CURRENT_MODLINE, modline);
+	ProMan::GetProfileManager()->ProfileWrite(PRO_CFG_TC_CURRENT_MOD, shortname);
+
+	TCManager::GenerateTCActiveModChanged();
+	this->Refresh();
+}
+
+wxString ModList::MakeModline(const ModItem& item) {
+	wxString modline;
+
+	if ( !item.primarylist.IsEmpty() ) {
+		wxStringTokenizer prependtokens(item.primarylist, _T(","), wxTOKEN_STRTOK); // no empty tokens
 		while ( prependtokens.HasMoreTokens() ) {
 			if ( !modline.IsEmpty() ) {
 				modline += _T(",");
@@ -910,17 +952,16 @@ void ModList::OnActivateMod(wxCommandEvent &WXUNUSED(event)) {
 		}
 	}
 
-	wxCHECK_RET( !shortname.IsEmpty(), _T("Mod shortname is empty!"));
 	if ( !modline.IsEmpty() ) {
 		modline += _T(",");
 	}
-	if ( selected != 0 ) {
+	if ( item.shortname != NO_MOD ) {
 		// put current mods name into the list unless it is (No mod)
-		modline += shortname;
+		modline += item.shortname;
 	}
 
-	if ( !this->appendmods.IsEmpty() ) {
-		wxStringTokenizer appendtokens(this->appendmods, _T(","), wxTOKEN_STRTOK);
+	if ( !item.secondarylist.IsEmpty() ) {
+		wxStringTokenizer appendtokens(item.secondarylist, _T(","), wxTOKEN_STRTOK);
 		while ( appendtokens.HasMoreTokens() ) {
 			if ( !modline.IsEmpty() ) {
 				modline += _T(",");
@@ -928,20 +969,85 @@ void ModList::OnActivateMod(wxCommandEvent &WXUNUSED(event)) {
 			modline += appendtokens.GetNextToken().Trim(true).Trim(false);
 		}
 	}
+	return modline;
+}
 
-	wxLogDebug(_T("New modline is %s"), modline.c_str());
+/** The profile switched to another mod in this TC, so select and activate
+ it without scanning the mods again. */
+void ModList::OnProfileModChanged(wxCommandEvent &WXUNUSED(event)) {
+	this->SetSelectedMod();
+}
 
-	ProMan::GetProfileManager()->ProfileWrite(PRO_CFG_TC_CURRENT_MODLINE, modline);
-	ProMan::GetProfileManager()->ProfileWrite(PRO_CFG_TC_CURRENT_MOD, shortname);
+/** A mod was installed or updated in this TC, so parse just its mod.ini
+ and add or replace its entry, instead of scanning the whole TC again. */
+void ModList::OnModInstalled(wxCommandEvent &event) {
+	const wxString shortname(event.GetString());
+	wxCHECK_RET(!shortname.IsEmpty(), _T("Installed mod has no shortname."));
+	wxString tcPath;
+	ProMan::GetProfileManager()->ProfileRead(
+		PRO_CFG_TC_ROOT_FOLDER, &tcPath, wxEmptyString);
+	wxCHECK_RET(!tcPath.IsEmpty(), _T("Mod installed without a TC."));
 
-	TCManager::GenerateTCActiveModChanged();
+	const wxFileName modIni(
+		tcPath + wxFileName::GetPathSeparator() + shortname, _T("mod.ini"));
+	wxLogDebug(_T("Refreshing mod %s from %s"),
+		shortname.c_str(), modIni.GetFullPath().c_str());
+
+	for (size_t i = 0; i < this->configFiles->GetCount(); ++i) {
+		if (this->configFiles->Item(i).shortname == shortname) {
+			this->configFiles->RemoveAt(i);
+			break;
+		}
+	}
+	if (!modIni.FileExists() || !ParseModIni(modIni.GetFullPath(), tcPath)) {
+		wxLogError(_T("Unable to read the mod.ini of the installed mod %s"),
+			shortname.c_str());
+		return;
+	}
+	ModItem* item = this->MakeModItem(this->configFiles->Last(), tcPath, false);
+
+	const int selected = this->GetSelection();
+	const wxString selectedShortname((selected == wxNOT_FOUND) ? wxString(wxEmptyString)
+		: this->tableData->Item(selected).shortname);
+	bool wasActive = false;
+	for (size_t i = 0; i < this->tableData->GetCount(); ++i) {
+		if (this->tableData->Item(i).shortname == shortname) {
+			wasActive = (&this->tableData->Item(i) == ModList::activeMod);
+			this->tableData->RemoveAt(i);
+			break;
+		}
+	}
+
+	size_t position = 0;
+	while (position < this->tableData->GetCount()
+		&& !CompareModItems(item, &this->tableData->Item(position))) {
+		++position;
+	}
+	this->tableData->Insert(item, position);
+	this->SetItemCount(this->tableData->GetCount());
+
+	if (wasActive) {
+		// its modline may have changed
+		SetSelectedMod();
+	} else {
+		for (size_t i = 0; i < this->tableData->GetCount(); ++i) {
+			if (this->tableData->Item(i).shortname == selectedShortname) {
+				this->SetSelection(i);
+				break;
+			}
+		}
+	}
 	this->Refresh();
 }
 
 void ModList::OnInfoMod(wxCommandEvent &WXUNUSED(event)) {
 	int selected = this->GetSelection();
 	wxCHECK_RET(selected != wxNOT_FOUND, _T("Do not have a valid selection."));
-	new ModInfoDialog(new ModItem(this->tableData->Item(selected)), this);
+	wxArrayString tcMods;
+	for (size_t i = 0; i < this->tableData->GetCount(); ++i) {
+		tcMods.Add(this->tableData->Item(i).shortname);
+	}
+	new ModInfoDialog(new ModItem(this->tableData->Item(selected)), tcMods, this);
 }
 
 void ModList::OnTCSkinChanged(wxCommandEvent &WXUNUSED(event)) {
@@ -999,6 +1105,8 @@ BEGIN_EVENT_TABLE(ModList, wxVListBox)
 EVT_LISTBOX(ID_MODLISTBOX, ModList::OnSelectionChange)
 EVT_BUTTON(ID_MODLISTBOX_ACTIVATE_BUTTON, ModList::OnActivateMod)
 EVT_BUTTON(ID_MODLISTBOX_INFO_BUTTON, ModList::OnInfoMod)
+EVT_COMMAND(wxID_NONE, EVT_TC_PROFILE_MOD_CHANGED, ModList::OnProfileModChanged)
+EVT_COMMAND(wxID_NONE, EVT_TC_MOD_INSTALLED, ModList::OnModInstalled)
 END_EVENT_TABLE()
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -1309,7 +1417,87 @@ void ModItem::ModImage::Draw(wxDC &dc, const wxRect &rect) {
 	}
 }
 
-ModInfoDialog::ModInfoDialog(ModItem* item, wxWindow* parent) {
+static wxString JoinExamples(const wxArrayString& examples) {
+	wxString joined;
+	for (size_t i = 0; i < examples.GetCount(); ++i) {
+		if (!joined.IsEmpty()) {
+			joined += _T(", ");
+		}
+		joined += examples[i];
+	}
+	return joined;
+}
+
+/** Puts the folders of item's mod chain into chain, in the order the game
+ searches them, the root folder last, and what to call them into names. */
+static void GetModChain(const ModItem& item, const wxString& tcPath,
+	wxArrayString& chain, wxArrayString& names) {
+	wxStringTokenizer tokens(ModList::MakeModline(item), _T(","), wxTOKEN_STRTOK);
+	while (tokens.HasMoreTokens()) {
+		const wxString mod(tokens.GetNextToken().Trim(true).Trim(false));
+		if (!mod.IsEmpty() && names.Index(mod) == wxNOT_FOUND) {
+			chain.Add(tcPath + wxFileName::GetPathSeparator() + mod);
+			names.Add(mod);
+		}
+	}
+	chain.Add(tcPath);
+	names.Add(_("the TC's root folder"));
+}
+
+/** Starts indexing the VPs of item's mod chain and of every other mod in
+ the TC, so that later dialogs only have to parse VPs that have changed.
+ owner is sent EVT_VP_INDEX_DONE when done. */
+static void StartPackageIndex(wxEvtHandler* owner, const ModItem& item,
+	const wxString& tcPath, const wxArrayString& tcMods) {
+	wxArrayString folders, names;
+	GetModChain(item, tcPath, folders, names);
+	for (size_t i = 0; i < tcMods.GetCount(); ++i) {
+		const wxString folder(tcPath + wxFileName::GetPathSeparator() + tcMods[i]);
+		if (tcMods[i] != NO_MOD && folders.Index(folder) == wxNOT_FOUND) {
+			folders.Add(folder);
+		}
+	}
+	VPIndex::Get().StartUpdate(owner, folders);
+}
+
+/** Describes the files in the VPs of item's folder, and which of them take
+ the place of or are replaced by files of the other mods in item's mod
+ chain, as indexed by StartPackageIndex(). */
+static wxString FormatPackageReport(const ModItem& item, const wxString& tcPath) {
+	wxArrayString chain, chainNames;
+	GetModChain(item, tcPath, chain, chainNames);
+
+	const int position = (item.shortname == NO_MOD) ?
+		static_cast<int>(chain.GetCount()) - 1 : chainNames.Index(item.shortname);
+	wxCHECK_MSG(position != wxNOT_FOUND, wxEmptyString,
+		_T("The mod is missing from its own mod chain"));
+	const VPIndex::ChainReport report(VPIndex::Get().Compare(chain, position));
+
+	if (report.vpCount == 0) {
+		return _("This mod has no VP files.");
+	}
+	wxString page(wxString::Format(_("<b>%lu files in %lu VP files.</b>"),
+		static_cast<unsigned long>(report.fileCount),
+		static_cast<unsigned long>(report.vpCount)));
+
+	for (size_t i = 0; i < report.overrides.size(); ++i) {
+		const VPIndex::Overlap& overlap(report.overrides[i]);
+		page += wxString::Format(_("<br>Replaces %lu files of <i>%s</i>, such as %s"),
+			static_cast<unsigned long>(overlap.count),
+			chainNames[chain.Index(overlap.folder)].c_str(),
+			JoinExamples(overlap.examples).c_str());
+	}
+	for (size_t i = 0; i < report.shadowedBy.size(); ++i) {
+		const VPIndex::Overlap& overlap(report.shadowedBy[i]);
+		page += wxString::Format(_("<br>%lu files are replaced by <i>%s</i>, such as %s"),
+			static_cast<unsigned long>(overlap.count),
+			chainNames[chain.Index(overlap.folder)].c_str(),
+			JoinExamples(overlap.examples).c_str());
+	}
+	return page;
+}
+
+ModInfoDialog::ModInfoDialog(ModItem* item, const wxArrayString& tcMods, wxWindow* parent) {
 	wxASSERT(item != NULL);
 	this->item = item;
 
@@ -1328,12 +1516,15 @@ ModInfoDialog::ModInfoDialog(ModItem* item, wxWindow* parent) {
 	titleBox->SetFont(titleFont);
 
 	wxString tcPath;
-	ProMan::GetProfileManager()->ProfileRead(PRO_CFG_TC_ROOT_FOLDER, &tcPath, wxEmptyString);
+	ProMan::GetProfileManager()->ProfileRead(PKEY_TC_ROOT_FOLDER, &tcPath);
 	wxString modFolderString =
 		wxString::Format(_T("%s%s"),
 			tcPath.c_str(),
 			(item->shortname == NO_MOD) ? wxEmptyString :
 				(wxString(wxFileName::GetPathSeparator()) + item->shortname).c_str());
+	this->modFolder = modFolderString;
+	this->tcPath = tcPath;
+	this->tcMods = tcMods;
 	wxStaticText* modFolderBox = 
 		new wxStaticText(this, wxID_ANY, modFolderString, wxDefaultPosition, wxDefaultSize, wxALIGN_CENTRE);
 
@@ -1411,6 +1602,26 @@ ModInfoDialog::ModInfoDialog(ModItem* item, wxWindow* parent) {
 		notesText->SetMinSize(wxSize(200, 64));
 	}
 
+	this->packages = NULL;
+	if ( !tcPath.IsEmpty() ) {
+		this->packages = new wxHtmlWindow(this, wxID_ANY, wxDefaultPosition, wxDefaultSize, wxBORDER_SUNKEN);
+		this->packages->SetMinSize(wxSize(SkinSystem::ModInfoDialogImageWidth, 100));
+		this->packages->SetPage(_("Reading the VP files..."));
+		this->Connect(EVT_VP_INDEX_DONE,
+			wxCommandEventHandler(ModInfoDialog::OnVPIndexDone));
+		StartPackageIndex(this, *item, tcPath, tcMods);
+	}
+
+	wxButton* verify = new wxButton(this, wxID_ANY, _("Verify files"));
+	verify->Connect(wxEVT_COMMAND_BUTTON_CLICKED,
+		wxCommandEventHandler(ModInfoDialog::OnVerify), NULL, this);
+	verify->Enable(!tcPath.IsEmpty());
+
+	wxButton* diskUsage = new wxButton(this, wxID_ANY, _("Disk usage..."));
+	diskUsage->Connect(wxEVT_COMMAND_BUTTON_CLICKED,
+		wxCommandEventHandler(ModInfoDialog::OnDiskUsage), NULL, this);
+	diskUsage->Enable(!tcPath.IsEmpty());
+
 	wxButton* close = new wxButton(this, wxID_ANY, _("Close"));
 	this->SetEscapeId(close->GetId());
 
@@ -1430,11 +1641,21 @@ ModInfoDialog::ModInfoDialog(ModItem* item, wxWindow* parent) {
 			sizer->Add(notesText, wxSizerFlags().Expand().Centre());
 		}
 	}
-	sizer->Add(close, wxSizerFlags().Centre());
+	if ( this->packages != NULL ) {
+		sizer->Add(this->packages, wxSizerFlags().Expand().Centre());
+	}
+	wxBoxSizer* buttonSizer = new wxBoxSizer(wxHORIZONTAL);
+	buttonSizer->Add(verify);
+	buttonSizer->AddSpacer(5);
+	buttonSizer->Add(diskUsage);
+	buttonSizer->AddSpacer(5);
+	buttonSizer->Add(close);
+	sizer->Add(buttonSizer, wxSizerFlags().Centre());
 	this->SetSizerAndFit(sizer);
 	this->Layout();
 	this->CentreOnParent();
 	this->ShowModal();
+	VPIndex::Get().CancelUpdate();
 }
 
 void ModInfoDialog::OnLinkClicked(wxHtmlLinkEvent &event) {
@@ -1443,6 +1664,36 @@ void ModInfoDialog::OnLinkClicked(wxHtmlLinkEvent &event) {
 	wxLaunchDefaultBrowser(info.GetHref());
 }
 
+/** Verifies the files in the mod's folder, which for (No mod) is the
+ whole TC, against the mod's checksum manifest if it has one. */
+void ModInfoDialog::OnVerify(wxCommandEvent &WXUNUSED(event)) {
+	wxString manifest;
+	if ( !this->item->manifest.IsEmpty() ) {
+		manifest = this->modFolder + wxFileName::GetPathSeparator() + this->item->manifest;
+	}
+	const VerifyResult result(ModVerifier::Get().Verify(this->modFolder, manifest, this));
+	wxMessageBox(ModVerifier::FormatResult(result, 10), _("Verify files"),
+		wxOK | (result.problems.empty() ? wxICON_INFORMATION : wxICON_WARNING), this);
+}
+
+/** Shows the disk usage of every mod in the TC, starting with this one.
+ (No mod) stands for the TC's own folder. */
+void ModInfoDialog::OnDiskUsage(wxCommandEvent &WXUNUSED(event)) {
+	wxArrayString mods;
+	for (size_t i = 0; i < this->tcMods.GetCount(); ++i) {
+		mods.Add((this->tcMods[i] == NO_MOD) ? wxString() : this->tcMods[i]);
+	}
+	DiskUsageDialog dialog(this, this->tcPath,
+		mods, (this->item->shortname == NO_MOD) ? wxString() : this->item->shortname);
+	dialog.ShowModal();
+}
+
+void ModInfoDialog::OnVPIndexDone(wxCommandEvent &WXUNUSED(event)) {
+	if ( VPIndex::Get().FinishUpdate() ) {
+		this->packages->SetPage(FormatPackageReport(*this->item, this->tcPath));
+	}
+}
+
 ModInfoDialog::ImageDrawer::ImageDrawer(ModInfoDialog* parent):
 wxPanel(parent) {
 	this->parent = parent;
@@ -93,6 +93,8 @@ public:
 	wxString recommendedlightingname;
 	wxString recommendedlightingflagset;
 
+	wxString manifest; //!< checksum file, relative to the mod's folder
+
 	FlagSets* flagsets;	// set 0 is the ideal set.
 
 #ifdef MOD_TEXT_LOCALIZATION // mod text localization is not supported for now
@@ -154,8 +156,13 @@ public:
 	void OnActivateMod(wxCommandEvent &event);
 	void OnInfoMod(wxCommandEvent &event);
 	void OnTCSkinChanged(wxCommandEvent &event);
+	void OnProfileModChanged(wxCommandEvent &event);
+	void OnModInstalled(wxCommandEvent &event);
 	
 	static const ModItem* GetActiveMod() { return ModList::activeMod; }
+	/** Returns the modline that activating item would give: its primary
+	 mods, the mod itself, then its secondary mods. */
+	static wxString MakeModline(const ModItem& item);
 
 private:
 	/** A hash map of the wxFileConfigs that represent the mod.ini files for
@@ -192,6 +199,7 @@ private:
 	wxString escapeSpecials(const wxString& toEscape);
 	
 	bool ParseModIni(const wxString& modIniPath, const wxString& tcPath, bool isNoMod = false);
+	ModItem* MakeModItem(const ConfigPair& pair, const wxString& tcPath, bool isTC);
 	void SetSelectedMod();
 	static wxString GetShortName(const wxString& modIniPath, const wxString& tcPath);
 
@@ -43,6 +43,7 @@ const int ICON_FIELD_WIDTH = 25;
 BEGIN_EVENT_TABLE(StatusBar, wxStatusBar)
 EVT_SIZE(StatusBar::OnSize)
 EVT_COMMAND(wxID_NONE, EVT_TC_SKIN_CHANGED, StatusBar::OnTCSkinChanged)
+EVT_COMMAND(wxID_NONE, EVT_LOG_STATUS_MESSAGE, StatusBar::OnLogStatusMessage)
 END_EVENT_TABLE()
 
 StatusBar::StatusBar(wxWindow *parent)
@@ -124,6 +125,11 @@ void StatusBar::OnTCSkinChanged(wxCommandEvent &WXUNUSED(event)) {
 	}	
 }
 
+/** Shows a message that was logged from another thread. */
+void StatusBar::OnLogStatusMessage(wxCommandEvent& event) {
+	this->SetMainStatusText(event.GetString(), event.GetInt());
+}
+
 void StatusBar::SetMainStatusText(wxString msg, int icon) {
 	this->SetStatusText(msg, SB_FIELD_MAINTEXT);
 	if ( icon > ID_SB_NO_CHANGE && icon < ID_SB_MAX_ID ) {
@@ -32,6 +32,7 @@ public:
 
 	void OnSize(wxSizeEvent& event);
 	void OnTCSkinChanged(wxCommandEvent& event);
+	void OnLogStatusMessage(wxCommandEvent& event);
 
 	void SetMainStatusText(wxString msg, int icon=ID_SB_NO_CHANGE);
 	void SetJobStatusText(int value, wxString msg=_T(""));
@@ -18,6 +18,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 #include "generated/configure_launcher.h"
 #include "datastructures/FSOExecutable.h"
+#include "global/LogDetail.h"
 #include <wx/dir.h>
 #include <wx/tokenzr.h>
 
@@ -196,7 +197,7 @@ wxArrayString FSOExecutable::GetBinariesFromRootFolder(
 			files.GetCount(), execType.c_str(), path.GetPath().c_str());
 		
 		for (size_t i = 0, n = files.GetCount(); i < n; ++i) {
-			wxLogDebug(_T("Found executable: %s"), files.Item(i).c_str());
+			LOG_DEBUG_PARSE(_T("Found executable: %s"), files.Item(i).c_str());
 		}
 	}
 
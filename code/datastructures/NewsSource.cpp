@@ -25,8 +25,10 @@ using std::vector;
 vector<NewsSource> NewsSource::newsSources;
 
 NewsSource::NewsSource(const NewsSourceId id, const wxString& name,
-	const wxString& newsUrl, const wxString& label)
-: id(id), name(name), newsUrl(newsUrl), label(label) {
+	const wxString& newsUrl, const wxString& label,
+	const wxTimeSpan& refreshInterval)
+: id(id), name(name), newsUrl(newsUrl), label(label),
+refreshInterval(refreshInterval) {
 	wxASSERT(!name.IsEmpty());
 	wxASSERT(!newsUrl.IsEmpty());
 	wxASSERT(!label.IsEmpty());
@@ -72,6 +74,13 @@ const NewsSource* NewsSource::FindSource(const wxString& name) {
 	return NULL;
 }
 
+const vector<NewsSource>& NewsSource::GetAllSources() {
+	if (newsSources.empty()) {
+		InitializeSources();
+	}
+	return newsSources;
+}
+
 void NewsSource::InitializeSources() {
 		wxASSERT_MSG(newsSources.empty(),
 			_T("news sources have already been initialized"));
@@ -84,11 +93,13 @@ void NewsSource::InitializeSources() {
 			NEWS_SOURCE_ID_HLP,
 			_T("hlp"),
 			_T("http://www.audiozone.ro/hl/"),
-			_("Latest highlights from Hard Light Productions")));
+			_("Latest highlights from Hard Light Productions"),
+			wxTimeSpan::Day()));
 	newsSources.push_back(
 		NewsSource(
 			NEWS_SOURCE_ID_DIASPORA,
 			_T("diaspora"),
 			_T("http://diaspora.hard-light.net/hl.htm"),
-			_("Latest Diaspora news")));
+			_("Latest Diaspora news"),
+			wxTimeSpan::Days(3))); // updated far less often than HLP
 }
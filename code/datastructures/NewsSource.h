@@ -21,6 +21,7 @@
 
 #include <vector>
 #include <wx/string.h>
+#include <wx/datetime.h>
 
 enum NewsSourceId {
 	NEWS_SOURCE_ID_HLP,
@@ -31,20 +32,25 @@ enum NewsSourceId {
 class NewsSource {
 public:
 	NewsSource(NewsSourceId id, const wxString& name,
-		const wxString& newsUrl, const wxString& label);
+		const wxString& newsUrl, const wxString& label,
+		const wxTimeSpan& refreshInterval);
 	
 	const NewsSourceId GetId() const { return this->id; }
 	const wxString& GetName() const { return this->name; }
 	const wxString& GetNewsUrl() const { return this->newsUrl; }
 	const wxString& GetLabel() const { return this->label; }
+	/** How long downloaded news is used before it is fetched again. */
+	const wxTimeSpan& GetRefreshInterval() const { return this->refreshInterval; }
 	
 	static const NewsSource* FindSource(NewsSourceId id);
 	static const NewsSource* FindSource(const wxString& name);
+	static const std::vector<NewsSource>& GetAllSources();
 private:
 	NewsSourceId id;
 	wxString name;
 	wxString newsUrl;
 	wxString label;
+	wxTimeSpan refreshInterval;
 	
 	static void InitializeSources();
 	static std::vector<NewsSource> newsSources;
@@ -20,8 +20,12 @@
 
 #include <wx/hashmap.h>
 
+#include "generated/configure_launcher.h"
 #include "controls/ModList.h"
 #include "apis/EventHandlers.h"
+#include "apis/FlagListManager.h"
+#include "apis/ProfileManager.h"
+#include "global/ProfileKeys.h"
 
 LAUNCHER_DEFINE_EVENT_TYPE(EVT_RESOLUTION_MAP_CHANGED);
 
@@ -53,6 +57,111 @@ bool ResolutionMap::HasEntryForActiveMod() {
 	return prefResMap.find(activeMod->shortname) != prefResMap.end();
 }
 
+/** Returns the API that the current binary lists its modes with. */
+static ResolutionMan::ApiType GetModesApi() {
+#if IS_WIN32
+	// If the current executable is a SDL exe, use that API
+	return (FlagListManager::GetFlagListManager()->GetBuildCaps()
+		& FlagListManager::BUILD_CAPS_SDL) ?
+			ResolutionMan::API_SDL : ResolutionMan::API_WIN32;
+#else
+	// OSX and Linux always use the SDL api
+	return ResolutionMan::API_SDL;
+#endif
+}
+
+void ResolutionMap::GetModesForActiveMod(ResolutionMan::ResolutionArray& modes) {
+	const ModItem* activeMod = ModList::GetActiveMod();
+	wxCHECK_RET(activeMod != NULL,
+		_T("GetModesForActiveMod: activeMod is NULL!"));
+
+	if (!FlagListManager::GetFlagListManager()->IsProcessingOK()) {
+		return;
+	}
+
+	ResolutionMan::EnumerateGraphicsModes(GetModesApi(), modes,
+		activeMod->minhorizontalres, activeMod->minverticalres);
+}
+
+bool ResolutionMap::StartEnumeratingModes(wxEvtHandler* handler) {
+	if (!FlagListManager::GetFlagListManager()->IsProcessingOK()) {
+		return false;
+	}
+	return ResolutionMan::ModeCatalog::StartEnumeration(GetModesApi(), handler);
+}
+
+/** Returns whether modes has width x height, not counting the headers. */
+static bool HasMode(const ResolutionMan::ResolutionArray& modes,
+	const long width, const long height)
+{
+	for (size_t i = 0; i < modes.GetCount(); ++i) {
+		if (!modes[i]->IsHeader()
+			&& (modes[i]->GetWidth() == width) && (modes[i]->GetHeight() == height)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool ResolutionMap::ChooseForActiveMod(const ResolutionMan::ResolutionArray& modes) {
+	const ModItem* activeMod = ModList::GetActiveMod();
+	wxCHECK_MSG(activeMod != NULL, false,
+		_T("ChooseForActiveMod: activeMod is NULL!"));
+	ProMan* proman = ProMan::GetProfileManager();
+
+	long width = 0, height = 0;
+	bool hasValidRes = false;
+
+	// first try the map
+	const ResolutionData* resDataPtr = ResolutionRead(activeMod->shortname);
+	if (resDataPtr != NULL) {
+		width = resDataPtr->width;
+		height = resDataPtr->height;
+		hasValidRes = HasMode(modes, width, height);
+		if (!hasValidRes) {
+			wxLogDebug(_T("map resolution %ldx%ld not found, attempting to use profile value"),
+				width, height);
+		}
+	} else {
+		wxLogDebug(_T("no resolution found in map, attempting to use profile value"));
+	}
+
+	// then the profile
+	if (!hasValidRes
+		&& proman->ProfileRead(PKEY_VIDEO_RESOLUTION_WIDTH, &width)
+		&& proman->ProfileRead(PKEY_VIDEO_RESOLUTION_HEIGHT, &height)) {
+		hasValidRes = HasMode(modes, width, height);
+	}
+
+	// last resort, use the max supported resolution
+	if (!hasValidRes) {
+		wxLogDebug(_T("no usable resolution in map or profile, using default max supported resolution"));
+		long maxResProduct = 0;
+		for (size_t i = 0; i < modes.GetCount(); ++i) {
+			// 'n' is pretty small, so just look at all of them
+			if (!modes[i]->IsHeader()
+				&& (modes[i]->GetWidth() * modes[i]->GetHeight() > maxResProduct)) {
+				width = modes[i]->GetWidth();
+				height = modes[i]->GetHeight();
+				maxResProduct = width * height;
+			}
+		}
+		if (maxResProduct == 0) {
+			wxLogError(
+				_T("Your system does not support the minimum resolution needed to play this mod (%ldx%ld)."),
+				activeMod->minhorizontalres, activeMod->minverticalres);
+			return false;
+		}
+	}
+
+	// update profile and map
+	proman->ProfileWrite(PRO_CFG_VIDEO_RESOLUTION_WIDTH, width);
+	proman->ProfileWrite(PRO_CFG_VIDEO_RESOLUTION_HEIGHT, height);
+
+	ResolutionWrite(activeMod->shortname, ResolutionData(width, height));
+	return true;
+}
+
 void ResolutionMap::RegisterResolutionMapChanged(wxEvtHandler *handler) {
 	wxASSERT_MSG(resolutionMapChangedHandlers.IndexOf(handler) == wxNOT_FOUND,
 		wxString::Format(
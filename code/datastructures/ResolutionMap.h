@@ -24,6 +24,7 @@
 
 #include "global/ModDefaults.h"
 #include "apis/EventHandlers.h"
+#include "apis/resolution_manager.hpp"
 
 /** Maps a mod shortname to its user-preferred resolution. */
 // TODO FIXME: Once the refresh button for the mod list is added,
@@ -53,6 +54,21 @@ public:
 	static void ResolutionWrite(const wxString& shortname, const ResolutionData& resData);
 	static bool HasEntryForActiveMod();
 	
+	/** Appends the resolutions that the current binary can use for the
+	 active mod to modes; the caller owns them. Appends nothing until flag
+	 file processing has succeeded, since the binary decides which API
+	 lists the modes. */
+	static void GetModesForActiveMod(ResolutionMan::ResolutionArray& modes);
+	/** Starts listing the current binary's modes in the background, if its
+	 API allows it. Returns true if handler is to wait for
+	 EVT_RESOLUTION_MODES_ENUMERATED before GetModesForActiveMod(). */
+	static bool StartEnumeratingModes(wxEvtHandler* handler);
+	/** Picks the active mod's resolution from modes and writes it to the map
+	 and the profile. The map's entry is kept if it is in modes, then the
+	 profile's, otherwise the largest of modes is used. Returns false if
+	 modes has no resolution. */
+	static bool ChooseForActiveMod(const ResolutionMan::ResolutionArray& modes);
+	
 	static void RegisterResolutionMapChanged(wxEvtHandler *handler);
 	static void UnRegisterResolutionMapChanged(wxEvtHandler *handler);
 private:
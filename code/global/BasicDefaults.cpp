@@ -17,36 +17,45 @@
  */
 
 #include "BasicDefaults.h"
+#include "ProfileKeyTable.h"
 
 // internal constants
 const unsigned int JOYMAN_INVALID_JOYSTICK =	99999;
 
-// defaults for basic settings
-const long DEFAULT_VIDEO_RESOLUTION_WIDTH =		1024;
-const long DEFAULT_VIDEO_RESOLUTION_HEIGHT =	768;
-const long DEFAULT_VIDEO_BIT_DEPTH =			32;
-const wxString DEFAULT_VIDEO_TEXTURE_FILTER =	_T("Trilinear");
-const long DEFAULT_VIDEO_ANISOTROPIC =			0;
-const long DEFAULT_VIDEO_ANTI_ALIAS =			0;
+// defaults for basic settings, taken from PROFILE_KEY_TABLE where the key has one
+const long DEFAULT_VIDEO_RESOLUTION_WIDTH =		PROFILE_KEYS[PKEY_VIDEO_RESOLUTION_WIDTH].defaultLong;
+const long DEFAULT_VIDEO_RESOLUTION_HEIGHT =	PROFILE_KEYS[PKEY_VIDEO_RESOLUTION_HEIGHT].defaultLong;
+const long DEFAULT_VIDEO_BIT_DEPTH =			PROFILE_KEYS[PKEY_VIDEO_BIT_DEPTH].defaultLong;
+const wxString DEFAULT_VIDEO_TEXTURE_FILTER =	PROFILE_KEYS[PKEY_VIDEO_TEXTURE_FILTER].defaultString;
+const long DEFAULT_VIDEO_ANISOTROPIC =			PROFILE_KEYS[PKEY_VIDEO_ANISOTROPIC].defaultLong;
+const long DEFAULT_VIDEO_ANTI_ALIAS =			PROFILE_KEYS[PKEY_VIDEO_ANTI_ALIAS].defaultLong;
 
-const wxString DEFAULT_AUDIO_OPENAL_DEVICE =	_T("no sound");
+const wxString DEFAULT_AUDIO_OPENAL_DEVICE =	PROFILE_KEYS[PKEY_OPENAL_DEVICE].defaultString;
 const wxString DEFAULT_AUDIO_OPENAL_PLAYBACK_DEVICE = wxEmptyString;
-const wxString DEFAULT_AUDIO_OPENAL_CAPTURE_DEVICE = wxEmptyString;
-const bool DEFAULT_AUDIO_OPENAL_EFX =			false;
-const long DEFAULT_AUDIO_OPENAL_SAMPLE_RATE =	0;
+const wxString DEFAULT_AUDIO_OPENAL_CAPTURE_DEVICE = PROFILE_KEYS[PKEY_OPENAL_CAPTURE_DEVICE].defaultString;
+const bool DEFAULT_AUDIO_OPENAL_EFX =			PROFILE_KEYS[PKEY_OPENAL_EFX].defaultLong != 0;
+const long DEFAULT_AUDIO_OPENAL_SAMPLE_RATE =	PROFILE_KEYS[PKEY_OPENAL_SAMPLE_RATE].defaultLong;
 
-const long DEFAULT_SPEECH_VOICE =				0;
-const long DEFAULT_SPEECH_VOLUME =				100;
-const bool DEFAULT_SPEECH_IN_TECHROOM =			false;
-const bool DEFAULT_SPEECH_IN_BRIEFINGS =		false;
-const bool DEFAULT_SPEECH_IN_GAME =				false;
-const bool DEFAULT_SPEECH_IN_MULTI =			false;
+const long DEFAULT_SPEECH_VOICE =				PROFILE_KEYS[PKEY_SPEECH_VOICE].defaultLong;
+const long DEFAULT_SPEECH_VOLUME =				PROFILE_KEYS[PKEY_SPEECH_VOLUME].defaultLong;
+const bool DEFAULT_SPEECH_IN_TECHROOM =			PROFILE_KEYS[PKEY_SPEECH_IN_TECHROOM].defaultLong != 0;
+const bool DEFAULT_SPEECH_IN_BRIEFINGS =		PROFILE_KEYS[PKEY_SPEECH_IN_BRIEFINGS].defaultLong != 0;
+const bool DEFAULT_SPEECH_IN_GAME =				PROFILE_KEYS[PKEY_SPEECH_IN_GAME].defaultLong != 0;
+const bool DEFAULT_SPEECH_IN_MULTI =			PROFILE_KEYS[PKEY_SPEECH_IN_MULTI].defaultLong != 0;
 
 const long DEFAULT_JOYSTICK_ID =				JOYMAN_INVALID_JOYSTICK;
-const bool DEFAULT_JOYSTICK_FORCE_FEEDBACK =	false;
-const bool DEFAULT_JOYSTICK_DIRECTIONAL =		false;
+static_assert(PROFILE_KEYS[PKEY_JOYSTICK_ID].defaultLong == static_cast<long>(JOYMAN_INVALID_JOYSTICK),
+	"PROFILE_KEY_TABLE's joystick id default must be JOYMAN_INVALID_JOYSTICK");
+const bool DEFAULT_JOYSTICK_FORCE_FEEDBACK =	PROFILE_KEYS[PKEY_JOYSTICK_FORCE_FEEDBACK].defaultLong != 0;
+const bool DEFAULT_JOYSTICK_DIRECTIONAL =		PROFILE_KEYS[PKEY_JOYSTICK_DIRECTIONAL].defaultLong != 0;
 
-const wxString DEFAULT_NETWORK_TYPE =			_T("None");
-const wxString DEFAULT_NETWORK_SPEED =			_T("None");
-const long DEFAULT_NETWORK_PORT =				0;
-const wxString DEFAULT_NETWORK_IP =				wxEmptyString;
+const wxString DEFAULT_NETWORK_TYPE =			PROFILE_KEYS[PKEY_NETWORK_TYPE].defaultString;
+const wxString DEFAULT_NETWORK_SPEED =			PROFILE_KEYS[PKEY_NETWORK_SPEED].defaultString;
+const long DEFAULT_NETWORK_PORT =				PROFILE_KEYS[PKEY_NETWORK_PORT].defaultLong;
+const wxString DEFAULT_NETWORK_IP =				PROFILE_KEYS[PKEY_NETWORK_IP].defaultString;
+
+const wxString DEFAULT_LAUNCH_CPU_AFFINITY =	PROFILE_KEYS[PKEY_LAUNCH_CPU_AFFINITY].defaultString;
+const long DEFAULT_LAUNCH_NICE =				PROFILE_KEYS[PKEY_LAUNCH_NICE].defaultLong;
+const long DEFAULT_LAUNCH_IO_CLASS =			PROFILE_KEYS[PKEY_LAUNCH_IO_CLASS].defaultLong;
+const long DEFAULT_LAUNCH_IO_PRIORITY =			PROFILE_KEYS[PKEY_LAUNCH_IO_PRIORITY].defaultLong;
+const wxString DEFAULT_LAUNCH_ENVIRONMENT =	PROFILE_KEYS[PKEY_LAUNCH_ENVIRONMENT].defaultString;
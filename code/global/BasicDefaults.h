@@ -51,6 +51,12 @@ extern const wxString DEFAULT_NETWORK_TYPE;
 extern const wxString DEFAULT_NETWORK_SPEED;
 extern const long DEFAULT_NETWORK_PORT;
 extern const wxString DEFAULT_NETWORK_IP;
+
+extern const wxString DEFAULT_LAUNCH_CPU_AFFINITY;
+extern const long DEFAULT_LAUNCH_NICE;
+extern const long DEFAULT_LAUNCH_IO_CLASS;
+extern const long DEFAULT_LAUNCH_IO_PRIORITY;
+extern const wxString DEFAULT_LAUNCH_ENVIRONMENT;
 /** @}*/
 
 #endif
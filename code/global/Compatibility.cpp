@@ -97,7 +97,7 @@ namespace Compatibility
 		wxFileName oldConfigFolder;
 #if IS_WIN32
 		wxString rootPath;
-		if (!profileManager->ProfileRead(PRO_CFG_TC_ROOT_FOLDER, &rootPath))
+		if (!profileManager->ProfileRead(PKEY_TC_ROOT_FOLDER, &rootPath))
 		{
 			wxLogWarning(_T("No TC root folder in configuration!"));
 			return false;
@@ -0,0 +1,55 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef LOGDETAIL_H
+#define LOGDETAIL_H
+
+#include <wx/log.h>
+
+#include "generated/configure_launcher.h"
+
+/** Detail levels for debug messages logged from loops that run often, such
+ as parsing files or drawing controls. The DEBUG_LOG_DETAIL build setting
+ picks the highest level that is compiled in; the calls for the levels above
+ it expand to nothing, so their arguments aren't even evaluated. */
+#define LOG_DETAIL_PARSE 1
+#define LOG_DETAIL_DRAW 2
+
+#ifndef DEBUG_LOG_DETAIL
+#define DEBUG_LOG_DETAIL LOG_DETAIL_PARSE
+#endif
+
+#if DEBUG_LOG_DETAIL < 0 || DEBUG_LOG_DETAIL > LOG_DETAIL_DRAW
+#error DEBUG_LOG_DETAIL must be 0 (none), 1 (parsing files) or 2 (also drawing controls)
+#endif
+
+/** wxLogDebug for a message logged for every line or entry of a parsed file. */
+#if DEBUG_LOG_DETAIL >= LOG_DETAIL_PARSE
+#define LOG_DEBUG_PARSE(...) wxLogDebug(__VA_ARGS__)
+#else
+#define LOG_DEBUG_PARSE(...) do {} while (0)
+#endif
+
+/** wxLogDebug for a message logged every time something is drawn. */
+#if DEBUG_LOG_DETAIL >= LOG_DETAIL_DRAW
+#define LOG_DEBUG_DRAW(...) wxLogDebug(__VA_ARGS__)
+#else
+#define LOG_DEBUG_DRAW(...) do {} while (0)
+#endif
+
+#endif
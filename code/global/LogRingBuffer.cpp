@@ -0,0 +1,77 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "global/LogRingBuffer.h"
+
+#include "global/MemoryDebugging.h"
+
+LogRingBuffer::LogRingBuffer(size_t capacity)
+: mask(0), pushPosition(0), popPosition(0) {
+	size_t size = 2;
+	while (size < capacity) {
+		size <<= 1;
+	}
+	this->mask = size - 1;
+
+	this->slots.reset(new Slot[size]);
+	for (size_t i = 0; i < size; ++i) {
+		this->slots[i].sequence.store(i, std::memory_order_relaxed);
+	}
+}
+
+bool LogRingBuffer::TryPush(LogEntry& entry) {
+	size_t position = this->pushPosition.load(std::memory_order_relaxed);
+	Slot* slot;
+	for (;;) {
+		slot = &this->slots[position & this->mask];
+		const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+		const ptrdiff_t diff =
+			static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(position);
+		if (diff == 0) {
+			// the slot is free; claim it unless another producer got there first
+			if (this->pushPosition.compare_exchange_weak(position, position + 1,
+					std::memory_order_relaxed)) {
+				break;
+			}
+		} else if (diff < 0) {
+			return false; // the reader hasn't freed this slot yet: full
+		} else {
+			position = this->pushPosition.load(std::memory_order_relaxed);
+		}
+	}
+
+	slot->entry.text.swap(entry.text);
+	slot->sequence.store(position + 1, std::memory_order_release);
+	return true;
+}
+
+bool LogRingBuffer::TryPop(LogEntry& entry) {
+	const size_t position = this->popPosition.load(std::memory_order_relaxed);
+	Slot* slot = &this->slots[position & this->mask];
+	const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+	if (sequence != position + 1) {
+		return false; // empty, or the producer hasn't finished writing it
+	}
+	this->popPosition.store(position + 1, std::memory_order_relaxed);
+
+	entry.text.swap(slot->entry.text);
+	slot->entry.text.clear();
+	// hand the slot back to producers one lap later
+	slot->sequence.store(position + this->mask + 1, std::memory_order_release);
+	return true;
+}
@@ -0,0 +1,65 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef LOGRINGBUFFER_H
+#define LOGRINGBUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+/** One line of the log file, already formatted and converted to UTF-8 by
+ the thread that logged it. */
+struct LogEntry {
+	std::string text;
+};
+
+/** LogRingBuffer - a fixed-size queue of log entries that any number of
+ threads can push to without taking a lock, drained by a single reader.
+ Each slot carries a sequence number that tells producers and the reader
+ whose turn it is to use the slot (Vyukov's bounded queue). A push fails
+ instead of waiting when the buffer is full. */
+class LogRingBuffer {
+public:
+	/** capacity is rounded up to a power of two. */
+	explicit LogRingBuffer(size_t capacity);
+
+	/** Moves entry into the buffer. Returns false if the buffer is full, in
+	 which case entry is left as it was. */
+	bool TryPush(LogEntry& entry);
+	/** Moves the oldest entry into entry. Returns false if the buffer is
+	 empty. Must only be called from one thread at a time. */
+	bool TryPop(LogEntry& entry);
+
+private:
+	struct Slot {
+		std::atomic<size_t> sequence;
+		LogEntry entry;
+	};
+
+	std::unique_ptr<Slot[]> slots;
+	size_t mask;
+	std::atomic<size_t> pushPosition;
+	std::atomic<size_t> popPosition;
+
+	LogRingBuffer(const LogRingBuffer&);
+	LogRingBuffer& operator=(const LogRingBuffer&);
+};
+
+#endif
@@ -0,0 +1,167 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+ 
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <wx/wx.h>
+
+#include "global/MappedFile.h"
+
+#if IS_WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+#include "global/MemoryDebugging.h"
+
+/** Logs message, or hands it back through error if the caller wants it. */
+static void ReportError(wxString* error, const wxString& message) {
+	if (error != NULL) {
+		*error = message;
+	} else {
+		wxLogError(_T("%s"), message.c_str());
+	}
+}
+
+MappedFile::MappedFile()
+: isOpen(false), data(NULL), size(0)
+#if IS_WIN32
+, fileHandle(INVALID_HANDLE_VALUE), mappingHandle(NULL)
+#endif
+{
+}
+
+MappedFile::~MappedFile() {
+	this->Close();
+}
+
+#if IS_WIN32
+bool MappedFile::Open(const wxString& path, wxString* error) {
+	this->Close();
+
+	HANDLE file = ::CreateFileW(path.wc_str(), GENERIC_READ, FILE_SHARE_READ,
+		NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE) {
+		ReportError(error, wxString::Format(_T("Unable to open %s for mapping (error %lu)"),
+			path.c_str(), ::GetLastError()));
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!::GetFileSizeEx(file, &fileSize)
+		|| static_cast<unsigned long long>(fileSize.QuadPart) > static_cast<size_t>(-1)) {
+		ReportError(error, wxString::Format(
+			_T("Unable to get the size of %s for mapping"), path.c_str()));
+		::CloseHandle(file);
+		return false;
+	}
+
+	this->fileHandle = file;
+	this->size = static_cast<size_t>(fileSize.QuadPart);
+	this->isOpen = true;
+	if (this->size == 0) {
+		return true; // nothing to map
+	}
+
+	HANDLE mapping = ::CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mapping == NULL) {
+		ReportError(error, wxString::Format(_T("Unable to map %s (error %lu)"),
+			path.c_str(), ::GetLastError()));
+		this->Close();
+		return false;
+	}
+	this->mappingHandle = mapping;
+
+	this->data = static_cast<const unsigned char*>(
+		::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+	if (this->data == NULL) {
+		ReportError(error, wxString::Format(_T("Unable to map a view of %s (error %lu)"),
+			path.c_str(), ::GetLastError()));
+		this->Close();
+		return false;
+	}
+	return true;
+}
+
+void MappedFile::Close() {
+	if (this->data != NULL) {
+		::UnmapViewOfFile(this->data);
+	}
+	if (this->mappingHandle != NULL) {
+		::CloseHandle(static_cast<HANDLE>(this->mappingHandle));
+	}
+	if (this->fileHandle != INVALID_HANDLE_VALUE) {
+		::CloseHandle(static_cast<HANDLE>(this->fileHandle));
+	}
+	this->fileHandle = INVALID_HANDLE_VALUE;
+	this->mappingHandle = NULL;
+	this->data = NULL;
+	this->size = 0;
+	this->isOpen = false;
+}
+#else
+bool MappedFile::Open(const wxString& path, wxString* error) {
+	this->Close();
+
+	const int fd = ::open(path.fn_str(), O_RDONLY);
+	if (fd < 0) {
+		ReportError(error, wxString::Format(_T("Unable to open %s for mapping: %s"), path.c_str(),
+			wxString(strerror(errno), wxConvLocal).c_str()));
+		return false;
+	}
+
+	struct stat info;
+	if (::fstat(fd, &info) != 0 || info.st_size < 0
+		|| static_cast<unsigned long long>(info.st_size) > static_cast<size_t>(-1)) {
+		ReportError(error, wxString::Format(
+			_T("Unable to get the size of %s for mapping"), path.c_str()));
+		::close(fd);
+		return false;
+	}
+
+	this->size = static_cast<size_t>(info.st_size);
+	if (this->size > 0) {
+		void* mapping = ::mmap(NULL, this->size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (mapping == MAP_FAILED) {
+			ReportError(error, wxString::Format(_T("Unable to map %s: %s"), path.c_str(),
+				wxString(strerror(errno), wxConvLocal).c_str()));
+			::close(fd);
+			this->size = 0;
+			return false;
+		}
+		this->data = static_cast<const unsigned char*>(mapping);
+	}
+	// the mapping holds its own reference to the file
+	::close(fd);
+	this->isOpen = true;
+	return true;
+}
+
+void MappedFile::Close() {
+	if (this->data != NULL) {
+		::munmap(const_cast<unsigned char*>(this->data), this->size);
+	}
+	this->data = NULL;
+	this->size = 0;
+	this->isOpen = false;
+}
+#endif
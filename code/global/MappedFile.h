@@ -0,0 +1,60 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+ 
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+
+#include <wx/string.h>
+
+#include "generated/configure_launcher.h"
+
+/** MappedFile - a file mapped read-only into memory, so that it can be read
+ through a pointer without copying it into buffers first. The mapping lasts
+ until Close() or the MappedFile is destroyed. */
+class MappedFile {
+public:
+	MappedFile();
+	~MappedFile();
+
+	/** Maps the file at path, closing any file already mapped. Returns
+	 false if it can't, with the reason in error, or logged if error is NULL.
+	 Passing error makes Open() safe to call from a worker thread. */
+	bool Open(const wxString& path, wxString* error = NULL);
+	void Close();
+	bool IsOpen() const { return this->isOpen; }
+
+	/** NULL for an empty file. */
+	const unsigned char* GetData() const { return this->data; }
+	size_t GetSize() const { return this->size; }
+
+private:
+	bool isOpen;
+	const unsigned char* data;
+	size_t size;
+#if IS_WIN32
+	void* fileHandle; //!< HANDLEs, kept as void* to keep windows.h out of here
+	void* mappingHandle;
+#endif
+
+	MappedFile(const MappedFile&);
+	MappedFile& operator=(const MappedFile&);
+};
+
+#endif
@@ -63,3 +63,5 @@ const wxString MOD_INI_KEY_SKIN_NEWS_SOURCE					(_T("/skin/newssource"));
 
 const wxString MOD_INI_KEY_RECOMMENDED_LIGHTING_NAME		(_T("/recommendedlighting/name"));
 const wxString MOD_INI_KEY_RECOMMENDED_LIGHTING_FLAGSET		(_T("/recommendedlighting/flagset"));
+
+const wxString MOD_INI_KEY_INTEGRITY_MANIFEST				(_T("/integrity/manifest"));
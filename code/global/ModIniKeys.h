@@ -73,6 +73,8 @@ extern const wxString MOD_INI_KEY_SKIN_NEWS_SOURCE;
 extern const wxString MOD_INI_KEY_RECOMMENDED_LIGHTING_NAME;
 extern const wxString MOD_INI_KEY_RECOMMENDED_LIGHTING_FLAGSET;
 
+extern const wxString MOD_INI_KEY_INTEGRITY_MANIFEST;
+
 /** @}*/
 
 #endif
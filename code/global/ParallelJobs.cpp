@@ -0,0 +1,50 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <algorithm>
+
+#include "global/ParallelJobs.h"
+
+#include "global/MemoryDebugging.h"
+
+ParallelJobs::ParallelJobs(size_t jobCount)
+: jobCount(jobCount),
+  threadCount(std::min<size_t>(jobCount,
+	std::max<unsigned int>(1, std::thread::hardware_concurrency()))),
+  next(0), running(0), isCancelled(false) {
+}
+
+ParallelJobs::~ParallelJobs() {
+	this->Cancel();
+	this->Join();
+}
+
+bool ParallelJobs::Claim(size_t& job) {
+	if (this->isCancelled) {
+		return false;
+	}
+	job = this->next++;
+	return job < this->jobCount;
+}
+
+void ParallelJobs::Join() {
+	for (size_t i = 0; i < this->threads.size(); ++i) {
+		this->threads[i].join();
+	}
+	this->threads.clear();
+}
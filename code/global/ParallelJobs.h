@@ -0,0 +1,90 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef PARALLELJOBS_H
+#define PARALLELJOBS_H
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "global/ProgressWait.h"
+
+/** ParallelJobs - hands the job numbers 0 to jobCount - 1 out to worker
+ threads, one thread per core but never more threads than jobs.
+
+ Each job number is given to exactly one worker by Claim(), so a worker may
+ use the data of the jobs it claimed without a lock, as long as nothing
+ else touches that data until the workers are joined. That includes
+ wxString: its reference count isn't atomic in every build, so a string in
+ a job must be a deep copy of its own, never one shared with the main
+ thread or with another job. Workers must not log either, as wxLog isn't
+ thread-safe in wx 2.8; they keep their errors in their jobs instead, for
+ the main thread to log once they are joined. */
+class ParallelJobs: public BackgroundTask {
+public:
+	explicit ParallelJobs(size_t jobCount);
+	/** Cancels and joins any workers still running. */
+	virtual ~ParallelJobs();
+
+	size_t GetJobCount() const { return this->jobCount; }
+	size_t GetThreadCount() const { return this->threadCount; }
+
+	/** Starts GetThreadCount() threads, each running worker(arg, thread),
+	 where thread counts up from 0. */
+	template <typename Arg>
+	void Start(void (*worker)(Arg*, size_t), Arg* arg) {
+		for (size_t i = 0; i < this->threadCount; ++i) {
+			++this->running;
+			this->threads.push_back(std::thread(RunWorker<Arg>, this, worker, arg, i));
+		}
+	}
+	/** For the workers: puts the next unclaimed job number in job. Returns
+	 false once every job is claimed or the jobs were cancelled. */
+	bool Claim(size_t& job);
+	bool IsCancelled() const { return this->isCancelled; }
+	/** Waits for all the workers to return. */
+	void Join();
+
+	/** True once every worker has returned. */
+	virtual bool IsDone() const { return this->running == 0; }
+	/** Stops handing out jobs. The workers should also check IsCancelled()
+	 during a long job. */
+	virtual void Cancel() { this->isCancelled = true; }
+
+private:
+	template <typename Arg>
+	static void RunWorker(ParallelJobs* jobs, void (*worker)(Arg*, size_t),
+		Arg* arg, size_t thread) {
+		worker(arg, thread);
+		--jobs->running;
+	}
+
+	const size_t jobCount;
+	const size_t threadCount;
+	std::atomic<size_t> next;
+	std::atomic<size_t> running;
+	std::atomic<bool> isCancelled;
+	std::vector<std::thread> threads;
+
+	ParallelJobs(const ParallelJobs&);
+	ParallelJobs& operator=(const ParallelJobs&);
+};
+
+#endif
@@ -0,0 +1,136 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef PROFILE_KEY_TABLE_H
+#define PROFILE_KEY_TABLE_H
+
+#include <cstddef>
+#include <wx/string.h>
+
+/** \defgroup profilekeytable Typed descriptors for the keys used in profiles
+ The table below is the single definition of every profile key: its path in the
+ profile, the type of its value and its default. It is expanded into the
+ PRO_CFG_* strings (ProfileKeys.cpp), the ProfileKeyId enum and the
+ PROFILE_KEYS descriptor array, which ProMan uses to cache typed values. */
+/** @{*/
+
+/** PROFILE_KEY_TABLE(BOOL_KEY, LONG_KEY, STRING_KEY)
+ Each entry is KIND_KEY(name, path, default), where name is the key's
+ PRO_CFG_ name without the prefix. */
+#define PROFILE_KEY_TABLE(BOOL_KEY, LONG_KEY, STRING_KEY) \
+	STRING_KEY(MAIN_NAME,					"/main/name",				"") \
+	STRING_KEY(MAIN_FILENAME,				"/main/filename",			"") \
+	BOOL_KEY(MAIN_INITIALIZED,				"/main/initialized",		false) \
+	\
+	STRING_KEY(TC_ROOT_FOLDER,				"/tc/folder",				"") \
+	STRING_KEY(TC_CURRENT_BINARY,			"/tc/currentbinary",		"") \
+	STRING_KEY(TC_CURRENT_MODLINE,			"/tc/currentmodline",		"") \
+	STRING_KEY(TC_CURRENT_MOD,				"/tc/currentmod",			"") \
+	STRING_KEY(TC_CURRENT_FLAG_LINE,		"/tc/flags",				"") \
+	STRING_KEY(TC_CURRENT_FRED,				"/tc/currentfred",			"") \
+	\
+	LONG_KEY(VIDEO_RESOLUTION_WIDTH,		"/video/width",				1024) \
+	LONG_KEY(VIDEO_RESOLUTION_HEIGHT,		"/video/height",			768) \
+	LONG_KEY(VIDEO_BIT_DEPTH,				"/video/depth",				32) \
+	LONG_KEY(VIDEO_ANISOTROPIC,				"/video/anisotropic",		0) \
+	LONG_KEY(VIDEO_ANTI_ALIAS,				"/video/antialias",			0) \
+	STRING_KEY(VIDEO_TEXTURE_FILTER,		"/video/texturefilter",		"Trilinear") \
+	\
+	STRING_KEY(LIGHTING_PRESET,				"/lighting/preset",			"") \
+	\
+	LONG_KEY(SPEECH_VOICE,					"/speech/voice",			0) \
+	LONG_KEY(SPEECH_VOLUME,					"/speech/volume",			100) \
+	BOOL_KEY(SPEECH_IN_TECHROOM,			"/speech/intechroom",		false) \
+	BOOL_KEY(SPEECH_IN_BRIEFINGS,			"/speech/inbriefings",		false) \
+	BOOL_KEY(SPEECH_IN_GAME,				"/speech/ingame",			false) \
+	BOOL_KEY(SPEECH_IN_MULTI,				"/speech/inmulti",			false) \
+	\
+	STRING_KEY(NETWORK_TYPE,				"/network/type",			"None") \
+	STRING_KEY(NETWORK_SPEED,				"/network/speed",			"None") \
+	LONG_KEY(NETWORK_PORT,					"/network/port",			0) \
+	STRING_KEY(NETWORK_IP,					"/network/ip",				"") \
+	\
+	STRING_KEY(OPENAL_DEVICE,				"/openal/device",			"no sound") \
+	STRING_KEY(OPENAL_CAPTURE_DEVICE,		"/openal/capturedevice",	"") \
+	BOOL_KEY(OPENAL_EFX,					"/openal/efx",				false) \
+	LONG_KEY(OPENAL_SAMPLE_RATE,			"/openal/samplerate",		0) \
+	\
+	LONG_KEY(JOYSTICK_ID,					"/joystick/id",				99999 /* JOYMAN_INVALID_JOYSTICK */) \
+	BOOL_KEY(JOYSTICK_FORCE_FEEDBACK,		"/joystick/forcefeedback",	false) \
+	BOOL_KEY(JOYSTICK_DIRECTIONAL,			"/joystick/directional",	false) \
+	\
+	STRING_KEY(LAUNCH_CPU_AFFINITY,			"/launch/cpuaffinity",		"") \
+	LONG_KEY(LAUNCH_NICE,					"/launch/nice",				0) \
+	LONG_KEY(LAUNCH_IO_CLASS,				"/launch/ioclass",			0 /* LAUNCH_IO_CLASS_DEFAULT */) \
+	LONG_KEY(LAUNCH_IO_PRIORITY,			"/launch/iopriority",		4) \
+	STRING_KEY(LAUNCH_ENVIRONMENT,			"/launch/environment",		"")
+
+enum ProfileKeyType {
+	PROFILE_KEY_BOOL,
+	PROFILE_KEY_LONG,
+	PROFILE_KEY_STRING
+};
+
+#define PROFILE_KEY_ENUM_ENTRY(name, path, defaultValue) PKEY_##name,
+enum ProfileKeyId {
+	PROFILE_KEY_TABLE(PROFILE_KEY_ENUM_ENTRY, PROFILE_KEY_ENUM_ENTRY, PROFILE_KEY_ENUM_ENTRY)
+	PROFILE_KEY_COUNT
+};
+#undef PROFILE_KEY_ENUM_ENTRY
+
+struct ProfileKeyDescriptor {
+	ProfileKeyId id;
+	const wxChar* path;
+	ProfileKeyType type;
+	long defaultLong; //!< default for bool and long keys
+	const wxChar* defaultString; //!< default for string keys
+};
+
+#define PROFILE_KEY_BOOL_DESCRIPTOR(name, path, defaultValue) \
+	{ PKEY_##name, _T(path), PROFILE_KEY_BOOL, (defaultValue) ? 1 : 0, _T("") },
+#define PROFILE_KEY_LONG_DESCRIPTOR(name, path, defaultValue) \
+	{ PKEY_##name, _T(path), PROFILE_KEY_LONG, defaultValue, _T("") },
+#define PROFILE_KEY_STRING_DESCRIPTOR(name, path, defaultValue) \
+	{ PKEY_##name, _T(path), PROFILE_KEY_STRING, 0, _T(defaultValue) },
+constexpr ProfileKeyDescriptor PROFILE_KEYS[] = {
+	PROFILE_KEY_TABLE(PROFILE_KEY_BOOL_DESCRIPTOR,
+		PROFILE_KEY_LONG_DESCRIPTOR,
+		PROFILE_KEY_STRING_DESCRIPTOR)
+};
+#undef PROFILE_KEY_BOOL_DESCRIPTOR
+#undef PROFILE_KEY_LONG_DESCRIPTOR
+#undef PROFILE_KEY_STRING_DESCRIPTOR
+
+/** Checks that every descriptor sits at the index of its own id. */
+constexpr bool AreProfileKeysInOrder(size_t i = 0) {
+	return (i == PROFILE_KEY_COUNT)
+		|| ((PROFILE_KEYS[i].id == static_cast<ProfileKeyId>(i))
+			&& AreProfileKeysInOrder(i + 1));
+}
+
+static_assert(sizeof(PROFILE_KEYS) / sizeof(PROFILE_KEYS[0]) == PROFILE_KEY_COUNT,
+	"PROFILE_KEYS must have one descriptor per ProfileKeyId");
+static_assert(AreProfileKeysInOrder(),
+	"PROFILE_KEYS must be indexed by ProfileKeyId");
+
+inline constexpr const ProfileKeyDescriptor& GetProfileKeyDescriptor(ProfileKeyId id) {
+	return PROFILE_KEYS[id];
+}
+/** @}*/
+
+#endif
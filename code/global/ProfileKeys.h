@@ -44,14 +44,28 @@ extern const wxString GBL_CFG_PROXY_PORT;				//!< int
 extern const wxString GBL_CFG_NET_FOLDER;				//!< string (folder name)
 extern const wxString GBL_CFG_NET_DOWNLOAD_NEWS;		//!< bool, true means autodownload
 extern const wxString NEWS_LAST_TIME_FORMAT;
-// these two are entries relative to news source folders, not absolute paths
+// these are entries relative to news source folders, not absolute paths
 extern const wxString GBL_CFG_NET_NEWS_LAST_TIME;		//!< string, formated time as NEWS_LAST_TIME_FORMAT
 extern const wxString GBL_CFG_NET_THE_NEWS;				//!< string, the formatted text (workin' for a livin'!)
+extern const wxString GBL_CFG_NET_NEWS_ETAG;			//!< string, ETag header of the last download
+extern const wxString GBL_CFG_NET_NEWS_LAST_MODIFIED;	//!< string, Last-Modified header of the last download
+
+// what OpenAL last reported, see OpenALMan; device lists are newline separated
+extern const wxString GBL_CFG_OPENAL_CACHE_LIBRARY;		//!< string, path and modification time of the library probed
+extern const wxString GBL_CFG_OPENAL_CACHE_VERSION;		//!< string
+extern const wxString GBL_CFG_OPENAL_CACHE_PLAYBACK;	//!< string, playback devices
+extern const wxString GBL_CFG_OPENAL_CACHE_CAPTURE;		//!< string, capture devices
+extern const wxString GBL_CFG_OPENAL_CACHE_DEFAULT_PLAYBACK; //!< string
+extern const wxString GBL_CFG_OPENAL_CACHE_DEFAULT_CAPTURE; //!< string
+extern const wxString GBL_CFG_OPENAL_CACHE_EFX;			//!< string, playback devices that support EFX
 
 extern const wxString GBL_CFG_OPT_CONFIG_FRED;			//!< bool, true means show the user the FRED button and allow user to select FRED executable
+extern const wxString GBL_CFG_OPT_WARMUP_BUDGET;		//!< int, megabytes of the active mods' VP files to read ahead of launch, 0 turns it off
 /** @}*/
 
-/** \defgroup profilekeys Keys used in profiles */
+/** \defgroup profilekeys Keys used in profiles
+ These are defined from PROFILE_KEY_TABLE in ProfileKeyTable.h,
+ which also holds their types and defaults. */
 /** @{*/
 extern const wxString PRO_CFG_MAIN_NAME;				//!< string, name of profile
 extern const wxString PRO_CFG_MAIN_FILENAME;			//!< string, full path to profile
@@ -94,6 +108,12 @@ extern const wxString PRO_CFG_OPENAL_SAMPLE_RATE;		//!< int
 extern const wxString PRO_CFG_JOYSTICK_ID;				//!< int
 extern const wxString PRO_CFG_JOYSTICK_FORCE_FEEDBACK;	//!< bool
 extern const wxString PRO_CFG_JOYSTICK_DIRECTIONAL;		//!< bool
+
+extern const wxString PRO_CFG_LAUNCH_CPU_AFFINITY;		//!< string, CPU list such as "0-3,6", empty for every CPU
+extern const wxString PRO_CFG_LAUNCH_NICE;				//!< int, -20 to 19, 0 leaves it as inherited
+extern const wxString PRO_CFG_LAUNCH_IO_CLASS;			//!< int, a LaunchIOClass
+extern const wxString PRO_CFG_LAUNCH_IO_PRIORITY;		//!< int, 0 (highest) to 7
+extern const wxString PRO_CFG_LAUNCH_ENVIRONMENT;		//!< string, NAME=value lines set for the game
 /** @}*/
 
 #endif
@@ -0,0 +1,55 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <algorithm>
+
+#include <wx/wx.h>
+#include <wx/progdlg.h>
+
+#include "global/ProgressWait.h"
+
+#include "global/MemoryDebugging.h"
+
+/** Milliseconds between progress dialog updates. */
+const int PROGRESS_WAIT_INTERVAL = 100;
+const int PROGRESS_WAIT_RANGE = 1000;
+
+bool WaitWithProgress(BackgroundTask& task, const WorkProgress& progress,
+	uint64_t totalBytes, size_t itemCount, wxWindow* parent, const wxString& title,
+	const wxString& message, const wxString& statusFormat) {
+	bool isCancelled = false;
+	wxProgressDialog dialog(title, message, PROGRESS_WAIT_RANGE, parent,
+		wxPD_APP_MODAL | wxPD_AUTO_HIDE | wxPD_CAN_ABORT
+		| wxPD_ELAPSED_TIME | wxPD_REMAINING_TIME);
+	while (!task.IsDone()) {
+		const uint64_t done = progress.bytesDone;
+		// held short of the end, which would hide the dialog while still waiting
+		const int value = (totalBytes == 0) ? 0 : static_cast<int>(
+			std::min<uint64_t>(done * PROGRESS_WAIT_RANGE / totalBytes,
+				PROGRESS_WAIT_RANGE - 1));
+		if (!isCancelled && !dialog.Update(value,
+				wxString::Format(statusFormat,
+					static_cast<unsigned long>(progress.itemsDone.load()),
+					static_cast<unsigned long>(itemCount)))) {
+			task.Cancel();
+			isCancelled = true;
+		}
+		wxMilliSleep(PROGRESS_WAIT_INTERVAL);
+	}
+	return !isCancelled;
+}
@@ -0,0 +1,59 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef PROGRESSWAIT_H
+#define PROGRESSWAIT_H
+
+#include <atomic>
+#include <cstddef>
+#include <stdint.h>
+
+#include <wx/string.h>
+
+class wxWindow;
+
+/** BackgroundTask - work running on other threads that WaitWithProgress()
+ waits for and can cancel. */
+class BackgroundTask {
+public:
+	virtual ~BackgroundTask() { }
+	/** True once the work has stopped, whether it finished or was cancelled. */
+	virtual bool IsDone() const = 0;
+	/** Asks the work to stop early. Stopping may take a moment, so the work
+	 is still waited for until IsDone(). */
+	virtual void Cancel() = 0;
+};
+
+/** Counters that the workers of a BackgroundTask add to as they go. */
+struct WorkProgress {
+	WorkProgress(): itemsDone(0), bytesDone(0) { }
+
+	std::atomic<size_t> itemsDone;
+	std::atomic<uint64_t> bytesDone;
+};
+
+/** Shows an app-modal progress dialog over parent until task is done,
+ with a bar of progress.bytesDone out of totalBytes under message, and the
+ status statusFormat, which is given the items done and itemCount as two
+ %lu. If the user presses Cancel, the task is cancelled and waited for.
+ Returns false if the user cancelled. */
+bool WaitWithProgress(BackgroundTask& task, const WorkProgress& progress,
+	uint64_t totalBytes, size_t itemCount, wxWindow* parent, const wxString& title,
+	const wxString& message, const wxString& statusFormat);
+
+#endif
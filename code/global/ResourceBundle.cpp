@@ -0,0 +1,190 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+ 
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include <wx/wx.h>
+#include <wx/filename.h>
+#include <wx/mstream.h>
+
+#include "generated/configure_launcher.h"
+#include "global/ResourceBundle.h"
+
+#include "global/MemoryDebugging.h"
+
+namespace {
+	const unsigned char BUNDLE_MAGIC[] = { 'W', 'X', 'L', 'R', 'E', 'S', 0, 1 };
+
+	/** Reads little endian integers from the bundle's header, failing
+	 instead of reading past its end. */
+	class HeaderReader {
+	public:
+		HeaderReader(const unsigned char* data, size_t size)
+		: data(data), size(size), position(0) { }
+
+		bool Skip(size_t count) {
+			if (this->size - this->position < count) {
+				return false;
+			}
+			this->position += count;
+			return true;
+		}
+		bool ReadUInt16(size_t& value) {
+			if (this->size - this->position < 2) {
+				return false;
+			}
+			const unsigned char* p = this->data + this->position;
+			value = p[0] | (p[1] << 8);
+			this->position += 2;
+			return true;
+		}
+		bool ReadUInt32(size_t& value) {
+			if (this->size - this->position < 4) {
+				return false;
+			}
+			const unsigned char* p = this->data + this->position;
+			value = static_cast<size_t>(p[0]) | (static_cast<size_t>(p[1]) << 8)
+				| (static_cast<size_t>(p[2]) << 16) | (static_cast<size_t>(p[3]) << 24);
+			this->position += 4;
+			return true;
+		}
+		const unsigned char* GetCurrent() const { return this->data + this->position; }
+
+	private:
+		const unsigned char* data;
+		size_t size;
+		size_t position;
+	};
+}
+
+ResourceBundle& ResourceBundle::Get() {
+	static ResourceBundle bundle;
+	return bundle;
+}
+
+ResourceBundle::ResourceBundle() {
+#ifdef RESOURCE_BUNDLE_LOCATION
+	if (wxFileName::FileExists(_T(RESOURCE_BUNDLE_LOCATION))) {
+		this->Open(_T(RESOURCE_BUNDLE_LOCATION));
+	} else {
+		wxLogDebug(_T("No resource bundle at %s, loading resources from their own files"),
+			_T(RESOURCE_BUNDLE_LOCATION));
+	}
+#endif
+}
+
+void ResourceBundle::Open(const wxString& path) {
+	if (!this->file.Open(path)) {
+		return;
+	}
+
+	HeaderReader reader(this->file.GetData(), this->file.GetSize());
+	size_t count;
+	if (this->file.GetSize() < sizeof(BUNDLE_MAGIC)
+		|| memcmp(this->file.GetData(), BUNDLE_MAGIC, sizeof(BUNDLE_MAGIC)) != 0
+		|| !reader.Skip(sizeof(BUNDLE_MAGIC)) || !reader.ReadUInt32(count)) {
+		wxLogWarning(_T("%s is not a resource bundle I understand"), path.c_str());
+		this->file.Close();
+		return;
+	}
+
+	std::vector<Entry> bundleEntries;
+	for (size_t i = 0; i < count; ++i) {
+		Entry entry;
+		size_t nameLength;
+		if (!reader.ReadUInt16(nameLength)) {
+			break;
+		}
+		const char* name = reinterpret_cast<const char*>(reader.GetCurrent());
+		if (!reader.Skip(nameLength)
+			|| !reader.ReadUInt32(entry.offset) || !reader.ReadUInt32(entry.size)) {
+			break;
+		}
+		entry.name.assign(name, nameLength);
+		if (entry.offset > this->file.GetSize()
+			|| entry.size > this->file.GetSize() - entry.offset) {
+			break;
+		}
+		bundleEntries.push_back(entry);
+	}
+	if (bundleEntries.size() != count) {
+		wxLogWarning(_T("Resource bundle %s is damaged"), path.c_str());
+		this->file.Close();
+		return;
+	}
+
+	this->entries.swap(bundleEntries);
+	wxLogDebug(_T("Mapped resource bundle %s with %lu resources"),
+		path.c_str(), static_cast<unsigned long>(this->entries.size()));
+}
+
+bool ResourceBundle::EntryNameLess(const Entry& entry, const std::string& name) {
+	return entry.name < name;
+}
+
+bool ResourceBundle::Find(const wxString& name,
+	const unsigned char*& data, size_t& size) const {
+	const std::string utf8Name(name.mb_str(wxConvUTF8));
+	std::vector<Entry>::const_iterator entry = std::lower_bound(
+		this->entries.begin(), this->entries.end(), utf8Name, EntryNameLess);
+	if (entry == this->entries.end() || entry->name != utf8Name) {
+		return false;
+	}
+	data = this->file.GetData() + entry->offset;
+	size = entry->size;
+	return true;
+}
+
+/** Decodes name from the bundle's mapping without copying it first. */
+bool ResourceBundle::LoadImage(const wxString& name, wxBitmapType type,
+	wxImage& image) const {
+	const unsigned char* data;
+	size_t size;
+	if (!this->Find(name, data, size)) {
+		return false;
+	}
+	wxMemoryInputStream stream(data, size);
+	if (!image.LoadFile(stream, type)) {
+		wxLogWarning(_T("Unable to decode %s from the resource bundle"), name.c_str());
+		return false;
+	}
+	return true;
+}
+
+wxBitmap ResourceBundle::LoadBitmap(const wxString& name) {
+	wxImage image;
+	if (this->LoadImage(name, wxBITMAP_TYPE_ANY, image)) {
+		return wxBitmap(image);
+	}
+	return wxBitmap(GetResourcePath(name), wxBITMAP_TYPE_ANY);
+}
+
+wxIcon ResourceBundle::LoadIcon(const wxString& name) {
+	wxImage image;
+	if (this->LoadImage(name, wxBITMAP_TYPE_ICO, image)) {
+		wxIcon icon;
+		icon.CopyFromBitmap(wxBitmap(image));
+		return icon;
+	}
+	return wxIcon(GetResourcePath(name), wxBITMAP_TYPE_ICO);
+}
+
+wxString ResourceBundle::GetResourcePath(const wxString& name) {
+	return wxFileName(_T(RESOURCES_PATH), name).GetFullPath();
+}
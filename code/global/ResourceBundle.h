@@ -0,0 +1,67 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+ 
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef RESOURCEBUNDLE_H
+#define RESOURCEBUNDLE_H
+
+#include <string>
+#include <vector>
+
+#include <wx/wx.h>
+
+#include "global/MappedFile.h"
+
+/** ResourceBundle - the default skin and splash images, packed into one file
+ by scripts/resourcebundler.py. The bundle is mapped into memory the first
+ time it is used and images are decoded straight from the mapping. An image
+ that is not in the bundle, or any image if there is no bundle, is loaded
+ from its own file in RESOURCES_PATH instead. */
+class ResourceBundle {
+public:
+	static ResourceBundle& Get();
+
+	/** Returns an invalid bitmap if name can't be loaded. */
+	wxBitmap LoadBitmap(const wxString& name);
+	/** Loads an .ico file. Returns an invalid icon if name can't be loaded. */
+	wxIcon LoadIcon(const wxString& name);
+
+	/** The path of name's own file, for messages about it. */
+	static wxString GetResourcePath(const wxString& name);
+
+private:
+	ResourceBundle();
+	void Open(const wxString& path);
+	/** Sets data and size to name's bytes in the mapping. */
+	bool Find(const wxString& name, const unsigned char*& data, size_t& size) const;
+	bool LoadImage(const wxString& name, wxBitmapType type, wxImage& image) const;
+
+	struct Entry {
+		std::string name; //!< UTF-8, as the entries are sorted
+		size_t offset;
+		size_t size;
+	};
+	static bool EntryNameLess(const Entry& entry, const std::string& name);
+
+	MappedFile file;
+	std::vector<Entry> entries; //!< sorted by name
+
+	ResourceBundle(const ResourceBundle&);
+	ResourceBundle& operator=(const ResourceBundle&);
+};
+
+#endif
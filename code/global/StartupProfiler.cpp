@@ -0,0 +1,228 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+ 
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <wx/wx.h>
+#include <wx/ffile.h>
+#include <wx/stopwatch.h>
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include "global/StartupProfiler.h"
+
+#include "global/MemoryDebugging.h"
+
+namespace {
+	/** Thread ids used in the trace, so that asynchronous phases, which may
+	 overlap the scoped ones, get a row of their own in the viewer. */
+	const int TRACE_TID_SCOPED = 1;
+	const int TRACE_TID_ASYNC = 2;
+
+	struct StartupPhase {
+		StartupPhase(const wxString& name, const wxLongLong& start,
+			const wxLongLong& duration, int depth, int tid)
+			: name(name), start(start), duration(duration), depth(depth), tid(tid) { }
+		wxString name;
+		wxLongLong start; //!< microseconds
+		wxLongLong duration; //!< microseconds
+		int depth; //!< nesting level of scoped phases
+		int tid;
+	};
+
+	std::vector<StartupPhase> phases;
+	std::map<wxString, wxLongLong> openAsyncPhases;
+	int scopeDepth = 0;
+	bool isEnabled = false;
+	bool isFinished = false;
+	wxString traceFileName;
+
+	wxStopWatch& GetClock() {
+		static wxStopWatch clock;
+		return clock;
+	}
+
+	wxString EscapeJSON(const wxString& str) {
+		wxString escaped;
+		for (size_t i = 0; i < str.length(); ++i) {
+			const wxChar c = str[i];
+			if (c == wxT('"') || c == wxT('\\')) {
+				escaped += wxT('\\');
+				escaped += c;
+			} else if (c < 0x20) {
+				escaped += wxString::Format(wxT("\\u%04x"), static_cast<int>(c));
+			} else {
+				escaped += c;
+			}
+		}
+		return escaped;
+	}
+
+	/** Orders phases by start time, parents before their children. */
+	bool IsEarlierPhase(const StartupPhase& a, const StartupPhase& b) {
+		if (a.start != b.start) {
+			return a.start < b.start;
+		}
+		return a.depth < b.depth;
+	}
+
+	wxString FormatMillis(const wxLongLong& micros) {
+		return wxString::Format(wxT("%.1f"), micros.ToDouble() / 1000.0);
+	}
+
+	void WriteTrace() {
+		wxFFile out(traceFileName, wxT("wb"));
+		if (!out.IsOpened()) {
+			wxLogWarning(_T("Unable to open startup trace file %s"),
+				traceFileName.c_str());
+			return;
+		}
+
+		wxString json(wxT("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"));
+		for (std::vector<StartupPhase>::const_iterator it = phases.begin(),
+			 end = phases.end(); it != end; ++it) {
+			if (it != phases.begin()) {
+				json += wxT(",\n");
+			}
+			json += wxString::Format(
+				wxT("{\"name\":\"%s\",\"cat\":\"startup\",\"ph\":\"X\",")
+				wxT("\"ts\":%s,\"dur\":%s,\"pid\":1,\"tid\":%d}"),
+				EscapeJSON(it->name).c_str(),
+				it->start.ToString().c_str(),
+				it->duration.ToString().c_str(),
+				it->tid);
+		}
+		json += wxT("\n]}\n");
+
+		if (!out.Write(json, wxConvUTF8)) {
+			wxLogWarning(_T("Unable to write startup trace file %s"),
+				traceFileName.c_str());
+			return;
+		}
+		wxLogInfo(_T("Startup trace written to %s"), traceFileName.c_str());
+	}
+
+	void LogSummary() {
+		wxLogInfo(_T("Startup phases (%s ms until startup finished):"),
+			FormatMillis(StartupProfiler::Now()).c_str());
+		for (std::vector<StartupPhase>::const_iterator it = phases.begin(),
+			 end = phases.end(); it != end; ++it) {
+			wxLogInfo(_T(" %s%s%s: %s ms (at %s ms)"),
+				wxString(wxT(' '), 2 * it->depth).c_str(),
+				(it->tid == TRACE_TID_ASYNC) ? _T("[async] ") : _T(""),
+				it->name.c_str(),
+				FormatMillis(it->duration).c_str(),
+				FormatMillis(it->start).c_str());
+		}
+	}
+}
+
+void StartupProfiler::Enable(const wxString& traceFile) {
+	isEnabled = true;
+	traceFileName = traceFile;
+}
+
+bool StartupProfiler::IsEnabled() {
+	return isEnabled;
+}
+
+bool StartupProfiler::IsRecording() {
+	return !isFinished;
+}
+
+wxLongLong StartupProfiler::Now() {
+#if wxCHECK_VERSION(2, 9, 3)
+	return GetClock().TimeInMicro();
+#else
+	return wxLongLong(GetClock().Time()) * 1000;
+#endif
+}
+
+int StartupProfiler::EnterScope() {
+	return scopeDepth++;
+}
+
+void StartupProfiler::LeaveScope(const wxString& name,
+		const wxLongLong& start, int depth) {
+	scopeDepth = depth;
+	if (!IsRecording()) {
+		return;
+	}
+	phases.push_back(StartupPhase(name, start, Now() - start, depth, TRACE_TID_SCOPED));
+}
+
+void StartupProfiler::BeginAsync(const wxString& name) {
+	if (!IsRecording()) {
+		return;
+	}
+	openAsyncPhases[name] = Now();
+}
+
+void StartupProfiler::EndAsync(const wxString& name) {
+	if (!IsRecording()) {
+		return;
+	}
+	std::map<wxString, wxLongLong>::iterator it = openAsyncPhases.find(name);
+	if (it == openAsyncPhases.end()) {
+		return; // began after recording started, or already ended
+	}
+	phases.push_back(StartupPhase(name, it->second, Now() - it->second, 0, TRACE_TID_ASYNC));
+	openAsyncPhases.erase(it);
+}
+
+void StartupProfiler::Finish() {
+	if (isFinished) {
+		return;
+	}
+	isFinished = true;
+
+	if (isEnabled) {
+		std::stable_sort(phases.begin(), phases.end(), IsEarlierPhase);
+		LogSummary();
+		WriteTrace();
+	}
+
+	phases.clear();
+	openAsyncPhases.clear();
+}
+
+StartupProbe::StartupProbe(const wxString& name)
+: name(name), start(StartupProfiler::Now()), depth(StartupProfiler::EnterScope()) {
+}
+
+StartupProbe::~StartupProbe() {
+	StartupProfiler::LeaveScope(this->name, this->start, this->depth);
+}
+
+StartupPhases::StartupPhases()
+: current(NULL) {
+}
+
+StartupPhases::~StartupPhases() {
+	this->End();
+}
+
+void StartupPhases::Next(const wxString& name) {
+	this->End();
+	this->current = new StartupProbe(name);
+}
+
+void StartupPhases::End() {
+	delete this->current;
+	this->current = NULL;
+}
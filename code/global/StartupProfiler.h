@@ -0,0 +1,80 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+ 
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef STARTUPPROFILER_H
+#define STARTUPPROFILER_H
+
+#include <wx/wx.h>
+#include <wx/longlong.h>
+
+/** StartupProfiler - records how long each phase of launcher startup takes.
+ Phases are always recorded (there are only a few dozen of them) until
+ Finish() is called; Finish() only writes anything out if the profiler was
+ enabled with the --profile-startup switch. */
+class StartupProfiler {
+public:
+	/** Turns on output. The trace is written to traceFile in the Chrome
+	 trace event format (load it in chrome://tracing) and a summary goes
+	 to the log. */
+	static void Enable(const wxString& traceFile);
+	static bool IsEnabled();
+	/** Returns true until Finish() has been called. */
+	static bool IsRecording();
+
+	/** Marks the start and end of a phase that spans several event handlers,
+	 such as waiting for the FSO binary to write its flag file. */
+	static void BeginAsync(const wxString& name);
+	static void EndAsync(const wxString& name);
+
+	/** Stops recording, then writes the trace and the summary if enabled.
+	 Calls after the first one do nothing. */
+	static void Finish();
+
+	/** Microseconds since the profiler's clock started. */
+	static wxLongLong Now();
+
+	// used by StartupProbe and StartupPhases
+	static int EnterScope();
+	static void LeaveScope(const wxString& name, const wxLongLong& start, int depth);
+};
+
+/** Records the time from its construction to its destruction as a phase. */
+class StartupProbe {
+public:
+	StartupProbe(const wxString& name);
+	~StartupProbe();
+private:
+	wxString name;
+	wxLongLong start;
+	int depth;
+};
+
+/** Records a sequence of back-to-back phases, such as the steps of
+ wxLauncher::OnInit(). Each Next() ends the current phase and starts the
+ next one; the last one ends with End() or on destruction. */
+class StartupPhases {
+public:
+	StartupPhases();
+	~StartupPhases();
+	void Next(const wxString& name);
+	void End();
+private:
+	StartupProbe* current;
+};
+
+#endif
@@ -0,0 +1,159 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <cstring>
+
+#include "global/XXHash64.h"
+
+#include "global/MemoryDebugging.h"
+
+static const uint64_t PRIME64_1 = 0x9E3779B185EBCA87ULL;
+static const uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+static const uint64_t PRIME64_3 = 0x165667B19E3779F9ULL;
+static const uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+static const uint64_t PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+static inline uint64_t RotateLeft(uint64_t value, int bits) {
+	return (value << bits) | (value >> (64 - bits));
+}
+
+static inline uint64_t Read64(const unsigned char* bytes) {
+	uint64_t value = 0;
+	for (int i = 7; i >= 0; --i) {
+		value = (value << 8) | bytes[i];
+	}
+	return value;
+}
+
+static inline uint32_t Read32(const unsigned char* bytes) {
+	return static_cast<uint32_t>(bytes[0])
+		| (static_cast<uint32_t>(bytes[1]) << 8)
+		| (static_cast<uint32_t>(bytes[2]) << 16)
+		| (static_cast<uint32_t>(bytes[3]) << 24);
+}
+
+static inline uint64_t Round(uint64_t accumulator, uint64_t input) {
+	accumulator += input * PRIME64_2;
+	return RotateLeft(accumulator, 31) * PRIME64_1;
+}
+
+static inline uint64_t MergeRound(uint64_t hash, uint64_t accumulator) {
+	hash ^= Round(0, accumulator);
+	return hash * PRIME64_1 + PRIME64_4;
+}
+
+/** Processes whole 32 byte stripes, returning the number of bytes used. */
+static size_t ProcessStripes(uint64_t* accumulators, const unsigned char* data,
+	size_t length) {
+	const unsigned char* const start = data;
+	const unsigned char* const end = data + (length & ~static_cast<size_t>(31));
+	uint64_t a0 = accumulators[0], a1 = accumulators[1];
+	uint64_t a2 = accumulators[2], a3 = accumulators[3];
+	for (; data < end; data += 32) {
+		a0 = Round(a0, Read64(data));
+		a1 = Round(a1, Read64(data + 8));
+		a2 = Round(a2, Read64(data + 16));
+		a3 = Round(a3, Read64(data + 24));
+	}
+	accumulators[0] = a0;
+	accumulators[1] = a1;
+	accumulators[2] = a2;
+	accumulators[3] = a3;
+	return data - start;
+}
+
+XXHash64::XXHash64(uint64_t seed)
+: seed(seed), bufferSize(0), totalLength(0) {
+	this->accumulators[0] = seed + PRIME64_1 + PRIME64_2;
+	this->accumulators[1] = seed + PRIME64_2;
+	this->accumulators[2] = seed;
+	this->accumulators[3] = seed - PRIME64_1;
+}
+
+void XXHash64::Update(const void* data, size_t length) {
+	const unsigned char* bytes = static_cast<const unsigned char*>(data);
+	this->totalLength += length;
+
+	if (this->bufferSize > 0) {
+		const size_t needed = sizeof(this->buffer) - this->bufferSize;
+		if (length < needed) {
+			memcpy(this->buffer + this->bufferSize, bytes, length);
+			this->bufferSize += length;
+			return;
+		}
+		memcpy(this->buffer + this->bufferSize, bytes, needed);
+		ProcessStripes(this->accumulators, this->buffer, sizeof(this->buffer));
+		this->bufferSize = 0;
+		bytes += needed;
+		length -= needed;
+	}
+
+	const size_t used = ProcessStripes(this->accumulators, bytes, length);
+	bytes += used;
+	length -= used;
+	if (length > 0) {
+		memcpy(this->buffer, bytes, length);
+		this->bufferSize = length;
+	}
+}
+
+uint64_t XXHash64::Digest() const {
+	uint64_t hash;
+	if (this->totalLength >= 32) {
+		const uint64_t* a = this->accumulators;
+		hash = RotateLeft(a[0], 1) + RotateLeft(a[1], 7)
+			+ RotateLeft(a[2], 12) + RotateLeft(a[3], 18);
+		hash = MergeRound(hash, a[0]);
+		hash = MergeRound(hash, a[1]);
+		hash = MergeRound(hash, a[2]);
+		hash = MergeRound(hash, a[3]);
+	} else {
+		hash = this->seed + PRIME64_5;
+	}
+	hash += this->totalLength;
+
+	const unsigned char* bytes = this->buffer;
+	size_t remaining = this->bufferSize;
+	for (; remaining >= 8; bytes += 8, remaining -= 8) {
+		hash ^= Round(0, Read64(bytes));
+		hash = RotateLeft(hash, 27) * PRIME64_1 + PRIME64_4;
+	}
+	if (remaining >= 4) {
+		hash ^= static_cast<uint64_t>(Read32(bytes)) * PRIME64_1;
+		hash = RotateLeft(hash, 23) * PRIME64_2 + PRIME64_3;
+		bytes += 4;
+		remaining -= 4;
+	}
+	for (; remaining > 0; ++bytes, --remaining) {
+		hash ^= *bytes * PRIME64_5;
+		hash = RotateLeft(hash, 11) * PRIME64_1;
+	}
+
+	hash ^= hash >> 33;
+	hash *= PRIME64_2;
+	hash ^= hash >> 29;
+	hash *= PRIME64_3;
+	hash ^= hash >> 32;
+	return hash;
+}
+
+uint64_t XXHash64::Hash(const void* data, size_t length, uint64_t seed) {
+	XXHash64 hasher(seed);
+	hasher.Update(data, length);
+	return hasher.Digest();
+}
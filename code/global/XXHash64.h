@@ -0,0 +1,48 @@
+/*
+ Copyright (C) 2026 wxLauncher Team
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef XXHASH64_H
+#define XXHASH64_H
+
+#include <cstddef>
+#include <stdint.h>
+
+/** XXHash64 - the 64 bit xxHash, a non-cryptographic hash that runs at
+ several gigabytes a second, fast enough that hashing a file costs little
+ more than reading it. The results match the reference implementation, so
+ checksums made with the xxhsum tool can be compared against. Data can be
+ passed to Update() in as many pieces as convenient. */
+class XXHash64 {
+public:
+	explicit XXHash64(uint64_t seed = 0);
+
+	void Update(const void* data, size_t length);
+	/** The hash of everything passed to Update() so far. */
+	uint64_t Digest() const;
+
+	static uint64_t Hash(const void* data, size_t length, uint64_t seed = 0);
+
+private:
+	uint64_t seed;
+	uint64_t accumulators[4];
+	unsigned char buffer[32]; //!< the start of a stripe not yet processed
+	size_t bufferSize;
+	uint64_t totalLength;
+};
+
+#endif
@@ -44,6 +44,7 @@ enum WindowIDS {
 	ID_FRED2_PROCESS,
 	
 	ID_F3_PRESSED,
+	ID_F4_PRESSED,
 
 	ID_PROFILE_COMBO,
 	ID_NEW_PROFILE,
@@ -101,6 +102,11 @@ enum WindowIDS {
 	ID_JOY_CALIBRATE_BUTTON,
 	ID_JOY_DETECT_BUTTON,
 
+	ID_LAUNCH_CPU_AFFINITY,
+	ID_LAUNCH_NICE,
+	ID_LAUNCH_IO_CLASS,
+	ID_LAUNCH_IO_PRIORITY,
+
 	ID_PROXY_TYPE,
 	ID_PROXY_HTTP_SERVER,
 	ID_PROXY_HTTP_PORT,
@@ -113,6 +119,11 @@ enum WindowIDS {
 	ID_MODLISTBOX_ACTIVATE_BUTTON,
 	ID_MODLISTBOX_INFO_BUTTON,
 
+	ID_DISK_USAGE_MODS,
+	ID_DISK_USAGE_TYPES,
+	ID_DISK_USAGE_RESCAN_BUTTON,
+	ID_DISK_USAGE_TIMER,
+
 	ID_STATUSBAR_STATUS_ICON,
 	ID_STATUSBAR_PROGRESS_BAR,
 
@@ -136,10 +147,20 @@ enum WindowIDS {
 	ID_CUSTOM_FLAGS_TEXT,
 	ID_COMMAND_LINE_TEXT,
 	ID_FLAG_SET_NOTES_TEXT,
+	ID_LAUNCH_ENVIRONMENT_BUTTON,
+
+	ID_ENVIRONMENT_TEXT,
+	ID_ENVIRONMENT_TEMPLATE_CHOICE,
+	ID_ENVIRONMENT_ADD_TEMPLATE_BUTTON,
+	ID_ENVIRONMENT_COMPARE_CHOICE,
 
 	ID_NET_DOWNLOAD_NEWS,
 	ID_EVENT_NET_DOWNLOAD_NEWS,
 	ID_MORE_INFO_PRIVACY,
+
+	ID_INSTALL_PACKAGE_TEXT,
+	ID_INSTALL_BROWSE_BUTTON,
+	ID_INSTALL_BUTTON,
 };
 
 enum MainTabImageIDs {
@@ -26,6 +26,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "apis/TCManager.h"
 #include "apis/ProfileManager.h"
 #include "apis/SkinManager.h"
+#include "controls/EnvironmentDialog.h"
 #include "controls/LightingPresets.h"
 #include "global/ids.h"
 #include "global/ProfileKeys.h"
@@ -50,6 +51,10 @@ AdvSettingsPage::AdvSettingsPage(wxWindow* parent): wxPanel(parent, wxID_ANY), f
 	
 	wxLogDebug(_T("AdvSettingsPage is at %p."), this);
 
+	// the page may be built long after the last reset
+	wxCommandEvent nullEvent;
+	this->OnExeChanged(nullEvent);
+
 	CmdLineManager::RegisterCmdLineChanged(this);
 	CmdLineManager::RegisterCustomFlagsChanged(this);
 	FlagListManager::GetFlagListManager()->RegisterFlagFileProcessingStatusChanged(this);
@@ -68,6 +73,7 @@ EVT_COMMAND(wxID_NONE, EVT_CUSTOM_FLAGS_CHANGED, AdvSettingsPage::OnNeedUpdateCu
 EVT_COMMAND(wxID_NONE, EVT_FLAG_LIST_BOX_READY, AdvSettingsPage::OnFlagListBoxReady)
 EVT_TEXT(ID_CUSTOM_FLAGS_TEXT, AdvSettingsPage::OnCustomFlagsBoxChanged)
 EVT_CHOICE(ID_SELECT_FLAG_SET, AdvSettingsPage::OnSelectFlagSet)
+EVT_BUTTON(ID_LAUNCH_ENVIRONMENT_BUTTON, AdvSettingsPage::OnEditEnvironment)
 END_EVENT_TABLE()
 
 // FIXME HACK for now, hard-code flag list box height (sigh)
@@ -92,7 +98,6 @@ void AdvSettingsPage::OnExeChanged(wxCommandEvent& event) {
 	// top left components
 	this->flagListBox = new FlagListBox(this);
 	this->flagListBox->RegisterFlagListBoxReady(this);
-	FlagListManager::GetFlagListManager()->BeginFlagFileProcessing();
 
 #if 0 // doesn't do anything
 	wxHtmlWindow* description = new wxHtmlWindow(this);
@@ -169,11 +174,19 @@ void AdvSettingsPage::OnExeChanged(wxCommandEvent& event) {
 	wxTextCtrl* commandLineText = new wxTextCtrl(this, ID_COMMAND_LINE_TEXT,
 		wxEmptyString, wxDefaultPosition, wxDefaultSize,
 		wxTE_MULTILINE|wxTE_READONLY);
+	wxButton* environmentButton = new wxButton(this, ID_LAUNCH_ENVIRONMENT_BUTTON,
+		_("Environment..."));
+	environmentButton->SetToolTip(_("Environment variables that this profile launches the game with"));
+
+	wxBoxSizer* commandLineLabelSizer = new wxBoxSizer(wxHORIZONTAL);
+	commandLineLabelSizer->Add(commandLineTextLabel, wxSizerFlags().Center());
+	commandLineLabelSizer->AddStretchSpacer(1);
+	commandLineLabelSizer->Add(environmentButton, wxSizerFlags().Center());
 
 	wxBoxSizer* bottomSizer = new wxBoxSizer(wxVERTICAL);
 	bottomSizer->Add(customFlagsTextLabel, wxSizerFlags().Left().Border(wxTOP|wxBOTTOM, 5));
 	bottomSizer->Add(customFlagsText, wxSizerFlags().Expand().Border(wxBOTTOM, 10));
-	bottomSizer->Add(commandLineTextLabel, wxSizerFlags().Left().Border(wxBOTTOM, 5));
+	bottomSizer->Add(commandLineLabelSizer, wxSizerFlags().Expand().Border(wxBOTTOM, 5));
 	bottomSizer->Add(commandLineText, wxSizerFlags().Proportion(1).Expand());
 
 	// final layout
@@ -187,10 +200,6 @@ void AdvSettingsPage::OnExeChanged(wxCommandEvent& event) {
 
 	this->SetSizer(sizer);
 	this->Layout();
-
-	if (!ProfileProxy::GetProxy()->IsProfileInitialized()) {
-		ProfileProxy::GetProxy()->FinishProfileInitialization();
-	}
 }
 
 void AdvSettingsPage::OnFlagFileProcessingStatusChanged(wxCommandEvent &event) {
@@ -207,6 +216,11 @@ void AdvSettingsPage::OnFlagFileProcessingStatusChanged(wxCommandEvent &event) {
 	this->UpdateComponents();
 	
 	if (status == FlagListManager::FLAG_FILE_PROCESSING_OK) {
+		if (this->flagListBox->IsReady()) {
+			// the page was built just as processing finished, and was sent
+			// the status both on registering and by the processing itself
+			return;
+		}
 		FlagFileData* flagData = FlagListManager::GetFlagListManager()->GetFlagFileData();
 		wxCHECK_RET(flagData != NULL,
 			_T("Flag file processing succeeded but could not retrieve extracted data."));
@@ -246,11 +260,19 @@ void AdvSettingsPage::OnProxyFlagDataReady(wxCommandEvent& event) {
 	wxASSERT((this->flagListBox != NULL) &&
 		ProfileProxy::GetProxy()->IsFlagDataReady());
 	
-	if (this->flagListBox->IsReady() && !this->flagListBox->FlagsLoaded()) {
-		this->flagListBox->LoadEnabledFlags();
-		CmdLineManager::GenerateCustomFlagsChanged();
-		CmdLineManager::GenerateCmdLineChanged();
-	}	
+	if (!this->flagListBox->IsReady()) {
+		return;
+	}
+	
+	if (this->flagListBox->FlagsLoaded()) {
+		// the proxy re-read the flag line of a new profile that uses the
+		// same binary, so there was no reset to rebuild the page
+		this->flagListBox->UnloadEnabledFlags();
+	}
+	
+	this->flagListBox->LoadEnabledFlags();
+	CmdLineManager::GenerateCustomFlagsChanged();
+	CmdLineManager::GenerateCmdLineChanged();
 }
 
 void AdvSettingsPage::UpdateComponents() {
@@ -367,15 +389,15 @@ void AdvSettingsPage::OnNeedUpdateCommandLine(wxCommandEvent &WXUNUSED(event)) {
 	wxString tcPath, exeName, modline;
 	wxCHECK_RET(
 		ProMan::GetProfileManager()->ProfileRead(
-			PRO_CFG_TC_ROOT_FOLDER, &tcPath),
+			PKEY_TC_ROOT_FOLDER, &tcPath),
 		_T("Could not find profile entry for root folder."));
 	wxCHECK_RET(
 		ProMan::GetProfileManager()->ProfileRead(
-			PRO_CFG_TC_CURRENT_BINARY, &exeName),
+			PKEY_TC_CURRENT_BINARY, &exeName),
 		_T("Could not find profile entry for FSO binary."));
 	wxCHECK_RET(
 		ProMan::GetProfileManager()->ProfileRead(
-			PRO_CFG_TC_CURRENT_MODLINE, &modline),
+			PKEY_TC_CURRENT_MODLINE, &modline),
 		_T("Could not find profile entry for mod line."));
 	
 	wxString flagFileFlags(ProfileProxy::GetProxy()->GetEnabledFlagsString());
@@ -466,3 +488,8 @@ void AdvSettingsPage::OnSelectFlagSet(wxCommandEvent &WXUNUSED(event)) {
 	}
 }
 	
+
+void AdvSettingsPage::OnEditEnvironment(wxCommandEvent& WXUNUSED(event)) {
+	EnvironmentDialog dialog(this);
+	dialog.ShowModal();
+}
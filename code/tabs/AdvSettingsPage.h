@@ -47,6 +47,7 @@ public:
 	void OnCustomFlagsBoxChanged(wxCommandEvent& event);
 	void OnFlagListBoxReady(wxCommandEvent& event);
 	void OnProxyFlagDataReady(wxCommandEvent& event);
+	void OnEditEnvironment(wxCommandEvent& event);
 
 	DECLARE_EVENT_TABLE()
 };
@@ -41,11 +41,14 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "apis/SpeechManager.h"
 #include "apis/OpenALManager.h"
 #include "apis/JoystickManager.h"
+#include "apis/LaunchPipeline.h"
 #include "apis/resolution_manager.hpp"
 #include "apis/HelpManager.h"
+#include "apis/ProcessPriority.h"
 #include "controls/ModList.h"
 #include "datastructures/FSOExecutable.h"
 #include "datastructures/ResolutionMap.h"
+#include "global/StartupProfiler.h"
 
 #include "global/MemoryDebugging.h" // Last include for memory debugging
 
@@ -54,6 +57,24 @@ namespace
 	const int BUILD_CAP_SDL = 1 << 3;
 }
 
+/** Returns the API to read the joysticks with for the current binary. */
+static JoyMan::ApiType GetJoystickApi() {
+#if IS_APPLE || IS_LINUX
+	// Unix always uses SDL
+	return JoyMan::API_SDL;
+#else
+	// If the current executable is a SDL exe, use that API
+	if (FlagListManager::GetFlagListManager()->GetBuildCaps() & BUILD_CAP_SDL)
+	{
+		return JoyMan::API_SDL;
+	}
+	else
+	{
+		return JoyMan::API_NATIVE;
+	}
+#endif
+}
+
 /** A mechanism for allowing a network settings option's description (GUI label)
  to differ from its corresponding registry value. */
 class NetworkSettingsOption {
@@ -156,7 +177,6 @@ BasicSettingsPage::BasicSettingsPage(wxWindow* parent): wxPanel(parent, wxID_ANY
 		InitializeNetworkOptions();
 	}
 	
-	TCManager::Initialize();
 	TCManager::RegisterTCChanged(this);
 	TCManager::RegisterTCActiveModChanged(this);
 	TCManager::RegisterTCBinaryChanged(this);
@@ -164,18 +184,32 @@ BasicSettingsPage::BasicSettingsPage(wxWindow* parent): wxPanel(parent, wxID_ANY
 	ProMan::GetProfileManager()->AddEventHandler(this);
 	FlagListManager::GetFlagListManager()->RegisterFlagFileProcessingStatusChanged(this);
 	FREDManager::RegisterFREDEnabledChanged(this);
+	this->CreateControls();
 	wxCommandEvent event(this->GetId());
 	this->ProfileChanged(event);
 }
 
+/** Puts the values of the newly selected profile into the controls, which are
+ only created once. The executable controls are updated separately, by
+ OnTCChanged(). */
 void BasicSettingsPage::ProfileChanged(wxCommandEvent &WXUNUSED(event)) {
-	if (this->GetSizer() != NULL) {
-		this->GetSizer()->Clear(true);
-	}
+	this->Freeze();
+	this->UpdateVideoControls();
+#if IS_WIN32
+	this->UpdateSpeechControls();
+#endif
+	this->UpdateNetworkControls();
+	this->UpdateAudioControls();
+	this->UpdateJoystickControls();
+#if IS_LINUX
+	this->UpdateSchedulingControls();
+#endif
+	this->Thaw();
+}
 
-	this->InitializeMemberVariables();
-	
-	ProMan* proman = ProMan::GetProfileManager();
+/** Creates the controls and sizers of the page. Called once, from the
+ constructor. */
+void BasicSettingsPage::CreateControls() {
 	// exe Selection
 	wxStaticBox* exeBox = new wxStaticBox(this, wxID_ANY, _("FS2 Open game root folder and executable"));
 
@@ -223,103 +257,38 @@ void BasicSettingsPage::ProfileChanged(wxCommandEvent &WXUNUSED(event)) {
 	wxStaticText* resolutionText = 
 		new wxStaticText(this, wxID_ANY, _("Resolution:"));
 	wxChoice* resolutionCombo = new wxChoice(this, ID_RESOLUTION_COMBO);
-	
-	SetUpResolution();
 
 	wxStaticText* depthText = 
 		new wxStaticText(this, wxID_ANY, _("Depth:"));
 	wxChoice* depthCombo = new wxChoice(this, ID_DEPTH_COMBO);
-	long bitDepth;
 	depthCombo->Append(_("16-bit"));
 	depthCombo->Append(_("32-bit"));
-	proman->ProfileRead(PRO_CFG_VIDEO_BIT_DEPTH, &bitDepth, DEFAULT_VIDEO_BIT_DEPTH, true);
-	depthCombo->SetSelection((bitDepth == 16) ? 0 : 1);
 
 	wxStaticText* textureFilterText = 
 		new wxStaticText(this, wxID_ANY, _("Texture filter:"));
 	wxChoice* textureFilterCombo = new wxChoice(this, ID_TEXTURE_FILTER_COMBO);
-	wxString filter;
 	textureFilterCombo->Append(_("Bilinear"));
 	textureFilterCombo->Append(_("Trilinear"));
-	proman->ProfileRead(PRO_CFG_VIDEO_TEXTURE_FILTER, &filter, DEFAULT_VIDEO_TEXTURE_FILTER, true);
-	// FIXME shouldn't need case folding. comparison should be case-sensitive:
-	//       either Bilinear or Trilinear.
-	//       although now we've created legacy texture filter values. hmm.
-	filter.MakeLower();
-	textureFilterCombo->SetSelection( (filter == _T("bilinear")) ? 0 : 1);
 
 #if !IS_WIN32 // AF/AA don't yet work on Windows
 	wxStaticText* anisotropicText = 
 		new wxStaticText(this, wxID_ANY, _("Anisotropic:"));
 	wxChoice* anisotropicCombo = new wxChoice(this, ID_ANISOTROPIC_COMBO);
-	long anisotropic;
 	anisotropicCombo->Append(_("Off"));
 	anisotropicCombo->Append(_T(" 1x"));
 	anisotropicCombo->Append(_T(" 2x"));
 	anisotropicCombo->Append(_T(" 4x"));
 	anisotropicCombo->Append(_T(" 8x"));
 	anisotropicCombo->Append(_T("16x"));
-	proman->ProfileRead(PRO_CFG_VIDEO_ANISOTROPIC, &anisotropic, DEFAULT_VIDEO_ANISOTROPIC, true);
-	switch(anisotropic) {
-		case 0:
-			anisotropic = 0;
-			break;
-		case 1:
-			anisotropic = 1;
-			break;
-		case 2:
-			anisotropic = 2;
-			break;
-		case 4:
-			anisotropic = 3;
-			break;
-		case 8:
-			anisotropic = 4;
-			break;
-		case 16:
-			anisotropic = 5;
-			break;
-		default:
-			wxLogWarning(_T("invalid anisotropic factor %ld, setting to 0"),
-				anisotropic);
-			proman->ProfileWrite(PRO_CFG_VIDEO_ANISOTROPIC, static_cast<long>(0));
-			anisotropic = 0;
-	}
-	anisotropicCombo->SetSelection(anisotropic);
 
 
 	wxStaticText* aaText = new wxStaticText(this, wxID_ANY, _("Anti-aliasing:"));
 	wxChoice* aaCombo = new wxChoice(this, ID_AA_COMBO);
-	long antialias;
 	aaCombo->Append(_("Off"));
 	aaCombo->Append(_T(" 2x"));
 	aaCombo->Append(_T(" 4x"));
 	aaCombo->Append(_T(" 8x"));
 	aaCombo->Append(_T("16x"));
-	proman->ProfileRead(PRO_CFG_VIDEO_ANTI_ALIAS, &antialias, DEFAULT_VIDEO_ANTI_ALIAS, true);
-	switch(antialias) {
-		case 0:
-			antialias = 0;
-			break;
-		case 2:
-			antialias = 1;
-			break;
-		case 4:
-			antialias = 2;
-			break;
-		case 8:
-			antialias = 3;
-			break;
-		case 16:
-			antialias = 4;
-			break;
-		default:
-			wxLogWarning(_T("invalid anti-aliasing factor %ld, setting to 0"),
-				antialias);
-			proman->ProfileWrite(PRO_CFG_VIDEO_ANTI_ALIAS, static_cast<long>(0));
-			antialias = 0;
-	}
-	aaCombo->SetSelection(antialias);
 #endif
 
 	// Sizer for graphics, resolution, depth, etc
@@ -419,62 +388,6 @@ void BasicSettingsPage::ProfileChanged(wxCommandEvent &WXUNUSED(event)) {
 		speechVoiceCombo->SetMinSize(wxSize(maxStringWidth + 40, // 40 to include drop down box control
 			speechVoiceCombo->GetSize().GetHeight()));
 		this->Layout();
-
-		long speechVoice;
-		int speechSystemVoice = SpeechMan::GetVoice();
-		if ( speechSystemVoice < 0 ) {
-			wxLogWarning(_T("Had problem retrieving the system voice, using voice %d"),
-				DEFAULT_SPEECH_VOICE);
-			speechSystemVoice = DEFAULT_SPEECH_VOICE;
-		}
-		// set the voice to what is in the profile, if not set in profile use
-		// system settings
-		proman->ProfileRead(PRO_CFG_SPEECH_VOICE, &speechVoice, speechSystemVoice, true);
-		// there should not be more than MAX_INT voices installed on a system so
-		// the cast of an unsigned int to a signed int should not result in a 
-		// loss of data.
-		if ( speechVoice >= static_cast<int>(speechVoiceCombo->GetCount()) ) {
-			wxLogWarning(_T("Profile speech voice index out of range,")
-				_T(" setting to system default"));
-			speechVoice = speechSystemVoice;
-		}
-		speechVoiceCombo->SetSelection(speechVoice);
-
-		long speechVolume;
-		int speechSystemVolume = SpeechMan::GetVolume();
-		if (speechSystemVolume < 0) {
-			wxLogWarning(_T("Had problem in retrieving the system speech volume,")
-				_T(" setting to %d"), DEFAULT_SPEECH_VOLUME);
-			speechSystemVolume = DEFAULT_SPEECH_VOLUME;
-		}
-		proman->ProfileRead(PRO_CFG_SPEECH_VOLUME, &speechVolume, speechSystemVolume, true);
-		if ( speechVolume < 0 || speechVolume > 100 ) {
-			wxLogWarning(_T("Speech Volume recorded in profile is out of range,")
-				_T(" resetting to %d"), DEFAULT_SPEECH_VOLUME);
-			speechVolume = DEFAULT_SPEECH_VOLUME;
-		}
-		speechVoiceVolume->SetValue(speechVolume);
-
-
-		bool speechInTechroom;
-		proman->ProfileRead(
-			PRO_CFG_SPEECH_IN_TECHROOM, &speechInTechroom, DEFAULT_SPEECH_IN_TECHROOM, true);
-		speechInTechroomCheck->SetValue(speechInTechroom);
-
-		bool speechInBriefings;
-		proman->ProfileRead(
-			PRO_CFG_SPEECH_IN_BRIEFINGS, &speechInBriefings, DEFAULT_SPEECH_IN_BRIEFINGS, true);
-		speechInBriefingCheck->SetValue(speechInBriefings);
-
-		bool speechInGame;
-		proman->ProfileRead(
-			PRO_CFG_SPEECH_IN_GAME, &speechInGame, DEFAULT_SPEECH_IN_GAME, true);
-		speechInGameCheck->SetValue(speechInGame);
-
-		bool speechInMulti;
-		proman->ProfileRead(
-			PRO_CFG_SPEECH_IN_MULTI, &speechInMulti, DEFAULT_SPEECH_IN_MULTI, true);
-		speechInMultiCheck->SetValue(speechInMulti);
 	} else {
 		speechBox->Disable();
 		speechTestText->Disable();
@@ -501,33 +414,6 @@ void BasicSettingsPage::ProfileChanged(wxCommandEvent &WXUNUSED(event)) {
 		networkType->Append(it->GetDescription());
 	}
 	
-	wxString type;
-	proman->ProfileRead(PRO_CFG_NETWORK_TYPE, &type,
-		DEFAULT_NETWORK_TYPE, true);
-	
-	int networkTypeSelection =
-		FindOptionIndexWithRegistryValue(networkTypeOptions, type);
-	if (networkTypeSelection < 0) {
-		wxLogError(
-			_T("Profile value '%s' was not found in list of type options. ")
-			_T("Using default '%s'."),
-				type.c_str(),
-				DEFAULT_NETWORK_TYPE.c_str());		
-		
-		networkTypeSelection =
-			FindOptionIndexWithRegistryValue(networkTypeOptions, DEFAULT_NETWORK_TYPE);
-		if (networkTypeSelection < 0) {
-			wxLogError(
-				_T("Default value '%s' was not found in list of type options. ")
-				_T("Using first entry '%s'."),
-					DEFAULT_NETWORK_TYPE.c_str(),
-					networkTypeOptions[0].GetRegistryValue().c_str());
-			networkTypeSelection = 0;
-		}
-	}
-
-	networkType->SetSelection(networkTypeSelection);
-	
 	wxChoice* networkSpeed = new wxChoice(this, ID_NETWORK_SPEED);
 	for (NetworkSettingsOptions::const_iterator
 		 it = networkSpeedOptions.begin(),
@@ -535,48 +421,13 @@ void BasicSettingsPage::ProfileChanged(wxCommandEvent &WXUNUSED(event)) {
 		 it != end; ++it) {
 		networkSpeed->Append(it->GetDescription());
 	}
-	
-	wxString speed;
-	proman->ProfileRead(PRO_CFG_NETWORK_SPEED, &speed,
-		DEFAULT_NETWORK_SPEED, true);
-	
-	int networkSpeedSelection =
-		FindOptionIndexWithRegistryValue(networkSpeedOptions, speed);
-	if (networkSpeedSelection < 0) {
-		wxLogError(
-			_T("Profile value '%s' was not found in list of speed options. ")
-			_T("Using default '%s'."),
-				speed.c_str(),
-				DEFAULT_NETWORK_SPEED.c_str());		
-		
-		networkSpeedSelection =
-			FindOptionIndexWithRegistryValue(networkSpeedOptions, DEFAULT_NETWORK_SPEED);
-		if (networkSpeedSelection < 0) {
-			wxLogError(
-				_T("Default value '%s' was not found in list of speed options. ")
-				_T("Using first entry '%s'."),
-					DEFAULT_NETWORK_SPEED.c_str(),
-					networkSpeedOptions[0].GetRegistryValue().c_str());
-			networkSpeedSelection = 0;
-		}
-	}
-	
-	networkSpeed->SetSelection(networkSpeedSelection);
 
 	wxTextCtrl* networkPort = 
 		new wxTextCtrl(this, ID_NETWORK_PORT, wxEmptyString);
-	long port;
-	proman->ProfileRead(PRO_CFG_NETWORK_PORT, &port, DEFAULT_NETWORK_PORT, true);
-	if (port != DEFAULT_NETWORK_PORT) {
-		networkPort->ChangeValue(wxString::Format(_T("%ld"), port));
-	}
 	networkPort->SetValidator(wxTextValidator(wxFILTER_NUMERIC));
 	networkPort->SetMaxLength(5);
 
 	wxTextCtrl* networkIP = new wxTextCtrl(this, ID_NETWORK_IP, wxEmptyString);
-	wxString ip;
-	proman->ProfileRead(PRO_CFG_NETWORK_IP, &ip, DEFAULT_NETWORK_IP, true);
-	networkIP->ChangeValue(ip);
 	networkIP->SetMaxLength(15); // for ###.###.###.###
 	
 	wxGridSizer* networkInsideSizerL = new wxFlexGridSizer(2);
@@ -667,57 +518,416 @@ void BasicSettingsPage::ProfileChanged(wxCommandEvent &WXUNUSED(event)) {
 	joystickDetectionSizer->Add(joystickSelected, wxSizerFlags().Proportion(1).Expand().Border(wxBOTTOM, 5));
 	joystickDetectionSizer->Add(joystickDetectButton, wxSizerFlags().Right());
 
-	wxBoxSizer* joystickExtrasSizer = new wxBoxSizer(wxVERTICAL);
-	joystickExtrasSizer->Add(joystickForceFeedback, wxSizerFlags().Expand().Border(wxBOTTOM, 5));
-	joystickExtrasSizer->Add(joystickDirectionalHit, wxSizerFlags().Expand().Border(wxBOTTOM, 5));
-#if IS_WIN32
-	joystickExtrasSizer->Add(joystickCalibrateButton, wxSizerFlags().Expand());
-#endif
+	wxBoxSizer* joystickExtrasSizer = new wxBoxSizer(wxVERTICAL);
+	joystickExtrasSizer->Add(joystickForceFeedback, wxSizerFlags().Expand().Border(wxBOTTOM, 5));
+	joystickExtrasSizer->Add(joystickDirectionalHit, wxSizerFlags().Expand().Border(wxBOTTOM, 5));
+#if IS_WIN32
+	joystickExtrasSizer->Add(joystickCalibrateButton, wxSizerFlags().Expand());
+#endif
+
+	wxStaticBoxSizer* joystickSizer = new wxStaticBoxSizer(joystickBox, wxHORIZONTAL);
+	joystickSizer->Add(joystickDetectionSizer, 1, wxALIGN_BOTTOM|wxLEFT|wxRIGHT|wxBOTTOM, 5);
+	joystickSizer->Add(joystickExtrasSizer, wxSizerFlags().Expand().Border(wxLEFT|wxRIGHT|wxBOTTOM, 5));
+
+#if IS_LINUX
+	// Scheduling, which takes the place of speech on the page
+	wxStaticBox* schedulingBox = new wxStaticBox(this, wxID_ANY, _("Game scheduling"));
+
+	this->cpuAffinityText = new wxTextCtrl(this, ID_LAUNCH_CPU_AFFINITY);
+	this->cpuAffinityText->SetToolTip(
+		_("The CPUs the game may run on, such as 0-3,6. Leave empty for every CPU."));
+
+	this->niceSpin = new wxSpinCtrl(this, ID_LAUNCH_NICE, wxEmptyString,
+		wxDefaultPosition, wxSize(60, -1), wxSP_ARROW_KEYS,
+		LAUNCH_NICE_HIGHEST, LAUNCH_NICE_LOWEST, DEFAULT_LAUNCH_NICE);
+	this->niceSpin->SetToolTip(
+		_("Lower is a higher priority. 0 leaves the game at the launcher's level."));
+
+	this->ioClassChoice = new wxChoice(this, ID_LAUNCH_IO_CLASS);
+	// in the order of LaunchIOClass
+	this->ioClassChoice->Append(_("Default"));
+	this->ioClassChoice->Append(_("Real time"));
+	this->ioClassChoice->Append(_("Best effort"));
+	this->ioClassChoice->Append(_("Idle"));
+
+	this->ioPriorityChoice = new wxChoice(this, ID_LAUNCH_IO_PRIORITY);
+	for (long level = 0; level <= LAUNCH_IO_PRIORITY_LOWEST; ++level) {
+		this->ioPriorityChoice->Append(wxString::Format(_T("%ld"), level));
+	}
+	this->ioPriorityChoice->SetToolTip(_("0 is the highest priority within the class."));
+
+	wxBoxSizer* schedulingInsideSizer = new wxBoxSizer(wxHORIZONTAL);
+	schedulingInsideSizer->Add(new wxStaticText(this, wxID_ANY, _("CPUs:")), 0, wxALIGN_CENTER_VERTICAL|wxRIGHT, 5);
+	schedulingInsideSizer->Add(this->cpuAffinityText, 1, wxALIGN_CENTER_VERTICAL);
+	schedulingInsideSizer->AddStretchSpacer(5);
+	schedulingInsideSizer->Add(new wxStaticText(this, wxID_ANY, _("Nice level:")), 0, wxALIGN_CENTER_VERTICAL|wxRIGHT, 5);
+	schedulingInsideSizer->Add(this->niceSpin, 0, wxALIGN_CENTER_VERTICAL);
+	schedulingInsideSizer->AddStretchSpacer(5);
+	schedulingInsideSizer->Add(new wxStaticText(this, wxID_ANY, _("I/O priority:")), 0, wxALIGN_CENTER_VERTICAL|wxRIGHT, 5);
+	schedulingInsideSizer->Add(this->ioClassChoice, 0, wxALIGN_CENTER_VERTICAL|wxRIGHT, 5);
+	schedulingInsideSizer->Add(this->ioPriorityChoice, 0, wxALIGN_CENTER_VERTICAL);
+
+	wxStaticBoxSizer* schedulingSizer = new wxStaticBoxSizer(schedulingBox, wxHORIZONTAL);
+	schedulingSizer->Add(schedulingInsideSizer, wxSizerFlags(1).Expand().Border(wxLEFT|wxRIGHT|wxBOTTOM, 5));
+#endif
+
+	// Proxy
+	// sorry, but there won't be space for the proxy on any platform
+#if 0
+	wxStaticBox* proxyBox = new wxStaticBox(this, wxID_ANY, _("Proxy"));
+
+	wxChoicebook* proxyChoice = new ProxyChoice(this, ID_PROXY_TYPE);
+
+	wxStaticBoxSizer* proxySizer = new wxStaticBoxSizer(proxyBox, wxVERTICAL);
+	proxySizer->Add(proxyChoice, wxSizerFlags().Expand().Border(wxLEFT|wxRIGHT, 5));
+#endif
+
+	// Final Layout
+	wxBoxSizer* settingsSizer = new wxBoxSizer(wxVERTICAL);
+
+	settingsSizer->Add(videoSizer, wxSizerFlags().Expand().Border(wxBOTTOM, 5));
+	settingsSizer->Add(audioSizer, wxSizerFlags().Expand().Border(wxBOTTOM, 5));
+#if IS_WIN32
+	settingsSizer->Add(speechSizer, wxSizerFlags().Expand().Border(wxBOTTOM, 5));
+#endif
+	settingsSizer->Add(joystickSizer, wxSizerFlags().Expand().Border(wxBOTTOM, 5));
+#if IS_LINUX
+	settingsSizer->Add(schedulingSizer, wxSizerFlags().Expand().Border(wxBOTTOM, 5));
+#endif
+	settingsSizer->Add(networkSizer, wxSizerFlags().Expand());
+
+	wxBoxSizer* sizer = new wxBoxSizer(wxVERTICAL);
+	sizer->SetMinSize(wxSize(TAB_AREA_WIDTH-5, -1)); // 5 being for the border
+	sizer->Add(exeSizer, wxSizerFlags().Expand().Border(wxALL, 5));
+	sizer->Add(settingsSizer, wxSizerFlags().Expand().Border(wxLEFT|wxRIGHT|wxBOTTOM, 5));
+
+	this->SetSizer(sizer);
+	this->Layout();
+}
+
+/** Reads the video settings from the profile. The resolution list is
+ limited by the active mod, which is kept if the new profile uses the same
+ mod (and otherwise is replaced through OnActiveModChanged()). */
+void BasicSettingsPage::UpdateVideoControls() {
+	ProMan* proman = ProMan::GetProfileManager();
+
+	this->SelectResolution();
+
+	wxChoice* depthCombo = dynamic_cast<wxChoice*>(
+		wxWindow::FindWindowById(ID_DEPTH_COMBO, this));
+	wxCHECK_RET(depthCombo != NULL, _T("Unable to find depth combo"));
+	long bitDepth;
+	proman->ProfileRead(PRO_CFG_VIDEO_BIT_DEPTH, &bitDepth, DEFAULT_VIDEO_BIT_DEPTH, true);
+	depthCombo->SetSelection((bitDepth == 16) ? 0 : 1);
+
+	wxChoice* textureFilterCombo = dynamic_cast<wxChoice*>(
+		wxWindow::FindWindowById(ID_TEXTURE_FILTER_COMBO, this));
+	wxCHECK_RET(textureFilterCombo != NULL, _T("Unable to find texture filter combo"));
+	wxString filter;
+	proman->ProfileRead(PRO_CFG_VIDEO_TEXTURE_FILTER, &filter, DEFAULT_VIDEO_TEXTURE_FILTER, true);
+	// FIXME shouldn't need case folding. comparison should be case-sensitive:
+	//       either Bilinear or Trilinear.
+	//       although now we've created legacy texture filter values. hmm.
+	filter.MakeLower();
+	textureFilterCombo->SetSelection( (filter == _T("bilinear")) ? 0 : 1);
+
+#if !IS_WIN32 // AF/AA don't yet work on Windows
+	wxChoice* anisotropicCombo = dynamic_cast<wxChoice*>(
+		wxWindow::FindWindowById(ID_ANISOTROPIC_COMBO, this));
+	wxCHECK_RET(anisotropicCombo != NULL, _T("Unable to find anisotropic combo"));
+	long anisotropic;
+	proman->ProfileRead(PRO_CFG_VIDEO_ANISOTROPIC, &anisotropic, DEFAULT_VIDEO_ANISOTROPIC, true);
+	switch(anisotropic) {
+		case 0:
+			anisotropic = 0;
+			break;
+		case 1:
+			anisotropic = 1;
+			break;
+		case 2:
+			anisotropic = 2;
+			break;
+		case 4:
+			anisotropic = 3;
+			break;
+		case 8:
+			anisotropic = 4;
+			break;
+		case 16:
+			anisotropic = 5;
+			break;
+		default:
+			wxLogWarning(_T("invalid anisotropic factor %ld, setting to 0"),
+				anisotropic);
+			proman->ProfileWrite(PRO_CFG_VIDEO_ANISOTROPIC, static_cast<long>(0));
+			anisotropic = 0;
+	}
+	anisotropicCombo->SetSelection(anisotropic);
+
+	wxChoice* aaCombo = dynamic_cast<wxChoice*>(
+		wxWindow::FindWindowById(ID_AA_COMBO, this));
+	wxCHECK_RET(aaCombo != NULL, _T("Unable to find anti-aliasing combo"));
+	long antialias;
+	proman->ProfileRead(PRO_CFG_VIDEO_ANTI_ALIAS, &antialias, DEFAULT_VIDEO_ANTI_ALIAS, true);
+	switch(antialias) {
+		case 0:
+			antialias = 0;
+			break;
+		case 2:
+			antialias = 1;
+			break;
+		case 4:
+			antialias = 2;
+			break;
+		case 8:
+			antialias = 3;
+			break;
+		case 16:
+			antialias = 4;
+			break;
+		default:
+			wxLogWarning(_T("invalid anti-aliasing factor %ld, setting to 0"),
+				antialias);
+			proman->ProfileWrite(PRO_CFG_VIDEO_ANTI_ALIAS, static_cast<long>(0));
+			antialias = 0;
+	}
+	aaCombo->SetSelection(antialias);
+#endif
+}
+
+#if IS_WIN32
+void BasicSettingsPage::UpdateSpeechControls() {
+	if (!SpeechMan::IsInitialized()) {
+		return; // the controls were disabled when they were created
+	}
+	ProMan* proman = ProMan::GetProfileManager();
+
+	wxChoice* speechVoiceCombo = dynamic_cast<wxChoice*>(
+		wxWindow::FindWindowById(ID_SPEECH_VOICE_COMBO, this));
+	wxCHECK_RET(speechVoiceCombo != NULL, _T("Unable to find speech voice combo"));
+	wxSlider* speechVoiceVolume = dynamic_cast<wxSlider*>(
+		wxWindow::FindWindowById(ID_SPEECH_VOICE_VOLUME, this));
+	wxCHECK_RET(speechVoiceVolume != NULL, _T("Unable to find speech volume slider"));
+	wxCheckBox* speechInTechroomCheck = dynamic_cast<wxCheckBox*>(
+		wxWindow::FindWindowById(ID_SPEECH_IN_TECHROOM, this));
+	wxCheckBox* speechInBriefingCheck = dynamic_cast<wxCheckBox*>(
+		wxWindow::FindWindowById(ID_SPEECH_IN_BRIEFING, this));
+	wxCheckBox* speechInGameCheck = dynamic_cast<wxCheckBox*>(
+		wxWindow::FindWindowById(ID_SPEECH_IN_GAME, this));
+	wxCheckBox* speechInMultiCheck = dynamic_cast<wxCheckBox*>(
+		wxWindow::FindWindowById(ID_SPEECH_IN_MULTI, this));
+	wxCHECK_RET(speechInTechroomCheck != NULL && speechInBriefingCheck != NULL
+		&& speechInGameCheck != NULL && speechInMultiCheck != NULL,
+		_T("Unable to find speech checkboxes"));
+
+	long speechVoice;
+	int speechSystemVoice = SpeechMan::GetVoice();
+	if ( speechSystemVoice < 0 ) {
+		wxLogWarning(_T("Had problem retrieving the system voice, using voice %d"),
+			DEFAULT_SPEECH_VOICE);
+		speechSystemVoice = DEFAULT_SPEECH_VOICE;
+	}
+	// set the voice to what is in the profile, if not set in profile use
+	// system settings
+	proman->ProfileRead(PRO_CFG_SPEECH_VOICE, &speechVoice, speechSystemVoice, true);
+	// there should not be more than MAX_INT voices installed on a system so
+	// the cast of an unsigned int to a signed int should not result in a 
+	// loss of data.
+	if ( speechVoice >= static_cast<int>(speechVoiceCombo->GetCount()) ) {
+		wxLogWarning(_T("Profile speech voice index out of range,")
+			_T(" setting to system default"));
+		speechVoice = speechSystemVoice;
+	}
+	speechVoiceCombo->SetSelection(speechVoice);
+
+	long speechVolume;
+	int speechSystemVolume = SpeechMan::GetVolume();
+	if (speechSystemVolume < 0) {
+		wxLogWarning(_T("Had problem in retrieving the system speech volume,")
+			_T(" setting to %d"), DEFAULT_SPEECH_VOLUME);
+		speechSystemVolume = DEFAULT_SPEECH_VOLUME;
+	}
+	proman->ProfileRead(PRO_CFG_SPEECH_VOLUME, &speechVolume, speechSystemVolume, true);
+	if ( speechVolume < 0 || speechVolume > 100 ) {
+		wxLogWarning(_T("Speech Volume recorded in profile is out of range,")
+			_T(" resetting to %d"), DEFAULT_SPEECH_VOLUME);
+		speechVolume = DEFAULT_SPEECH_VOLUME;
+	}
+	speechVoiceVolume->SetValue(speechVolume);
+
+
+	bool speechInTechroom;
+	proman->ProfileRead(
+		PRO_CFG_SPEECH_IN_TECHROOM, &speechInTechroom, DEFAULT_SPEECH_IN_TECHROOM, true);
+	speechInTechroomCheck->SetValue(speechInTechroom);
+
+	bool speechInBriefings;
+	proman->ProfileRead(
+		PRO_CFG_SPEECH_IN_BRIEFINGS, &speechInBriefings, DEFAULT_SPEECH_IN_BRIEFINGS, true);
+	speechInBriefingCheck->SetValue(speechInBriefings);
+
+	bool speechInGame;
+	proman->ProfileRead(
+		PRO_CFG_SPEECH_IN_GAME, &speechInGame, DEFAULT_SPEECH_IN_GAME, true);
+	speechInGameCheck->SetValue(speechInGame);
+
+	bool speechInMulti;
+	proman->ProfileRead(
+		PRO_CFG_SPEECH_IN_MULTI, &speechInMulti, DEFAULT_SPEECH_IN_MULTI, true);
+	speechInMultiCheck->SetValue(speechInMulti);
+}
+#endif
+
+void BasicSettingsPage::UpdateNetworkControls() {
+	ProMan* proman = ProMan::GetProfileManager();
+
+	wxChoice* networkType = dynamic_cast<wxChoice*>(
+		wxWindow::FindWindowById(ID_NETWORK_TYPE, this));
+	wxCHECK_RET(networkType != NULL, _T("Unable to find network type choice"));
+	wxChoice* networkSpeed = dynamic_cast<wxChoice*>(
+		wxWindow::FindWindowById(ID_NETWORK_SPEED, this));
+	wxCHECK_RET(networkSpeed != NULL, _T("Unable to find network speed choice"));
+	wxTextCtrl* networkPort = dynamic_cast<wxTextCtrl*>(
+		wxWindow::FindWindowById(ID_NETWORK_PORT, this));
+	wxCHECK_RET(networkPort != NULL, _T("Unable to find network port text ctrl"));
+	wxTextCtrl* networkIP = dynamic_cast<wxTextCtrl*>(
+		wxWindow::FindWindowById(ID_NETWORK_IP, this));
+	wxCHECK_RET(networkIP != NULL, _T("Unable to find network IP text ctrl"));
+
+	wxString type;
+	proman->ProfileRead(PRO_CFG_NETWORK_TYPE, &type,
+		DEFAULT_NETWORK_TYPE, true);
+	
+	int networkTypeSelection =
+		FindOptionIndexWithRegistryValue(networkTypeOptions, type);
+	if (networkTypeSelection < 0) {
+		wxLogError(
+			_T("Profile value '%s' was not found in list of type options. ")
+			_T("Using default '%s'."),
+				type.c_str(),
+				DEFAULT_NETWORK_TYPE.c_str());		
+		
+		networkTypeSelection =
+			FindOptionIndexWithRegistryValue(networkTypeOptions, DEFAULT_NETWORK_TYPE);
+		if (networkTypeSelection < 0) {
+			wxLogError(
+				_T("Default value '%s' was not found in list of type options. ")
+				_T("Using first entry '%s'."),
+					DEFAULT_NETWORK_TYPE.c_str(),
+					networkTypeOptions[0].GetRegistryValue().c_str());
+			networkTypeSelection = 0;
+		}
+	}
+
+	networkType->SetSelection(networkTypeSelection);
+
+	wxString speed;
+	proman->ProfileRead(PRO_CFG_NETWORK_SPEED, &speed,
+		DEFAULT_NETWORK_SPEED, true);
+	
+	int networkSpeedSelection =
+		FindOptionIndexWithRegistryValue(networkSpeedOptions, speed);
+	if (networkSpeedSelection < 0) {
+		wxLogError(
+			_T("Profile value '%s' was not found in list of speed options. ")
+			_T("Using default '%s'."),
+				speed.c_str(),
+				DEFAULT_NETWORK_SPEED.c_str());		
+		
+		networkSpeedSelection =
+			FindOptionIndexWithRegistryValue(networkSpeedOptions, DEFAULT_NETWORK_SPEED);
+		if (networkSpeedSelection < 0) {
+			wxLogError(
+				_T("Default value '%s' was not found in list of speed options. ")
+				_T("Using first entry '%s'."),
+					DEFAULT_NETWORK_SPEED.c_str(),
+					networkSpeedOptions[0].GetRegistryValue().c_str());
+			networkSpeedSelection = 0;
+		}
+	}
+	
+	networkSpeed->SetSelection(networkSpeedSelection);
+
+	long port;
+	proman->ProfileRead(PRO_CFG_NETWORK_PORT, &port, DEFAULT_NETWORK_PORT, true);
+	networkPort->ChangeValue((port != DEFAULT_NETWORK_PORT)
+		? wxString::Format(_T("%ld"), port) : wxString());
 
-	wxStaticBoxSizer* joystickSizer = new wxStaticBoxSizer(joystickBox, wxHORIZONTAL);
-	joystickSizer->Add(joystickDetectionSizer, 1, wxALIGN_BOTTOM|wxLEFT|wxRIGHT|wxBOTTOM, 5);
-	joystickSizer->Add(joystickExtrasSizer, wxSizerFlags().Expand().Border(wxLEFT|wxRIGHT|wxBOTTOM, 5));
+	wxString ip;
+	proman->ProfileRead(PRO_CFG_NETWORK_IP, &ip, DEFAULT_NETWORK_IP, true);
+	networkIP->ChangeValue(ip);
+}
 
-	// Proxy
-	// sorry, but there won't be space for the proxy on any platform
-#if 0
-	wxStaticBox* proxyBox = new wxStaticBox(this, wxID_ANY, _("Proxy"));
+/** Selects the new profile's devices in the sound device lists. The lists
+ themselves come from OpenAL, so they are only filled once. */
+void BasicSettingsPage::UpdateAudioControls() {
+	if (!OpenALMan::IsInitialized() || this->isSoundDevicePlaceholderShown) {
+		return; // SetupOpenALSection() reads the profile when it runs
+	}
 
-	wxChoicebook* proxyChoice = new ProxyChoice(this, ID_PROXY_TYPE);
+	if (!this->soundDeviceCombo->IsEmpty()) {
+		this->SelectSoundDeviceFromProfile(this->soundDeviceCombo,
+			PRO_CFG_OPENAL_DEVICE, wxEmptyString,
+			OpenALMan::GetSystemDefaultPlaybackDevice());
+	}
+	if (!this->captureDeviceCombo->IsEmpty()) {
+		this->SelectSoundDeviceFromProfile(this->captureDeviceCombo,
+			PRO_CFG_OPENAL_CAPTURE_DEVICE, _T(" capture"),
+			OpenALMan::GetSystemDefaultCaptureDevice());
+	}
 
-	wxStaticBoxSizer* proxySizer = new wxStaticBoxSizer(proxyBox, wxVERTICAL);
-	proxySizer->Add(proxyChoice, wxSizerFlags().Expand().Border(wxLEFT|wxRIGHT, 5));
-#endif
+	// SetupOpenALSection() lays the section out for the binary once its flag
+	// file is processed, so only the values are read here
+	if (FlagListManager::GetFlagListManager()->IsProcessingOK()
+		&& OpenALMan::BuildHasNewSoundCode()) {
+		this->ReadOpenALSettingsFromProfile();
+		this->Layout();
+	}
+}
 
-	// Final Layout
-	wxBoxSizer* settingsSizer = new wxBoxSizer(wxVERTICAL);
+void BasicSettingsPage::UpdateJoystickControls() {
+	// only enabled once joysticks have been found
+	if (this->joystickSelected->IsEnabled()) {
+		this->SelectJoystickFromProfile();
+	}
+}
 
-	settingsSizer->Add(videoSizer, wxSizerFlags().Expand().Border(wxBOTTOM, 5));
-	settingsSizer->Add(audioSizer, wxSizerFlags().Expand().Border(wxBOTTOM, 5));
-#if IS_WIN32
-	settingsSizer->Add(speechSizer, wxSizerFlags().Expand().Border(wxBOTTOM, 5));
-#endif
-	settingsSizer->Add(joystickSizer, wxSizerFlags().Expand().Border(wxBOTTOM, 5));
-	settingsSizer->Add(networkSizer, wxSizerFlags().Expand());
+#if IS_LINUX
+void BasicSettingsPage::UpdateSchedulingControls() {
+	const LaunchPriority priority(ProcessPriority::ReadFromProfile());
 
-	wxBoxSizer* sizer = new wxBoxSizer(wxVERTICAL);
-	sizer->SetMinSize(wxSize(TAB_AREA_WIDTH-5, -1)); // 5 being for the border
-	sizer->Add(exeSizer, wxSizerFlags().Expand().Border(wxALL, 5));
-	sizer->Add(settingsSizer, wxSizerFlags().Expand().Border(wxLEFT|wxRIGHT|wxBOTTOM, 5));
+	this->cpuAffinityText->ChangeValue(priority.cpus);
+	this->cpuAffinityText->SetForegroundColour(
+		wxSystemSettings::GetColour(wxSYS_COLOUR_WINDOWTEXT));
+	this->niceSpin->SetValue(priority.nice);
 
-	this->SetSizer(sizer);
-	this->Layout();
+	const long ioClass = (priority.ioClass >= LAUNCH_IO_CLASS_DEFAULT
+		&& priority.ioClass <= LAUNCH_IO_CLASS_IDLE) ? priority.ioClass : LAUNCH_IO_CLASS_DEFAULT;
+	this->ioClassChoice->SetSelection(ioClass);
+	const long ioPriority = (priority.ioPriority >= 0
+		&& priority.ioPriority <= LAUNCH_IO_PRIORITY_LOWEST) ?
+			priority.ioPriority : DEFAULT_LAUNCH_IO_PRIORITY;
+	this->ioPriorityChoice->SetSelection(ioPriority);
+	// only the realtime and best effort classes have levels
+	this->ioPriorityChoice->Enable(ioClass == LAUNCH_IO_CLASS_REALTIME
+		|| ioClass == LAUNCH_IO_CLASS_BEST_EFFORT);
 }
+#endif
 
 BasicSettingsPage::~BasicSettingsPage() {
-	TCManager::DeInitialize();
 	if ( SpeechMan::IsInitialized() ) {
 		SpeechMan::DeInitialize();
 	}
+	ResolutionMan::ModeCatalog::CancelEnumerationEvent(this);
 	JoyMan::DeInitialize();
 	OpenALMan::DeInitialize();
 }
 
+/** Private event that runs one step of device detection. The step is in the
+ event's int and the detection pass it belongs to in its extra long. */
+LAUNCHER_DECLARE_EVENT_TYPE(EVT_BSP_DEVICE_DETECTION_STEP);
+LAUNCHER_DEFINE_EVENT_TYPE(EVT_BSP_DEVICE_DETECTION_STEP);
+
 /// Event Handling
 BEGIN_EVENT_TABLE(BasicSettingsPage, wxPanel)
 EVT_BUTTON(ID_EXE_SELECT_ROOT_BUTTON, BasicSettingsPage::OnSelectTC)
@@ -732,6 +942,8 @@ EVT_COMMAND(wxID_NONE, EVT_TC_FRED_BINARY_CHANGED, BasicSettingsPage::OnCurrentF
 EVT_COMMAND(wxID_NONE, EVT_FLAG_FILE_PROCESSING_STATUS_CHANGED,
 	BasicSettingsPage::OnFlagFileProcessingStatusChanged)
 EVT_COMMAND(wxID_NONE, EVT_FRED_ENABLED_CHANGED, BasicSettingsPage::OnFREDEnabledChanged)
+EVT_COMMAND(wxID_NONE, EVT_BSP_DEVICE_DETECTION_STEP, BasicSettingsPage::OnDeviceDetectionStep)
+EVT_COMMAND(wxID_NONE, EVT_RESOLUTION_MODES_ENUMERATED, BasicSettingsPage::OnModesEnumerated)
 
 // Video controls
 EVT_CHOICE(ID_RESOLUTION_COMBO, BasicSettingsPage::OnSelectVideoResolution)
@@ -763,6 +975,7 @@ EVT_CHECKBOX(ID_ENABLE_EFX, BasicSettingsPage::OnToggleEnableEFX)
 EVT_TEXT(ID_AUDIO_SAMPLE_RATE, BasicSettingsPage::OnChangeSampleRate)
 EVT_BUTTON(ID_DOWNLOAD_OPENAL, BasicSettingsPage::OnDownloadOpenAL)
 EVT_BUTTON(ID_DETECT_OPENAL, BasicSettingsPage::OnDetectOpenAL)
+EVT_COMMAND(wxID_NONE, EVT_OPENAL_PROBE_DONE, BasicSettingsPage::OnOpenALProbeDone)
 
 // Joystick
 EVT_CHOICE(ID_JOY_SELECTED, BasicSettingsPage::OnSelectJoystick)
@@ -770,6 +983,16 @@ EVT_CHECKBOX(ID_JOY_FORCE_FEEDBACK, BasicSettingsPage::OnCheckForceFeedback)
 EVT_CHECKBOX(ID_JOY_DIRECTIONAL_HIT, BasicSettingsPage::OnCheckDirectionalHit)
 EVT_BUTTON(ID_JOY_CALIBRATE_BUTTON, BasicSettingsPage::OnCalibrateJoystick)
 EVT_BUTTON(ID_JOY_DETECT_BUTTON, BasicSettingsPage::OnDetectJoystick)
+EVT_COMMAND(wxID_NONE, EVT_JOYSTICK_PROBE_DONE, BasicSettingsPage::OnJoystickProbeDone)
+EVT_COMMAND(wxID_NONE, EVT_JOYSTICK_HOTPLUG, BasicSettingsPage::OnJoystickHotplug)
+
+#if IS_LINUX
+// Scheduling
+EVT_TEXT(ID_LAUNCH_CPU_AFFINITY, BasicSettingsPage::OnChangeCpuAffinity)
+EVT_SPINCTRL(ID_LAUNCH_NICE, BasicSettingsPage::OnChangeNice)
+EVT_CHOICE(ID_LAUNCH_IO_CLASS, BasicSettingsPage::OnSelectIOClass)
+EVT_CHOICE(ID_LAUNCH_IO_PRIORITY, BasicSettingsPage::OnSelectIOPriority)
+#endif
 
 // Profile
 EVT_COMMAND(wxID_NONE, EVT_CURRENT_PROFILE_CHANGED, BasicSettingsPage::ProfileChanged)
@@ -781,10 +1004,117 @@ void BasicSettingsPage::OnFlagFileProcessingStatusChanged(wxCommandEvent& event)
 		static_cast<FlagListManager::FlagFileProcessingStatus>(event.GetInt());
 	
 	if (status == FlagListManager::FLAG_FILE_PROCESSING_OK) {
-		this->SetupOpenALSection();
-		this->SetupJoystickSection();
-		this->SetUpResolution();
+		this->BeginDeviceDetection();
+	}
+}
+
+/** Puts "Detecting..." into the sound device, joystick and resolution
+ controls and queues their setup. The probes that can run on a worker thread
+ do: OpenAL, the native joysticks and the Win32 display modes. Each of their
+ steps waits for its probe's event, then runs again to fill in its controls.
+ SDL's joysticks and modes have to be read on the main thread, so each of
+ those runs in its own turn of the event loop instead. */
+void BasicSettingsPage::BeginDeviceDetection() {
+	this->deviceDetectionPass++;
+
+	if (OpenALMan::WasCompiledIn() && !OpenALMan::IsInitialized()
+		&& (this->soundDeviceCombo->IsEmpty() || this->isSoundDevicePlaceholderShown)) {
+		this->soundDeviceCombo->Clear();
+		this->soundDeviceCombo->Append(_("Detecting..."));
+		this->soundDeviceCombo->SetSelection(0);
+		this->soundDeviceCombo->Disable();
+		this->openALVersion->SetLabel(_("Detecting OpenAL..."));
+		this->isSoundDevicePlaceholderShown = true;
 	}
+
+	this->joystickSelected->Clear();
+	this->joystickSelected->Append(_("Detecting..."));
+	this->joystickSelected->SetSelection(0);
+	this->joystickSelected->Disable();
+
+	wxChoice* resolutionCombo = dynamic_cast<wxChoice*>(
+		wxWindow::FindWindowById(ID_RESOLUTION_COMBO, this));
+	wxCHECK_RET(resolutionCombo != NULL, _T("Unable to find resolution combo"));
+	resolutionCombo->Clear();
+	resolutionCombo->Append(_("Detecting..."));
+	resolutionCombo->SetSelection(0);
+	resolutionCombo->Disable();
+
+	this->PostDeviceDetectionStep(DETECT_OPENAL);
+}
+
+void BasicSettingsPage::PostDeviceDetectionStep(const DeviceDetectionStep step) {
+	wxCommandEvent stepEvent(EVT_BSP_DEVICE_DETECTION_STEP, wxID_NONE);
+	stepEvent.SetInt(step);
+	stepEvent.SetExtraLong(this->deviceDetectionPass);
+	this->AddPendingEvent(stepEvent);
+}
+
+void BasicSettingsPage::OnDeviceDetectionStep(wxCommandEvent& event) {
+	if (event.GetExtraLong() != this->deviceDetectionPass) {
+		return; // a later pass has started over
+	}
+
+	const DeviceDetectionStep step =
+		static_cast<DeviceDetectionStep>(event.GetInt());
+
+	switch (step) {
+		case DETECT_OPENAL: {
+			StartupProbe probe(_T("OpenAL setup"));
+			if (this->isSoundDevicePlaceholderShown && OpenALMan::Initialize()
+				&& !OpenALMan::HasCapabilities()) {
+				// nothing cached for this OpenAL, so keep showing "Detecting..."
+				// until OnOpenALProbeDone()
+				OpenALMan::StartProbe(this);
+				break;
+			}
+			if (this->isSoundDevicePlaceholderShown) {
+				this->soundDeviceCombo->Clear();
+				this->soundDeviceCombo->Enable();
+				this->openALVersion->SetLabel(wxEmptyString);
+				this->isSoundDevicePlaceholderShown = false;
+			}
+			this->SetupOpenALSection();
+			break;
+		}
+		case DETECT_JOYSTICK: {
+			if (JoyMan::WasCompiledIn() && JoyMan::StartProbe(GetJoystickApi(), this)) {
+				return; // back to this step from OnJoystickProbeDone()
+			}
+			StartupProbe probe(_T("Joystick setup"));
+			// SetupJoystickSection() only enables the choice if there are joysticks
+			this->SetupJoystickSection();
+			break;
+		}
+		case DETECT_RESOLUTION: {
+			if (ResolutionMap::StartEnumeratingModes(this)) {
+				return; // back to this step from OnModesEnumerated()
+			}
+			StartupProbe probe(_T("Resolution setup"));
+			wxChoice* resolutionCombo = dynamic_cast<wxChoice*>(
+				wxWindow::FindWindowById(ID_RESOLUTION_COMBO, this));
+			wxCHECK_RET(resolutionCombo != NULL, _T("Unable to find resolution combo"));
+			resolutionCombo->Clear();
+			resolutionCombo->Enable();
+			this->SetUpResolution();
+			break;
+		}
+		case DETECT_DONE:
+			// started last, once the joysticks and the resolutions have been
+			// read, since the monitor pumps SDL's events
+			JoyMan::StartHotplugMonitor(this);
+			return;
+		default:
+			wxFAIL_MSG(wxString::Format(
+				_T("Unknown device detection step %d"), event.GetInt()));
+			return;
+	}
+
+	this->PostDeviceDetectionStep(static_cast<DeviceDetectionStep>(step + 1));
+}
+
+void BasicSettingsPage::OnModesEnumerated(wxCommandEvent& WXUNUSED(event)) {
+	this->PostDeviceDetectionStep(DETECT_RESOLUTION);
 }
 
 void BasicSettingsPage::OnFREDEnabledChanged(wxCommandEvent& WXUNUSED(event)) {
@@ -814,7 +1144,7 @@ void BasicSettingsPage::OnFREDEnabledChanged(wxCommandEvent& WXUNUSED(event)) {
 void BasicSettingsPage::OnSelectTC(wxCommandEvent &WXUNUSED(event)) {
 	wxString directory;
 	ProMan* proman = ProMan::GetProfileManager();
-	proman->ProfileRead(PRO_CFG_TC_ROOT_FOLDER, &directory, wxEmptyString);
+	proman->ProfileRead(PKEY_TC_ROOT_FOLDER, &directory);
 	wxDirDialog filechooser(this, _T("Choose the root folder of an FS2 Open game."),
 		directory, wxDD_DEFAULT_STYLE|wxDD_DIR_MUST_EXIST);
 
@@ -864,7 +1194,7 @@ currently select executable from the active profile only if the executable
 specified in the profile does not exist in the TC.
 
 \note clearing the selected executable disables the play button.
-\note Emits a EVT_TC_BINARY_CHANGED in any case.*/
+\note TCManager sends EVT_TC_BINARY_CHANGED right after EVT_TC_CHANGED.*/
 void BasicSettingsPage::OnTCChanged(wxCommandEvent &WXUNUSED(event)) {
 	ExeChoice* exeChoice = dynamic_cast<ExeChoice*>(
 		wxWindow::FindWindowById(ID_EXE_CHOICE_BOX, this));
@@ -904,7 +1234,7 @@ void BasicSettingsPage::OnTCChanged(wxCommandEvent &WXUNUSED(event)) {
 		fredChoice->Clear();
 	}
 
-	if ( ProMan::GetProfileManager()->ProfileRead(PRO_CFG_TC_ROOT_FOLDER, &tcPath) ) {
+	if ( ProMan::GetProfileManager()->ProfileRead(PKEY_TC_ROOT_FOLDER, &tcPath) ) {
 		wxLogInfo(_T("The current game root folder is %s"), tcPath.c_str());
 		tcFolder->ChangeValue(tcPath);
 
@@ -930,7 +1260,7 @@ void BasicSettingsPage::OnTCChanged(wxCommandEvent &WXUNUSED(event)) {
 			}
 
 			// set selection to profile entry for current binary if there is one, noting if selected binary can't be found
-			bool hasBinary = ProMan::GetProfileManager()->ProfileRead(PRO_CFG_TC_CURRENT_BINARY, &binaryName);
+			bool hasBinary = ProMan::GetProfileManager()->ProfileRead(PKEY_TC_CURRENT_BINARY, &binaryName);
 			if ( hasBinary && !exeChoice->FindAndSetSelectionWithClientData(binaryName) ) {
 				// no need for a warning, since classes handling the EVT_TC_BINARY_CHANGED will issue warnings
 				wxLogDebug(_T("BasicSettingsPage::OnTCChanged(): couldn't find selected FSO executable %s in list of executables"),
@@ -941,7 +1271,7 @@ void BasicSettingsPage::OnTCChanged(wxCommandEvent &WXUNUSED(event)) {
 				// set selection to profile entry for current FRED binary if there is one,
 				// noting if the FRED binary can't be found
 				bool hasFredBinary =
-					ProMan::GetProfileManager()->ProfileRead(PRO_CFG_TC_CURRENT_FRED, &fredBinaryName);
+					ProMan::GetProfileManager()->ProfileRead(PKEY_TC_CURRENT_FRED, &fredBinaryName);
 				if ( hasFredBinary && !fredChoice->FindAndSetSelectionWithClientData(fredBinaryName) ) {
 					// no need for a warning, since classes handling the EVT_TC_FRED_BINARY_CHANGED will issue warnings
 					wxLogDebug(_T("BasicSettingsPage::OnTCChanged(): couldn't find selected FRED executable %s in list of executables"),
@@ -952,19 +1282,11 @@ void BasicSettingsPage::OnTCChanged(wxCommandEvent &WXUNUSED(event)) {
 		wxLogDebug(_T("The current root folder is %s."), this->isTcRootFolderValid ? _T("valid") : _T("invalid"));
 	} else {
 		wxLogDebug(_T("The current profile has no entry for root folder."));
+		tcFolder->ChangeValue(wxEmptyString);
 		this->isTcRootFolderValid = false;
 		this->DisableExecutableChoiceControls(MISSING_TC_ROOT_FOLDER);
 	}
 	this->GetSizer()->Layout();
-
-	// TCManager::CurrentProfileChanged() (which calls TCManager::GenerateTCChanged())
-	// assumes that TCManager::GenerateTCBinaryChanged() is called here unconditionally
-	TCManager::GenerateTCBinaryChanged();
-	// TCManager::CurrentProfileChanged() also assumes that TCManager::GenerateTCFredBinaryChanged()
-	// is called here unconditionally if FRED launching is enabled
-	if (fredEnabled) {
-		TCManager::GenerateTCFredBinaryChanged();
-	}
 }
 
 /** Puts the pretty description of all of the executables in the TCs folder
@@ -1031,7 +1353,7 @@ void BasicSettingsPage::OnPressExecutableChoiceRefreshButton(wxCommandEvent &WXU
 		_T("Cannot find executable choice control"));
 
 	wxString tcPath, binaryName;
-	wxCHECK_RET(ProMan::GetProfileManager()->ProfileRead(PRO_CFG_TC_ROOT_FOLDER, &tcPath),
+	wxCHECK_RET(ProMan::GetProfileManager()->ProfileRead(PKEY_TC_ROOT_FOLDER, &tcPath),
 		_T("OnPressExecutableChoiceRefreshButton: root folder entry not found"));
 	
 	if (!wxFileName::DirExists(tcPath)) {
@@ -1058,7 +1380,7 @@ void BasicSettingsPage::OnPressExecutableChoiceRefreshButton(wxCommandEvent &WXU
 	} else {
 		// set selection to profile entry for current binary if there is one,
 		// noting if selected binary can't be found and could be found before or vice versa
-		if (ProMan::GetProfileManager()->ProfileRead(PRO_CFG_TC_CURRENT_BINARY, &binaryName)) {
+		if (ProMan::GetProfileManager()->ProfileRead(PKEY_TC_CURRENT_BINARY, &binaryName)) {
 			bool exeFound = exeChoice->FindAndSetSelectionWithClientData(binaryName);
 			if (!exeFound && this->isCurrentBinaryValid) {
 				wxLogDebug(_T("OnPressExecutableChoiceRefresh: couldn't find selected FSO executable %s in list of executables"),
@@ -1102,7 +1424,7 @@ void BasicSettingsPage::OnPressFredExecutableChoiceRefreshButton(wxCommandEvent
 		_T("Cannot find FRED executable choice control"));
 
 	wxString tcPath, fredBinaryName;
-	wxCHECK_RET(ProMan::GetProfileManager()->ProfileRead(PRO_CFG_TC_ROOT_FOLDER, &tcPath),
+	wxCHECK_RET(ProMan::GetProfileManager()->ProfileRead(PKEY_TC_ROOT_FOLDER, &tcPath),
 		_T("OnPressFredExecutableChoiceRefreshButton: root folder entry not found"));
 	
 	if (!wxFileName::DirExists(tcPath)) {
@@ -1119,7 +1441,7 @@ void BasicSettingsPage::OnPressFredExecutableChoiceRefreshButton(wxCommandEvent
 
 	// set selection to profile entry for current FRED binary if there is one,
 	// noting if selected FRED binary can't be found and could be found before or vice versa
-	if (ProMan::GetProfileManager()->ProfileRead(PRO_CFG_TC_CURRENT_FRED, &fredBinaryName)) {
+	if (ProMan::GetProfileManager()->ProfileRead(PKEY_TC_CURRENT_FRED, &fredBinaryName)) {
 		bool fredExeFound = fredChoice->FindAndSetSelectionWithClientData(fredBinaryName);
 		if (!fredExeFound && this-isCurrentFredBinaryValid) {
 			wxLogDebug(_T("OnPressFredExecutableChoiceRefresh: couldn't find selected FRED exec %s in list of executables"),
@@ -1158,11 +1480,18 @@ void BasicSettingsPage::InitializeMemberVariables() {
 	this->joystickDetectButton = NULL;
 #if IS_WIN32
 	this->joystickCalibrateButton = NULL;
+#endif
+#if IS_LINUX
+	this->cpuAffinityText = NULL;
+	this->niceSpin = NULL;
+	this->ioClassChoice = NULL;
+	this->ioPriorityChoice = NULL;
 #endif
 	this->isTcRootFolderValid = false;
 	this->isCurrentBinaryValid = false;
 	this->isCurrentFredBinaryValid = false;
-	
+	this->deviceDetectionPass = 0;
+	this->isSoundDevicePlaceholderShown = false;
 }
 
 /** Disables the executable choice and refresh button controls, such as would occur
@@ -1170,7 +1499,7 @@ void BasicSettingsPage::InitializeMemberVariables() {
 void BasicSettingsPage::DisableExecutableChoiceControls(const ReasonForExecutableDisabling reason) {
 
 	wxString tcFolderPath;
-	bool hasTcPath = ProMan::GetProfileManager()->ProfileRead(PRO_CFG_TC_ROOT_FOLDER, &tcFolderPath);
+	bool hasTcPath = ProMan::GetProfileManager()->ProfileRead(PKEY_TC_ROOT_FOLDER, &tcFolderPath);
 	wxCHECK_RET(hasTcPath || (reason == MISSING_TC_ROOT_FOLDER),
 		_T("DisableChoiceExecutableControls: profile has no root folder entry, but reason is not a missing root folder"));
 	wxCHECK_RET((!hasTcPath) || (reason != MISSING_TC_ROOT_FOLDER),
@@ -1242,90 +1571,69 @@ void BasicSettingsPage::SetUpResolution(const long minHorizRes, const long minVe
 		// selection box correctly
 		return;
 	}
-	ProMan* proman = ProMan::GetProfileManager();
 	
 	wxChoice* resolutionCombo = dynamic_cast<wxChoice*>(
 		wxWindow::FindWindowById(ID_RESOLUTION_COMBO, this));
 	wxCHECK_RET(resolutionCombo != NULL, _T("Unable to find resolution combo"));
 	
-	FillResolutionDropBox(resolutionCombo, minHorizRes, minVertRes);
-	
-	long width = 0, height = 0;
-
-	const wxString& shortname(activeMod->shortname);
-	
-	bool hasValidRes = false;
-	wxString resString;
+	ResolutionMan::ResolutionArray resolutions;
+	ResolutionMap::GetModesForActiveMod(resolutions);
+	for (size_t i = 0; i < resolutions.GetCount(); ++i) {
+		// the combo owns the Resolution objects from here on
+		resolutionCombo->Append(resolutions[i]->GetResString(), resolutions[i]);
+	}
+	this->resolutionListMod = activeMod->shortname;
 	
-	// first try reading from ResolutionMap
-	const ResolutionData* resDataPtr = ResolutionMap::ResolutionRead(shortname);
-		
-	if (resDataPtr != NULL) {
-		width = resDataPtr->width;
-		height = resDataPtr->height;
-		
-		resString =
+	if (resolutions.IsEmpty()) {
+		wxMessageBox(
 			wxString::Format(
-				CFG_RES_FORMAT_STRING,
-				static_cast<int>(width),
-				static_cast<int>(height));
-		hasValidRes = resolutionCombo->SetStringSelection(resString);
-	}
-
-	// then try reading resolution from profile
-	if (!hasValidRes) {
-		if (!resString.IsEmpty()) {
-			wxLogDebug(_T("map resolution %s not found, attempting to use profile value"),
-				resString.c_str());
-			resString.Clear();
-		} else {
-			wxLogDebug(_T("no resolution found in map, attempting to use profile value"));
-		}
+				_T("Your system does not support the minimum resolution needed to play this mod (%ldx%ld)."),
+				minHorizRes, minVertRes),
+			_T("Mod not supported"), wxOK | wxICON_ERROR);
+		return;
+	}
+	this->SelectResolution();
+}
 
-		bool hasResWidth = proman->ProfileRead(PRO_CFG_VIDEO_RESOLUTION_WIDTH, &width);
-		bool hasResHeight = proman->ProfileRead(PRO_CFG_VIDEO_RESOLUTION_HEIGHT, &height);
-		
-		if (hasResWidth && hasResHeight) {
-			resString =
-				wxString::Format(
-					CFG_RES_FORMAT_STRING,
-					static_cast<int>(width),
-					static_cast<int>(height));
-			hasValidRes = resolutionCombo->SetStringSelection(resString);
-		}
+/** Selects the active mod's resolution in the resolution list. The list
+ only depends on the active mod and the binary, so it is kept when the
+ profile changes and only the selection is made again. */
+void BasicSettingsPage::SelectResolution() {
+	const ModItem* activeMod = ModList::GetActiveMod();
+	if (activeMod == NULL || !FlagListManager::GetFlagListManager()->IsProcessingOK()
+		|| activeMod->shortname != this->resolutionListMod) {
+		return; // the list is empty or about to be refilled
 	}
 	
-	// last resort, use default (max supported resolution)
-	if (!hasValidRes) {
-		if (!resString.IsEmpty()) {
-			wxLogDebug(_T("resolution map value %s not found, using default max supported resolution"),
-				resString.c_str());
-		} else {
-			wxLogDebug(_T("no resolution found in map, using default max supported resolution"));
-		}
-		
-		int maxResIndex = GetMaxSupportedResolution(*resolutionCombo, width, height);
-		
-		if (maxResIndex != wxNOT_FOUND) {
-			resolutionCombo->SetSelection(maxResIndex);
-		} else {
-			const wxString InsufficientResolutionMsg(
-				wxString::Format(
-					_T("Your system does not support the minimum resolution needed to play this mod (%ldx%ld)."),
-						minHorizRes, minVertRes));
-			
-			wxLogError(InsufficientResolutionMsg);
-			wxMessageBox(InsufficientResolutionMsg, _T("Mod not supported"), wxOK | wxICON_ERROR);
-			
-			return;
+	wxChoice* resolutionCombo = dynamic_cast<wxChoice*>(
+		wxWindow::FindWindowById(ID_RESOLUTION_COMBO, this));
+	wxCHECK_RET(resolutionCombo != NULL, _T("Unable to find resolution combo"));
+	
+	if (!resolutionCombo->HasClientObjectData()) {
+		return; // showing "Detecting..."
+	}
+	// still owned by the combo
+	ResolutionMan::ResolutionArray resolutions;
+	for (unsigned int i = 0; i < resolutionCombo->GetCount(); ++i) {
+		ResolutionMan::Resolution* resolution = dynamic_cast<ResolutionMan::Resolution*>(
+			resolutionCombo->GetClientObject(i));
+		if (resolution != NULL) {
+			resolutions.Add(resolution);
 		}
 	}
 	
-	// update profile and ResolutionMap
-	proman->ProfileWrite(PRO_CFG_VIDEO_RESOLUTION_WIDTH, width);
-	proman->ProfileWrite(PRO_CFG_VIDEO_RESOLUTION_HEIGHT, height);
+	// LaunchPipeline may already have picked one, while the page wasn't built
+	if (resolutions.IsEmpty() || !ResolutionMap::ChooseForActiveMod(resolutions)) {
+		return;
+	}
 	
-	ResolutionMap::ResolutionWrite(shortname, ResolutionData(width, height));
+	const ResolutionData* resDataPtr = ResolutionMap::ResolutionRead(activeMod->shortname);
+	wxCHECK_RET(resDataPtr != NULL, _T("SelectResolution: no map entry after choosing one"));
+	resolutionCombo->SetStringSelection(
+		wxString::Format(
+			CFG_RES_FORMAT_STRING,
+			static_cast<int>(resDataPtr->width),
+			static_cast<int>(resDataPtr->height)));
 }
 
 /** Adjust the resolution drop down box according to the active mod's restrictions. */
@@ -1347,7 +1655,7 @@ void BasicSettingsPage::OnActiveModChanged(wxCommandEvent& event) {
 void BasicSettingsPage::OnCurrentBinaryChanged(wxCommandEvent& event) {
 	wxString tcPath, binaryName;
 
-	if (!ProMan::GetProfileManager()->ProfileRead(PRO_CFG_TC_ROOT_FOLDER, &tcPath)) {
+	if (!ProMan::GetProfileManager()->ProfileRead(PKEY_TC_ROOT_FOLDER, &tcPath)) {
 		this->isCurrentBinaryValid = false;
 		this->ShowSettings(this->isCurrentBinaryValid);
 		return;
@@ -1360,7 +1668,17 @@ void BasicSettingsPage::OnCurrentBinaryChanged(wxCommandEvent& event) {
 		return;
 	}
 	
-	bool hasBinary = ProMan::GetProfileManager()->ProfileRead(PRO_CFG_TC_CURRENT_BINARY, &binaryName);
+	bool hasBinary = ProMan::GetProfileManager()->ProfileRead(PKEY_TC_CURRENT_BINARY, &binaryName);
+
+	// a profile switch that keeps the root folder skips OnTCChanged(),
+	// which is what normally selects the binary in the list
+	ExeChoice* exeChoice = dynamic_cast<ExeChoice*>(
+		wxWindow::FindWindowById(ID_EXE_CHOICE_BOX, this));
+	if (exeChoice != NULL && exeChoice->IsEnabled()
+		&& (!hasBinary || !exeChoice->FindAndSetSelectionWithClientData(binaryName))) {
+		exeChoice->SetSelection(wxNOT_FOUND);
+	}
+
 	this->isCurrentBinaryValid =
 		this->isTcRootFolderValid && hasBinary && wxFileName::FileExists(tcPath + wxFileName::GetPathSeparator() + binaryName);
 
@@ -1383,7 +1701,7 @@ void BasicSettingsPage::OnCurrentFredBinaryChanged(wxCommandEvent& event) {
 
 	wxString tcPath, fredBinaryName;
 
-	if (!ProMan::GetProfileManager()->ProfileRead(PRO_CFG_TC_ROOT_FOLDER, &tcPath)) {
+	if (!ProMan::GetProfileManager()->ProfileRead(PKEY_TC_ROOT_FOLDER, &tcPath)) {
 		this->isCurrentFredBinaryValid = false;
 		return;
 	}
@@ -1393,7 +1711,15 @@ void BasicSettingsPage::OnCurrentFredBinaryChanged(wxCommandEvent& event) {
 		return;
 	}
 
-	bool hasFredBinary = ProMan::GetProfileManager()->ProfileRead(PRO_CFG_TC_CURRENT_FRED, &fredBinaryName);
+	bool hasFredBinary = ProMan::GetProfileManager()->ProfileRead(PKEY_TC_CURRENT_FRED, &fredBinaryName);
+
+	ExeChoice* fredChoice = dynamic_cast<ExeChoice*>(
+		wxWindow::FindWindowById(ID_EXE_FRED_CHOICE_BOX, this));
+	if (fredChoice != NULL && fredChoice->IsEnabled()
+		&& (!hasFredBinary || !fredChoice->FindAndSetSelectionWithClientData(fredBinaryName))) {
+		fredChoice->SetSelection(wxNOT_FOUND);
+	}
+
 	this->isCurrentFredBinaryValid =
 		this->isTcRootFolderValid && hasFredBinary && wxFileName::FileExists(tcPath + wxFileName::GetPathSeparator() + fredBinaryName);
 
@@ -1421,84 +1747,6 @@ void BasicSettingsPage::ShowSettings(const bool showSettings) {
 	}
 }
 
-void BasicSettingsPage::FillResolutionDropBox(wxChoice *resChoice,
-	const long minHorizontalRes, const long minVerticalRes)
-{
-	ResolutionMan::ResolutionArray resolutions;
-	ResolutionMan::ApiType apiType;
-	auto flagListManager = FlagListManager::GetFlagListManager();
-
-	if (flagListManager->IsProcessingOK()) {
-#if IS_WIN32
-		// If the current executable is a SDL exe, use that API
-		if (flagListManager->GetBuildCaps() & BUILD_CAP_SDL) {
-			apiType = ResolutionMan::API_SDL;
-		} else {
-			apiType = ResolutionMan::API_WIN32;
-		}
-#else
-		// OSX and Linux always use the SDL api
-		apiType = ResolutionMan::API_SDL;
-#endif
-		ResolutionMan::EnumerateGraphicsModes(apiType, resolutions,
-			minHorizontalRes, minVerticalRes);
-
-		for (auto it = resolutions.begin(), end = resolutions.end();
-			it != end; ++it)
-		{
-			auto p = dynamic_cast<ResolutionMan::Resolution*>(*it);
-			resChoice->Append(p->GetResString(), p);
-		}
-	}
-}
-
-/** Takes a resolution drop down box, finds the maximum resolution, updates the provided
-    width and height variables, and returns the index at which the maximum resolution
-    was found, returning wxNOT_FOUND on error. */
-int BasicSettingsPage::GetMaxSupportedResolution(const wxChoice& resChoice, long& width, long& height) {
-	if (resChoice.IsEmpty()) {
-		wxLogError(_T("GetMaxSupportedResolution() given empty resChoice."));
-		return wxNOT_FOUND;
-	}
-	
-	int maxResIndex = -1;
-	int maxResProduct = 0;
-	ResolutionMan::Resolution* res;
-
-	for (unsigned int i = 0; i < resChoice.GetCount(); ++i) {
-		res = dynamic_cast<ResolutionMan::Resolution*>(
-			resChoice.GetClientObject(i));
-		wxCHECK_MSG(res != NULL, wxNOT_FOUND,
-			wxString::Format(
-				_T("choice does not have Resolution object at index %u"), i));
-
-		// We could store somewhere the highest resolutions for each
-		// aspect ratio but 'n' is pretty small, so it is not
-		// worth the space or complexity tradeoff
-		if (!res->IsHeader()) {
-			int resProduct = res->GetWidth() * res->GetHeight();
-			if (resProduct > maxResProduct) {
-				maxResIndex = i;
-				maxResProduct = resProduct;
-			}
-		}
-	}
-	
-	wxCHECK_MSG(maxResIndex > -1, wxNOT_FOUND,
-		_T("maximum Resolution was not found"));
-	
-	res = dynamic_cast<ResolutionMan::Resolution*>(
-		resChoice.GetClientObject(maxResIndex));
-	wxCHECK_MSG(res != NULL, wxNOT_FOUND,
-		_T("Choice is missing max Resolution object"));
-	width = res->GetWidth();
-	height = res->GetHeight();
-	
-	wxLogDebug(_T("Found max resolution of %s at index %d"),
-		res->GetResString().c_str(), maxResIndex);
-	return maxResIndex;
-}
-
 void BasicSettingsPage::OnSelectVideoResolution(
 	wxCommandEvent &WXUNUSED(event))
 {
@@ -1775,8 +2023,28 @@ void BasicSettingsPage::OnDownloadOpenAL(wxCommandEvent &WXUNUSED(event)) {
 	this->OpenNonSCPWebSite(_T("http://connect.creativelabs.com/openal/Downloads/Forms/AllItems.aspx"));
 }
 
+/** Fills in the sound devices that were waiting for the probe, which only
+ runs when nothing was cached for the OpenAL library. */
+void BasicSettingsPage::OnOpenALProbeDone(wxCommandEvent& WXUNUSED(event)) {
+	const bool isChanged = OpenALMan::FinishProbe();
+
+	if (this->isSoundDevicePlaceholderShown) {
+		this->soundDeviceCombo->Clear();
+		this->soundDeviceCombo->Enable();
+		this->openALVersion->SetLabel(wxEmptyString);
+		this->isSoundDevicePlaceholderShown = false;
+	} else if (isChanged) {
+		this->soundDeviceCombo->Clear();
+		this->captureDeviceCombo->Clear();
+	} else {
+		return;
+	}
+	this->SetupOpenALSection();
+}
+
 void BasicSettingsPage::OnDetectOpenAL(wxCommandEvent& WXUNUSED(event)) {
-	if ( !OpenALMan::IsInitialized() ) {
+	// while detection is pending, its OpenAL step will do the setup
+	if ( !OpenALMan::IsInitialized() && !this->isSoundDevicePlaceholderShown ) {
 		this->SetupOpenALSection();
 	}
 }
@@ -1841,6 +2109,20 @@ void BasicSettingsPage::InitializeSoundDeviceDropDownBox(
 	// update device drop down box and select a device
 	deviceDropDownBox->Append(availableDevices);
 	
+	this->SelectSoundDeviceFromProfile(deviceDropDownBox,
+		deviceProfileEntryName, deviceTypeNameAdjustment, defaultDevice);
+}
+
+/** Selects the device stored under deviceProfileEntryName, in a drop down box
+ that already lists the available devices. If the profile has no device, the system default
+ (or else the first entry) is selected and written back to the profile. */
+void BasicSettingsPage::SelectSoundDeviceFromProfile(wxChoice* deviceDropDownBox,
+	const wxString& deviceProfileEntryName,
+	const wxString& deviceTypeNameAdjustment,
+	const wxString& defaultDevice) {
+	wxCHECK_RET(deviceDropDownBox != NULL && !deviceDropDownBox->IsEmpty(),
+		_T("Sound device drop down box is missing or empty"));
+
 	wxString device;
 	
 	if (ProMan::GetProfileManager()->ProfileRead(deviceProfileEntryName, &device)) {
@@ -1893,8 +2175,14 @@ void BasicSettingsPage::SetupOpenALSection() {
 		this->soundDeviceCombo->Disable();
 		this->detectOpenALButton->SetLabel(_("Redetect OpenAL"));
 		this->downloadOpenALButton->Enable();
+	} else if ( !OpenALMan::HasCapabilities() ) {
+		// nothing cached for this OpenAL; OnOpenALProbeDone() comes back here
+		if (this->openALVersion != NULL) {
+			this->openALVersion->SetLabel(_("Detecting OpenAL..."));
+		}
+		OpenALMan::StartProbe(this);
 	} else {
-		// have working openal
+		// have working openal, its devices from the cache or a probe
 		if (this->soundDeviceCombo->IsEmpty()) {
 			this->InitializeSoundDeviceDropDownBox(PLAYBACK);
 		}
@@ -1906,31 +2194,6 @@ void BasicSettingsPage::SetupOpenALSection() {
 				this->InitializeSoundDeviceDropDownBox(CAPTURE);
 			}
 			
-			wxCheckBox* efxCheckBox = dynamic_cast<wxCheckBox*>(
-				wxWindow::FindWindowById(ID_ENABLE_EFX, this));
-			wxCHECK_RET(efxCheckBox != NULL,
-				_T("Cannot find enable EFX checkbox."));
-			
-			bool enableEFX;
-			ProMan::GetProfileManager()->ProfileRead(
-				PRO_CFG_OPENAL_EFX, &enableEFX, false);
-			efxCheckBox->SetValue(enableEFX);
-			
-			long sampleRate;
-			ProMan::GetProfileManager()->ProfileRead(
-				PRO_CFG_OPENAL_SAMPLE_RATE,
-				&sampleRate,
-				DEFAULT_AUDIO_OPENAL_SAMPLE_RATE);
-			
-			wxTextCtrl* sampleRateBox = dynamic_cast<wxTextCtrl*>(
-				wxWindow::FindWindowById(ID_AUDIO_SAMPLE_RATE, this));
-			wxCHECK_RET(sampleRateBox != NULL,
-				_T("Cannot find sample rate text ctrl."));
-			
-			if (sampleRate != DEFAULT_AUDIO_OPENAL_SAMPLE_RATE) {
-				sampleRateBox->ChangeValue(wxString::Format(_T("%ld"), sampleRate));
-			}
-			
 			this->soundDeviceText->SetLabel(_("Playback device:"));
 
 			if (this->audioOldSoundSizer->GetItem(this->soundDeviceText) != NULL) {
@@ -1949,14 +2212,7 @@ void BasicSettingsPage::SetupOpenALSection() {
 			this->audioSizer->Hide(this->audioOldSoundSizer, true);
 			this->audioSizer->Show(this->audioNewSoundSizer, true);
 			
-			const wxString playbackDevice(this->soundDeviceCombo->GetStringSelection());
-			if (!OpenALMan::IsEFXSupported(playbackDevice)) {
-				wxLogDebug(
-					_T("Playback device '%s' does not support EFX.")
-					_T(" Hiding Enable EFX checkbox."),
-						playbackDevice.c_str());
-				this->audioNewSoundSizer->Hide(efxCheckBox);
-			}
+			this->ReadOpenALSettingsFromProfile();
 			
 			if (this->captureDeviceCombo->IsEmpty()) {
 				this->audioNewSoundDeviceSizer->Hide(this->captureDeviceCombo);
@@ -2032,6 +2288,44 @@ void BasicSettingsPage::SetupOpenALSection() {
 	}
 }
 
+/** Puts the profile's EFX and sample rate settings into the new sound code's
+ controls, showing Enable EFX only if the selected playback device has EFX. */
+void BasicSettingsPage::ReadOpenALSettingsFromProfile() {
+	wxCheckBox* efxCheckBox = dynamic_cast<wxCheckBox*>(
+		wxWindow::FindWindowById(ID_ENABLE_EFX, this));
+	wxCHECK_RET(efxCheckBox != NULL,
+		_T("Cannot find enable EFX checkbox."));
+	
+	bool enableEFX;
+	ProMan::GetProfileManager()->ProfileRead(
+		PRO_CFG_OPENAL_EFX, &enableEFX, false);
+	efxCheckBox->SetValue(enableEFX);
+	
+	long sampleRate;
+	ProMan::GetProfileManager()->ProfileRead(
+		PRO_CFG_OPENAL_SAMPLE_RATE,
+		&sampleRate,
+		DEFAULT_AUDIO_OPENAL_SAMPLE_RATE);
+	
+	wxTextCtrl* sampleRateBox = dynamic_cast<wxTextCtrl*>(
+		wxWindow::FindWindowById(ID_AUDIO_SAMPLE_RATE, this));
+	wxCHECK_RET(sampleRateBox != NULL,
+		_T("Cannot find sample rate text ctrl."));
+	
+	sampleRateBox->ChangeValue((sampleRate != DEFAULT_AUDIO_OPENAL_SAMPLE_RATE)
+		? wxString::Format(_T("%ld"), sampleRate) : wxString());
+	
+	const wxString playbackDevice(this->soundDeviceCombo->GetStringSelection());
+	const bool isEFXSupported = OpenALMan::IsEFXSupported(playbackDevice);
+	if (!isEFXSupported) {
+		wxLogDebug(
+			_T("Playback device '%s' does not support EFX.")
+			_T(" Hiding Enable EFX checkbox."),
+				playbackDevice.c_str());
+	}
+	this->audioNewSoundSizer->Show(efxCheckBox, isEFXSupported);
+}
+
 void BasicSettingsPage::OpenNonSCPWebSite(wxString url) {
 	::wxLaunchDefaultBrowser(url);
 }
@@ -2064,24 +2358,7 @@ void BasicSettingsPage::SetupJoystickSection() {
 	}
 	else
 	{
-		JoyMan::ApiType apiType;
-
-#if IS_APPLE || IS_LINUX
-		// Unix always uses SDL
-		apiType = JoyMan::API_SDL;
-#else
-		// If the current executable is a SDL exe, use that API
-		if (FlagListManager::GetFlagListManager()->GetBuildCaps() & BUILD_CAP_SDL)
-		{
-			apiType = JoyMan::API_SDL;
-		}
-		else
-		{
-			apiType = JoyMan::API_NATIVE;
-		}
-#endif
-
-		if (!JoyMan::Initialize(apiType)) {
+		if (!JoyMan::Initialize(GetJoystickApi())) {
 			this->joystickSelected->Disable();
 			this->joystickSelected->Append(_("Initialize Failed"));
 			this->joystickForceFeedback->Disable();
@@ -2112,46 +2389,52 @@ void BasicSettingsPage::SetupJoystickSection() {
 #endif
 			}
 			else {
-				long profileJoystick;
-				unsigned int i;
 				this->joystickSelected->Enable();
 #if IS_WIN32
 				this->joystickDetectButton->Enable();
 #endif
-				ProMan::GetProfileManager()->
-					ProfileRead(PRO_CFG_JOYSTICK_ID,
-						&profileJoystick,
-						DEFAULT_JOYSTICK_ID,
-						true);
-				// set current joystick
-				for (i = 0; i < this->joystickSelected->GetCount(); i++) {
-					JoyNumber* data = dynamic_cast<JoyNumber*>(
-						this->joystickSelected->GetClientObject(i));
-					wxCHECK2_MSG(data != NULL, continue,
-						_T("JoyNumber is not the clientObject in joystickSelected"));
-
-					if (profileJoystick == data->GetNumber()) {
-						this->joystickSelected->SetSelection(i);
-						this->SetupControlsForJoystick(i);
-						return; // All joystick controls are now setup
-					}
-				}
-				// Getting here means that the joystick is no longer installed
-				// or is not plugged in
-				if (JoyMan::IsJoystickPluggedIn(profileJoystick)) {
-					wxLogWarning(_T("Last selected joystick is not plugged in"));
-				}
-				else {
-					wxLogWarning(_T("Last selected joystick does not seem to be installed"));
-				}
-				// set to no joystick (the first selection)
-				this->joystickSelected->SetSelection(0);
-				this->SetupControlsForJoystick(0);
+				this->SelectJoystickFromProfile();
 			}
 		}
 	}
 }
 
+/** Selects the profile's joystick in the list of plugged in joysticks,
+ falling back to no joystick if it is not there. */
+void BasicSettingsPage::SelectJoystickFromProfile() {
+	long profileJoystick;
+	unsigned int i;
+	ProMan::GetProfileManager()->
+		ProfileRead(PRO_CFG_JOYSTICK_ID,
+			&profileJoystick,
+			DEFAULT_JOYSTICK_ID,
+			true);
+	// set current joystick
+	for (i = 0; i < this->joystickSelected->GetCount(); i++) {
+		JoyNumber* data = dynamic_cast<JoyNumber*>(
+			this->joystickSelected->GetClientObject(i));
+		wxCHECK2_MSG(data != NULL, continue,
+			_T("JoyNumber is not the clientObject in joystickSelected"));
+
+		if (profileJoystick == data->GetNumber()) {
+			this->joystickSelected->SetSelection(i);
+			this->SetupControlsForJoystick(i);
+			return; // All joystick controls are now setup
+		}
+	}
+	// Getting here means that the joystick is no longer installed
+	// or is not plugged in
+	if (JoyMan::IsJoystickPluggedIn(profileJoystick)) {
+		wxLogWarning(_T("Last selected joystick is not plugged in"));
+	}
+	else {
+		wxLogWarning(_T("Last selected joystick does not seem to be installed"));
+	}
+	// set to no joystick (the first selection)
+	this->joystickSelected->SetSelection(0);
+	this->SetupControlsForJoystick(0);
+}
+
 void BasicSettingsPage::SetupControlsForJoystick(unsigned int i) {
 	JoyNumber* joynumber = dynamic_cast<JoyNumber*>(
 		this->joystickSelected->GetClientObject(i));
@@ -2215,8 +2498,132 @@ void BasicSettingsPage::OnCalibrateJoystick(
 void BasicSettingsPage::OnDetectJoystick(wxCommandEvent &WXUNUSED(event)) {
 		if ( JoyMan::DeInitialize() ) {
 			this->SetupJoystickSection();
+			JoyMan::StartHotplugMonitor(this);
+			// joystick numbering (and so the pushed GUID) may have changed
+			LaunchPipeline::Get()->Invalidate();
+		}
+}
+
+/** The native joysticks have been read, so fill in the joystick controls. */
+void BasicSettingsPage::OnJoystickProbeDone(wxCommandEvent& WXUNUSED(event)) {
+	this->PostDeviceDetectionStep(DETECT_JOYSTICK);
+}
+
+/** Adds or removes the one joystick that was plugged in or unplugged,
+ renumbering the entries after it to match JoyMan. */
+void BasicSettingsPage::OnJoystickHotplug(wxCommandEvent& event) {
+	unsigned int index;
+	const JoyMan::HotplugChange change = JoyMan::ApplyHotplugEvent(event, index);
+	if (change == JoyMan::HOTPLUG_NONE) {
+		return;
+	}
+	if (!this->joystickSelected->HasClientObjectData()) {
+		return; // showing "Detecting...", the list is rebuilt from JoyMan soon
+	}
+
+	const int selection = this->joystickSelected->GetSelection();
+	int selectedJoystick = DEFAULT_JOYSTICK_ID;
+	if (selection != wxNOT_FOUND) {
+		JoyNumber* data = dynamic_cast<JoyNumber*>(
+			this->joystickSelected->GetClientObject(selection));
+		wxCHECK_RET(data != NULL,
+			_T("joystickSelected does not have JoyNumber as clientdata"));
+		selectedJoystick = data->GetNumber();
+	}
+
+	// "No Joystick" is always first
+	unsigned int insertAt = this->joystickSelected->GetCount();
+	int newSelection = (selection == wxNOT_FOUND) ? 0 : selection;
+	bool isSelectionRenumbered = false;
+	for (unsigned int i = this->joystickSelected->GetCount(); i-- > 1; ) {
+		JoyNumber* data = dynamic_cast<JoyNumber*>(
+			this->joystickSelected->GetClientObject(i));
+		wxCHECK2_MSG(data != NULL, continue,
+			_T("JoyNumber is not the clientObject in joystickSelected"));
+		const int number = data->GetNumber();
+		if (number < static_cast<int>(index)) {
+			continue;
+		}
+
+		if (change == JoyMan::HOTPLUG_REMOVED && number == static_cast<int>(index)) {
+			this->joystickSelected->Delete(i);
+			if (static_cast<int>(i) == selection) {
+				newSelection = 0;
+			} else if (static_cast<int>(i) < newSelection) {
+				newSelection--;
+			}
+			continue;
+		}
+
+		const int renumbered = (change == JoyMan::HOTPLUG_ADDED) ? number + 1 : number - 1;
+		this->joystickSelected->SetClientObject(i, new JoyNumber(renumbered));
+		if (change == JoyMan::HOTPLUG_ADDED) {
+			insertAt = i;
+		}
+		if (number == selectedJoystick) {
+			isSelectionRenumbered = true;
 		}
+	}
+
+	if (change == JoyMan::HOTPLUG_ADDED) {
+		this->joystickSelected->Insert(JoyMan::JoystickName(index), insertAt,
+			new JoyNumber(index));
+		if (selection != wxNOT_FOUND && static_cast<int>(insertAt) <= newSelection) {
+			newSelection++;
+		}
+	}
+
+	if (this->joystickSelected->GetCount() > 1) {
+		this->joystickSelected->Enable();
+	} else {
+		this->joystickSelected->Disable();
+	}
+	this->joystickSelected->SetSelection(newSelection);
+	if (newSelection != selection || isSelectionRenumbered) {
+		// also saves the selected joystick's new number to the profile
+		this->SetupControlsForJoystick(newSelection);
+	}
+
+	// joystick numbering (and so the pushed GUID) has changed
+	LaunchPipeline::Get()->Invalidate();
+}
+
+#if IS_LINUX
+/** Only a valid CPU list is saved; an invalid one is shown in red until
+ it is fixed. */
+void BasicSettingsPage::OnChangeCpuAffinity(wxCommandEvent& WXUNUSED(event)) {
+	const wxString cpus(this->cpuAffinityText->GetValue());
+	std::vector<int> cpuNumbers;
+	const bool isValid = ProcessPriority::ParseCpuList(cpus, cpuNumbers)
+		&& (cpus.IsEmpty() || !cpuNumbers.empty());
+	this->cpuAffinityText->SetForegroundColour(isValid ?
+		wxSystemSettings::GetColour(wxSYS_COLOUR_WINDOWTEXT) : *wxRED);
+	this->cpuAffinityText->Refresh();
+	if (isValid) {
+		ProMan::GetProfileManager()->ProfileWrite(PRO_CFG_LAUNCH_CPU_AFFINITY, cpus);
+	}
+}
+
+void BasicSettingsPage::OnChangeNice(wxSpinEvent& WXUNUSED(event)) {
+	ProMan::GetProfileManager()->ProfileWrite(PRO_CFG_LAUNCH_NICE,
+		static_cast<long>(this->niceSpin->GetValue()));
+}
+
+void BasicSettingsPage::OnSelectIOClass(wxCommandEvent& WXUNUSED(event)) {
+	const int ioClass = this->ioClassChoice->GetSelection();
+	wxCHECK_RET(ioClass != wxNOT_FOUND, _T("No I/O class is selected"));
+	ProMan::GetProfileManager()->ProfileWrite(PRO_CFG_LAUNCH_IO_CLASS, static_cast<long>(ioClass));
+	this->ioPriorityChoice->Enable(ioClass == LAUNCH_IO_CLASS_REALTIME
+		|| ioClass == LAUNCH_IO_CLASS_BEST_EFFORT);
+}
+
+void BasicSettingsPage::OnSelectIOPriority(wxCommandEvent& WXUNUSED(event)) {
+	const int ioPriority = this->ioPriorityChoice->GetSelection();
+	wxCHECK_RET(ioPriority != wxNOT_FOUND, _T("No I/O priority is selected"));
+	ProMan::GetProfileManager()->ProfileWrite(PRO_CFG_LAUNCH_IO_PRIORITY,
+		static_cast<long>(ioPriority));
 }
+#endif
 
 //////////// ProxyChoice
 ProxyChoice::ProxyChoice(wxWindow *parent, wxWindowID id)
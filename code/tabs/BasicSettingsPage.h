@@ -22,6 +22,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include <vector>
 
 #include <wx/wx.h>
+#include <wx/spinctrl.h>
 
 #include "controls/TruncatableChoice.h"
 
@@ -66,12 +67,22 @@ public:
 	void OnChangeSampleRate(wxCommandEvent &event);
 	void OnDownloadOpenAL(wxCommandEvent& event);
 	void OnDetectOpenAL(wxCommandEvent& event);
+	void OnOpenALProbeDone(wxCommandEvent& event);
 
+	void OnJoystickProbeDone(wxCommandEvent& event);
 	void OnSelectJoystick(wxCommandEvent& event);
 	void OnCheckForceFeedback(wxCommandEvent& event);
 	void OnCheckDirectionalHit(wxCommandEvent& event);
 	void OnCalibrateJoystick(wxCommandEvent& event);
 	void OnDetectJoystick(wxCommandEvent& event);
+	void OnJoystickHotplug(wxCommandEvent& event);
+
+#if IS_LINUX
+	void OnChangeCpuAffinity(wxCommandEvent& event);
+	void OnChangeNice(wxSpinEvent& event);
+	void OnSelectIOClass(wxCommandEvent& event);
+	void OnSelectIOPriority(wxCommandEvent& event);
+#endif
 
 	void ProfileChanged(wxCommandEvent& event);
 	void OnFlagFileProcessingStatusChanged(wxCommandEvent& event);
@@ -86,8 +97,7 @@ private:
 	void SetUpResolution(
 		long minHorizRes = DEFAULT_MOD_RESOLUTION_MIN_HORIZONTAL_RES,
 		long minVertRes  = DEFAULT_MOD_RESOLUTION_MIN_VERTICAL_RES);
-	static void FillResolutionDropBox(wxChoice* resChoice, long minHorizRes, long minVertRes);
-	static int GetMaxSupportedResolution(const wxChoice& resChoice, long& width, long& height);
+	void SelectResolution();
 	
 	enum ReasonForExecutableDisabling {
 		MISSING_TC_ROOT_FOLDER,
@@ -96,6 +106,17 @@ private:
 	};
 	
 	void InitializeMemberVariables();
+	void CreateControls();
+	void UpdateVideoControls();
+#if IS_WIN32
+	void UpdateSpeechControls();
+#endif
+	void UpdateNetworkControls();
+	void UpdateAudioControls();
+	void UpdateJoystickControls();
+#if IS_LINUX
+	void UpdateSchedulingControls();
+#endif
 	void DisableExecutableChoiceControls(const ReasonForExecutableDisabling reason);
 	void OnCurrentBinaryChanged(wxCommandEvent& event);
 	void OnCurrentFredBinaryChanged(wxCommandEvent& event);
@@ -108,10 +129,28 @@ private:
 	};
 	
 	void InitializeSoundDeviceDropDownBox(const SoundDeviceType deviceType);
+	void SelectSoundDeviceFromProfile(wxChoice* deviceDropDownBox,
+		const wxString& deviceProfileEntryName,
+		const wxString& deviceTypeNameAdjustment,
+		const wxString& defaultDevice);
 	void SetupOpenALSection();
+	void ReadOpenALSettingsFromProfile();
 	void SetupJoystickSection();
+	void SelectJoystickFromProfile();
 	void SetupControlsForJoystick(unsigned int i);
 	
+	enum DeviceDetectionStep {
+		DETECT_OPENAL,
+		DETECT_JOYSTICK,
+		DETECT_RESOLUTION,
+		DETECT_DONE
+	};
+	
+	void BeginDeviceDetection();
+	void PostDeviceDetectionStep(const DeviceDetectionStep step);
+	void OnDeviceDetectionStep(wxCommandEvent& event);
+	void OnModesEnumerated(wxCommandEvent& event);
+	
 	DECLARE_EVENT_TABLE();
 
 private:
@@ -135,10 +174,19 @@ private:
 	wxButton* joystickDetectButton;
 #if IS_WIN32
 	wxButton* joystickCalibrateButton;
+#endif
+#if IS_LINUX
+	wxTextCtrl* cpuAffinityText;
+	wxSpinCtrl* niceSpin;
+	wxChoice* ioClassChoice;
+	wxChoice* ioPriorityChoice;
 #endif
 	bool isTcRootFolderValid;
 	bool isCurrentBinaryValid;
 	bool isCurrentFredBinaryValid;
+	long deviceDetectionPass; //!< bumped to drop the steps of an earlier pass
+	bool isSoundDevicePlaceholderShown;
+	wxString resolutionListMod; //!< shortname of the mod the resolution list is for
 };
 
 #endif
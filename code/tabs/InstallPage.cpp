@@ -19,7 +19,9 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include <wx/wx.h>
 #include <wx/filename.h>
 #include "global/ids.h"
+#include "global/ProfileKeys.h"
 #include "apis/ProfileManager.h"
+#include "apis/ModInstaller.h"
 #include "tabs/InstallPage.h"
 #include "apis/HelpManager.h"
 #include "generated/configure_launcher.h"
@@ -27,7 +29,72 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "global/MemoryDebugging.h" // Last include for memory debugging
 
 InstallPage::InstallPage(wxWindow* parent): wxPanel(parent, wxID_ANY) {
+	wxStaticBox* packageBox = new wxStaticBox(this, wxID_ANY, _("Install a mod from a file"));
+	wxStaticText* explanation = new wxStaticText(this, wxID_ANY,
+		_("Choose a mod's zip or 7z package to install it into the current game root folder, or to update a mod that is already installed. An install that is stopped continues where it stopped when the same package is installed again."));
+	explanation->Wrap(500);
+
+	wxStaticText* packageLabel = new wxStaticText(this, wxID_ANY, _("Package:"));
+	this->packageText = new wxTextCtrl(this, ID_INSTALL_PACKAGE_TEXT);
+	wxButton* browseButton = new wxButton(this, ID_INSTALL_BROWSE_BUTTON, _("Browse..."));
+	this->installButton = new wxButton(this, ID_INSTALL_BUTTON, _("Install"));
+	this->installButton->Disable();
+	this->statusText = new wxStaticText(this, wxID_ANY, wxEmptyString);
+
+	wxBoxSizer* packageSizer = new wxBoxSizer(wxHORIZONTAL);
+	packageSizer->Add(packageLabel, 0, wxALIGN_CENTER_VERTICAL|wxRIGHT, 5);
+	packageSizer->Add(this->packageText, wxSizerFlags().Proportion(1).Expand());
+	packageSizer->Add(browseButton, wxSizerFlags().Expand().Border(wxLEFT, 5));
+	packageSizer->Add(this->installButton, wxSizerFlags().Expand().Border(wxLEFT, 5));
+
+	wxStaticBoxSizer* installSizer = new wxStaticBoxSizer(packageBox, wxVERTICAL);
+	installSizer->Add(explanation, wxSizerFlags().Expand().Border(wxALL, 5));
+	installSizer->Add(packageSizer, wxSizerFlags().Expand().Border(wxALL, 5));
+	installSizer->Add(this->statusText, wxSizerFlags().Expand().Border(wxALL, 5));
+
+	wxBoxSizer* sizer = new wxBoxSizer(wxVERTICAL);
+	sizer->Add(installSizer, wxSizerFlags().Expand().Border(wxALL, 5));
+	this->SetSizer(sizer);
+	this->Layout();
+}
+
+void InstallPage::OnBrowse(wxCommandEvent &WXUNUSED(event)) {
+	wxFileDialog chooser(this, _("Choose a mod package"),
+		wxFileName(this->packageText->GetValue()).GetPath(), wxEmptyString,
+		ModInstaller::GetWildcard(), wxFD_OPEN | wxFD_FILE_MUST_EXIST);
+	if (chooser.ShowModal() == wxID_OK) {
+		this->packageText->SetValue(chooser.GetPath());
+	}
+}
+
+void InstallPage::OnPackageChanged(wxCommandEvent &WXUNUSED(event)) {
+	this->installButton->Enable(wxFileExists(this->packageText->GetValue()));
+}
+
+void InstallPage::OnInstall(wxCommandEvent &WXUNUSED(event)) {
+	const wxString package(this->packageText->GetValue());
+	wxString tcPath;
+	ProMan::GetProfileManager()->ProfileRead(PKEY_TC_ROOT_FOLDER, &tcPath);
+	if (tcPath.IsEmpty() || !wxFileName::DirExists(tcPath)) {
+		this->statusText->SetLabel(_("Choose a game root folder on the Basic Settings tab first."));
+		return;
+	}
+	if (!wxFileExists(package)) {
+		this->statusText->SetLabel(_("The package doesn't exist."));
+		return;
+	}
+
+	this->installButton->Disable();
+	this->statusText->SetLabel(_("Installing..."));
+	const InstallResult result(ModInstaller::Install(package, tcPath, this));
+	this->statusText->SetLabel(ModInstaller::FormatResult(result));
+	this->statusText->Wrap(500);
+	this->installButton->Enable();
+	this->Layout();
 }
 
 BEGIN_EVENT_TABLE(InstallPage, wxPanel)
+EVT_BUTTON(ID_INSTALL_BROWSE_BUTTON, InstallPage::OnBrowse)
+EVT_BUTTON(ID_INSTALL_BUTTON, InstallPage::OnInstall)
+EVT_TEXT(ID_INSTALL_PACKAGE_TEXT, InstallPage::OnPackageChanged)
 END_EVENT_TABLE()
\ No newline at end of file
@@ -25,6 +25,15 @@ class InstallPage: public wxPanel {
 public:
 	InstallPage(wxWindow* parent);
 
+	void OnBrowse(wxCommandEvent &event);
+	void OnInstall(wxCommandEvent &event);
+	void OnPackageChanged(wxCommandEvent &event);
+
+private:
+	wxTextCtrl* packageText;
+	wxButton* installButton;
+	wxStaticText* statusText;
+
 	DECLARE_EVENT_TABLE()
 };
 
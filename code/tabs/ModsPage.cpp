@@ -51,7 +51,7 @@ END_EVENT_TABLE()
 void ModsPage::OnTCChanged(wxCommandEvent &WXUNUSED(event)) {
 	wxString tcPath;
 
-	ProMan::GetProfileManager()->ProfileRead(PRO_CFG_TC_ROOT_FOLDER, &tcPath, wxEmptyString);
+	ProMan::GetProfileManager()->ProfileRead(PKEY_TC_ROOT_FOLDER, &tcPath);
 
 	wxSizer* currentSizer = this->GetSizer();
 	if ( currentSizer != NULL ) {
@@ -21,8 +21,6 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include <wx/valgen.h>
 #include <wx/valtext.h>
 #include <wx/datetime.h>
-#include <wx/sstream.h>
-#include <wx/tokenzr.h>
 
 #include "generated/configure_launcher.h"
 #include "tabs/WelcomePage.h"
@@ -33,8 +31,6 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 
 #include "global/MemoryDebugging.h" // Last include for memory debugging
 
-#define TIME_BETWEEN_NEWS_UPDATES			wxTimeSpan::Day()
-
 class CloneProfileDialog: public wxDialog {
 public:
 	CloneProfileDialog(wxWindow* parent);
@@ -110,6 +106,7 @@ EVT_CHOICE(ID_PROFILE_COMBO, WelcomePage::ProfileChanged)
 EVT_CHECKBOX(ID_NET_DOWNLOAD_NEWS, WelcomePage::OnDownloadNewsCheck)
 
 EVT_IDLE(WelcomePage::UpdateNews)
+EVT_COMMAND(wxID_NONE, EVT_NEWS_FETCHED, WelcomePage::OnNewsFetched)
 END_EVENT_TABLE()
 
 BEGIN_EVENT_TABLE(CloneProfileDialog, wxDialog)
@@ -119,7 +116,8 @@ EVT_CHECKBOX(ID_CLONE_PROFILE_CHECKBOX, CloneProfileDialog::OnClickCloneCheckbox
 END_EVENT_TABLE()
 
 WelcomePage::WelcomePage(wxWindow* parent):
-	wxPanel(parent, wxID_ANY), lastLinkInfo(NULL), needToUpdateNews(false)
+	wxPanel(parent, wxID_ANY), lastLinkInfo(NULL), needToUpdateNews(false),
+	newsFetcher(NewsFetcher::IsInitialized() ? new NewsFetcher(this) : NULL)
 {
 	ProMan* proman = ProMan::GetProfileManager();
 	SkinSystem::RegisterTCSkinChanged(this);
@@ -456,55 +454,124 @@ void WelcomePage::UpdateNews(wxIdleEvent& WXUNUSED(event)) {
 		return;
 	}
 	if (allowedToUpdateNews) {
-		const NewsSource& newsSource(SkinSystem::GetSkinSystem()->GetNewsSource());
-		const NewsData* newsData =
-			proman->NewsRead(newsSource.GetName());
-		
-		wxASSERT((newsData == NULL) || newsData->IsValid());
-		
-		if ((newsData != NULL) &&
-				(wxDateTime::Now() - newsData->lastDownloadNews < TIME_BETWEEN_NEWS_UPDATES) ) {
-			// post the news that we have on file for now
-			newsWindow->SetPage(newsData->theNews);
-		} else {
-			wxFileSystem filesystem;
-			wxFSFile* news = filesystem.OpenFile(newsSource.GetNewsUrl(), wxFS_READ);
-			if ( news == NULL ) {
-				wxLogError(_("Error in retrieving news"));
-				return;
+		// fetch every source whose news is out of date, all at once
+		const std::vector<NewsSource>& sources(NewsSource::GetAllSources());
+		for (std::vector<NewsSource>::const_iterator it = sources.begin(), end = sources.end();
+				it != end; ++it) {
+			const NewsData* newsData = proman->NewsRead(it->GetName());
+
+			wxASSERT((newsData == NULL) || newsData->IsValid());
+
+			if (!this->newsFetcher) {
+				if (newsData == NULL) {
+					this->newsStatus[it->GetName()] = _("The news can't be downloaded.");
+				}
+				continue;
 			}
-
-			wxInputStream* rawNewsStream = news->GetStream();
-			wxLogDebug(_T("news loaded from %s with type %s"), news->GetLocation().c_str(), news->GetMimeType().c_str());
-
-			wxString newsStr;
-			wxStringOutputStream newsStrStream(&newsStr);
-			rawNewsStream->Read(newsStrStream);
-			wxString formattedData(_T("<ul>"));
-			wxStringTokenizer tok(newsStr, _T("\t"), wxTOKEN_STRTOK);
-			
-			while(tok.HasMoreTokens()) {
-				wxString title(tok.GetNextToken());
-				wxCHECK_RET(tok.HasMoreTokens(), _T("news formatter has run out of tokens at wrong time"));
-				wxString link(tok.GetNextToken());
-				wxCHECK_RET(tok.HasMoreTokens(), _T("news formatter has run out of tokens at wrong time"));
-				wxString imglink(tok.GetNextToken());
-				
-				formattedData += wxString::Format(_T("\n<li><a href='%s'>%s</a><!-- %s --></li>"), link.c_str(), title.c_str(), imglink.c_str());
+			if (((newsData != NULL) &&
+					(wxDateTime::Now() - newsData->lastDownloadNews < it->GetRefreshInterval()))
+				|| this->newsFetcher->IsFetching(it->GetName())) {
+				continue;
 			}
-			formattedData += _T("\n</ul>");
-			
-			newsWindow->SetPage(formattedData);
 
-			proman->NewsWrite(
-				newsSource.GetName(),
-				NewsData(formattedData, wxDateTime::Now()));
+			NewsFetchRequest request;
+			request.sourceName = it->GetName();
+			request.url = it->GetNewsUrl();
+			if (newsData != NULL) {
+				request.etag = newsData->etag;
+				request.lastModified = newsData->lastModified;
+			} else {
+				this->newsStatus[it->GetName()] = _("Retrieving news...");
+			}
+			this->newsFetcher->Start(request);
 		}
+		// the news on file is shown until the new news arrives
+		this->ShowNews();
 	} else {
 		newsWindow->SetPage(_("Automatic news retrieval disabled."));
 	}
 }
 
+void WelcomePage::OnNewsFetched(wxCommandEvent& event) {
+	NewsFetchResult result;
+	if (!this->newsFetcher || !this->newsFetcher->TakeResult(event.GetInt(), result)) {
+		return;
+	}
+	ProMan* proman = ProMan::GetProfileManager();
+	const NewsData* newsData = proman->NewsRead(result.sourceName);
+
+	switch (result.status) {
+		case NewsFetchResult::NEWS_FETCH_OK:
+			wxLogDebug(wxT_2("news downloaded for %s"), result.sourceName.c_str());
+			proman->NewsWrite(result.sourceName,
+				NewsData(NewsFetcher::FormatNews(result.items), wxDateTime::Now(),
+					result.etag, result.lastModified));
+			this->newsStatus.erase(result.sourceName);
+			break;
+		case NewsFetchResult::NEWS_FETCH_NOT_MODIFIED:
+			wxCHECK_RET(newsData != NULL,
+				wxT_2("news not modified, but there is no news on file"));
+			wxLogDebug(wxT_2("news for %s has not changed"), result.sourceName.c_str());
+			proman->NewsWrite(result.sourceName,
+				NewsData(wxString(newsData->theNews), wxDateTime::Now(),
+					result.etag, result.lastModified));
+			this->newsStatus.erase(result.sourceName);
+			break;
+		default:
+			wxLogWarning(_("Unable to retrieve the news for %s: %s"),
+				result.sourceName.c_str(), result.error.c_str());
+			// shown above the old news, if there is any, until a fetch succeeds
+			this->newsStatus[result.sourceName] = _("Unable to retrieve the news.");
+			break;
+	}
+
+	bool allowedToUpdateNews;
+	if (proman->GlobalRead(GBL_CFG_NET_DOWNLOAD_NEWS, &allowedToUpdateNews)
+			&& allowedToUpdateNews) {
+		this->ShowNews();
+	}
+}
+
+/** Shows a section for every news source, the current skin's source first. */
+void WelcomePage::ShowNews() {
+	wxHtmlWindow* newsWindow = dynamic_cast<wxHtmlWindow*>(wxWindow::FindWindowById(ID_NEWS_HTML_PANEL, this));
+	wxCHECK_RET(newsWindow != NULL, _T("Show news called, but can't find the news window"));
+
+	const NewsSource& skinSource(SkinSystem::GetSkinSystem()->GetNewsSource());
+	// the news box is already labelled with the skin's source
+	wxString page(this->GetNewsSection(skinSource, false));
+
+	const std::vector<NewsSource>& sources(NewsSource::GetAllSources());
+	for (std::vector<NewsSource>::const_iterator it = sources.begin(), end = sources.end();
+			it != end; ++it) {
+		if (it->GetName() != skinSource.GetName()) {
+			page += this->GetNewsSection(*it, true);
+		}
+	}
+	newsWindow->SetPage(page);
+}
+
+wxString WelcomePage::GetNewsSection(const NewsSource& source, bool withHeading) const {
+	wxString section;
+	if (withHeading) {
+		wxString label(source.GetLabel());
+		label.Replace(wxT_2("&&"), wxT_2("&amp;")); // && is an & in control labels
+		section += wxString::Format(wxT_2("\n<h4>%s</h4>"), label.c_str());
+	}
+
+	const NewsData* newsData = ProMan::GetProfileManager()->NewsRead(source.GetName());
+	wxStringToStringHashMap::const_iterator status =
+		this->newsStatus.find(source.GetName());
+	if (status != this->newsStatus.end()) {
+		section += (newsData != NULL) ?
+			wxString::Format(wxT_2("<p><i>%s</i></p>"), status->second.c_str()) : status->second;
+	}
+	if (newsData != NULL) {
+		section += newsData->theNews;
+	}
+	return section;
+}
+
 void WelcomePage::getOrPromptUpdateNews(wxIdleEvent &WXUNUSED(event)) {
 	this->Disconnect(wxEVT_IDLE, wxIdleEventHandler(WelcomePage::getOrPromptUpdateNews));
 	wxCHECK_RET(updateNewsCheck != NULL, wxT("checkbox is NULL"));
@@ -19,9 +19,14 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #ifndef WELCOMEPAGE_H
 #define WELCOMEPAGE_H
 
+#include <memory>
+
 #include <wx/wx.h>
+#include <wx/hashmap.h>
 
 #include "global/ids.h"
+#include "apis/NewsFetcher.h"
+#include "datastructures/NewsSource.h"
 #include "apis/ProfileManager.h"
 
 class WelcomePage: public wxPanel {
@@ -35,6 +40,7 @@ public:
 	void ProfileChanged(wxCommandEvent& event);
 	void ProfileCountChanged(wxCommandEvent& event);
 	void UpdateNews(wxIdleEvent& event);
+	void OnNewsFetched(wxCommandEvent& event);
 	void OnDownloadNewsCheck(wxCommandEvent& event);
 	void OnUpdateNewsHelp(wxCommandEvent& event);
 	void OnTCSkinChanged(wxCommandEvent& event);
@@ -48,6 +54,13 @@ private:
 	void deleteProfile(wxChoice* combobox, ProMan* profile);
 
 	bool needToUpdateNews;
+	/** NULL if the news can't be downloaded this session. */
+	std::unique_ptr<NewsFetcher> newsFetcher;
+	/** What to show for a source instead of its news, or above the news on
+	 file when the last fetch failed. */
+	wxStringToStringHashMap newsStatus;
+	void ShowNews();
+	wxString GetNewsSection(const NewsSource& source, bool withHeading) const;
 	wxCheckBox* updateNewsCheck;
 	void getOrPromptUpdateNews(wxIdleEvent&);
 
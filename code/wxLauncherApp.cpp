@@ -24,6 +24,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include <wx/fs_arc.h>
 #include <wx/fs_inet.h>
 #include <wx/splash.h>
+#include <wx/stdpaths.h>
 
 #if HAS_SDL == 1
 #include "SDL.h"
@@ -43,7 +44,13 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "apis/ProfileManager.h"
 #include "apis/HelpManager.h"
 #include "apis/FlagListManager.h"
+#include "apis/EventDispatcher.h"
 #include "apis/ProfileProxy.h"
+#include "apis/LaunchPipeline.h"
+#include "apis/ModDataWarmer.h"
+#include "apis/NewsFetcher.h"
+#include "global/ResourceBundle.h"
+#include "global/StartupProfiler.h"
 
 #include "global/MemoryDebugging.h" // Last include for memory debugging
 
@@ -70,6 +77,12 @@ void wxLauncher::OnInitCmdLine(wxCmdLineParser& parser)
 		"The path to a file to operate on. Operand FILE.";
 	static const char sessiononlydesc[] =
 		"Do not remember the profile that is selected at exit";
+	static const char profilestartupdesc[] =
+		"Time the phases of startup, writing a summary to the log "
+		"and a Chrome trace to wxLauncher_startup.json";
+	static const char newsurldesc[] =
+		"Fetch the news from URL instead of from the skin's news source, "
+		"such as a local test server";
 
 	/* Operators */
 	parser.AddSwitch(wxEmptyString, wxT_2("add-profile"),
@@ -88,6 +101,11 @@ void wxLauncher::OnInitCmdLine(wxCmdLineParser& parser)
 	/* Other */
 	parser.AddSwitch(wxEmptyString, wxT_2("session-only"),
 		wxGetTranslation(wxString::FromUTF8(sessiononlydesc)));
+	parser.AddSwitch(wxEmptyString, wxT_2("profile-startup"),
+		wxGetTranslation(wxString::FromUTF8(profilestartupdesc)));
+	parser.AddOption(wxEmptyString, wxT_2("news-url"),
+		wxGetTranslation(wxString::FromUTF8(newsurldesc)),
+		wxCMD_LINE_VAL_STRING);
 
 	parser.SetSwitchChars(wxT_2("-")); // always use -, even on windows
 
@@ -103,6 +121,18 @@ bool wxLauncher::OnCmdLineParsed(wxCmdLineParser& parser)
 	{
 		mKeepForSessionOnly = true;
 	}
+
+	if (parser.Found(wxT_2("profile-startup")))
+	{
+		StartupProfiler::Enable(wxFileName(wxStandardPaths::Get().GetUserDataDir(),
+			wxT_2("wxLauncher_startup.json")).GetFullPath());
+	}
+
+	wxString newsUrl;
+	if (parser.Found(wxT_2("news-url"), &newsUrl))
+	{
+		NewsFetcher::SetUrlOverride(newsUrl);
+	}
 	
 	if (parser.Found(wxT_2("add-profile")))
 	{
@@ -154,10 +184,9 @@ of the failue.  Returns true otherwise.
 */
 bool displaySplash(wxSplashScreen **splashWindow)
 {
-	wxBitmap splash;
 	// splash image location is fixed so that it's known at compile time
-	wxFileName splashFile(wxT_2(RESOURCES_PATH), wxT_2("wxL_Splash.png"));
-	if (splash.LoadFile(splashFile.GetFullPath(), wxBITMAP_TYPE_ANY)) {
+	const wxBitmap splash(ResourceBundle::Get().LoadBitmap(wxT_2("wxL_Splash.png")));
+	if (splash.IsOk()) {
 #if NDEBUG
 		(*splashWindow) = new wxSplashScreen(splash, wxSPLASH_CENTRE_ON_SCREEN, 0, NULL, wxID_ANY);
 #else
@@ -191,12 +220,16 @@ int wxLauncher::OnRun() {
 }
 
 bool wxLauncher::OnInit() {
+	StartupPhases phases;
+	phases.Next(wxT_2("Image handlers"));
 	wxInitAllImageHandlers();
 
+	phases.Next(wxT_2("Command line"));
 	// call base class OnInit so that cmdline stuff works.
 	if (!wxApp::OnInit())
 		return false; // base said abort so abort
 
+	phases.Next(wxT_2("Logger"));
 	wxLog::SetActiveTarget(new Logger());
 	wxLogInfo(wxT_2("wxLauncher Version %d.%d.%d"), MAJOR_VERSION, MINOR_VERSION, PATCH_VERSION);
 	wxLogInfo(wxT_2("Build \"%s\" committed on (%s)"), GITVersion, GITDate);
@@ -217,10 +250,16 @@ bool wxLauncher::OnInit() {
 		}
 	}
 
+	phases.Next(wxT_2("Splash screen"));
 	wxSplashScreen* splashWindow = NULL;
 	if (!displaySplash(&splashWindow))
 		return false;
 
+	phases.Next(wxT_2("EventDispatcher::Initialize"));
+	wxLogInfo(wxT_2("Initializing EventDispatcher..."));
+	EventDispatcher::Initialize();
+
+	phases.Next(wxT_2("ProMan::Initialize"));
 	wxLogInfo(wxT_2("Initializing profiles..."));
 	ProMan::Flags promanFlags = ProMan::None;
 	if (mKeepForSessionOnly)
@@ -238,21 +277,44 @@ bool wxLauncher::OnInit() {
 	wxFileSystem::AddHandler(new wxArchiveFSHandler);
 	wxFileSystem::AddHandler(new wxInternetFSHandler);
 
+	phases.Next(wxT_2("SkinSystem::Initialize"));
 	wxLogInfo(wxT_2("Initializing SkinSystem..."));
 	SkinSystem::Initialize();
 
+	phases.Next(wxT_2("HelpManager::Initialize"));
 	wxLogInfo(wxT_2("Initializing HelpManager..."));
 	HelpManager::Initialize();
 	
+	phases.Next(wxT_2("TCManager::Initialize"));
+	wxLogInfo(wxT_2("Initializing TCManager..."));
+	TCManager::Initialize();
+
+	phases.Next(wxT_2("FlagListManager::Initialize"));
 	wxLogInfo(wxT_2("Initializing FlagListManager..."));
 	FlagListManager::Initialize();
 	
+	phases.Next(wxT_2("ProfileProxy::Initialize"));
 	wxLogInfo(wxT_2("Initializing ProfileProxy..."));
 	ProfileProxy::Initialize();
 
+	phases.Next(wxT_2("LaunchPipeline::Initialize"));
+	wxLogInfo(wxT_2("Initializing LaunchPipeline..."));
+	LaunchPipeline::Initialize();
+
+	phases.Next(wxT_2("ModDataWarmer::Initialize"));
+	wxLogInfo(wxT_2("Initializing ModDataWarmer..."));
+	ModDataWarmer::Initialize();
+
+	phases.Next(wxT_2("NewsFetcher::Initialize"));
+	wxLogInfo(wxT_2("Initializing NewsFetcher..."));
+	if (!NewsFetcher::Initialize()) {
+		wxLogWarning(wxT_2("Unable to initialize sockets; the news will not be downloaded."));
+	}
+
 	wxLogInfo(wxT_2("wxLauncher starting up."));
 
 
+	phases.Next(wxT_2("MainWindow"));
 	MainWindow* window = new MainWindow();
 	wxLogStatus(_("MainWindow is complete"));
 	window->Show(true);
@@ -261,17 +323,21 @@ bool wxLauncher::OnInit() {
 	splashWindow->Destroy();
 #endif
 
+	phases.Next(wxT_2("Initial profile events"));
 	// must call TCManager::CurrentProfileChanged() manually on startup,
 	// since initial profile switch takes place before TCManager has been initialized
-	// calling it here to ensure that AdvSettingsPage is set up by the time events are triggered
+	// pages that are built later are sent the resulting events when they register
 	wxCommandEvent tcMgrInitEvent;
 	TCManager::Get()->CurrentProfileChanged(tcMgrInitEvent);
+	phases.End();
 
 	wxLogStatus(_("Ready."));
 	return true;
 }
 
 int wxLauncher::OnExit() {
+	// in case startup never got as far as processing a flag file
+	StartupProfiler::Finish();
 
 	ProMan::DeInitialize();
 
@@ -279,8 +345,12 @@ int wxLauncher::OnExit() {
 	{
 
 		// deinitialize subsystems in the opposite order of initialization
+		NewsFetcher::DeInitialize();
+		ModDataWarmer::DeInitialize();
+		LaunchPipeline::DeInitialize();
 		ProfileProxy::DeInitialize();
 		FlagListManager::DeInitialize();
+		TCManager::DeInitialize();
 		HelpManager::DeInitialize();
 		SkinSystem::DeInitialize();
 
@@ -290,6 +360,10 @@ int wxLauncher::OnExit() {
 
 	}
 
+	if (EventDispatcher::IsInitialized()) {
+		EventDispatcher::DeInitialize();
+	}
+
 	wxLogInfo(_("wxLogger shutdown complete."));
 
 	return wxApp::OnExit();
@@ -299,10 +373,13 @@ int wxLauncher::OnExit() {
 int main(int argc, char** argv)
 {
 #if HAS_SDL == 1
-	if (SDL_InitSubSystem(SDL_INIT_VIDEO) < 0)
 	{
-		wxLogFatalError(wxT_2("SDL_Init failed"));
-		return 1;
+		StartupProbe probe(wxT_2("SDL_InitSubSystem(SDL_INIT_VIDEO)"));
+		if (SDL_InitSubSystem(SDL_INIT_VIDEO) < 0)
+		{
+			wxLogFatalError(wxT_2("SDL_Init failed"));
+			return 1;
+		}
 	}
 #endif
 
@@ -266,6 +266,11 @@ class Stage5Parser(OutputParser):
     def __init__(self, *args, **kwargs):
         OutputParser.__init__(self, *args, **kwargs)
         self.title = "Untitled"
+        self.text = []  # the page's text without tags, for the search index
+
+    def handle_data(self, data):
+        self.text.append(data)
+        OutputParser.handle_data(self, data)
 
     def handle_endtag(self, tag):
         if tag == "title":
@@ -1,7 +1,10 @@
-from __future__ import absolute_import
+from __future__ import (absolute_import, division,
+                        print_function, unicode_literals)
 
+import io
 import logging
 import os
+import re
 import shutil
 import zipfile
 
@@ -62,9 +65,12 @@ def _do_build(args, files, notices):
         logging.info("   Stage 4")
         name4 = process_input_stage4(name3, args, files)
     logging.info(" Stage 5")
-    process_input_stage5(args, files, extra_files)
+    search_pages = list()
+    process_input_stage5(args, files, extra_files, search_pages)
     logging.info(" Stage 6")
     process_input_stage6(args, files)
+    logging.info(" Generating search index")
+    generate_search_index(args, search_pages)
     logging.info(" Generating .cpp files")
     generate_cpp_files(args, files, help_array)
     notices.info("....Done.")
@@ -85,6 +91,9 @@ def generate_paths(options):
             logging.debug(" Making %s", path)
             os.makedirs(path)
 
+    if options.indexfilename is None:
+        options.indexfilename = os.path.splitext(options.outfile)[0] + ".idx"
+
     return paths
 
 
@@ -103,6 +112,9 @@ def should_build(options):
     elif options.carrayfilename and not os.path.exists(options.carrayfilename):
         logger.info(" .cpp file does not exist")
         return True
+    elif not os.path.exists(options.indexfilename):
+        logger.info(" Search index does not exist")
+        return True
     elif check_source_newer_than_outfile(options):
         logger.info(" Source files are newer than output")
         return True
@@ -240,8 +252,10 @@ INDEXES_FILE_TEMPLATE = "\n".join([
     ''])
 
 
-def process_input_stage5(options, files, extrafiles):
-    """Generate the index and table of contents"""
+def process_input_stage5(options, files, extrafiles, searchpages):
+    """Generate the index and table of contents.
+
+    Also appends (file in archive, title, text) to searchpages for each page."""
 
     # write header file
     header_file_name = os.path.join(files['stage5'], "header.hhp")
@@ -298,6 +312,7 @@ def process_input_stage5(options, files, extrafiles):
         parser.feed(input)
         parser.close()
         outindex.close()
+        searchpages.append((index_in_archive, parser.title, " ".join(parser.text)))
 
         tocfile.write(
             generate_sections(path_list, last_path_list, index_filename=index_in_archive, section_title=parser.title))
@@ -329,6 +344,7 @@ def process_input_stage5(options, files, extrafiles):
             outfile.close()
 
             filename_in_indexes = filename_in_archive.replace('\\', '/')
+            searchpages.append((filename_in_indexes, parser.title, " ".join(parser.text)))
 
             tocfile.write(INDEXES_FILE_TEMPLATE % {
                 "tab": "\t"*level,
@@ -454,6 +470,47 @@ def process_input_stage6(options, stage_dirs):
     outzip.close()
 
 
+SEARCH_INDEX_HEADER = "wxLauncher help index 1"
+SEARCH_WORD_RE = re.compile(r"[a-z0-9]+")
+
+
+def search_words(text):
+    """Splits text into the words the search index is keyed on.
+
+    Must match HelpManager's splitting of search queries: lower case ASCII
+    letters and digits, two or more long."""
+    return set(word for word in SEARCH_WORD_RE.findall(text.lower())
+               if len(word) > 1)
+
+
+def generate_search_index(options, pages):
+    """Write the inverted index that the launcher answers help searches from.
+
+    The file is UTF-8 text: the header line, then "pages N" and one
+    "file<TAB>title" line per page, then one "word<TAB>page,page,..." line
+    per word, sorted by word, listing the numbers of the pages it is in."""
+    # the pages' text is bytes when Python 2 read it from the stage files
+    pages = [tuple(field.decode("utf-8") if isinstance(field, bytes) else field
+                   for field in page)
+             for page in pages]
+    postings = dict()
+    for number, (filename, title, text) in enumerate(pages):
+        for word in search_words(title + " " + text):
+            postings.setdefault(word, []).append(number)
+
+    logging.getLogger('notices').info("Writing to %s", options.indexfilename)
+    with io.open(options.indexfilename, mode="w", encoding="utf-8",
+                 newline="\n") as outfile:
+        outfile.write("%s\n" % SEARCH_INDEX_HEADER)
+        outfile.write("pages %d\n" % len(pages))
+        for filename, title, text in pages:
+            outfile.write("%s\t%s\n" % (filename, " ".join(title.split())))
+        for word in sorted(postings):
+            outfile.write("%s\t%s\n" % (
+                word, ",".join(str(number) for number in postings[word])))
+    logging.debug(" %d words in %d pages", len(postings), len(pages))
+
+
 def generate_cpp_files(options, files, helparray):
     if options.carrayfilename == None:
         defaultname = os.path.join(os.path.dirname(options.outfile), "helplinks.cpp")
@@ -465,7 +522,9 @@ def generate_cpp_files(options, files, helparray):
     outfile = open(options.carrayfilename, mode="w")
     outfile.write("// Generated by scripts/onlinehelpmaker.py\n")
     outfile.write("// GENERATED FILE - DO NOT EDIT\n")
-    for id, location in helparray:
+    # sorted so that the generated file doesn't change with the order the
+    # help files are found in; HelpManager sorts the table by id value itself
+    for id, location in sorted(helparray):
         outfile.write("""{%s,_T("%s")},\n""" %
                       (id, location.replace(os.path.sep, "/")))
 
@@ -46,6 +46,10 @@ def main(argv):
     bld_ps.add_argument("-c", "--cfile", default=None, dest="carrayfilename",
                         metavar="FILE",
                         help="file to put the htb index in (c code)")
+    bld_ps.add_argument("-i", "--index", default=None, dest="indexfilename",
+                        metavar="FILE",
+                        help="file to put the full-text search index in "
+                        "(OUTFILE with a .idx extension by default)")
     bld_ps.add_argument("-a", "--always", action="store_true",
                         default=False, dest="always_build",
                         help="builder should always build source files")
@@ -0,0 +1,96 @@
+"""Packs the launcher's default skin and splash images into one file.
+
+The launcher maps the bundle into memory at startup and decodes each image
+straight out of it, so that starting up opens one file instead of a dozen.
+
+Bundle layout, all integers little endian:
+    8 bytes   magic, "WXLRES" followed by the format version as two bytes
+    uint32    number of entries
+    entries, sorted by name:
+        uint16    length of the name in bytes
+        bytes     name, UTF-8
+        uint32    offset of the file's data from the start of the bundle
+        uint32    size of the file's data
+    the files' data, each starting on an 8 byte boundary
+
+The files are stored as they are: PNG and ICO are already compressed
+without loss, so compressing them again gains nothing."""
+
+import argparse
+import logging
+import os.path
+import struct
+import sys
+
+MAGIC = b"WXLRES\x00\x01"
+ALIGNMENT = 8
+
+
+def align(offset):
+    return (offset + ALIGNMENT - 1) // ALIGNMENT * ALIGNMENT
+
+
+def build_bundle(outfile, files):
+    entries = list()
+    for path in files:
+        name = os.path.basename(path)
+        with open(path, mode="rb") as infile:
+            entries.append((name.encode("utf-8"), infile.read()))
+    entries.sort()
+
+    names = set()
+    for name, data in entries:
+        if name in names:
+            raise ValueError("%s is in the bundle twice" % name.decode("utf-8"))
+        names.add(name)
+
+    header_size = len(MAGIC) + 4
+    for name, data in entries:
+        header_size += 2 + len(name) + 4 + 4
+
+    header = [MAGIC, struct.pack("<I", len(entries))]
+    offset = align(header_size)
+    offsets = list()
+    for name, data in entries:
+        header.append(struct.pack("<H", len(name)))
+        header.append(name)
+        header.append(struct.pack("<II", offset, len(data)))
+        offsets.append(offset)
+        offset = align(offset + len(data))
+
+    outdir = os.path.dirname(outfile)
+    if outdir and not os.path.exists(outdir):
+        os.makedirs(outdir)
+
+    with open(outfile, mode="wb") as out:
+        out.write(b"".join(header))
+        for (name, data), data_offset in zip(entries, offsets):
+            out.write(b"\0" * (data_offset - out.tell()))
+            out.write(data)
+            logging.debug(" %s: %d bytes at %d", name.decode("utf-8"),
+                          len(data), data_offset)
+
+    logging.info("Packed %d files into %s", len(entries), outfile)
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(
+        description="Pack the default skin images into a resource bundle")
+    parser.add_argument('outfile', type=os.path.normpath,
+                        help="bundle file to write")
+    parser.add_argument('files', nargs='+', type=os.path.normpath,
+                        help="files to put in the bundle, stored under their "
+                        "file names")
+    parser.add_argument("-d", "--debug", action="store_const",
+                        default=logging.INFO, const=logging.DEBUG,
+                        help="print debugging information to the screen")
+
+    options = parser.parse_args(argv)
+    logging.basicConfig(level=options.debug)
+
+    build_bundle(options.outfile, options.files)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))